@@ -11,86 +11,92 @@ struct VSIn {
 struct PSIn {
 	float4 position : SV_Position;
 	float3 normal : NORMAL0;
+	float3 tangent : TANGENT0;
+	float3 bitangent : BINORMAL0;
 	float2 texCoords : TEXCOORD0;
 	float clip : SV_ClipDistance0;
-	float3 toCam : TOCAM;
-	//Material material : MAT;
-	LightList lights : LIGHTS;
+	float3 worldPos : WORLDPOS;
+	float4 clipPos : CLIPPOS; // Finds the light cluster without knowing the size of the render target
 };
 
+// Per object, updated every draw
 cbuffer VSPSSystemCBuffer : register(b0) {
 	matrix sys_mWorld;
-    matrix sys_mVP;
+}
+
+#ifdef _SAIL_DX12
+// DX12 gathers the world matrices of all draws into one buffer, indexed by a root constant
+struct DrawConstants {
+	uint drawID;
+};
+ConstantBuffer<DrawConstants> sys_draw : register(b4);
+StructuredBuffer<float4x4> sys_worldMatrices : register(t10);
+#define SYS_WORLD sys_worldMatrices[sys_draw.drawID]
+#else
+#define SYS_WORLD sys_mWorld
+#endif
+
+// Per material, updated when the material changes
+cbuffer VSPSMaterial : register(b1) {
     Material sys_material;
-    //float padding;
+}
+
+// Per frame, updated once by the renderer
+cbuffer VSPSFrameCBuffer : register(b2) {
+    matrix sys_mVP;
     float4 sys_clippingPlane;
     float3 sys_cameraPos;
+    uint4 sys_lightGridSize; // Tiles in x and y and the number of depth slices
+    float4 sys_lightGridDepth; // Near z and slices per unit of log(viewZ / near)
+}
+
+// Per pass, updated once by the renderer
+cbuffer VSPSLights : register(b3) {
+	DirectionalLight dirLight;
 }
 
-struct PointLightInput {
+// Clustered point lights from LightGrid, see LightGrid.h for how a pixel finds its cluster
+struct ClusterLight {
 	float3 color;
+	float radius;
 	float3 position;
-    float attConstant;
-    //float attLinear;
-    //float attQuadratic;
+	float attConstant;
+	float attLinear;
+	float attQuadratic;
+	float2 padding;
 };
-cbuffer VSLights : register(b1) {
-	DirectionalLight dirLight;
-    PointLightInput pointLights[NUM_POINT_LIGHTS];
+StructuredBuffer<ClusterLight> sys_clusterLights : register(t11);
+StructuredBuffer<uint2> sys_lightClusters : register(t12); // Offset and count in sys_clusterLightIndices
+StructuredBuffer<uint> sys_clusterLightIndices : register(t13);
+
+uint getClusterIndex(float4 clipPos) {
+	// Tile rows go from the top of the screen and down, the w of a perspective projection is the view depth
+	float2 ndc = clipPos.xy / clipPos.w;
+	uint tileX = min((uint)(saturate(ndc.x * 0.5f + 0.5f) * sys_lightGridSize.x), sys_lightGridSize.x - 1);
+	uint tileY = min((uint)(saturate(0.5f - ndc.y * 0.5f) * sys_lightGridSize.y), sys_lightGridSize.y - 1);
+	uint slice = min((uint)max(log(clipPos.w / sys_lightGridDepth.x) * sys_lightGridDepth.y, 0.f), sys_lightGridSize.z - 1);
+	return tileX + (tileY + slice * sys_lightGridSize.y) * sys_lightGridSize.x;
 }
 
 PSIn VSMain(VSIn input) {
 	PSIn output;
 
-	// Copy over the directional light
-	output.lights.dirLight = dirLight;
-	// Copy over point lights
-    for (uint i = 0; i < NUM_POINT_LIGHTS; i++) {
-        output.lights.pointLights[i].attConstant = pointLights[i].attConstant;
-        output.lights.pointLights[i].attLinear = 0.1f;
-        output.lights.pointLights[i].attQuadratic = 0.02f;
-        //output.lights.pointLights[i].attLinear = pointLights[i].attLinear;
-        //output.lights.pointLights[i].attQuadratic = pointLights[i].attQuadratic;
-        output.lights.pointLights[i].color = pointLights[i].color;
-    }
-
 	input.position.w = 1.f;
-	output.position = mul(sys_mWorld, input.position);
+	output.position = mul(SYS_WORLD, input.position);
 
 	// Calculate the distance from the vertex to the clipping plane
 	// This needs to be done with world coordinates
     output.clip = dot(output.position, sys_clippingPlane);
 
-	// World space vector pointing from the vertex position to the camera
-    output.toCam = sys_cameraPos - output.position.xyz;
-
-    for (uint i = 0; i < NUM_POINT_LIGHTS; i++) {
-		// World space vector poiting from the vertex position to the point light
-        output.lights.pointLights[i].fragToLight = pointLights[i].position - output.position.xyz;
-		// The world space distance from the vertex to the light
-        output.lights.pointLights[i].distanceToLight = length(output.lights.pointLights[i].fragToLight);
-    }
-
+	// Lights are evaluated per pixel in world space
+    output.worldPos = output.position.xyz;
 
     output.position = mul(sys_mVP, output.position);
+    output.clipPos = output.position;
 
-	if (sys_material.hasNormalTexture) {
-	    // Convert to tangent space
-		float3x3 TBN = {
-			mul((float3x3) sys_mWorld, normalize(input.tangent)),
-			mul((float3x3) sys_mWorld, normalize(input.bitangent)),
-			mul((float3x3) sys_mWorld, normalize(input.normal))
-		};
-		TBN = transpose(TBN);
-
-		output.toCam = mul(output.toCam, TBN);
-		output.lights.dirLight.direction = mul(output.lights.dirLight.direction, TBN);
-        for (int i = 0; i < NUM_POINT_LIGHTS; i++)
-            output.lights.pointLights[i].fragToLight = mul(output.lights.pointLights[i].fragToLight, TBN);
-    }
-
-	output.normal = mul((float3x3) sys_mWorld, input.normal);
-	output.normal = normalize(output.normal);
+	output.normal = normalize(mul((float3x3) SYS_WORLD, input.normal));
+	output.tangent = mul((float3x3) SYS_WORLD, input.tangent);
+	output.bitangent = mul((float3x3) SYS_WORLD, input.bitangent);
 
 	output.texCoords = input.texCoords;
 
@@ -108,25 +114,43 @@ float4 PSMain(PSIn input) : SV_Target0 {
 
 	PhongInput phongInput;
 	phongInput.mat = sys_material;
-	phongInput.fragToCam = input.toCam;
-	phongInput.lights = input.lights;
+	phongInput.fragToCam = normalize(sys_cameraPos - input.worldPos);
 
 	phongInput.diffuseColor = sys_material.modelColor;
 	if (sys_material.hasDiffuseTexture)
 		phongInput.diffuseColor *= sys_texDiffuse.Sample(PSss, input.texCoords);
 
-	phongInput.normal = input.normal;
-	if (sys_material.hasNormalTexture)
-		phongInput.normal = sys_texNormal.Sample(PSss, input.texCoords).rgb * 2.f - 1.f;
+	phongInput.normal = normalize(input.normal);
+	if (sys_material.hasNormalTexture) {
+		// Tangent space to world space
+		float3x3 TBN = { normalize(input.tangent), normalize(input.bitangent), phongInput.normal };
+		phongInput.normal = normalize(mul(decodeNormalMap(sys_texNormal.Sample(PSss, input.texCoords)), TBN));
+	}
 
 	phongInput.specMap = float3(1.f, 1.f, 1.f);
 	if (sys_material.hasSpecularTexture)
 		phongInput.specMap = sys_texSpecular.Sample(PSss, input.texCoords).rgb;
 
 
+	float3 totalColor = phongDirectionalLight(phongInput, dirLight);
+
+	// Only the point lights whose spheres overlap the cluster of this pixel
+	uint2 cluster = sys_lightClusters[getClusterIndex(input.clipPos)];
+	for (uint i = 0; i < cluster.y; i++) {
+		ClusterLight light = sys_clusterLights[sys_clusterLightIndices[cluster.x + i]];
+		PointLight p;
+		p.color = light.color;
+		p.fragToLight = light.position - input.worldPos;
+		p.distanceToLight = length(p.fragToLight);
+		p.attConstant = light.attConstant;
+		p.attLinear = light.attLinear;
+		p.attQuadratic = light.attQuadratic;
+		totalColor += phongPointLight(phongInput, p);
+	}
+
     //return sys_texDiffuse.Sample(PSss, input.texCoords);
 	// return float4(phongInput.normal * 0.5f + 0.5, 1.f);
-    return phongShade(phongInput);
+    return phongCombine(phongInput, totalColor);
     //return float4(phongInput.lights.dirLight.direction, 1.f);
     //return float4(phongInput.diffuseColor.rgb, 1.f);
     //return float4(0.f, 1.f, 0.f, 1.f);
@@ -1,4 +1,5 @@
-#define NUM_POINT_LIGHTS 8
+#define NUM_POINT_LIGHTS 8 // Length of LightList, has to match LightSetup::MAX_POINTLIGHTS_PER_OBJECT
+#define MAX_POINT_LIGHTS 512 // Has to match LightSetup::MAX_POINTLIGHTS
 
 struct PointLight {
 	float3 color;
@@ -39,59 +40,66 @@ struct PhongInput {
 	LightList lights;
 };
 
+// Tangent space normal from a normal map sample
+// Only red and green are read and z is rebuilt, so the same code works for RGBA8 and two channel BC5 normal maps
+float3 decodeNormalMap(float4 texel) {
+	float2 xy = texel.rg * 2.f - 1.f;
+	return float3(xy, sqrt(saturate(1.f - dot(xy, xy))));
+}
 
-float4 phongShade(PhongInput input) {
-
-	float3 ambientCoefficient = float3(0.3f, 0.3f, 0.3f);
 
-	float3 totalColor = float3(0.f, 0.f, 0.f);
-
-	input.fragToCam = normalize(input.fragToCam);
-	input.normal = normalize(input.normal);
+fl// Light contributions for shaders that loop over their own lights
+// The normal and fragToCam of the input have to be normalized and in the same space as the light vectors
+float3 phongDirectionalLight(PhongInput input, DirectionalLight light) {
+	float3 direction = normalize(light.direction);
 
-	// Directional light
-
-	input.lights.dirLight.direction = normalize(input.lights.dirLight.direction);
-
-	float diffuseCoefficient = saturate(dot(input.normal, -input.lights.dirLight.direction));
+	float diffuseCoefficient = saturate(dot(input.normal, -direction));
 
 	float3 specularCoefficient = float3(0.f, 0.f, 0.f);
 	if (diffuseCoefficient > 0.f) {
 
-		float3 r = reflect(input.lights.dirLight.direction, input.normal);
+		float3 r = reflect(direction, input.normal);
 		r = normalize(r);
 		specularCoefficient = pow(saturate(dot(input.fragToCam, r)), input.mat.shininess) * input.specMap;
 
 	}
-	totalColor += (input.mat.kd * diffuseCoefficient + input.mat.ks * specularCoefficient) * input.diffuseColor.rgb * input.lights.dirLight.color;
-
-	// Point lights
+	return (input.mat.kd * diffuseCoefficient + input.mat.ks * specularCoefficient) * input.diffuseColor.rgb * light.color;
+}
 
-	for (int i = 0; i < NUM_POINT_LIGHTS; i++) {
-		PointLight p = input.lights.pointLights[i];
+float3 phongPointLight(PhongInput input, PointLight p) {
+	p.fragToLight = normalize(p.fragToLight);
 
-		p.fragToLight = normalize(p.fragToLight);
+	float diffuseCoefficient = saturate(dot(input.normal, p.fragToLight));
 
-		diffuseCoefficient = saturate(dot(input.normal, p.fragToLight));
+	float3 specularCoefficient = float3(0.f, 0.f, 0.f);
+	if (diffuseCoefficient > 0.f) {
 
-		specularCoefficient = float3(0.f, 0.f, 0.f);
-		if (diffuseCoefficient > 0.f) {
+		float3 r = reflect(-p.fragToLight, input.normal);
+		r = normalize(r);
+		specularCoefficient = pow(saturate(dot(input.fragToCam, r)), input.mat.shininess) * input.specMap;
 
-			float3 r = reflect(-p.fragToLight, input.normal);
-			r = normalize(r);
-			specularCoefficient = pow(saturate(dot(input.fragToCam, r)), input.mat.shininess) * input.specMap;
+	}
 
-		}
+	float attenuation = 1.f / (p.attConstant + p.attLinear * p.distanceToLight + p.attQuadratic * pow(p.distanceToLight, 2.f));
 
-		//float attenuation = 1.f / (1.f + p.attenuation * pow(p.distanceToLight, 2.f));
-        float attenuation = 1.f / (p.attConstant + p.attLinear * p.distanceToLight + p.attQuadratic * pow(p.distanceToLight, 2.f));
+	return (input.mat.kd * diffuseCoefficient + input.mat.ks * specularCoefficient) * input.diffuseColor.rgb * p.color * attenuation;
+}
 
-		totalColor += (input.mat.kd * diffuseCoefficient + input.mat.ks * specularCoefficient) * input.diffuseColor.rgb * p.color * attenuation;
+// Adds the ambient term to the summed light contributions
+float4 phongCombine(PhongInput input, float3 totalColor) {
+	float3 ambientCoefficient = float3(0.3f, 0.3f, 0.3f);
+	return float4(saturate(input.mat.ka * ambientCoefficient * input.diffuseColor.rgb + totalColor), 1.0f);
+}
 
-	}
+float4 phongShade(PhongInput input) {
 
+	input.fragToCam = normalize(input.fragToCam);
+	input.normal = normalize(input.normal);
 
+	float3 totalColor = phongDirectionalLight(input, input.lights.dirLight);
+	for (int i = 0; i < NUM_POINT_LIGHTS; i++)
+		totalColor += phongPointLight(input, input.lights.pointLights[i]);
 
-	return float4(saturate(input.mat.ka * ambientCoefficient * input.diffuseColor.rgb + totalColor), 1.0f);
+	return phongCombine(input, totalColor);
 
 }
\ No newline at end of file
@@ -133,7 +133,7 @@ GBuffers PSMain(PSIn input) {
 
   gbuffers.normal = float4(normalize(input.normal) / 2.f + .5f, 1.f);
   if (material.hasNormalTexture)
-    gbuffers.normal = float4(mul(normalize(tex[1].Sample(ss, input.texCoords).rgb * 2.f - 1.f), input.tbn) / 2.f + .5f, 1.0f);
+    gbuffers.normal = float4(mul(decodeNormalMap(tex[1].Sample(ss, input.texCoords)), input.tbn) / 2.f + .5f, 1.0f);
 
   gbuffers.specular = float4(1.f, material.shininess, 1.f, 1.f);
   if (material.hasSpecularTexture)
@@ -127,7 +127,7 @@ GBuffers PSMain(PSIn input) {
 
     gbuffers.normal = float4(normalize(input.normal) / 2.f + .5f, 1.f);
     if (sys_material.hasNormalTexture)
-        gbuffers.normal = float4(mul(normalize(sys_texNormal.Sample(PSss, input.texCoords).rgb * 2.f - 1.f), input.tbn) / 2.f + .5f, 1.0f);
+        gbuffers.normal = float4(mul(decodeNormalMap(sys_texNormal.Sample(PSss, input.texCoords)), input.tbn) / 2.f + .5f, 1.0f);
 
     gbuffers.specular = float4(1.f, sys_material.shininess, 1.f, 1.f);
     if (sys_material.hasSpecularTexture)
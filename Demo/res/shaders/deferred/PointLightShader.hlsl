@@ -1,19 +1,36 @@
+#define MAX_LIGHT_VOLUMES 512
+
 struct VSIn {
 	float4 position : POSITION0;
+	uint instanceID : SV_InstanceID;
 };
 
 struct PSIn {
 	float4 position : SV_Position;
 	float4 clipSpace : CLIPSPACE;
 	float3 positionVS : POSVS;
+	nointerpolation uint instanceID : INSTANCEID;
+};
+
+struct LightVolume {
+	float3 position; // World space
+	float radius;
+	float3 color;
+	float attConstant;
+	float attLinear;
+	float attQuadratic;
+	float2 padding;
 };
 
 cbuffer VSSystemCBuffer : register(b0) {
-    matrix sys_mWorld;
     matrix sys_mView;
     matrix sys_mProj;
 }
 
+cbuffer LightVolumes : register(b1) {
+	LightVolume def_lightVolumes[MAX_LIGHT_VOLUMES];
+}
+
 //cbuffer ModelData : register(b0) {
 //	matrix mWV;
 //	matrix mP;
@@ -22,14 +39,16 @@ cbuffer VSSystemCBuffer : register(b0) {
 PSIn VSMain(VSIn input) {
 	PSIn output;
 
-	input.position.w = 1.f;
-	output.position = input.position;
-    matrix wv = mul(sys_mWorld, sys_mView);
-	output.position = mul(input.position, wv);
-	output.position = mul(output.position, sys_mProj);
+	// Scale and move the unit sphere to the light
+	LightVolume light = def_lightVolumes[input.instanceID];
+	float4 positionWS = float4(input.position.xyz * light.radius + light.position, 1.f);
+
+	float4 positionVS = mul(positionWS, sys_mView);
+	output.position = mul(positionVS, sys_mProj);
 	output.clipSpace = output.position;
 
-	output.positionVS = mul(input.position.xyz, (float3x3)wv);
+	output.positionVS = positionVS.xyz;
+	output.instanceID = input.instanceID;
 
 	return output;
 
@@ -49,10 +68,6 @@ struct DeferredPointLightData {
 	float3 positionVS; // View space position of pointlight
 };
 
-cbuffer PSLight : register(b0) {
-	DeferredPointLightData def_pointLightInput;
-}
-
 float3 deferredPhongShading(DeferredPointLightData light, float3 fragPosVS, float3 diffuse, float3 specular, float3 normal) {
 
 	// View space vector poiting from the fragment position to the point light pos
@@ -118,7 +133,15 @@ float4 PSMain(PSIn input) : SV_Target0 {
 
     float3 specular = def_texSpecular.Sample(PSss, texCoords).rgb;
 
-    return float4(deferredPhongShading(def_pointLightInput, positionVS, diffuseColor, specular, normal), 1.0f);
+	LightVolume volume = def_lightVolumes[input.instanceID];
+	DeferredPointLightData light;
+	light.color = volume.color;
+	light.attConstant = volume.attConstant;
+	light.attLinear = volume.attLinear;
+	light.attQuadratic = volume.attQuadratic;
+	light.positionVS = mul(float4(volume.position, 1.f), sys_mView).xyz;
+
+    return float4(deferredPhongShading(light, positionVS, diffuseColor, specular, normal), 1.0f);
 	//return float4(fragToCam, 1.0f);
 	//return float4(diffuseColor + float3(0.1f, 0.1f, 0.1f), 1.f);
 	//return float4(tex[0].Sample(PSss, texCoords).rgb, 1.0f);
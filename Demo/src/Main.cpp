@@ -1,5 +1,98 @@
 #include "game/Game.h"
+#include "Sail/resources/loaders/MeshCooker.h"
+#include "Sail/resources/loaders/TextureCooker.h"
+#include "Sail/resources/TextureData.h"
+#include "Sail/api/VertexPacker.h"
+#include <filesystem>
+#include <sstream>
 
+namespace {
+
+// Runs the tool or game selected on the command line and returns the exit code
+int Run(HINSTANCE hInstance, const std::string& cmdLine) {
+
+	// Cook models with -cook <model.fbx> ... and exit without starting the game
+	{
+		std::istringstream args(cmdLine);
+		std::string arg, filename;
+		if (args >> arg && arg == "-cook") {
+			int exitCode = 0;
+			while (args >> filename) {
+				std::string path = ParsedScene::DEFAULT_MODEL_LOCATION + filename;
+				if (!MeshCooker::Cook(path, MeshCooker::GetCookedPath(path)))
+					exitCode = 1;
+			}
+			return exitCode;
+		}
+		// Cook textures with -cooktextures [texture.tga] ..., every targa file under the texture folder is cooked when none are given
+		if (arg == "-cooktextures") {
+			std::vector<std::string> paths;
+			while (args >> filename)
+				paths.push_back(TextureData::DEFAULT_TEXTURE_LOCATION + filename);
+			if (paths.empty()) {
+				for (const auto& entry : std::filesystem::recursive_directory_iterator(TextureData::DEFAULT_TEXTURE_LOCATION)) {
+					if (entry.is_regular_file() && entry.path().extension() == ".tga")
+						paths.push_back(entry.path().string());
+				}
+			}
+			int exitCode = 0;
+			for (const std::string& path : paths) {
+				if (!TextureCooker::Cook(path, TextureCooker::GetCookedPath(path)))
+					exitCode = 1;
+			}
+			return exitCode;
+		}
+		// Benchmark texture decoding with -benchtextures [iterations] on every targa file under the texture folder
+		if (arg == "-benchtextures") {
+			unsigned int iterations = 10;
+			args >> iterations;
+			std::vector<std::string> filenames;
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(TextureData::DEFAULT_TEXTURE_LOCATION)) {
+				if (entry.is_regular_file() && entry.path().extension() == ".tga")
+					filenames.push_back(entry.path().string());
+			}
+			FileLoader::TGALoader::BenchmarkDecode(filenames, iterations);
+			return 0;
+		}
+		// Benchmark vertex packing with -benchvertices [iterations] on a million random vertices
+		if (arg == "-benchvertices") {
+			unsigned int iterations = 10;
+			args >> iterations;
+			VertexPacker::Benchmark(1000000, iterations);
+			return 0;
+		}
+		// Benchmark resource lookups with -benchresources [iterations] on 5000 paths
+		if (arg == "-benchresources") {
+			unsigned int iterations = 100;
+			args >> iterations;
+			ResourceID::BenchmarkLookups(5000, iterations);
+			return 0;
+		}
+	}
+
+	Game game(hInstance);
+	// Run a benchmark instead of the interactive demo when started with -benchmark
+	Benchmark::Settings benchmarkSettings;
+	Benchmark::ParseResult benchmark = Benchmark::ParseCommandLine(cmdLine, benchmarkSettings);
+	if (benchmark == Benchmark::INVALID_ARGUMENTS)
+		return Benchmark::EXIT_FAILED;
+	if (benchmark == Benchmark::ENABLED)
+		game.startBenchmark(benchmarkSettings);
+	// Input can be recorded to a file with -record <file> and played back with -replay <file>
+	std::istringstream args(cmdLine);
+	std::string arg, path;
+	while (args >> arg) {
+		if (arg == "-record" && args >> path)
+			game.startInputRecording(path);
+		else if (arg == "-replay" && args >> path)
+			game.startInputReplay(path);
+	}
+	return game.run();
+}
+
+}
+
+#ifdef _WIN32
 // Entry point for windows subsystem
 int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nShowCmd) {
 
@@ -16,12 +109,20 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 	_CrtSetReportMode(_CRT_ERROR, _CRTDBG_MODE_DEBUG);
 
-	Game game(hInstance);
-	game.run();
+	int exitCode = Run(hInstance, lpCmdLine);
 
 	//OutputDebugString(L"\n========= Memory leak report =========\n");
 	//_CrtDumpMemoryLeaks();
 	//OutputDebugString(L"======================================\n\n");
 
-	return 0;
-}
\ No newline at end of file
+	return exitCode;
+}
+#else
+// Entry point for the null platform on other systems, the arguments are joined into a windows style command line
+int main(int argc, char** argv) {
+	std::string cmdLine;
+	for (int i = 1; i < argc; i++)
+		cmdLine += ((i > 1) ? " " : "") + std::string(argv[i]);
+	return Run(nullptr, cmdLine);
+}
+#endif
\ No newline at end of file
@@ -12,11 +12,14 @@ GameState::GameState(StateStack& stack)
 	m_app = Application::getInstance();
 	//m_scene = std::make_unique<Scene>(AABB(glm::vec3(-100.f, -100.f, -100.f), glm::vec3(100.f, 100.f, 100.f)));
 
-	// Textures needs to be loaded before they can be used
-	// TODO: automatically load textures when needed so the following can be removed
-	Application::getInstance()->getResourceManager().loadTexture("sponza/textures/spnza_bricks_a_ddn.tga");
-	Application::getInstance()->getResourceManager().loadTexture("sponza/textures/spnza_bricks_a_diff.tga");
-	Application::getInstance()->getResourceManager().loadTexture("sponza/textures/spnza_bricks_a_spec.tga");
+	auto& resman = m_app->getResourceManager();
+	auto* shader = &resman.getShaderSet<MaterialShader>();
+
+	// Decode the textures and the model on worker threads while the rest of the state is set up
+	resman.loadTextureAsync("sponza/textures/spnza_bricks_a_ddn.tga");
+	resman.loadTextureAsync("sponza/textures/spnza_bricks_a_diff.tga");
+	resman.loadTextureAsync("sponza/textures/spnza_bricks_a_spec.tga");
+	m_sphereModel = resman.loadModelAsync("sphere.fbx", shader);
 
 	// Set up camera with controllers
 	m_cam.setPosition(glm::vec3(1.6f, 4.7f, 7.4f));
@@ -55,8 +58,6 @@ GameState::GameState(StateStack& stack)
 	// Disable culling for testing purposes
 	m_app->getAPI()->setFaceCulling(GraphicsAPI::NO_CULLING);
 
-	auto* shader = &m_app->getResourceManager().getShaderSet<MaterialShader>();
-
 	// Create/load models
 	m_cubeModel = ModelFactory::CubeModel::Create(glm::vec3(0.5f), shader);
 	m_cubeModel->getMesh(0)->getMaterial()->setColor(glm::vec4(0.2f, 0.8f, 0.4f, 1.0f));
@@ -65,11 +66,6 @@ GameState::GameState(StateStack& stack)
 	m_planeModel->getMesh(0)->getMaterial()->setNormalTexture("sponza/textures/spnza_bricks_a_ddn.tga");
 	m_planeModel->getMesh(0)->getMaterial()->setSpecularTexture("sponza/textures/spnza_bricks_a_spec.tga");
 	
-	Model* fbxModel = &m_app->getResourceManager().getModel("sphere.fbx", shader);
-	fbxModel->getMesh(0)->getMaterial()->setDiffuseTexture("sponza/textures/spnza_bricks_a_diff.tga");
-	fbxModel->getMesh(0)->getMaterial()->setNormalTexture("sponza/textures/spnza_bricks_a_ddn.tga");
-	fbxModel->getMesh(0)->getMaterial()->setSpecularTexture("sponza/textures/spnza_bricks_a_spec.tga");
-
 	// Create entities
 	auto e = Entity::Create("Static cube");
 	e->addComponent<ModelComponent>(m_cubeModel.get());
@@ -88,7 +84,8 @@ GameState::GameState(StateStack& stack)
 
 	// Add some cubes which are connected through parenting
 	m_texturedCubeEntity = Entity::Create("Textured parent cube");
-	m_texturedCubeEntity->addComponent<ModelComponent>(fbxModel);
+	// The entity is not drawn until the model is parsed, its handle keeps the model loaded while it is in the scene
+	m_texturedCubeEntity->addComponent<ModelComponent>(m_sphereModel);
 	m_texturedCubeEntity->addComponent<TransformComponent>(glm::vec3(-1.f, 2.f, 0.f), m_texturedCubeEntity->getComponent<TransformComponent>());
 	m_texturedCubeEntity->setName("MovingCube");
 	m_scene.addEntity(m_texturedCubeEntity);
@@ -145,8 +142,28 @@ bool GameState::processInput(float dt) {
 		m_lights.setDirectionalLight(DirectionalLight(color, m_cam.getDirection()));
 	}
 
-	// Update the camera controller from input devices
-	m_camController.update(dt);
+	// Benchmarks fly the camera along a fixed path unless replaying recorded input, otherwise it is controlled from input devices
+	Benchmark* benchmark = m_app->getBenchmark();
+	if (benchmark && !m_app->getInputReplay()) {
+		if (!benchmark->hasCameraPath()) {
+			// Circle the scene once over the whole run
+			const Benchmark::Settings& settings = benchmark->getSettings();
+			std::vector<Benchmark::CameraKeyframe> path;
+			float loopTime = settings.fixedDeltaTime * (settings.warmupFrames + settings.numFrames);
+			for (unsigned int i = 0; i <= 16; i++) {
+				float angle = i / 16.f * glm::two_pi<float>();
+				path.push_back({ i / 16.f * loopTime, glm::vec3(glm::cos(angle) * 12.f, 4.f, glm::sin(angle) * 12.f), glm::vec3(0.f, 1.f, 0.f) });
+			}
+			benchmark->setCameraPath(path);
+		}
+		glm::vec3 position = m_cam.getPosition();
+		glm::vec3 direction = m_cam.getDirection();
+		benchmark->getCameraPose(position, direction);
+		m_cam.setPosition(position);
+		m_cam.setDirection(direction);
+	} else {
+		m_camController.update(dt);
+	}
 
 	// Reload shaders
 	if (Input::WasKeyJustPressed(SAIL_KEY_R)) {
@@ -185,6 +202,15 @@ bool GameState::update(float dt) {
 	static float change = 0.4f;
 	
 	counter += dt * 2;
+
+	// Textures can only be set once the async load has created the material, they show the placeholder until they are decoded
+	if (m_sphereModel.isReady()) {
+		Material* material = m_sphereModel.get()->getMesh(0)->getMaterial();
+		material->setDiffuseTexture("sponza/textures/spnza_bricks_a_diff.tga");
+		material->setNormalTexture("sponza/textures/spnza_bricks_a_ddn.tga");
+		material->setSpecularTexture("sponza/textures/spnza_bricks_a_spec.tga");
+		m_sphereModel.reset();
+	}
 	if (m_texturedCubeEntity) {
 		// Move the cubes around
 		m_texturedCubeEntity->getComponent<TransformComponent>()->setTranslation(glm::vec3(glm::sin(counter), 1.f, glm::cos(counter)));
@@ -221,5 +247,7 @@ bool GameState::render(float dt) {
 bool GameState::renderImgui(float dt) {
 	// The ImGui window is rendered when activated on F10
 	ImGui::ShowDemoWindow();
+	Profiler::DrawImGui();
+	Application::getInstance()->getAPI()->getRenderStats().drawImGui();
 	return false;
 }
@@ -35,5 +35,7 @@ private:
 
 	std::unique_ptr<Model> m_cubeModel;
 	std::unique_ptr<Model> m_planeModel;
+	// Held until the sphere is loaded and its material has been given textures
+	ModelHandle m_sphereModel;
 
 };
\ No newline at end of file
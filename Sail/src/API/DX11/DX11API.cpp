@@ -1,6 +1,19 @@
 #include "pch.h"
 #include "DX11API.h"
 #include "API/Windows/Win32Window.h"
+#include "Sail/api/RenderStateCache.h"
+#include "Sail/graphics/shader/component/BindShader.h"
+
+// Resource behind a view, views of the same resource share it
+static uint64_t ResourceOf(ID3D11View* view) {
+	if (!view)
+		return 0;
+	ID3D11Resource* resource = nullptr;
+	view->GetResource(&resource);
+	// GetResource adds a reference, the view keeps the resource alive
+	resource->Release();
+	return (uint64_t)resource;
+}
 
 GraphicsAPI* GraphicsAPI::Create() {
 	return SAIL_NEW DX11API();
@@ -309,7 +322,7 @@ void DX11API::createDepthStencilBufferAndBind(UINT windowWidth, UINT windowHeigh
 	ThrowIfFailed(m_device->CreateDepthStencilView(m_depthStencilBuffer, &depthStencilViewDesc, &m_depthStencilView));
 
 	// Bind render target view
-	m_deviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+	setRenderTargets(1, &m_renderTargetView, m_depthStencilView);
 
 }
 
@@ -319,7 +332,7 @@ void DX11API::resizeBuffers(UINT width, UINT height) {
 
 	if (m_swapChain) {
 
-		m_deviceContext->OMSetRenderTargets(0, 0, m_depthStencilView);
+		setRenderTargets(0, 0, m_depthStencilView);
 
 		// Release all outstanding references to the swap chain's buffers
 		Memory::SafeRelease(m_renderTargetView);
@@ -333,7 +346,7 @@ void DX11API::resizeBuffers(UINT width, UINT height) {
 		ThrowIfFailed(m_device->CreateRenderTargetView(backBufferTex, nullptr, &m_renderTargetView));
 		Memory::SafeRelease(backBufferTex);
 
-		m_deviceContext->OMSetRenderTargets(1, &m_renderTargetView, nullptr);
+		setRenderTargets(1, &m_renderTargetView, nullptr);
 
 		// Viewport creation
 		m_viewport.Width = static_cast<FLOAT>(width);
@@ -353,6 +366,8 @@ void DX11API::resizeBuffers(UINT width, UINT height) {
 }
 
 void DX11API::setDepthMask(DepthMask setting) {
+	if (!getStateCache().setDepthMask(setting))
+		return;
 
 	switch (setting) {
 		case DepthMask::NO_MASK:		m_deviceContext->OMSetDepthStencilState(m_depthStencilStateEnabled, 1);
@@ -366,6 +381,8 @@ void DX11API::setDepthMask(DepthMask setting) {
 }
 
 void DX11API::setFaceCulling(Culling setting) {
+	if (!getStateCache().setFaceCulling(setting))
+		return;
 
 	switch (setting) {
 		case Culling::NO_CULLING: m_deviceContext->RSSetState(m_rasterStateNoCulling);
@@ -379,6 +396,8 @@ void DX11API::setFaceCulling(Culling setting) {
 }
 
 void DX11API::setBlending(Blending setting) {
+	if (!getStateCache().setBlending(setting))
+		return;
 
 	switch (setting) {
 		case Blending::NO_BLENDING:	m_deviceContext->OMSetBlendState(m_blendStateDisabled, NULL, 0xffffff);
@@ -440,11 +459,23 @@ ID3DUserDefinedAnnotation* DX11API::getPerfProfiler() {
 	return m_perf;
 }
 
-void DX11API::renderToBackBuffer() const {
-	m_deviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+void DX11API::renderToBackBuffer() {
+	setRenderTargets(1, &m_renderTargetView, m_depthStencilView);
 	m_deviceContext->RSSetViewports(1, &m_viewport);
 }
 
+void DX11API::setShaderResource(UINT slot, ID3D11ShaderResourceView* srv) {
+	if (getStateCache().setTexture(slot, ShaderComponent::PS, (uint64_t)srv, ResourceOf(srv)))
+		m_deviceContext->PSSetShaderResources(slot, 1, &srv);
+}
+
+void DX11API::setRenderTargets(UINT numViews, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depthStencilView) {
+	for (UINT i = 0; i < numViews; i++)
+		getStateCache().unbindResource(ResourceOf(views[i]));
+	getStateCache().unbindResource(ResourceOf(depthStencilView));
+	m_deviceContext->OMSetRenderTargets(numViews, views, depthStencilView);
+}
+
 bool DX11API::onResize(WindowResizeEvent& event) {
 	resizeBuffers(event.getWidth(), event.getHeight());
 	Logger::Log("dx11 resize ran");
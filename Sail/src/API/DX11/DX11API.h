@@ -32,7 +32,10 @@ public:
 	UINT getAASamples();
 	ID3D11RenderTargetView* const* getBackBufferRTV() const;
 	ID3DUserDefinedAnnotation* getPerfProfiler();
-	void renderToBackBuffer() const;
+	void renderToBackBuffer();
+	// Bind through the state cache, which has to know when a resource stops being readable
+	void setShaderResource(UINT slot, ID3D11ShaderResourceView* srv);
+	void setRenderTargets(UINT numViews, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depthStencilView);
 
 	virtual bool onResize(WindowResizeEvent& event) override;
 
@@ -10,7 +10,7 @@ IndexBuffer* IndexBuffer::Create(Mesh::Data& modelData) {
 DX11IndexBuffer::DX11IndexBuffer(Mesh::Data& modelData) 
 	: IndexBuffer(modelData)
 {
-	ULONG* indices = getIndexData(modelData);
+	unsigned char* indices = getIndexData(modelData);
 
 	// Set up index buffer description
 	D3D11_BUFFER_DESC ibd;
@@ -39,6 +39,6 @@ ID3D11Buffer* const* DX11IndexBuffer::getBuffer() const {
 }
 
 void DX11IndexBuffer::bind(void* cmdList) const {
-	// TODO: is 32 bits too much for indices? nah
-	Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->IASetIndexBuffer(m_buffer, DXGI_FORMAT_R32_UINT, 0);
+	DXGI_FORMAT format = (hasShortIndices()) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->IASetIndexBuffer(m_buffer, format, 0);
 }
@@ -5,6 +5,7 @@
 #include "Sail/Application.h"
 #include "Sail/graphics/shader/Shader.h"
 #include "DX11API.h"
+#include "Sail/api/RenderStats.h"
 
 Mesh* Mesh::Create(Data& buildData, Shader* shader) {
 	return SAIL_NEW DX11Mesh(buildData, shader);
@@ -20,12 +21,13 @@ DX11Mesh::DX11Mesh(Data& buildData, Shader* shader)
 	if (buildData.numIndices > 0) {
 		indexBuffer = std::unique_ptr<IndexBuffer>(IndexBuffer::Create(buildData));
 	}
+	releaseCPUData(GetDefaultCPUDataPolicy());
 }
 
 DX11Mesh::~DX11Mesh() {
 }
 
-void DX11Mesh::draw(const Renderer& renderer, void* cmdList) {
+void DX11Mesh::draw(const Renderer& renderer, void* cmdList, unsigned int numInstances) {
 	material->bind();
 
 	vertexBuffer->bind();
@@ -37,7 +39,8 @@ void DX11Mesh::draw(const Renderer& renderer, void* cmdList) {
 	devCon->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	// Draw call
 	if (indexBuffer)
-		devCon->DrawIndexed(getNumIndices(), 0U, 0U);
+		devCon->DrawIndexedInstanced(getNumIndices(), numInstances, 0U, 0, 0U);
 	else
-		devCon->Draw(getNumVertices(), 0);
+		devCon->DrawInstanced(getNumVertices(), numInstances, 0U, 0U);
+	Application::getInstance()->getAPI()->getRenderStats().addDraw(indexBuffer ? getNumIndices() : getNumVertices(), numInstances);
 }
@@ -8,7 +8,7 @@ public:
 	DX11Mesh(Data& buildData, Shader* shader);
 	~DX11Mesh();
 
-	virtual void draw(const Renderer& renderer, void* cmdList) override;
+	virtual void draw(const Renderer& renderer, void* cmdList, unsigned int numInstances) override;
 
 private:
 
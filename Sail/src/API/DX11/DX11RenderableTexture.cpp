@@ -162,7 +162,7 @@ void DX11RenderableTexture::begin() {
 
 	auto api = Application::getInstance()->getAPI<DX11API>();
 	// Set render target
-	api->getDeviceContext()->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+	api->setRenderTargets(1, &m_renderTargetView, m_depthStencilView);
 	// Bind viewport
 	api->getDeviceContext()->RSSetViewports(1, &m_viewport);
 
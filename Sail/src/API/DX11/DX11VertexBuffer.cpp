@@ -11,7 +11,7 @@ DX11VertexBuffer::DX11VertexBuffer(const InputLayout& inputLayout, Mesh::Data& m
 	: VertexBuffer(inputLayout, modelData)
 	, m_instanceBuffer(nullptr)
 {
-	void* vertices = getVertexData(modelData);
+	const void* vertices = getVertexData(modelData);
 
 	D3D11_BUFFER_DESC vbd;
 	ZeroMemory(&vbd, sizeof(vbd));
@@ -30,7 +30,7 @@ DX11VertexBuffer::DX11VertexBuffer(const InputLayout& inputLayout, Mesh::Data& m
 	ThrowIfFailed(Application::getInstance()->getAPI<DX11API>()->getDevice()->CreateBuffer(&vbd, &vertexData, &m_vertBuffer));
 	
 	// Delete vertices from cpu memory
-	free(vertices);
+	freeVertexData(vertices, modelData);
 	
 	// Set up instanceData buffer if instances are set
 	if (modelData.numInstances > 0) {
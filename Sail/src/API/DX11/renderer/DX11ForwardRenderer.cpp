@@ -3,6 +3,11 @@
 #include "Sail/api/shader/ShaderPipeline.h"
 #include "Sail/graphics/light/LightSetup.h"
 #include "Sail/graphics/shader/Shader.h"
+#include "Sail/api/RenderStateCache.h"
+#include "Sail/Application.h"
+#include "Sail/api/RenderStats.h"
+#include "Sail/utils/Profiler.h"
+#include "../DX11API.h"
 
 Renderer* Renderer::Create(Renderer::Type type) {
 	switch (type) {
@@ -19,28 +24,77 @@ DX11ForwardRenderer::DX11ForwardRenderer() {
 }
 
 DX11ForwardRenderer::~DX11ForwardRenderer() {
-
+	for (StructuredBuffer* target : { &m_lightData, &m_lightClusters, &m_lightIndices }) {
+		Memory::SafeRelease(target->srv);
+		Memory::SafeRelease(target->buffer);
+	}
 }
 
 void DX11ForwardRenderer::present(RenderableTexture* output) {
+	SAIL_PROFILE_FUNCTION();
+	// State might have been changed by others since the last frame
+	Application::getInstance()->getAPI()->getStateCache().invalidate();
+
+	// Camera and light data is the same for all draws, upload and bind it once
+	updateSharedCBuffers();
+	frameCBuffer->bind();
+	passCBuffer->bind();
+	uploadLightGrid();
 
 	for (RenderCommand& command : commandQueue) {
-		ShaderPipeline* shaderPipeline = command.mesh->getMaterial()->getShader()->getPipeline();
+		Material* material = command.mesh->getMaterial();
+		ShaderPipeline* shaderPipeline = material->getShader()->getPipeline();
 		shaderPipeline->bind();
+		shaderPipeline->setCBufferVar("sys_mWorld", &command.transform, sizeof(glm::mat4));
 
-		shaderPipeline->setCBufferVar("sys_mWorld", &glm::transpose(command.transform), sizeof(glm::mat4));
-		shaderPipeline->setCBufferVar("sys_mVP", &camera->getViewProjection(), sizeof(glm::mat4));
-		shaderPipeline->setCBufferVar("sys_cameraPos", &camera->getPosition(), sizeof(glm::vec3));
+		command.mesh->draw(*this);
+	}
+}
 
-		if (lightSetup) {
-			auto& dlData = lightSetup->getDirLightData();
-			auto& plData = lightSetup->getPointLightsData();
-			shaderPipeline->setCBufferVar("dirLight", &dlData, sizeof(dlData));
-			shaderPipeline->setCBufferVar("pointLights", &plData, sizeof(plData));
-		}
+void DX11ForwardRenderer::uploadLightGrid() {
+	const LightGrid& grid = getLightGrid();
+	// Matching the shader registers t11 to t13
+	upload(m_lightData, grid.getLightData().data(), sizeof(LightGrid::LightData), (unsigned int)grid.getLightData().size(), 11);
+	upload(m_lightClusters, grid.getClusters().data(), sizeof(LightGrid::Cluster), (unsigned int)grid.getClusters().size(), 12);
+	upload(m_lightIndices, grid.getLightIndices().data(), sizeof(unsigned int), (unsigned int)grid.getLightIndices().size(), 13);
+}
 
-		command.mesh->draw(*this);
+void DX11ForwardRenderer::upload(StructuredBuffer& target, const void* data, unsigned int stride, unsigned int count, unsigned int slot) {
+	auto* api = Application::getInstance()->getAPI<DX11API>();
+
+	if (count > target.capacity || !target.buffer) {
+		// Grow in steps to avoid recreating the buffer every time a few lights are added
+		Memory::SafeRelease(target.srv);
+		Memory::SafeRelease(target.buffer);
+		target.capacity = std::max(count + count / 2, 256U);
+
+		D3D11_BUFFER_DESC desc;
+		ZeroMemory(&desc, sizeof(desc));
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		desc.ByteWidth = target.capacity * stride;
+		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+		desc.StructureByteStride = stride;
+		ThrowIfFailed(api->getDevice()->CreateBuffer(&desc, nullptr, &target.buffer));
+
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+		ZeroMemory(&srvDesc, sizeof(srvDesc));
+		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+		srvDesc.Buffer.FirstElement = 0;
+		srvDesc.Buffer.NumElements = target.capacity;
+		ThrowIfFailed(api->getDevice()->CreateShaderResourceView(target.buffer, &srvDesc, &target.srv));
+	}
+
+	if (count > 0) {
+		D3D11_MAPPED_SUBRESOURCE mappedResource;
+		api->getDeviceContext()->Map(target.buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+		memcpy(mappedResource.pData, data, count * stride);
+		api->getDeviceContext()->Unmap(target.buffer, 0);
+		api->getRenderStats().add(RenderStats::BUFFER_UPLOAD_BYTES, count * stride);
 	}
+	api->setShaderResource(slot, target.srv);
 }
 
 
@@ -2,6 +2,7 @@
 
 #include "Sail/api/Renderer.h"
 #include <glm/glm.hpp>
+#include <d3d11.h>
 
 class DX11ForwardRenderer : public Renderer {
 public:
@@ -11,6 +12,19 @@ public:
 	void present(RenderableTexture* output = nullptr) override;
 
 private:
-	
+	// Dynamic structured buffer, recreated when the data does not fit
+	struct StructuredBuffer {
+		ID3D11Buffer* buffer = nullptr;
+		ID3D11ShaderResourceView* srv = nullptr;
+		unsigned int capacity = 0;
+	};
+	// Uploads the light grid and binds it to the pixel shader
+	void uploadLightGrid();
+	void upload(StructuredBuffer& target, const void* data, unsigned int stride, unsigned int count, unsigned int slot);
+
+private:
+	StructuredBuffer m_lightData;
+	StructuredBuffer m_lightClusters;
+	StructuredBuffer m_lightIndices;
 
 };
\ No newline at end of file
@@ -3,6 +3,23 @@
 #include "Sail/Application.h"
 #include "../DX11API.h"
 
+namespace {
+	DXGI_FORMAT getDXGIFormat(ResourceFormat::TextureFormat format) {
+		switch (format) {
+		case ResourceFormat::BC1:
+			return DXGI_FORMAT_BC1_UNORM;
+		case ResourceFormat::BC3:
+			return DXGI_FORMAT_BC3_UNORM;
+		case ResourceFormat::BC5:
+			return DXGI_FORMAT_BC5_UNORM;
+		case ResourceFormat::BC7:
+			return DXGI_FORMAT_BC7_UNORM;
+		default:
+			return DXGI_FORMAT_R8G8B8A8_UNORM;
+		}
+	}
+}
+
 Texture* Texture::Create(const std::string& filename) {
 	return SAIL_NEW DX11Texture(filename);
 }
@@ -14,24 +31,27 @@ DX11Texture::DX11Texture(const std::string& filename) {
 	D3D11_TEXTURE2D_DESC texDesc;
 	ZeroMemory(&texDesc, sizeof(texDesc));
 	texDesc.ArraySize = 1;
-	texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+	texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 	texDesc.CPUAccessFlags = 0;
-	texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	texDesc.Format = getDXGIFormat(data.getFormat());
 	texDesc.Width = data.getWidth();
 	texDesc.Height = data.getHeight();
-	texDesc.MipLevels = 6;
+	texDesc.MipLevels = data.getMipLevels();
 	texDesc.SampleDesc.Count = 1;
 	texDesc.SampleDesc.Quality = 0;
-	texDesc.Usage = D3D11_USAGE_DEFAULT;
-	texDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
+	texDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	texDesc.MiscFlags = 0;
 
 	auto api = Application::getInstance()->getAPI<DX11API>();
 
-	// Create an empty Texture2D
-	ThrowIfFailed(api->getDevice()->CreateTexture2D(&texDesc, nullptr, &m_texture));
-	// Fill the texture with data
-	UINT rowPitch = sizeof(unsigned char) * data.getWidth() * 4;
-	api->getDeviceContext()->UpdateSubresource(m_texture, 0, nullptr, data.getTextureData(), rowPitch, 0);
+	// The mip chain is built on the CPU when the texture is loaded, so the texture is created with every level filled in
+	std::vector<D3D11_SUBRESOURCE_DATA> initData(texDesc.MipLevels);
+	for (UINT level = 0; level < texDesc.MipLevels; level++) {
+		initData[level].pSysMem = data.getMipData(level);
+		initData[level].SysMemPitch = (UINT)data.getMipRowPitch(level);
+		initData[level].SysMemSlicePitch = 0;
+	}
+	ThrowIfFailed(api->getDevice()->CreateTexture2D(&texDesc, initData.data(), &m_texture));
 
 	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
 	ZeroMemory(&srvDesc, sizeof(srvDesc));
@@ -42,9 +62,6 @@ DX11Texture::DX11Texture(const std::string& filename) {
 	// Create the ShaderResourceView
 	ThrowIfFailed(api->getDevice()->CreateShaderResourceView(m_texture, &srvDesc, &m_resourceView));
 
-	// Generate mipmaps for this texture.
-	api->getDeviceContext()->GenerateMips(m_resourceView);
-
 }
 
 DX11Texture::DX11Texture(UINT width, UINT height, UINT aaSamples, UINT bindFlags, UINT cpuAccessFlags) {
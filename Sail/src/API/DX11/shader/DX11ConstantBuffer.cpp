@@ -2,6 +2,8 @@
 #include "DX11ConstantBuffer.h"
 #include "Sail/Application.h"
 #include "../DX11API.h"
+#include "Sail/api/RenderStateCache.h"
+#include "Sail/api/RenderStats.h"
 
 namespace ShaderComponent {
 
@@ -44,26 +46,34 @@ namespace ShaderComponent {
 		// Overwrite part of the locally stored data
 		memcpy((char*)m_data + offset, newData, bufferSize);
 
+		// A discarding map has to write the whole buffer, so callers gather their changes into a single update per frame
+		// The driver renames the buffer on discard, which keeps the data valid for later frames without uploading it again
 		D3D11_MAPPED_SUBRESOURCE mappedResource;
 		Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->Map(m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
 		std::memcpy(mappedResource.pData, m_data, m_bufferSize);
 		Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->Unmap(m_buffer, 0);
+		Application::getInstance()->getAPI()->getRenderStats().add(RenderStats::CBUFFER_UPLOAD_BYTES, m_bufferSize);
 
 	}
 
 	void DX11ConstantBuffer::bind(void* cmdList) const {
+		auto* api = Application::getInstance()->getAPI<DX11API>();
+		if (!api->getStateCache().setCBuffer(m_slot, m_bindShader, (uint64_t)m_buffer))
+			return;
+
+		auto* devCon = api->getDeviceContext();
 		if (m_bindShader & ShaderComponent::VS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->VSSetConstantBuffers(m_slot, 1, &m_buffer);
+			devCon->VSSetConstantBuffers(m_slot, 1, &m_buffer);
 		if (m_bindShader & ShaderComponent::HS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->HSSetConstantBuffers(m_slot, 1, &m_buffer);
+			devCon->HSSetConstantBuffers(m_slot, 1, &m_buffer);
 		if (m_bindShader & ShaderComponent::DS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->DSSetConstantBuffers(m_slot, 1, &m_buffer);
+			devCon->DSSetConstantBuffers(m_slot, 1, &m_buffer);
 		if (m_bindShader & ShaderComponent::PS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->PSSetConstantBuffers(m_slot, 1, &m_buffer);
+			devCon->PSSetConstantBuffers(m_slot, 1, &m_buffer);
 		if (m_bindShader & ShaderComponent::GS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->GSSetConstantBuffers(m_slot, 1, &m_buffer);
+			devCon->GSSetConstantBuffers(m_slot, 1, &m_buffer);
 		if (m_bindShader & ShaderComponent::CS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->CSSetConstantBuffers(m_slot, 1, &m_buffer);
+			devCon->CSSetConstantBuffers(m_slot, 1, &m_buffer);
 
 	}
 
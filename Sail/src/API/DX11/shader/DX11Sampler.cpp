@@ -2,6 +2,7 @@
 #include "DX11Sampler.h"
 #include "Sail/Application.h"
 #include "../DX11API.h"
+#include "Sail/api/RenderStateCache.h"
 
 namespace ShaderComponent {
 
@@ -94,18 +95,23 @@ namespace ShaderComponent {
 	}
 
 	void DX11Sampler::bind() {
+		auto* api = Application::getInstance()->getAPI<DX11API>();
+		if (!api->getStateCache().setSampler(m_slot, m_bindShader, (uint64_t)m_samplerState))
+			return;
+
+		auto* devCon = api->getDeviceContext();
 		if (m_bindShader & ShaderComponent::VS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->VSSetSamplers(m_slot, 1, &m_samplerState);
+			devCon->VSSetSamplers(m_slot, 1, &m_samplerState);
 		if (m_bindShader & ShaderComponent::HS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->HSSetSamplers(m_slot, 1, &m_samplerState);
+			devCon->HSSetSamplers(m_slot, 1, &m_samplerState);
 		if (m_bindShader & ShaderComponent::DS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->DSSetSamplers(m_slot, 1, &m_samplerState);
+			devCon->DSSetSamplers(m_slot, 1, &m_samplerState);
 		if (m_bindShader & ShaderComponent::PS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->PSSetSamplers(m_slot, 1, &m_samplerState);
+			devCon->PSSetSamplers(m_slot, 1, &m_samplerState);
 		if (m_bindShader & ShaderComponent::GS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->GSSetSamplers(m_slot, 1, &m_samplerState);
+			devCon->GSSetSamplers(m_slot, 1, &m_samplerState);
 		if (m_bindShader & ShaderComponent::CS)
-			Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->CSSetSamplers(m_slot, 1, &m_samplerState);
+			devCon->CSSetSamplers(m_slot, 1, &m_samplerState);
 	}
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "DX11ShaderPipeline.h"
 #include "Sail/Application.h"
 #include "../DX11API.h"
+#include "Sail/api/RenderStateCache.h"
 #include "API/DX11/resources/DX11Texture.h"
 
 ShaderPipeline* ShaderPipeline::Create(const std::string& filename) {
@@ -33,7 +34,11 @@ DX11ShaderPipeline::~DX11ShaderPipeline() {
 void DX11ShaderPipeline::bind(void* cmdList) {
 	ShaderPipeline::bind(cmdList);
 
-	auto* devCon = Application::getInstance()->getAPI<DX11API>()->getDeviceContext();
+	auto* api = Application::getInstance()->getAPI<DX11API>();
+	if (!api->getStateCache().setPipeline(this))
+		return;
+
+	auto* devCon = api->getDeviceContext();
 
 	// Bind or unbind shaders
 	// Shader types not used will be nullptr which will unbind any previously bound shaders of that type
@@ -43,9 +48,8 @@ void DX11ShaderPipeline::bind(void* cmdList) {
 	devCon->DSSetShader(m_ds, 0, 0);
 	devCon->HSSetShader(m_hs, 0, 0);
 
-
-	// Set this shader as bound
-	CurrentlyBoundShader = this;
+	// Set input layout as active
+	inputLayout->bind();
 }
 
 void* DX11ShaderPipeline::compileShader(const std::string& source, const std::string& filepath, ShaderComponent::BIND_SHADER shaderType) {
@@ -100,7 +104,7 @@ void* DX11ShaderPipeline::compileShader(const std::string& source, const std::st
 void DX11ShaderPipeline::setTexture2D(const std::string& name, Texture* texture, void* cmdList) {
 	UINT slot = findSlotFromName(name, parsedData.textures);
 	auto* srv = ((DX11Texture*)texture)->getSRV();
-	Application::getInstance()->getAPI<DX11API>()->getDeviceContext()->PSSetShaderResources(slot, 1, &srv);
+	Application::getInstance()->getAPI<DX11API>()->setShaderResource(slot, srv);
 }
 
 void DX11ShaderPipeline::compile() {
@@ -300,17 +300,32 @@ void DX12API::createGlobalRootSignature() {
 	D3D12_ROOT_DESCRIPTOR rootDescCBV3 = {};
 	rootDescCBV3.ShaderRegister = 2; // TODO make shader shared define
 	rootDescCBV3.RegisterSpace = 0;
+	D3D12_ROOT_DESCRIPTOR rootDescCBV4 = {};
+	rootDescCBV4.ShaderRegister = 3; // TODO make shader shared define
+	rootDescCBV4.RegisterSpace = 0;
 	D3D12_ROOT_DESCRIPTOR rootDescSRVT10 = {};
 	rootDescSRVT10.ShaderRegister = 10;
 	rootDescSRVT10.RegisterSpace = 0;
 	D3D12_ROOT_DESCRIPTOR rootDescSRVT11 = {};
 	rootDescSRVT11.ShaderRegister = 11;
 	rootDescSRVT11.RegisterSpace = 0;
+	D3D12_ROOT_DESCRIPTOR rootDescSRVT12 = {};
+	rootDescSRVT12.ShaderRegister = 12;
+	rootDescSRVT12.RegisterSpace = 0;
+	D3D12_ROOT_DESCRIPTOR rootDescSRVT13 = {};
+	rootDescSRVT13.ShaderRegister = 13;
+	rootDescSRVT13.RegisterSpace = 0;
 
 	// TODO: autogen from other data
 	m_globalRootSignatureRegisters["b0"] = GlobalRootParam::CBV_TRANSFORM;
-	m_globalRootSignatureRegisters["b1"] = GlobalRootParam::CBV_DIFFUSE_TINT;
+	m_globalRootSignatureRegisters["b1"] = GlobalRootParam::CBV_MATERIAL;
 	m_globalRootSignatureRegisters["b2"] = GlobalRootParam::CBV_CAMERA;
+	m_globalRootSignatureRegisters["b3"] = GlobalRootParam::CBV_LIGHTS;
+	m_globalRootSignatureRegisters["b4"] = GlobalRootParam::CONST_DRAW_ID;
+	m_globalRootSignatureRegisters["t10"] = GlobalRootParam::SRV_WORLD_MATRICES;
+	m_globalRootSignatureRegisters["t11"] = GlobalRootParam::SRV_LIGHT_DATA;
+	m_globalRootSignatureRegisters["t12"] = GlobalRootParam::SRV_LIGHT_CLUSTERS;
+	m_globalRootSignatureRegisters["t13"] = GlobalRootParam::SRV_LIGHT_INDICES;
 
 	// Create root parameters
 	D3D12_ROOT_PARAMETER rootParam[GlobalRootParam::SIZE];
@@ -319,18 +334,45 @@ void DX12API::createGlobalRootSignature() {
 	rootParam[GlobalRootParam::CBV_TRANSFORM].Descriptor = rootDescCBV;
 	rootParam[GlobalRootParam::CBV_TRANSFORM].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
 
-	rootParam[GlobalRootParam::CBV_DIFFUSE_TINT].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-	rootParam[GlobalRootParam::CBV_DIFFUSE_TINT].Descriptor = rootDescCBV2;
-	rootParam[GlobalRootParam::CBV_DIFFUSE_TINT].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+	rootParam[GlobalRootParam::CBV_MATERIAL].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	rootParam[GlobalRootParam::CBV_MATERIAL].Descriptor = rootDescCBV2;
+	rootParam[GlobalRootParam::CBV_MATERIAL].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
 
 	rootParam[GlobalRootParam::CBV_CAMERA].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
 	rootParam[GlobalRootParam::CBV_CAMERA].Descriptor = rootDescCBV3;
-	rootParam[GlobalRootParam::CBV_CAMERA].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+	rootParam[GlobalRootParam::CBV_CAMERA].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	rootParam[GlobalRootParam::CBV_LIGHTS].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	rootParam[GlobalRootParam::CBV_LIGHTS].Descriptor = rootDescCBV4;
+	rootParam[GlobalRootParam::CBV_LIGHTS].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
 
 	rootParam[GlobalRootParam::DT_SRVS].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	rootParam[GlobalRootParam::DT_SRVS].DescriptorTable = dtSrv;
 	rootParam[GlobalRootParam::DT_SRVS].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
+	// World matrices of all draws in the frame
+	rootParam[GlobalRootParam::SRV_WORLD_MATRICES].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParam[GlobalRootParam::SRV_WORLD_MATRICES].Descriptor = rootDescSRVT10;
+	rootParam[GlobalRootParam::SRV_WORLD_MATRICES].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+	// Index of the current draw into the world matrices
+	rootParam[GlobalRootParam::CONST_DRAW_ID].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	rootParam[GlobalRootParam::CONST_DRAW_ID].Constants.ShaderRegister = 4;
+	rootParam[GlobalRootParam::CONST_DRAW_ID].Constants.RegisterSpace = 0;
+	rootParam[GlobalRootParam::CONST_DRAW_ID].Constants.Num32BitValues = 1;
+	rootParam[GlobalRootParam::CONST_DRAW_ID].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+	// Clustered point light lists of the frame, read by the pixel shader light loop
+	rootParam[GlobalRootParam::SRV_LIGHT_DATA].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParam[GlobalRootParam::SRV_LIGHT_DATA].Descriptor = rootDescSRVT11;
+	rootParam[GlobalRootParam::SRV_LIGHT_DATA].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+	rootParam[GlobalRootParam::SRV_LIGHT_CLUSTERS].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParam[GlobalRootParam::SRV_LIGHT_CLUSTERS].Descriptor = rootDescSRVT12;
+	rootParam[GlobalRootParam::SRV_LIGHT_CLUSTERS].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+	rootParam[GlobalRootParam::SRV_LIGHT_INDICES].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParam[GlobalRootParam::SRV_LIGHT_INDICES].Descriptor = rootDescSRVT13;
+	rootParam[GlobalRootParam::SRV_LIGHT_INDICES].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
 	D3D12_STATIC_SAMPLER_DESC staticSamplerDesc[2];
 	staticSamplerDesc[0] = {};
 	staticSamplerDesc[0].Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
@@ -644,6 +686,11 @@ UINT DX12API::getNumSwapBuffers() const {
 	return NUM_SWAP_BUFFERS;
 }
 
+unsigned int DX12API::getNumFramesInFlight() const {
+	// Every swap buffer has its own allocators and upload buffers
+	return NUM_SWAP_BUFFERS;
+}
+
 DescriptorHeap* const DX12API::getMainGPUDescriptorHeap() const {
 	return m_cbvSrvUavDescriptorHeap.get();
 }
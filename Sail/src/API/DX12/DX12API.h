@@ -30,9 +30,15 @@ using wComPtr = Microsoft::WRL::ComPtr<T>;
 namespace GlobalRootParam {
 	enum Slot {
 		CBV_TRANSFORM = 0,
-		CBV_DIFFUSE_TINT,
+		CBV_MATERIAL,
 		CBV_CAMERA,
+		CBV_LIGHTS,
 		DT_SRVS,
+		SRV_WORLD_MATRICES,
+		CONST_DRAW_ID,
+		SRV_LIGHT_DATA,
+		SRV_LIGHT_CLUSTERS,
+		SRV_LIGHT_INDICES,
 		SIZE
 	};
 }
@@ -57,6 +63,7 @@ public:
 	virtual unsigned int getMemoryUsage() const override;
 	virtual unsigned int getMemoryBudget() const override;
 	virtual void toggleFullscreen() override;
+	virtual unsigned int getNumFramesInFlight() const override;
 	virtual bool onResize(WindowResizeEvent& event) override;
 
 	ID3D12Device5* getDevice() const;
@@ -13,7 +13,7 @@ DX12IndexBuffer::DX12IndexBuffer(Mesh::Data& modelData)
 	: IndexBuffer(modelData)
 {
 	DX12API* context = Application::getInstance()->getAPI<DX12API>();
-	unsigned long* indices = getIndexData(modelData);
+	unsigned char* indices = getIndexData(modelData);
 
 	m_indexBuffer.Attach(DX12Utils::CreateBuffer(context->getDevice(), getIndexDataSize(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ, DX12Utils::sUploadHeapProperties));
 	m_indexBuffer->SetName(L"Index buffer");
@@ -39,7 +39,7 @@ void DX12IndexBuffer::bind(void* cmdList) const {
 	D3D12_INDEX_BUFFER_VIEW ibView = {};
 	ibView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
 	ibView.SizeInBytes = static_cast<UINT>(getIndexDataSize());
-	ibView.Format = DXGI_FORMAT_R32_UINT;
+	ibView.Format = (hasShortIndices()) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
 	// Later update to just put in a buffer on the renderer to set multiple vertex buffers at once
 	dxCmdList->IASetIndexBuffer(&ibView);
 }
@@ -5,6 +5,7 @@
 #include "Sail/Application.h"
 #include "Sail/graphics/shader/Shader.h"
 #include "resources/DescriptorHeap.h"
+#include "Sail/api/RenderStats.h"
 
 Mesh* Mesh::Create(Data& buildData, Shader* shader) {
 	return SAIL_NEW DX12Mesh(buildData, shader);
@@ -21,12 +22,13 @@ DX12Mesh::DX12Mesh(Data& buildData, Shader* shader)
 	if (buildData.numIndices > 0) {
 		indexBuffer = std::unique_ptr<IndexBuffer>(IndexBuffer::Create(buildData));
 	}
+	releaseCPUData(GetDefaultCPUDataPolicy());
 }
 
 DX12Mesh::~DX12Mesh() {
 }
 
-void DX12Mesh::draw(const Renderer& renderer, void* cmdList) {
+void DX12Mesh::draw(const Renderer& renderer, void* cmdList, unsigned int numInstances) {
 	auto* dxCmdList = static_cast<ID3D12GraphicsCommandList4*>(cmdList);
 	// Set offset in SRV heap for this mesh 
 	dxCmdList->SetGraphicsRootDescriptorTable(m_context->getRootIndexFromRegister("t0"), m_context->getMainGPUDescriptorHeap()->getCurentGPUDescriptorHandle());
@@ -39,7 +41,8 @@ void DX12Mesh::draw(const Renderer& renderer, void* cmdList) {
 
 	// Draw call
 	if (indexBuffer)
-		dxCmdList->DrawIndexedInstanced(getNumIndices(), 1, 0, 0, 0);
+		dxCmdList->DrawIndexedInstanced(getNumIndices(), numInstances, 0, 0, 0);
 	else
-		dxCmdList->DrawInstanced(getNumVertices(), 1, 0, 0);
+		dxCmdList->DrawInstanced(getNumVertices(), numInstances, 0, 0);
+	Application::getInstance()->getAPI()->getRenderStats().addDraw(indexBuffer ? getNumIndices() : getNumVertices(), numInstances);
 }
@@ -13,20 +13,18 @@ DX12VertexBuffer::DX12VertexBuffer(const InputLayout& inputLayout, Mesh::Data& m
 	: VertexBuffer(inputLayout, modelData)
 {
 	DX12API* context = Application::getInstance()->getAPI<DX12API>();
-	void* vertices = getVertexData(modelData);
 
 	m_vertexBuffer.Attach(DX12Utils::CreateBuffer(context->getDevice(), getVertexDataSize(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ, DX12Utils::sUploadHeapProperties));
 	m_vertexBuffer->SetName(L"Vertex buffer");
 
-	// Place verticies in the buffer
+	// The upload heap is write combined, so the vertices are interleaved in system memory and written to it with one sequential copy
+	const void* vertices = getVertexData(modelData);
 	void* pData;
 	D3D12_RANGE readRange{ 0, 0 };
 	ThrowIfFailed(m_vertexBuffer->Map(0, &readRange, &pData));
 	memcpy(pData, vertices, getVertexDataSize());
 	m_vertexBuffer->Unmap(0, nullptr);
-
-	// Delete vertices from cpu memory
-	free(vertices);
+	freeVertexData(vertices, modelData);
 }
 
 DX12VertexBuffer::~DX12VertexBuffer() {
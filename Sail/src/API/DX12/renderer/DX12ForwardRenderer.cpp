@@ -4,9 +4,12 @@
 #include "Sail/graphics/light/LightSetup.h"
 #include "Sail/graphics/shader/Shader.h"
 #include "Sail/Application.h"
+#include "Sail/utils/Profiler.h"
 #include "../DX12Utils.h"
 #include "../shader/DX12ShaderPipeline.h"
 #include "../resources/DescriptorHeap.h"
+#include "Sail/api/RenderStateCache.h"
+#include "Sail/api/RenderStats.h"
 
 Renderer* Renderer::Create(Renderer::Type type) {
 	switch (type) {
@@ -22,6 +25,11 @@ DX12ForwardRenderer::DX12ForwardRenderer() {
 	m_context = Application::getInstance()->getAPI<DX12API>();
 	m_context->initCommand(m_command);
 	m_command.list->SetName(L"Forward Renderer main command list");
+
+	initUploadBuffer(m_worldMatrices, L"World matrices upload buffer");
+	initUploadBuffer(m_lightData, L"Light data upload buffer");
+	initUploadBuffer(m_lightClusters, L"Light clusters upload buffer");
+	initUploadBuffer(m_lightIndices, L"Light indices upload buffer");
 }
 
 DX12ForwardRenderer::~DX12ForwardRenderer() {
@@ -29,6 +37,7 @@ DX12ForwardRenderer::~DX12ForwardRenderer() {
 }
 
 void DX12ForwardRenderer::present(RenderableTexture* output) {
+	SAIL_PROFILE_FUNCTION();
 	assert(!output); // Render to texture is currently not implemented for DX12!
 
 	auto frameIndex = m_context->getFrameIndex();
@@ -39,6 +48,8 @@ void DX12ForwardRenderer::present(RenderableTexture* output) {
 	// Reset allocators and lists for this frame
 	allocator->Reset();
 	cmdList->Reset(allocator.Get(), nullptr);
+	// A reset command list has no state bound
+	m_context->getStateCache().invalidate();
 
 	// Transition back buffer to render target
 	m_context->prepareToRender(cmdList.Get());
@@ -48,37 +59,47 @@ void DX12ForwardRenderer::present(RenderableTexture* output) {
 	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// Bind the descriptor heap that will contain all SRVs for this frame
-	m_context->getMainGPUDescriptorHeap()->bind(cmdList.Get());
-
-	// Bind mesh-common constant buffers (camera)
-	// TODO: bind camera cbuffer here
-	//cmdList->SetGraphicsRootConstantBufferView(GlobalRootParam::CBV_CAMERA, asdf);
-
-	// TODO: Sort meshes according to material
+	DescriptorHeap* descriptorHeap = m_context->getMainGPUDescriptorHeap();
+	descriptorHeap->bind(cmdList.Get());
+	unsigned int firstDescriptor = descriptorHeap->getIndex();
+
+	// Bind mesh-common constant buffers (camera and lights)
+	updateSharedCBuffers();
+	frameCBuffer->bind(cmdList.Get());
+	passCBuffer->bind(cmdList.Get());
+	upload(m_worldMatrices, worldMatrices.data(), (unsigned int)(worldMatrices.size() * sizeof(glm::mat4)), "t10", cmdList.Get());
+	const LightGrid& grid = getLightGrid();
+	upload(m_lightData, grid.getLightData().data(), (unsigned int)(grid.getLightData().size() * sizeof(LightGrid::LightData)), "t11", cmdList.Get());
+	upload(m_lightClusters, grid.getClusters().data(), (unsigned int)(grid.getClusters().size() * sizeof(LightGrid::Cluster)), "t12", cmdList.Get());
+	upload(m_lightIndices, grid.getLightIndices().data(), (unsigned int)(grid.getLightIndices().size() * sizeof(unsigned int)), "t13", cmdList.Get());
+
+	// The command queue is sorted by material, each material gets its own slice of the material cbuffer
+	Material* lastMaterial = nullptr;
 	unsigned int meshIndex = 0;
+	unsigned int materialIndex = 0;
+	UINT drawIDRootIndex = m_context->getRootIndexFromRegister("b4");
 	for (RenderCommand& command : commandQueue) {
-		DX12ShaderPipeline* shaderPipeline = static_cast<DX12ShaderPipeline*>(command.mesh->getMaterial()->getShader()->getPipeline());
+		Material* material = command.mesh->getMaterial();
+		DX12ShaderPipeline* shaderPipeline = static_cast<DX12ShaderPipeline*>(material->getShader()->getPipeline());
 
 		// Set mesh index which is used to bind the correct cbuffers from the resource heap
 		// The index order does not matter, as long as the same index is used for bind and setCBuffer
 		shaderPipeline->setResourceHeapMeshIndex(meshIndex);
+		if (material != lastMaterial) {
+			shaderPipeline->setResourceHeapMaterialIndex(materialIndex++);
+			lastMaterial = material;
+		}
 
 		shaderPipeline->bind(cmdList.Get());
 
-		shaderPipeline->setCBufferVar("sys_mWorld", &glm::transpose(command.transform), sizeof(glm::mat4));
-		shaderPipeline->setCBufferVar("sys_mVP", &camera->getViewProjection(), sizeof(glm::mat4));
-		shaderPipeline->setCBufferVar("sys_cameraPos", &camera->getPosition(), sizeof(glm::vec3));
-
-		if (lightSetup) {
-			auto& dlData = lightSetup->getDirLightData();
-			auto& plData = lightSetup->getPointLightsData();
-			shaderPipeline->setCBufferVar("dirLight", &dlData, sizeof(dlData));
-			shaderPipeline->setCBufferVar("pointLights", &plData, sizeof(plData));
-		}
+		// The world matrix is read from the per frame buffer at the same index as the command
+		cmdList->SetGraphicsRoot32BitConstant(drawIDRootIndex, meshIndex, 0);
 
 		command.mesh->draw(*this, cmdList.Get());
 		meshIndex++;
 	}
+	unsigned int numDescriptors = descriptorHeap->getNumDescriptors();
+	m_context->getRenderStats().add(RenderStats::DESCRIPTORS_USED, (descriptorHeap->getIndex() + numDescriptors - firstDescriptor) % numDescriptors);
 
 	// Lastly - transition back buffer to present
 	m_context->prepareToPresent(cmdList.Get());
@@ -87,3 +108,34 @@ void DX12ForwardRenderer::present(RenderableTexture* output) {
 	m_context->executeCommandLists({ cmdList.Get() });
 
 }
+
+void DX12ForwardRenderer::initUploadBuffer(UploadBuffer& target, const wchar_t* name) {
+	auto numSwapBuffers = m_context->getNumSwapBuffers();
+	target.buffers.resize(numSwapBuffers);
+	target.data.resize(numSwapBuffers, nullptr);
+	target.capacity.resize(numSwapBuffers, 0);
+	target.name = name;
+}
+
+void DX12ForwardRenderer::upload(UploadBuffer& target, const void* data, unsigned int size, const std::string& reg, ID3D12GraphicsCommandList4* cmdList) {
+	auto frameIndex = m_context->getFrameIndex();
+
+	if (size > target.capacity[frameIndex] || !target.buffers[frameIndex]) {
+		// Grow in steps to avoid recreating the buffer every time a few elements are added
+		// The buffer of this frame index is not in use by the GPU at this point
+		unsigned int capacity = std::max(size + size / 2, 64U * 1024U);
+		auto& buffer = target.buffers[frameIndex];
+		buffer.Reset();
+		buffer.Attach(DX12Utils::CreateBuffer(m_context->getDevice(), capacity, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ, DX12Utils::sUploadHeapProperties));
+		buffer->SetName(target.name);
+		D3D12_RANGE readRange{ 0, 0 }; // Never read on the CPU
+		ThrowIfFailed(buffer->Map(0, &readRange, &target.data[frameIndex]));
+		target.capacity[frameIndex] = capacity;
+	}
+
+	if (size > 0) {
+		memcpy(target.data[frameIndex], data, size);
+		m_context->getRenderStats().add(RenderStats::BUFFER_UPLOAD_BYTES, size);
+	}
+	cmdList->SetGraphicsRootShaderResourceView(m_context->getRootIndexFromRegister(reg), target.buffers[frameIndex]->GetGPUVirtualAddress());
+}
\ No newline at end of file
@@ -11,8 +11,25 @@ public:
 
 	void present(RenderableTexture* output = nullptr) override;
 
+private:
+	// One upload buffer per swap buffer, kept mapped and grown when the data does not fit
+	struct UploadBuffer {
+		std::vector<wComPtr<ID3D12Resource1>> buffers;
+		std::vector<void*> data;
+		std::vector<unsigned int> capacity; // In bytes
+		const wchar_t* name;
+	};
+	void initUploadBuffer(UploadBuffer& target, const wchar_t* name);
+	// Copies the data to the upload buffer of the current frame and binds it as a root SRV
+	void upload(UploadBuffer& target, const void* data, unsigned int size, const std::string& reg, ID3D12GraphicsCommandList4* cmdList);
+
 private:
 	DX12API* m_context;
 	DX12API::Command m_command;
 
+	UploadBuffer m_worldMatrices;
+	UploadBuffer m_lightData;
+	UploadBuffer m_lightClusters;
+	UploadBuffer m_lightIndices;
+
 };
\ No newline at end of file
@@ -3,6 +3,23 @@
 #include "Sail/Application.h"
 #include "../DX12Utils.h"
 
+namespace {
+	DXGI_FORMAT getDXGIFormat(ResourceFormat::TextureFormat format) {
+		switch (format) {
+		case ResourceFormat::BC1:
+			return DXGI_FORMAT_BC1_UNORM;
+		case ResourceFormat::BC3:
+			return DXGI_FORMAT_BC3_UNORM;
+		case ResourceFormat::BC5:
+			return DXGI_FORMAT_BC5_UNORM;
+		case ResourceFormat::BC7:
+			return DXGI_FORMAT_BC7_UNORM;
+		default:
+			return DXGI_FORMAT_R8G8B8A8_UNORM;
+		}
+	}
+}
+
 Texture* Texture::Create(const std::string& filename) {
 	return new DX12Texture(filename);
 }
@@ -15,11 +32,11 @@ DX12Texture::DX12Texture(const std::string& filename)
 	m_context = Application::getInstance()->getAPI<DX12API>();
 
 	m_textureDesc = {};
-	m_textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // TODO: read this from texture data
+	m_textureDesc.Format = getDXGIFormat(m_textureData.getFormat());
 	m_textureDesc.Width = m_textureData.getWidth();
 	m_textureDesc.Height = m_textureData.getHeight();
 	m_textureDesc.DepthOrArraySize = 1;
-	m_textureDesc.MipLevels = 1;
+	m_textureDesc.MipLevels = m_textureData.getMipLevels();
 	m_textureDesc.SampleDesc.Count = 1;
 	m_textureDesc.SampleDesc.Quality = 0;
 	m_textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
@@ -38,7 +55,7 @@ DX12Texture::DX12Texture(const std::string& filename)
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.Format = m_textureDesc.Format;
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Texture2D.MipLevels = 1;
+	srvDesc.Texture2D.MipLevels = m_textureDesc.MipLevels;
 	m_context->getDevice()->CreateShaderResourceView(m_textureDefaultBuffer.Get(), &srvDesc, m_heapCDH);
 	
 }
@@ -52,7 +69,9 @@ void DX12Texture::initBuffers(ID3D12GraphicsCommandList4* cmdList) {
 	// this function gets the size an upload buffer needs to be to upload a texture to the gpu.
 	// each row must be 256 byte aligned except for the last row, which can just be the size in bytes of the row
 	// eg. textureUploadBufferSize = ((((width * numBytesPerPixel) + 255) & ~255) * (height - 1)) + (width * numBytesPerPixel);
-	m_context->getDevice()->GetCopyableFootprints(&m_textureDesc, 0, 1, 0, nullptr, nullptr, nullptr, &textureUploadBufferSize);
+	// All mip levels are uploaded together, each one placed at its own aligned offset in the upload buffer
+	UINT numLevels = m_textureDesc.MipLevels;
+	m_context->getDevice()->GetCopyableFootprints(&m_textureDesc, 0, numLevels, 0, nullptr, nullptr, nullptr, &textureUploadBufferSize);
 
 	// Create the upload heap
 	// TODO: release the upload heap when it has been copied to the default buffer
@@ -60,12 +79,14 @@ void DX12Texture::initBuffers(ID3D12GraphicsCommandList4* cmdList) {
 	m_textureUploadBuffer.Attach(DX12Utils::CreateBuffer(m_context->getDevice(), textureUploadBufferSize, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ, DX12Utils::sUploadHeapProperties));
 	m_textureUploadBuffer->SetName(L"Texture upload buffer");
 
-	D3D12_SUBRESOURCE_DATA textureData = {};
-	textureData.pData = m_textureData.getTextureData();
-	textureData.RowPitch = m_textureData.getWidth() * m_textureData.getBytesPerPixel();
-	textureData.SlicePitch = textureData.RowPitch * m_textureData.getHeight();
+	std::vector<D3D12_SUBRESOURCE_DATA> textureData(numLevels);
+	for (UINT level = 0; level < numLevels; level++) {
+		textureData[level].pData = m_textureData.getMipData(level);
+		textureData[level].RowPitch = m_textureData.getMipRowPitch(level);
+		textureData[level].SlicePitch = textureData[level].RowPitch * m_textureData.getMipNumRows(level);
+	}
 	// Copy the upload buffer contents to the default heap using a helper method from d3dx12.h
-	DX12Utils::UpdateSubresources(cmdList, m_textureDefaultBuffer.Get(), m_textureUploadBuffer.Get(), 0, 0, 1, &textureData);
+	DX12Utils::UpdateSubresources(cmdList, m_textureDefaultBuffer.Get(), m_textureUploadBuffer.Get(), 0, 0, numLevels, textureData.data());
 	DX12Utils::SetResourceTransitionBarrier(cmdList, m_textureDefaultBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
 	m_isInitialized = true;
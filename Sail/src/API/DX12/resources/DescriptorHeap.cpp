@@ -43,6 +43,14 @@ void DescriptorHeap::setIndex(unsigned int index) {
 	m_index = index;
 }
 
+unsigned int DescriptorHeap::getIndex() const {
+	return m_index;
+}
+
+unsigned int DescriptorHeap::getNumDescriptors() const {
+	return m_numDescriptors;
+}
+
 void DescriptorHeap::bind(ID3D12GraphicsCommandList4* cmdList) const {
 	ID3D12DescriptorHeap* descriptorHeaps[] = { m_descHeap.Get() };
 	cmdList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
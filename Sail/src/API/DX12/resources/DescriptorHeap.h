@@ -18,6 +18,8 @@ public:
 	D3D12_GPU_DESCRIPTOR_HANDLE	getCurentGPUDescriptorHandle() const;
 
 	void setIndex(unsigned int index);
+	unsigned int getIndex() const;
+	unsigned int getNumDescriptors() const;
 
 	void bind(ID3D12GraphicsCommandList4* cmdList) const;
 
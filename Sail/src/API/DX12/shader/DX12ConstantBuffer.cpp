@@ -2,6 +2,8 @@
 #include "DX12ConstantBuffer.h"
 #include "Sail/Application.h"
 #include "../DX12Utils.h"
+#include "Sail/api/RenderStateCache.h"
+#include "Sail/api/RenderStats.h"
 
 namespace ShaderComponent {
 
@@ -40,14 +42,20 @@ namespace ShaderComponent {
 		// This method needs to be run every frame to make sure the buffer for all framebuffers are kept updated
 		auto frameIndex = m_context->getFrameIndex();
 		memcpy(m_cbGPUAddress[frameIndex] + m_byteAlignedSize * m_resourceHeapMeshIndex + offset, newData, bufferSize);
+		m_context->getRenderStats().add(RenderStats::CBUFFER_UPLOAD_BYTES, bufferSize);
 	}
 
 	void DX12ConstantBuffer::bind(void* cmdList) const {
 		auto* dxCmdList = static_cast<ID3D12GraphicsCommandList4*>(cmdList);
 		auto frameIndex = m_context->getFrameIndex();
 		
+		auto gpuAddress = m_constantBufferUploadHeap[frameIndex]->GetGPUVirtualAddress() + m_byteAlignedSize * m_resourceHeapMeshIndex;
+		// Root parameters are shared by all pipelines, skip the bind if the same address is already set
+		if (!m_context->getStateCache().setCBuffer(m_register, ShaderComponent::VS | ShaderComponent::PS, gpuAddress))
+			return;
+
 		UINT rootIndex = m_context->getRootIndexFromRegister("b" + std::to_string(m_register));
-		dxCmdList->SetGraphicsRootConstantBufferView(rootIndex, m_constantBufferUploadHeap[frameIndex]->GetGPUVirtualAddress() + m_byteAlignedSize * m_resourceHeapMeshIndex);
+		dxCmdList->SetGraphicsRootConstantBufferView(rootIndex, gpuAddress);
 	}
 
 	void DX12ConstantBuffer::setResourceHeapMeshIndex(unsigned int index) {
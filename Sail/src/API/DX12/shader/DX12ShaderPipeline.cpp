@@ -5,6 +5,7 @@
 #include "../DX12API.h"
 #include "DX12ConstantBuffer.h"
 #include "../resources/DX12Texture.h"
+#include "Sail/api/RenderStateCache.h"
 
 std::unique_ptr<DXILShaderCompiler> DX12ShaderPipeline::m_dxilCompiler = nullptr;
 
@@ -32,7 +33,8 @@ void DX12ShaderPipeline::bind(void* cmdList) {
 		Logger::Error("Tried to bind DX12PipelineState before the DirectX PipelineStateObject has been created!");
 	auto* dxCmdList = static_cast<ID3D12GraphicsCommandList4*>(cmdList);
 	ShaderPipeline::bind(cmdList);
-	dxCmdList->SetPipelineState(m_pipelineState.Get());
+	if (m_context->getStateCache().setPipeline(this))
+		dxCmdList->SetPipelineState(m_pipelineState.Get());
 }
 
 void* DX12ShaderPipeline::compileShader(const std::string& source, const std::string& filepath, ShaderComponent::BIND_SHADER shaderType) {
@@ -88,13 +90,16 @@ void* DX12ShaderPipeline::compileShader(const std::string& source, const std::st
 	flags |= D3DCOMPILE_DEBUG;
 	flags |= D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
+	// Shaders can check for _SAIL_DX12 to use resources only available through the DX12 root signature
+	// Shader model 5.1 is needed for ConstantBuffer<T> root constants
+	const D3D_SHADER_MACRO defines[] = { { "_SAIL_DX12", "1" }, { nullptr, nullptr } };
 	HRESULT hr;
 	switch (shaderType) {
 	case ShaderComponent::VS:
-		hr = D3DCompile(source.c_str(), source.length(), filepath.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "VSMain", "vs_5_0", flags, 0, &pShaders, &errorBlob);
+		hr = D3DCompile(source.c_str(), source.length(), filepath.c_str(), defines, D3D_COMPILE_STANDARD_FILE_INCLUDE, "VSMain", "vs_5_1", flags, 0, &pShaders, &errorBlob);
 		break;
 	case ShaderComponent::PS:
-		hr = D3DCompile(source.c_str(), source.length(), filepath.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "PSMain", "ps_5_0", flags, 0, &pShaders, &errorBlob);
+		hr = D3DCompile(source.c_str(), source.length(), filepath.c_str(), defines, D3D_COMPILE_STANDARD_FILE_INCLUDE, "PSMain", "ps_5_1", flags, 0, &pShaders, &errorBlob);
 	}
 
 	if (FAILED(hr)) {
@@ -131,6 +136,18 @@ void DX12ShaderPipeline::setTexture2D(const std::string& name, Texture* texture,
 
 void DX12ShaderPipeline::setResourceHeapMeshIndex(unsigned int index) {
 	for (auto& it : parsedData.cBuffers) {
+		if (it.slot == ShaderComponent::PER_MATERIAL)
+			continue;
+		static_cast<ShaderComponent::DX12ConstantBuffer*>(it.cBuffer.get())->setResourceHeapMeshIndex(index);
+	}
+}
+
+void DX12ShaderPipeline::setResourceHeapMaterialIndex(unsigned int index) {
+	// The slot at the new index holds whatever was written there in an earlier frame
+	uploadedMaterial = 0;
+	for (auto& it : parsedData.cBuffers) {
+		if (it.slot != ShaderComponent::PER_MATERIAL)
+			continue;
 		static_cast<ShaderComponent::DX12ConstantBuffer*>(it.cBuffer.get())->setResourceHeapMeshIndex(index);
 	}
 }
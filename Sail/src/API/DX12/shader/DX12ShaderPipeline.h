@@ -13,7 +13,10 @@ public:
 	virtual void* compileShader(const std::string& source, const std::string& filepath, ShaderComponent::BIND_SHADER shaderType) override;
 	virtual void setTexture2D(const std::string& name, Texture* texture, void* cmdList) override;
 
+	// Sets which slice of the cbuffer resource heaps to use
+	// The mesh index applies to all cbuffers except the per material one, which uses the material index
 	void setResourceHeapMeshIndex(unsigned int index);
+	void setResourceHeapMaterialIndex(unsigned int index);
 
 protected:
 	virtual void compile() override;
@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "NullAPI.h"
+#include "Sail/api/RenderStateCache.h"
+
+GraphicsAPI* GraphicsAPI::Create() {
+	return SAIL_NEW NullAPI();
+}
+
+NullAPI::NullAPI()
+	: m_currentStream(0)
+	, m_numPresentedFrames(0)
+	, m_memoryUsage(0)
+{
+
+}
+
+NullAPI::~NullAPI() {
+
+}
+
+bool NullAPI::init(Window* window) {
+	return true;
+}
+
+void NullAPI::clear(const glm::vec4& color) {
+	getCommandStream().record(NullCommandStream::CLEAR);
+}
+
+void NullAPI::setDepthMask(DepthMask setting) {
+	if (getStateCache().setDepthMask(setting))
+		getCommandStream().record(NullCommandStream::SET_DEPTH_MASK, 0, setting);
+}
+
+void NullAPI::setFaceCulling(Culling setting) {
+	if (getStateCache().setFaceCulling(setting))
+		getCommandStream().record(NullCommandStream::SET_FACE_CULLING, 0, setting);
+}
+
+void NullAPI::setBlending(Blending setting) {
+	if (getStateCache().setBlending(setting))
+		getCommandStream().record(NullCommandStream::SET_BLENDING, 0, setting);
+}
+
+void NullAPI::present(bool vsync) {
+	getCommandStream().record(NullCommandStream::PRESENT, 0, vsync);
+	// Swap streams, keeping the finished frame around for inspection
+	m_currentStream = 1 - m_currentStream;
+	m_streams[m_currentStream].clear();
+	m_numPresentedFrames++;
+}
+
+unsigned int NullAPI::getMemoryUsage() const {
+	return (unsigned int)(m_memoryUsage / 1000000);
+}
+
+unsigned int NullAPI::getMemoryBudget() const {
+	// Pretend to have a 4 GB card
+	return 4000;
+}
+
+NullCommandStream& NullAPI::getCommandStream() {
+	return m_streams[m_currentStream];
+}
+
+const NullCommandStream& NullAPI::getLastFrame() const {
+	return m_streams[1 - m_currentStream];
+}
+
+unsigned int NullAPI::getNumPresentedFrames() const {
+	return m_numPresentedFrames;
+}
+
+void NullAPI::addMemoryUsage(long long bytes) {
+	m_memoryUsage += bytes;
+}
+
+bool NullAPI::onResize(WindowResizeEvent& event) {
+	return true;
+}
\ No newline at end of file
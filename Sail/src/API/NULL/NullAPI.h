@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Sail/api/GraphicsAPI.h"
+#include "NullCommandStream.h"
+
+// Graphics API without a device
+// All commands are recorded into a command stream, which is handed over to getLastFrame() on present
+class NullAPI : public GraphicsAPI {
+public:
+	NullAPI();
+	~NullAPI();
+
+	virtual bool init(Window* window) override;
+	virtual void clear(const glm::vec4& color) override;
+	virtual void setDepthMask(DepthMask setting) override;
+	virtual void setFaceCulling(Culling setting) override;
+	virtual void setBlending(Blending setting) override;
+	virtual void present(bool vsync = false) override;
+	virtual unsigned int getMemoryUsage() const override;
+	virtual unsigned int getMemoryBudget() const override;
+
+	// Commands recorded since the last present
+	NullCommandStream& getCommandStream();
+	// Commands recorded during the last presented frame
+	const NullCommandStream& getLastFrame() const;
+	unsigned int getNumPresentedFrames() const;
+
+	// Used by resources to keep track of how much memory a device would have used
+	void addMemoryUsage(long long bytes);
+
+	virtual bool onResize(WindowResizeEvent& event) override;
+
+private:
+	NullCommandStream m_streams[2];
+	unsigned int m_currentStream;
+	unsigned int m_numPresentedFrames;
+	long long m_memoryUsage;
+
+};
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "pch.h"
+#include "NullCommandStream.h"
+
+NullCommandStream::NullCommandStream()
+	: m_keepCommands(true)
+{
+
+}
+
+NullCommandStream::~NullCommandStream() {
+
+}
+
+void NullCommandStream::record(Op op, uint64_t handle, unsigned int arg, unsigned int slot, unsigned int bindShader) {
+	m_counters.ops[op]++;
+	if (op == UPDATE_CBUFFER)
+		m_counters.cbufferBytesUploaded += arg;
+	if (m_keepCommands)
+		m_commands.push_back({ op, (unsigned char)slot, (unsigned short)bindShader, arg, handle });
+}
+
+void NullCommandStream::recordDraw(uint64_t handle, unsigned int count, unsigned int numInstances, bool indexed) {
+	if (indexed)
+		m_counters.indicesDrawn += (unsigned long long)count * numInstances;
+	else
+		m_counters.verticesDrawn += (unsigned long long)count * numInstances;
+	m_counters.instancesDrawn += numInstances;
+	record((indexed) ? DRAW_INDEXED : DRAW, handle, count, 0, 0);
+}
+
+void NullCommandStream::clear() {
+	m_commands.clear();
+	m_counters = Counters();
+}
+
+void NullCommandStream::setKeepCommands(bool keepCommands) {
+	m_keepCommands = keepCommands;
+}
+
+const std::vector<NullCommandStream::Command>& NullCommandStream::getCommands() const {
+	return m_commands;
+}
+
+const NullCommandStream::Counters& NullCommandStream::getCounters() const {
+	return m_counters;
+}
+
+unsigned int NullCommandStream::Counters::numDrawCalls() const {
+	return ops[DRAW] + ops[DRAW_INDEXED];
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Compact stream of the commands the null backend would have sent to a device
+// Used to measure and verify the CPU side of the renderer without a GPU
+class NullCommandStream {
+public:
+	enum Op : unsigned char {
+		CLEAR,
+		PRESENT,
+		SET_DEPTH_MASK,
+		SET_FACE_CULLING,
+		SET_BLENDING,
+		BIND_PIPELINE,
+		BIND_CBUFFER,
+		UPDATE_CBUFFER,
+		BIND_SAMPLER,
+		BIND_TEXTURE,
+		BIND_VERTEX_BUFFER,
+		BIND_INDEX_BUFFER,
+		DRAW,
+		DRAW_INDEXED,
+		NUM_OPS
+	};
+
+	// 16 bytes per command
+	struct Command {
+		Op op;
+		unsigned char slot;
+		unsigned short bindShader;
+		unsigned int arg; // Vertex/index count, byte size or state value depending on op
+		uint64_t handle;  // Address of the object the command uses
+	};
+
+	struct Counters {
+		unsigned int ops[NUM_OPS] = { 0 };
+		unsigned long long cbufferBytesUploaded = 0;
+		unsigned long long verticesDrawn = 0;
+		unsigned long long indicesDrawn = 0;
+		unsigned long long instancesDrawn = 0;
+
+		unsigned int numDrawCalls() const;
+	};
+
+public:
+	NullCommandStream();
+	~NullCommandStream();
+
+	void record(Op op, uint64_t handle = 0, unsigned int arg = 0, unsigned int slot = 0, unsigned int bindShader = 0);
+	void recordDraw(uint64_t handle, unsigned int count, unsigned int numInstances, bool indexed);
+	void clear();
+
+	// When disabled only the counters are updated, which makes recording as cheap as possible for benchmarks
+	void setKeepCommands(bool keepCommands);
+
+	const std::vector<Command>& getCommands() const;
+	const Counters& getCounters() const;
+
+private:
+	std::vector<Command> m_commands;
+	Counters m_counters;
+	bool m_keepCommands;
+
+};
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "pch.h"
+#include "NullIndexBuffer.h"
+#include "NullAPI.h"
+#include "Sail/Application.h"
+
+IndexBuffer* IndexBuffer::Create(Mesh::Data& modelData) {
+	return SAIL_NEW NullIndexBuffer(modelData);
+}
+
+NullIndexBuffer::NullIndexBuffer(Mesh::Data& modelData)
+	: IndexBuffer(modelData)
+{
+	unsigned char* indices = getIndexData(modelData);
+	Memory::SafeDeleteArr(indices);
+
+	m_byteSize = getIndexDataSize();
+	Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(m_byteSize);
+}
+
+NullIndexBuffer::~NullIndexBuffer() {
+	Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(-(long long)m_byteSize);
+}
+
+void NullIndexBuffer::bind(void* cmdList) const {
+	Application::getInstance()->getAPI<NullAPI>()->getCommandStream().record(NullCommandStream::BIND_INDEX_BUFFER, (uint64_t)this);
+}
\ No newline at end of file
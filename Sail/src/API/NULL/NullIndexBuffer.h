@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Sail/api/IndexBuffer.h"
+
+class NullIndexBuffer : public IndexBuffer {
+public:
+	NullIndexBuffer(Mesh::Data& modelData);
+	~NullIndexBuffer();
+
+	virtual void bind(void* cmdList) const override;
+
+private:
+	unsigned int m_byteSize;
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "pch.h"
+#include "NullInput.h"
+
+Input* Input::m_PlatformInstance = SAIL_NEW NullInput();
+Input* Input::m_Instance = Input::m_PlatformInstance;
+
+NullInput::NullInput()
+	: m_cursorHidden(false)
+	, m_mousePos(0, 0)
+	, m_lastMousePos(0, 0)
+	, m_mouseDelta(0, 0)
+	, m_mouseButtons{ false }
+	, m_keys{ false }
+	, m_lastMouseButtons{ false }
+	, m_lastKeys{ false }
+	, m_frameMouseButtons{ false }
+	, m_frameKeys{ false }
+{
+}
+
+NullInput::~NullInput() {}
+
+void NullInput::setKeyState(int keycode, bool pressed) {
+	m_keys[keycode] = pressed;
+}
+
+void NullInput::setMouseButtonState(int button, bool pressed) {
+	m_mouseButtons[button] = pressed;
+}
+
+void NullInput::setMousePosition(const glm::ivec2& position) {
+	m_mousePos = position;
+}
+
+bool NullInput::isKeyPressedImpl(int keycode) {
+	return m_keys[keycode];
+}
+
+bool NullInput::wasKeyJustPressedImpl(int keycode) {
+	return m_frameKeys[keycode];
+}
+
+bool NullInput::isMouseButtonPressedImpl(int button) {
+	return m_mouseButtons[button];
+}
+
+bool NullInput::wasMouseButtonJustPressedImpl(int button) {
+	return m_frameMouseButtons[button];
+}
+
+glm::ivec2 NullInput::getMousePositionImpl() {
+	return m_mousePos;
+}
+
+glm::ivec2 NullInput::getMouseDeltaImpl() {
+	return m_mouseDelta;
+}
+
+void NullInput::hideCursorImpl(bool hide) {
+	m_cursorHidden = hide;
+}
+
+bool NullInput::isCursorHiddenImpl() {
+	return m_cursorHidden;
+}
+
+void NullInput::beginFrame() {
+	m_mouseDelta = m_mousePos - m_lastMousePos;
+	m_lastMousePos = m_mousePos;
+	for (int button = 0; button < SAIL_NUM_MOUSE_BUTTONS; button++) {
+		m_frameMouseButtons[button] = m_mouseButtons[button] && !m_lastMouseButtons[button];
+		m_lastMouseButtons[button] = m_mouseButtons[button];
+	}
+	for (int key = 0; key < SAIL_NUM_KEYS; key++) {
+		m_frameKeys[key] = m_keys[key] && !m_lastKeys[key];
+		m_lastKeys[key] = m_keys[key];
+	}
+}
+
+void NullInput::endFrame() {
+	std::fill(m_frameMouseButtons, m_frameMouseButtons + SAIL_NUM_MOUSE_BUTTONS, false);
+	std::fill(m_frameKeys, m_frameKeys + SAIL_NUM_KEYS, false);
+}
\ No newline at end of file
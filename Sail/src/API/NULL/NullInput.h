@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Sail/api/Input.h"
+#include "../../Sail/MouseButtonCodes.h"
+#include "../../Sail/KeyCodes.h"
+
+// Input without any devices, state can be set from code to script input
+class NullInput : public Input {
+public:
+	NullInput();
+	~NullInput();
+
+	// State set from code is seen from the next frame on, like input that arrives between frames
+	void setKeyState(int keycode, bool pressed);
+	void setMouseButtonState(int button, bool pressed);
+	void setMousePosition(const glm::ivec2& position);
+
+private:
+	bool m_cursorHidden;
+	glm::ivec2 m_mousePos;
+	glm::ivec2 m_lastMousePos;
+	glm::ivec2 m_mouseDelta;
+	bool m_mouseButtons[SAIL_NUM_MOUSE_BUTTONS];
+	bool m_keys[SAIL_NUM_KEYS];
+	// State at the start of the previous frame, presses are found by comparing against it
+	bool m_lastMouseButtons[SAIL_NUM_MOUSE_BUTTONS];
+	bool m_lastKeys[SAIL_NUM_KEYS];
+	// frame_ contains keys and buttons pressed this frame
+	bool m_frameMouseButtons[SAIL_NUM_MOUSE_BUTTONS];
+	bool m_frameKeys[SAIL_NUM_KEYS];
+
+protected:
+	virtual bool isKeyPressedImpl(int keycode) override;
+	virtual bool wasKeyJustPressedImpl(int keycode) override;
+
+	virtual bool isMouseButtonPressedImpl(int button) override;
+	virtual bool wasMouseButtonJustPressedImpl(int button) override;
+
+	virtual glm::ivec2 getMousePositionImpl() override;
+	virtual glm::ivec2 getMouseDeltaImpl() override;
+
+	virtual void hideCursorImpl(bool hide) override;
+	virtual bool isCursorHiddenImpl() override;
+
+	virtual void beginFrame() override;
+	virtual void endFrame() override;
+
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "pch.h"
+#include "NullMesh.h"
+#include "NullAPI.h"
+#include "Sail/api/VertexBuffer.h"
+#include "Sail/api/IndexBuffer.h"
+#include "Sail/Application.h"
+#include "Sail/graphics/shader/Shader.h"
+#include "Sail/api/RenderStats.h"
+
+Mesh* Mesh::Create(Data& buildData, Shader* shader) {
+	return SAIL_NEW NullMesh(buildData, shader);
+}
+
+NullMesh::NullMesh(Data& buildData, Shader* shader)
+	: Mesh(buildData, shader)
+{
+	material = std::make_shared<Material>(shader);
+	// Create vertex buffer
+	vertexBuffer = std::unique_ptr<VertexBuffer>(VertexBuffer::Create(shader->getPipeline()->getInputLayout(), buildData));
+	// Create index buffer if indices are set
+	if (buildData.numIndices > 0) {
+		indexBuffer = std::unique_ptr<IndexBuffer>(IndexBuffer::Create(buildData));
+	}
+	releaseCPUData(GetDefaultCPUDataPolicy());
+}
+
+NullMesh::~NullMesh() {
+}
+
+void NullMesh::draw(const Renderer& renderer, void* cmdList, unsigned int numInstances) {
+	material->bind(cmdList);
+
+	vertexBuffer->bind(cmdList);
+	if (indexBuffer)
+		indexBuffer->bind(cmdList);
+
+	auto& stream = Application::getInstance()->getAPI<NullAPI>()->getCommandStream();
+	if (indexBuffer)
+		stream.recordDraw((uint64_t)this, getNumIndices(), numInstances, true);
+	else
+		stream.recordDraw((uint64_t)this, getNumVertices(), numInstances, false);
+	Application::getInstance()->getAPI()->getRenderStats().addDraw(indexBuffer ? getNumIndices() : getNumVertices(), numInstances);
+}
\ No newline at end of file
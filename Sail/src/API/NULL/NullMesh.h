@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Sail/api/Mesh.h"
+
+class NullMesh : public Mesh {
+public:
+	NullMesh(Data& buildData, Shader* shader);
+	~NullMesh();
+
+	virtual void draw(const Renderer& renderer, void* cmdList, unsigned int numInstances) override;
+
+};
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "pch.h"
+#include "NullVertexBuffer.h"
+#include "NullAPI.h"
+#include "Sail/Application.h"
+
+VertexBuffer* VertexBuffer::Create(const InputLayout& inputLayout, Mesh::Data& modelData) {
+	return SAIL_NEW NullVertexBuffer(inputLayout, modelData);
+}
+
+NullVertexBuffer::NullVertexBuffer(const InputLayout& inputLayout, Mesh::Data& modelData)
+	: VertexBuffer(inputLayout, modelData)
+{
+	// Interleave the vertex data like the other APIs do to keep the CPU cost comparable
+	const void* vertices = getVertexData(modelData);
+	freeVertexData(vertices, modelData);
+
+	m_byteSize = getVertexDataSize() + inputLayout.getInstanceSize() * modelData.numInstances;
+	Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(m_byteSize);
+}
+
+NullVertexBuffer::~NullVertexBuffer() {
+	Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(-(long long)m_byteSize);
+}
+
+void NullVertexBuffer::bind(void* cmdList) const {
+	Application::getInstance()->getAPI<NullAPI>()->getCommandStream().record(NullCommandStream::BIND_VERTEX_BUFFER, (uint64_t)this, getVertexDataStride());
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Sail/api/VertexBuffer.h"
+
+class NullVertexBuffer : public VertexBuffer {
+public:
+	NullVertexBuffer(const InputLayout& inputLayout, Mesh::Data& modelData);
+	~NullVertexBuffer();
+
+	virtual void bind(void* cmdList) const override;
+
+private:
+	unsigned int m_byteSize;
+};
\ No newline at end of file
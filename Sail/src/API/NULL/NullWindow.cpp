@@ -0,0 +1,55 @@
+#include "pch.h"
+#include "NullWindow.h"
+
+Window* Window::Create(const WindowProps& props) {
+	return SAIL_NEW NullWindow(props);
+}
+
+NullWindow::NullWindow(const WindowProps& props)
+	: Window(props)
+	, m_resized(false)
+	, m_closed(false)
+{
+
+}
+
+NullWindow::~NullWindow() {
+
+}
+
+bool NullWindow::initialize() {
+	isWindowFocused = true;
+	return true;
+}
+
+bool NullWindow::hasBeenResized() {
+	bool ret = m_resized;
+	m_resized = false;
+	return ret;
+}
+
+void NullWindow::setWindowTitle(const std::string& title) {
+	m_windowTitle = title;
+}
+
+bool NullWindow::processMessages() {
+	// There is no platform to receive messages from, the window only closes when asked to
+	// A close request ends one game loop, which lets tests and benchmarks start another one afterwards
+	if (m_closed) {
+		m_closed = false;
+		return false;
+	}
+	return true;
+}
+
+void NullWindow::requestClose(int exitCode) {
+	this->exitCode = exitCode;
+	m_closed = true;
+}
+
+void NullWindow::resize(unsigned int width, unsigned int height) {
+	windowWidth = width;
+	windowHeight = height;
+	isWindowMinimized = (width == 0 || height == 0);
+	m_resized = true;
+}
\ No newline at end of file
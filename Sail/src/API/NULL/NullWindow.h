@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Sail/api/Window.h"
+#include <string>
+
+// Window that only exists in memory, resizes can be simulated through resize()
+class NullWindow : public Window {
+
+public:
+	NullWindow(const WindowProps& props);
+	~NullWindow();
+
+	virtual bool initialize() override;
+	virtual bool hasBeenResized() override;
+	virtual void setWindowTitle(const std::string& title) override;
+	virtual bool processMessages() override;
+	virtual void requestClose(int exitCode) override;
+
+	void resize(unsigned int width, unsigned int height);
+
+private:
+	std::string m_windowTitle;
+	bool m_resized;
+	bool m_closed;
+
+};
\ No newline at end of file
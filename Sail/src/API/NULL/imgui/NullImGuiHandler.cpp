@@ -0,0 +1,41 @@
+#include "pch.h"
+#include "NullImGuiHandler.h"
+#include "Sail/Application.h"
+
+#include "imgui.h"
+
+ImGuiHandler* ImGuiHandler::Create() {
+	return new NullImGuiHandler();
+}
+
+NullImGuiHandler::NullImGuiHandler() {
+}
+
+NullImGuiHandler::~NullImGuiHandler() {
+	ImGui::DestroyContext();
+}
+
+void NullImGuiHandler::init() {
+	// A context is still needed since the application builds its ImGui windows every frame
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	// Build the font atlas, it would otherwise be uploaded by the renderer binding
+	unsigned char* pixels;
+	int width, height;
+	io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+	ImGui::StyleColorsDark();
+}
+
+void NullImGuiHandler::begin() {
+	ImGuiIO& io = ImGui::GetIO();
+	auto* window = Application::getInstance()->getWindow();
+	io.DisplaySize = ImVec2((float)window->getWindowWidth(), (float)window->getWindowHeight());
+	io.DeltaTime = 1.f / 60.f;
+	ImGui::NewFrame();
+}
+
+void NullImGuiHandler::end() {
+	// Generate the draw lists but don't draw them anywhere
+	ImGui::Render();
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include "Sail/api/ImGuiHandler.h"
+
+class NullImGuiHandler : public ImGuiHandler {
+public:
+	NullImGuiHandler();
+	~NullImGuiHandler();
+	virtual void init() override;
+	virtual void begin() override;
+	virtual void end() override;
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "NullForwardRenderer.h"
+#include "Sail/api/shader/ShaderPipeline.h"
+#include "Sail/graphics/light/LightSetup.h"
+#include "Sail/graphics/shader/Shader.h"
+#include "Sail/api/RenderStateCache.h"
+#include "Sail/Application.h"
+#include "Sail/api/RenderStats.h"
+#include "Sail/utils/Profiler.h"
+
+Renderer* Renderer::Create(Renderer::Type type) {
+	switch (type) {
+	case FORWARD:
+		return new NullForwardRenderer();
+	default:
+		Logger::Error("Tried to create a renderer of unknown or unimplemented type: " + type);
+	}
+	return nullptr;
+}
+
+NullForwardRenderer::NullForwardRenderer() {
+
+}
+
+NullForwardRenderer::~NullForwardRenderer() {
+
+}
+
+void NullForwardRenderer::present(RenderableTexture* output) {
+	SAIL_PROFILE_FUNCTION();
+	// Same command building as DX11ForwardRenderer, to make the recorded CPU cost comparable
+	Application::getInstance()->getAPI()->getStateCache().invalidate();
+
+	updateSharedCBuffers();
+	frameCBuffer->bind();
+	passCBuffer->bind();
+	// Nothing to upload to, the grid is built and its size counted like the other backends do
+	const LightGrid& grid = getLightGrid();
+	unsigned int gridSize = (unsigned int)(grid.getLightData().size() * sizeof(LightGrid::LightData)
+		+ grid.getClusters().size() * sizeof(LightGrid::Cluster) + grid.getLightIndices().size() * sizeof(unsigned int));
+	Application::getInstance()->getAPI()->getRenderStats().add(RenderStats::BUFFER_UPLOAD_BYTES, gridSize);
+
+	for (RenderCommand& command : commandQueue) {
+		Material* material = command.mesh->getMaterial();
+		ShaderPipeline* shaderPipeline = material->getShader()->getPipeline();
+		shaderPipeline->bind();
+		shaderPipeline->setCBufferVar("sys_mWorld", &command.transform, sizeof(glm::mat4));
+
+		command.mesh->draw(*this);
+	}
+}
\ No newline at end of file
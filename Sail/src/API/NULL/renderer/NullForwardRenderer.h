@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Sail/api/Renderer.h"
+#include <glm/glm.hpp>
+
+class NullForwardRenderer : public Renderer {
+public:
+	NullForwardRenderer();
+	~NullForwardRenderer();
+
+	void present(RenderableTexture* output = nullptr) override;
+
+};
\ No newline at end of file
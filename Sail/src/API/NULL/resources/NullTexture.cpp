@@ -0,0 +1,29 @@
+#include "pch.h"
+#include "NullTexture.h"
+#include "Sail/Application.h"
+#include "../NullAPI.h"
+
+Texture* Texture::Create(const std::string& filename) {
+	return SAIL_NEW NullTexture(filename);
+}
+
+NullTexture::NullTexture(const std::string& filename) {
+	// The texture is still loaded from disk to keep the CPU cost of loading realistic
+	TextureData& data = getTextureData(filename);
+	m_width = data.getWidth();
+	m_height = data.getHeight();
+	m_byteSize = (unsigned int)data.getByteSize();
+	Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(m_byteSize);
+}
+
+NullTexture::~NullTexture() {
+	Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(-(long long)m_byteSize);
+}
+
+unsigned int NullTexture::getWidth() const {
+	return m_width;
+}
+
+unsigned int NullTexture::getHeight() const {
+	return m_height;
+}
\ No newline at end of file
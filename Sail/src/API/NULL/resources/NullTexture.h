@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Sail/resources/TextureData.h"
+#include "Sail/api/Texture.h"
+
+class NullTexture : public Texture {
+
+public:
+	NullTexture(const std::string& filename);
+	~NullTexture();
+
+	unsigned int getWidth() const;
+	unsigned int getHeight() const;
+
+private:
+	unsigned int m_width;
+	unsigned int m_height;
+	unsigned int m_byteSize;
+
+};
\ No newline at end of file
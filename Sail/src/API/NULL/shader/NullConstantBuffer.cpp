@@ -0,0 +1,46 @@
+#include "pch.h"
+#include "NullConstantBuffer.h"
+#include "Sail/Application.h"
+#include "../NullAPI.h"
+#include "Sail/api/RenderStateCache.h"
+#include "Sail/api/RenderStats.h"
+
+namespace ShaderComponent {
+
+	ConstantBuffer* ConstantBuffer::Create(void* initData, unsigned int size, BIND_SHADER bindShader, unsigned int slot) {
+		return SAIL_NEW NullConstantBuffer(initData, size, bindShader, slot);
+	}
+
+	NullConstantBuffer::NullConstantBuffer(void* initData, unsigned int size, BIND_SHADER bindShader, unsigned int slot)
+		: m_bindShader(bindShader)
+		, m_slot(slot)
+		, m_bufferSize(size)
+	{
+		// The data is kept so that tests can check what would have been uploaded
+		m_data = malloc(size);
+		memcpy(m_data, initData, size);
+		Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(size);
+	}
+	NullConstantBuffer::~NullConstantBuffer() {
+		Application::getInstance()->getAPI<NullAPI>()->addMemoryUsage(-(long long)m_bufferSize);
+		free(m_data);
+	}
+
+	void NullConstantBuffer::updateData(const void* newData, unsigned int bufferSize, unsigned int offset) {
+		memcpy((char*)m_data + offset, newData, bufferSize);
+		auto* api = Application::getInstance()->getAPI<NullAPI>();
+		api->getRenderStats().add(RenderStats::CBUFFER_UPLOAD_BYTES, bufferSize);
+		api->getCommandStream().record(NullCommandStream::UPDATE_CBUFFER, (uint64_t)this, bufferSize, m_slot, m_bindShader);
+	}
+
+	void NullConstantBuffer::bind(void* cmdList) const {
+		auto* api = Application::getInstance()->getAPI<NullAPI>();
+		if (api->getStateCache().setCBuffer(m_slot, m_bindShader, (uint64_t)this))
+			api->getCommandStream().record(NullCommandStream::BIND_CBUFFER, (uint64_t)this, 0, m_slot, m_bindShader);
+	}
+
+	const void* NullConstantBuffer::getData() const {
+		return m_data;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Sail/api/shader/ConstantBuffer.h"
+
+namespace ShaderComponent {
+
+	class NullConstantBuffer : public ConstantBuffer {
+	public:
+		NullConstantBuffer(void* initData, unsigned int size, BIND_SHADER bindShader, unsigned int slot = 0);
+		virtual ~NullConstantBuffer();
+
+		virtual void updateData(const void* newData, unsigned int bufferSize, unsigned int offset = 0U) override;
+
+		virtual void bind(void* cmdList) const override;
+
+		const void* getData() const;
+
+	private:
+		BIND_SHADER m_bindShader;
+		unsigned int m_slot;
+		unsigned int m_bufferSize;
+		void* m_data;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "NullInputLayout.h"
+
+InputLayout* InputLayout::Create() {
+	return SAIL_NEW NullInputLayout();
+}
+
+NullInputLayout::NullInputLayout()
+	: InputLayout()
+{
+	InstanceSize = 0;
+}
+
+NullInputLayout::~NullInputLayout() {
+
+}
+
+void NullInputLayout::pushFloat(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass, UINT instanceDataStepRate) {
+	addSize(inputSlotClass, sizeof(float));
+	InputLayout::pushFloat(inputType, semanticName, semanticIndex, inputSlotClass, instanceDataStepRate);
+}
+void NullInputLayout::pushVec2(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass, UINT instanceDataStepRate) {
+	addSize(inputSlotClass, sizeof(glm::vec2));
+	InputLayout::pushVec2(inputType, semanticName, semanticIndex, inputSlotClass, instanceDataStepRate);
+}
+void NullInputLayout::pushVec3(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass, UINT instanceDataStepRate) {
+	addSize(inputSlotClass, sizeof(glm::vec3));
+	InputLayout::pushVec3(inputType, semanticName, semanticIndex, inputSlotClass, instanceDataStepRate);
+}
+void NullInputLayout::pushVec4(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass, UINT instanceDataStepRate) {
+	addSize(inputSlotClass, sizeof(glm::vec4));
+	InputLayout::pushVec4(inputType, semanticName, semanticIndex, inputSlotClass, instanceDataStepRate);
+}
+
+void NullInputLayout::create(void* vertexShaderBlob) {
+	// Nothing to create without a device
+}
+
+void NullInputLayout::bind() const {
+	// Bound together with the pipeline
+}
+
+int NullInputLayout::convertInputClassification(InputClassification inputSlotClass) {
+	return inputSlotClass;
+}
+
+void NullInputLayout::addSize(InputClassification inputSlotClass, UINT typeSize) {
+	if (inputSlotClass == PER_INSTANCE_DATA)
+		InstanceSize += typeSize;
+	else
+		VertexSize += typeSize;
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Sail/api/shader/InputLayout.h"
+
+class NullInputLayout : public InputLayout {
+public:
+	NullInputLayout();
+	~NullInputLayout();
+
+	virtual void pushFloat(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass = PER_VERTEX_DATA, UINT instanceDataStepRate = 0) override;
+	virtual void pushVec2(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass = PER_VERTEX_DATA, UINT instanceDataStepRate = 0) override;
+	virtual void pushVec3(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass = PER_VERTEX_DATA, UINT instanceDataStepRate = 0) override;
+	virtual void pushVec4(InputType inputType, LPCSTR semanticName, UINT semanticIndex, InputClassification inputSlotClass = PER_VERTEX_DATA, UINT instanceDataStepRate = 0) override;
+
+	virtual void create(void* vertexShaderBlob) override;
+	virtual void bind() const override;
+
+protected:
+	virtual int convertInputClassification(InputClassification inputSlotClass) override;
+
+private:
+	void addSize(InputClassification inputSlotClass, UINT typeSize);
+
+};
\ No newline at end of file
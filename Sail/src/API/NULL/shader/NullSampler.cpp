@@ -0,0 +1,31 @@
+#include "pch.h"
+#include "NullSampler.h"
+#include "Sail/Application.h"
+#include "../NullAPI.h"
+#include "Sail/api/RenderStateCache.h"
+
+namespace ShaderComponent {
+
+	Sampler* Sampler::Create(Texture::ADDRESS_MODE adressMode, Texture::FILTER filter, BIND_SHADER bindShader, unsigned int slot) {
+		return SAIL_NEW NullSampler(adressMode, filter, bindShader, slot);
+	}
+
+	NullSampler::NullSampler(Texture::ADDRESS_MODE addressMode, Texture::FILTER filter, BIND_SHADER bindShader, unsigned int slot)
+		: Sampler(addressMode, filter, bindShader, slot)
+		, m_bindShader(bindShader)
+		, m_slot(slot)
+	{
+
+	}
+
+	NullSampler::~NullSampler() {
+
+	}
+
+	void NullSampler::bind() {
+		auto* api = Application::getInstance()->getAPI<NullAPI>();
+		if (api->getStateCache().setSampler(m_slot, m_bindShader, (uint64_t)this))
+			api->getCommandStream().record(NullCommandStream::BIND_SAMPLER, (uint64_t)this, 0, m_slot, m_bindShader);
+	}
+
+}
\ No newline at end of file
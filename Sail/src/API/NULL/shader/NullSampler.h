@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Sail/api/shader/Sampler.h"
+
+namespace ShaderComponent {
+
+	class NullSampler : public Sampler {
+
+	public:
+		NullSampler(Texture::ADDRESS_MODE addressMode = Texture::WRAP, Texture::FILTER filter = Texture::MIN_MAG_MIP_LINEAR, BIND_SHADER bindShader = PS, unsigned int slot = 0);
+		~NullSampler();
+
+		virtual void bind() override;
+
+	private:
+		BIND_SHADER m_bindShader;
+		unsigned int m_slot;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "pch.h"
+#include "NullShaderPipeline.h"
+#include "Sail/Application.h"
+#include "../NullAPI.h"
+#include "Sail/api/RenderStateCache.h"
+
+ShaderPipeline* ShaderPipeline::Create(const std::string& filename) {
+	return SAIL_NEW NullShaderPipeline(filename);
+}
+
+NullShaderPipeline::NullShaderPipeline(const std::string& filename)
+	: ShaderPipeline(filename)
+{
+
+}
+
+NullShaderPipeline::~NullShaderPipeline() {
+
+}
+
+void NullShaderPipeline::bind(void* cmdList) {
+	ShaderPipeline::bind(cmdList);
+
+	auto* api = Application::getInstance()->getAPI<NullAPI>();
+	if (api->getStateCache().setPipeline(this))
+		api->getCommandStream().record(NullCommandStream::BIND_PIPELINE, (uint64_t)this);
+}
+
+void* NullShaderPipeline::compileShader(const std::string& source, const std::string& filepath, ShaderComponent::BIND_SHADER shaderType) {
+	// The source is still parsed by ShaderPipeline::compile(), there is just nothing to compile it for
+	return nullptr;
+}
+
+void NullShaderPipeline::setTexture2D(const std::string& name, Texture* texture, void* cmdList) {
+	UINT slot = findSlotFromName(name, parsedData.textures);
+	auto* api = Application::getInstance()->getAPI<NullAPI>();
+	if (api->getStateCache().setTexture(slot, ShaderComponent::PS, (uint64_t)texture))
+		api->getCommandStream().record(NullCommandStream::BIND_TEXTURE, (uint64_t)texture, 0, slot, ShaderComponent::PS);
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Sail/api/shader/ShaderPipeline.h"
+
+class NullShaderPipeline : public ShaderPipeline {
+public:
+	NullShaderPipeline(const std::string& filename);
+	~NullShaderPipeline();
+
+	virtual void bind(void* cmdList) override;
+	virtual void* compileShader(const std::string& source, const std::string& filepath, ShaderComponent::BIND_SHADER shaderType) override;
+	virtual void setTexture2D(const std::string& name, Texture* texture, void* cmdList) override;
+
+};
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "pch.h"
 #include "Win32Input.h"
 #include <windowsx.h>
-#include "sail/Application.h"
+#include "Sail/Application.h"
 #include "Win32Window.h"
 
-Input* Input::m_Instance = SAIL_NEW Win32Input();
+Input* Input::m_PlatformInstance = SAIL_NEW Win32Input();
+Input* Input::m_Instance = Input::m_PlatformInstance;
 
 Win32Input::Win32Input()
 	: m_mouseButtons{ false }
@@ -86,7 +86,7 @@ bool Win32Window::initialize() {
 	ShowWindow(m_hWnd, SW_SHOW);
 
 	// Register raw input
-	Input::GetInstance<Win32Input>()->registerRawDevices(m_hWnd);
+	Input::GetPlatformInstance<Win32Input>()->registerRawDevices(m_hWnd);
 
 	return true;
 
@@ -119,7 +119,7 @@ LRESULT Win32Window::MsgProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 	case WM_ACTIVATEAPP:
 	case WM_INPUT:
 	case WM_MOUSEMOVE:
-		Input::GetInstance<Win32Input>()->processMessage(msg, wParam, lParam);
+		Input::GetPlatformInstance<Win32Input>()->processMessage(msg, wParam, lParam);
 		break;
 	case WM_ACTIVATE:
 		isWindowFocused = (wParam == WA_ACTIVE || wParam == WA_CLICKACTIVE);
@@ -172,6 +172,23 @@ void Win32Window::setWindowTitle(const std::string& title) {
 	SetWindowText(m_hWnd, ttle.c_str());
 }
 
+bool Win32Window::processMessages() {
+	MSG msg = {0};
+	while (PeekMessage(&msg, NULL, NULL, NULL, PM_REMOVE)) {
+		if (msg.message == WM_QUIT) {
+			exitCode = (int)msg.wParam;
+			return false;
+		}
+		TranslateMessage(&msg);
+		DispatchMessage(&msg);
+	}
+	return true;
+}
+
+void Win32Window::requestClose(int exitCode) {
+	PostQuitMessage(exitCode);
+}
+
 const HWND* Win32Window::getHwnd() const {
 	return &m_hWnd;
 }
@@ -20,6 +20,8 @@ public:
 	virtual bool initialize() override;
 	virtual bool hasBeenResized() override;
 	virtual void setWindowTitle(const std::string& title) override;
+	virtual bool processMessages() override;
+	virtual void requestClose(int exitCode) override;
 
 	LRESULT MsgProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 	const HWND* getHwnd() const;
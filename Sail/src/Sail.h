@@ -14,10 +14,13 @@
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
 
-#include "sail/KeyCodes.h"
-#include "sail/MouseButtonCodes.h"
+#include "Sail/Platform.h"
+#include "Sail/KeyCodes.h"
+#include "Sail/MouseButtonCodes.h"
 #include "Sail/Application.h"
-#include "Sail/Utils/Utils.h"
+#include "Sail/utils/Utils.h"
+#include "Sail/utils/Profiler.h"
+#include "Sail/api/RenderStats.h"
 #include "Sail/graphics/text/Text.h"
 #include "Sail/graphics/text/SailFont.h"
 #include "Sail/graphics/camera/PerspectiveCamera.h"
@@ -2,6 +2,8 @@
 #include "Application.h"
 #include "events/WindowResizeEvent.h"
 #include "KeyCodes.h"
+#include "utils/Profiler.h"
+#include "api/RenderStats.h"
 
 Application* Application::m_instance = nullptr;
 
@@ -29,14 +31,12 @@ Application::Application(int windowWidth, int windowHeight, const char* windowTi
 
 	// Initalize the window
 	if (!m_window->initialize()) {
-		OutputDebugString(L"\nFailed to initialize Win32Window\n");
-		Logger::Error("Failed to initialize Win32Window!");
+		Logger::Error("Failed to initialize the window!");
 		return;
 	}
 
 	// Initialize the graphics API
 	if (!m_api->init(m_window.get())) {
-		OutputDebugString(L"\nFailed to initialize the graphics API\n");
 		Logger::Error("Failed to initialize the grahics API!");
 		return;
 	}
@@ -48,12 +48,15 @@ Application::Application(int windowWidth, int windowHeight, const char* windowTi
 	//m_input.registerRawDevices(*m_window.getHwnd());
 
 	// Load the missing texture texture
-	m_resourceManager.loadTexture("missing.tga");
+	m_resourceManager.getPlaceholderTexture();
 
 }
 
 Application::~Application() {
-	delete Input::GetInstance();
+	// Write the recording before the input it reads from is deleted
+	m_inputRecorder.reset();
+	Input::SetInstance(nullptr);
+	delete Input::GetPlatformInstance();
 }
 
 int Application::startGameLoop() {
@@ -61,8 +64,6 @@ int Application::startGameLoop() {
 	// Start delta timer
 	m_timer.startTimer();
 	
-	MSG msg = {0};
-
 	m_fps = 0;
 
 	float secCounter = 0.f;
@@ -72,84 +73,168 @@ int Application::startGameLoop() {
 	float updateTimer = 0.f;
 	float timeBetweenUpdates = 1.f / 60.f;
 
-	// TODO: move windows loop to api specific section
-
-	// Main message loop
-	while (msg.message != WM_QUIT) {
-
-		if (PeekMessage(&msg, NULL, NULL, NULL, PM_REMOVE)) {
-			TranslateMessage(&msg);
-			DispatchMessage(&msg);
-		} else {
+	// Main loop, the window handles the platform messages between frames
+	while (m_window->processMessages()) {
+		Profiler::BeginFrame();
+		if (m_benchmark)
+			m_benchmark->beginFrame();
+
+		// Handle window resizing
+		if (m_window->hasBeenResized()) {
+			UINT newWidth = m_window->getWindowWidth();
+			UINT newHeight = m_window->getWindowHeight();
+			bool isMinimized = m_window->isMinimized();
+			// Send resize event
+			WindowResizeEvent event(newWidth, newHeight, isMinimized);
+			dispatchEvent(event);
+		}
 
-			// Handle window resizing
-			if (m_window->hasBeenResized()) {
-				UINT newWidth = m_window->getWindowWidth();
-				UINT newHeight = m_window->getWindowHeight();
-				bool isMinimized = m_window->isMinimized();
-				// Send resize event
-				dispatchEvent(WindowResizeEvent(newWidth, newHeight, isMinimized));
-			}
-			
-			// Get delta time from last frame
-			float delta = static_cast<float>(m_timer.getFrameTime());
-			delta = std::min(delta, 0.04f);
-
-			// Update fps counter
-			secCounter += delta;
-			frameCounter++;
-
-			if (secCounter >= 1) {
-				m_fps = frameCounter;
-				frameCounter = 0;
-				secCounter = 0.f;
-			}
+		// Create the GPU resources of async loads that finished decoding
+		m_resourceManager.update();
+		
+		// Get delta time from last frame
+		float delta = static_cast<float>(m_timer.getFrameTime());
+		delta = std::min(delta, 0.04f);
+		// Benchmarks, recordings and replays always step the same amount to be reproducible
+		if (m_benchmark)
+			delta = m_benchmark->getSettings().fixedDeltaTime;
+		if (m_inputRecorder)
+			delta = m_inputRecorder->getDeltaTime();
+		if (m_inputReplay)
+			delta = m_inputReplay->getDeltaTime();
+
+		// Update fps counter
+		secCounter += delta;
+		frameCounter++;
+
+		if (secCounter >= 1) {
+			m_fps = frameCounter;
+			frameCounter = 0;
+			secCounter = 0.f;
+		}
 
-			// Update input states
-			//m_input.updateStates();
+		// Update input states
+		//m_input.updateStates();
 
-			// Update mouse deltas
+		// Update mouse deltas, the platform input is kept up to date while replaying
+		Input::GetPlatformInstance()->beginFrame();
+		if (m_inputReplay)
 			Input::GetInstance()->beginFrame();
+		if (m_inputRecorder)
+			m_inputRecorder->recordFrame();
 
-			// Quit on alt-f4
-			if (Input::IsKeyPressed(SAIL_KEY_MENU) && Input::IsKeyPressed(SAIL_KEY_F4))
-				PostQuitMessage(0);
+		// Quit on alt-f4
+		if (Input::IsKeyPressed(SAIL_KEY_MENU) && Input::IsKeyPressed(SAIL_KEY_F4))
+			m_window->requestClose(0);
 
+		{
+			SAIL_PROFILE_SCOPE("Application::processInput");
+			if (m_benchmark)
+				m_benchmark->beginPhase(Benchmark::INPUT);
 			processInput(delta);
+			if (m_benchmark)
+				m_benchmark->endPhase(Benchmark::INPUT);
+		}
 
-			// Update
+		// Update
 #ifdef _DEBUG
-			/*if (m_input.getKeyboardState().Escape)
-				PostQuitMessage(0);*/
+		/*if (m_input.getKeyboardState().Escape)
+			PostQuitMessage(0);*/
 
 
-			//if(delta > 0.0166)
-			//	Logger::Warning(std::to_string(elapsedTime) + " delta over 0.0166: " + std::to_string(delta));
+		//if(delta > 0.0166)
+		//	Logger::Warning(std::to_string(elapsedTime) + " delta over 0.0166: " + std::to_string(delta));
 #endif
-			updateTimer += delta;
+		updateTimer += delta;
 
-			int maxCounter = 0;
+		int maxCounter = 0;
+	
+		if (m_benchmark)
+			m_benchmark->beginPhase(Benchmark::UPDATE);
+
+		while (updateTimer >= timeBetweenUpdates) {
+			if (maxCounter >= 4)
+				break;
+			SAIL_PROFILE_SCOPE("Application::update");
+			update(timeBetweenUpdates);
+			updateTimer -= timeBetweenUpdates;
+			maxCounter++;
+		}
+		if (m_benchmark)
+			m_benchmark->endPhase(Benchmark::UPDATE);
+
+		// Render
+		{
+			SAIL_PROFILE_SCOPE("Application::render");
+			if (m_benchmark)
+				m_benchmark->beginPhase(Benchmark::RENDER);
+			render(delta);
+			if (m_benchmark)
+				m_benchmark->endPhase(Benchmark::RENDER);
+		}
 		
+		// Reset just pressed keys
+		Input::GetPlatformInstance()->endFrame();
+		if (m_inputReplay)
+			Input::GetInstance()->endFrame();
 
-			while (updateTimer >= timeBetweenUpdates) {
-				if (maxCounter >= 4)
-					break;
-				update(timeBetweenUpdates);
-				updateTimer -= timeBetweenUpdates;
-				maxCounter++;
-			}
+		m_api->getRenderStats().endFrame(m_api->getStateCache());
+		Profiler::EndFrame();
 
-			// Render
-			render(delta);
-			
-			// Reset just pressed keys
-			Input::GetInstance()->endFrame();
+		if (m_inputReplay && m_inputReplay->isFinished() && !m_benchmark) {
+			Logger::Log("Input replay finished after " + std::to_string(m_inputReplay->getNumFrames()) + " frames");
+			m_window->requestClose(0);
+		}
+		if (m_benchmark) {
+			m_benchmark->endFrame();
+			if (m_benchmark->isFinished()) {
+				int exitCode = m_benchmark->finish();
+				m_benchmark.reset();
+				m_window->requestClose(exitCode);
+			}
 		}
-
 	}
 
-	return (int)msg.wParam;
+	return m_window->getExitCode();
+
+}
+
+void Application::startBenchmark(const Benchmark::Settings& settings) {
+	m_benchmark = std::make_unique<Benchmark>(settings);
+}
+
+Benchmark* Application::getBenchmark() {
+	return m_benchmark.get();
+}
+
+void Application::startInputRecording(const std::string& path) {
+	m_inputRecorder = std::make_unique<InputRecorder>(path, 1.f / 60.f);
+}
+
+bool Application::stopInputRecording() {
+	if (!m_inputRecorder)
+		return false;
+	bool written = m_inputRecorder->stop();
+	m_inputRecorder.reset();
+	return written;
+}
+
+bool Application::startInputReplay(const std::string& path) {
+	auto replay = std::make_unique<ReplayInput>();
+	if (!replay->load(path))
+		return false;
+	m_inputReplay = std::move(replay);
+	Input::SetInstance(m_inputReplay.get());
+	return true;
+}
+
+void Application::stopInputReplay() {
+	Input::SetInstance(nullptr);
+	m_inputReplay.reset();
+}
 
+ReplayInput* Application::getInputReplay() {
+	return m_inputReplay.get();
 }
 
 std::string Application::getPlatformName() {
@@ -164,7 +249,7 @@ Application* Application::getInstance() {
 
 void Application::dispatchEvent(Event& event) {
 	m_api->onEvent(event);
-	Input::GetInstance()->onEvent(event);
+	Input::GetPlatformInstance()->onEvent(event);
 }
 
 GraphicsAPI* const Application::getAPI() {
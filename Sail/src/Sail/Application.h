@@ -2,11 +2,14 @@
 #include "api/Mesh.h"
 
 #include "api/Input.h"
+#include "api/InputRecorder.h"
+#include "api/ReplayInput.h"
 #include "api/GraphicsAPI.h"
 #include "api/Window.h"
 #include "api/ImGuiHandler.h"
 
 #include "utils/Timer.h"
+#include "utils/Benchmark.h"
 #include "resources/ResourceManager.h"
 #include "events/IEventDispatcher.h"
 
@@ -22,6 +25,20 @@ public:
 	virtual ~Application();
 
 	int startGameLoop();
+	// Runs the game loop in benchmark mode, startGameLoop() then returns the exit code from Benchmark::finish()
+	void startBenchmark(const Benchmark::Settings& settings);
+	// nullptr when not benchmarking
+	Benchmark* getBenchmark();
+	// Records the input of every frame until the application exits or the recording is stopped
+	void startInputRecording(const std::string& path);
+	// Writes the recording, returns false if nothing was recorded or the file could not be written
+	bool stopInputRecording();
+	// Replaces the input with a recording, the game loop steps with the timestep of the recording and quits when it ends
+	bool startInputReplay(const std::string& path);
+	// Gives the input back to the platform
+	void stopInputReplay();
+	// nullptr when not replaying
+	ReplayInput* getInputReplay();
 
 	// Required methods
 	virtual int run() = 0;
@@ -54,4 +71,8 @@ private:
 	Timer m_timer;
 	UINT m_fps;
 
+	std::unique_ptr<Benchmark> m_benchmark;
+	std::unique_ptr<InputRecorder> m_inputRecorder;
+	std::unique_ptr<ReplayInput> m_inputReplay;
+
 };
\ No newline at end of file
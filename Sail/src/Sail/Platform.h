@@ -0,0 +1,12 @@
+#pragma once
+
+// The few windows types and intrinsics used outside of the windows specific code, defined for other platforms
+#ifndef _WIN32
+#include <signal.h>
+
+typedef unsigned int UINT;
+typedef const char* LPCSTR;
+typedef void* HINSTANCE;
+
+#define __debugbreak() raise(SIGTRAP)
+#endif
\ No newline at end of file
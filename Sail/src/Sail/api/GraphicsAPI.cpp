@@ -0,0 +1,21 @@
+#include "pch.h"
+#include "GraphicsAPI.h"
+#include "RenderStateCache.h"
+#include "RenderStats.h"
+
+GraphicsAPI::GraphicsAPI() {
+	m_stateCache = std::make_unique<RenderStateCache>();
+	m_renderStats = std::make_unique<RenderStats>();
+}
+
+GraphicsAPI::~GraphicsAPI() {
+
+}
+
+RenderStateCache& GraphicsAPI::getStateCache() {
+	return *m_stateCache;
+}
+
+RenderStats& GraphicsAPI::getRenderStats() {
+	return *m_renderStats;
+}
\ No newline at end of file
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include "../utils/Utils.h"
 #include "Sail/events/IEventListener.h"
 #include "Sail/events/EventHandler.h"
 #include "Sail/events/WindowResizeEvent.h"
 
 class Window;
+class RenderStateCache;
+class RenderStats;
 
 class GraphicsAPI : public IEventListener {
 public:
@@ -27,8 +30,8 @@ public:
 
 public:
 	static GraphicsAPI* Create();
-	GraphicsAPI() { };
-	virtual ~GraphicsAPI() { };
+	GraphicsAPI();
+	virtual ~GraphicsAPI();
 
 	virtual bool init(Window* window) = 0;
 	virtual void clear(const glm::vec4& color) = 0;
@@ -39,6 +42,14 @@ public:
 	virtual unsigned int getMemoryUsage() const = 0;
 	virtual unsigned int getMemoryBudget() const = 0;
 	virtual void toggleFullscreen() { /* All APIs might not need to implement this */ };
+	// Frames the CPU can record ahead of the GPU, data that is written per frame needs this many copies to stay valid
+	// APIs whose driver renames buffers on write, like DX11, only need one
+	virtual unsigned int getNumFramesInFlight() const { return 1; }
+
+	// Used by the API implementations to skip redundant state changes
+	RenderStateCache& getStateCache();
+	// Per frame draw and bind counters, filled in by the renderers and finished by the application loop
+	RenderStats& getRenderStats();
 
 	virtual bool onResize(WindowResizeEvent& event) = 0;
 	virtual bool onEvent(Event& event) override {
@@ -46,5 +57,8 @@ public:
 		return true;
 	}
 
+private:
+	std::unique_ptr<RenderStateCache> m_stateCache;
+	std::unique_ptr<RenderStats> m_renderStats;
 
 };
\ No newline at end of file
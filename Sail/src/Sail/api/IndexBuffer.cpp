@@ -2,15 +2,22 @@
 #include "IndexBuffer.h"
 
 IndexBuffer::IndexBuffer(Mesh::Data& modelData) {
-	m_byteSize = modelData.numIndices * sizeof(unsigned int);
+	m_shortIndices = modelData.numVertices <= 0x10000;
+	m_byteSize = modelData.numIndices * (m_shortIndices ? sizeof(uint16_t) : sizeof(uint32_t));
 }
 
-unsigned long* IndexBuffer::getIndexData(Mesh::Data& modelData) {
-	ULONG* indices = SAIL_NEW ULONG[modelData.numIndices];
+unsigned char* IndexBuffer::getIndexData(Mesh::Data& modelData) {
+	unsigned char* indices = SAIL_NEW unsigned char[m_byteSize];
 
 	// Fill the array with the model indices
-	for (UINT i = 0; i < modelData.numIndices; i++) {
-		indices[i] = modelData.indices[i];
+	if (m_shortIndices) {
+		uint16_t* shortIndices = reinterpret_cast<uint16_t*>(indices);
+		for (UINT i = 0; i < modelData.numIndices; i++)
+			shortIndices[i] = static_cast<uint16_t>(modelData.indices[i]);
+	} else {
+		uint32_t* longIndices = reinterpret_cast<uint32_t*>(indices);
+		for (UINT i = 0; i < modelData.numIndices; i++)
+			longIndices[i] = static_cast<uint32_t>(modelData.indices[i]);
 	}
 
 	return indices;
@@ -19,3 +26,7 @@ unsigned long* IndexBuffer::getIndexData(Mesh::Data& modelData) {
 unsigned int IndexBuffer::getIndexDataSize() const {
 	return m_byteSize;
 }
+
+bool IndexBuffer::hasShortIndices() const {
+	return m_shortIndices;
+}
@@ -9,12 +9,15 @@ public:
 	virtual ~IndexBuffer() { }
 
 	virtual void bind(void* cmdList = nullptr) const = 0;
+	unsigned int getIndexDataSize() const;
 
 protected:
-	unsigned long* getIndexData(Mesh::Data& modelData);
-	unsigned int getIndexDataSize() const;
+	// Indices are packed into 16 bits when every vertex can be reached with them, free the data with SafeDeleteArr
+	unsigned char* getIndexData(Mesh::Data& modelData);
+	bool hasShortIndices() const;
 
 private:
 	unsigned int m_byteSize;
+	bool m_shortIndices;
 
 };
\ No newline at end of file
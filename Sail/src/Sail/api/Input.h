@@ -11,6 +11,13 @@ public:
 	template <typename T>
 	static T* GetInstance() { return static_cast<T*>(m_Instance); }
 	static Input* GetInstance() { return m_Instance; }
+	// The input of the platform, which keeps receiving window messages while another instance is active
+	template <typename T>
+	static T* GetPlatformInstance() { return static_cast<T*>(m_PlatformInstance); }
+	static Input* GetPlatformInstance() { return m_PlatformInstance; }
+	// Replaces the input read through the static functions, nullptr restores the platform input
+	// Used to replay recorded input, the caller keeps ownership of the instance
+	static void SetInstance(Input* input) { m_Instance = input ? input : m_PlatformInstance; }
 
 	inline static bool IsKeyPressed(int keycode) { return m_Instance->isKeyPressedImpl(keycode); }
 	inline static bool WasKeyJustPressed(int keycode) { return m_Instance->wasKeyJustPressedImpl(keycode); }
@@ -44,6 +51,7 @@ protected:
 
 private:
 	static Input* m_Instance;
+	static Input* m_PlatformInstance;
 
 
 };
\ No newline at end of file
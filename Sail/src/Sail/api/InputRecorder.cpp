@@ -0,0 +1,104 @@
+#include "pch.h"
+#include "InputRecorder.h"
+#include "Input.h"
+#include "Sail/utils/Utils.h"
+#include <fstream>
+
+InputRecorder::InputRecorder(const std::string& path, float deltaTime)
+	: m_path(path)
+	, m_deltaTime(deltaTime)
+	, m_stopped(false)
+	, m_frame(0)
+	, m_numRecords(0)
+	, m_keys{ false }
+	, m_buttons{ false }
+	, m_mouseX(0)
+	, m_mouseY(0)
+{
+}
+
+InputRecorder::~InputRecorder() {
+	if (!m_stopped)
+		stop();
+}
+
+void InputRecorder::recordFrame() {
+	m_events.clear();
+	auto addEvent = [&](EventType type, int code) {
+		m_events.push_back(type);
+		m_events.push_back((uint8_t)code);
+	};
+	for (int key = 0; key < SAIL_NUM_KEYS; key++) {
+		bool pressed = Input::IsKeyPressed(key);
+		if (pressed != m_keys[key])
+			addEvent(pressed ? KEY_DOWN : KEY_UP, key);
+		if (Input::WasKeyJustPressed(key))
+			addEvent(KEY_JUST_PRESSED, key);
+		m_keys[key] = pressed;
+	}
+	for (int button = 0; button < SAIL_NUM_MOUSE_BUTTONS; button++) {
+		bool pressed = Input::IsMouseButtonPressed(button);
+		if (pressed != m_buttons[button])
+			addEvent(pressed ? BUTTON_DOWN : BUTTON_UP, button);
+		if (Input::WasMouseButtonJustPressed(button))
+			addEvent(BUTTON_JUST_PRESSED, button);
+		m_buttons[button] = pressed;
+	}
+
+	glm::ivec2 delta = Input::GetMouseDelta();
+	glm::ivec2 pos = Input::GetMousePosition();
+	uint8_t flags = 0;
+	if (delta.x != 0 || delta.y != 0)
+		flags |= HAS_MOUSE_DELTA;
+	if (pos.x != m_mouseX || pos.y != m_mouseY)
+		flags |= HAS_MOUSE_POSITION;
+	m_mouseX = pos.x;
+	m_mouseY = pos.y;
+
+	// Frames without changes are not stored
+	if (flags != 0 || !m_events.empty()) {
+		write((uint32_t)m_frame);
+		write(flags);
+		write((uint16_t)(m_events.size() / 2));
+		if (flags & HAS_MOUSE_DELTA) {
+			write((int16_t)glm::clamp(delta.x, -32768, 32767));
+			write((int16_t)glm::clamp(delta.y, -32768, 32767));
+		}
+		if (flags & HAS_MOUSE_POSITION) {
+			write((int16_t)glm::clamp(pos.x, -32768, 32767));
+			write((int16_t)glm::clamp(pos.y, -32768, 32767));
+		}
+		m_data.insert(m_data.end(), m_events.begin(), m_events.end());
+		m_numRecords++;
+	}
+	m_frame++;
+}
+
+bool InputRecorder::stop() {
+	m_stopped = true;
+
+	std::ofstream file(m_path, std::ios::binary);
+	if (!file.is_open()) {
+		Logger::Warning("Could not open " + m_path + " to write the input recording");
+		return false;
+	}
+	FileHeader header = { FILE_MAGIC, FILE_VERSION, m_deltaTime, m_frame, m_numRecords };
+	file.write((const char*)&header, sizeof(header));
+	file.write(m_data.data(), m_data.size());
+	Logger::Log("Saved input recording of " + std::to_string(m_frame) + " frames to " + m_path);
+	return file.good();
+}
+
+unsigned int InputRecorder::getNumFrames() const {
+	return m_frame;
+}
+
+float InputRecorder::getDeltaTime() const {
+	return m_deltaTime;
+}
+
+template<typename T>
+void InputRecorder::write(const T& value) {
+	const char* bytes = (const char*)&value;
+	m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Sail/KeyCodes.h"
+#include "Sail/MouseButtonCodes.h"
+
+// Records the input state seen by the application every frame to a compact binary file, which can be played back with ReplayInput
+// Only frames where something changed are stored, identified by their frame index
+//
+// File layout:
+//   FileHeader
+//   numRecords records of
+//     uint32 frame, uint8 flags, uint16 numEvents
+//     int16 mouseDelta.x, mouseDelta.y  (if flags & HAS_MOUSE_DELTA)
+//     int16 mousePos.x, mousePos.y      (if flags & HAS_MOUSE_POSITION)
+//     numEvents * (uint8 EventType, uint8 code)
+class InputRecorder {
+public:
+	static const uint32_t FILE_MAGIC = 0x504E4953; // "SINP"
+	static const uint32_t FILE_VERSION = 1;
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t version;
+		float deltaTime; // Fixed timestep to replay with
+		uint32_t numFrames;
+		uint32_t numRecords;
+	};
+	enum Flags : uint8_t {
+		HAS_MOUSE_DELTA = 1,
+		HAS_MOUSE_POSITION = 2
+	};
+	enum EventType : uint8_t {
+		KEY_DOWN,
+		KEY_UP,
+		KEY_JUST_PRESSED,
+		BUTTON_DOWN,
+		BUTTON_UP,
+		BUTTON_JUST_PRESSED
+	};
+
+public:
+	InputRecorder(const std::string& path, float deltaTime);
+	// Writes the file if stop() has not been called
+	~InputRecorder();
+
+	// Samples the current state through the static Input functions, call once per frame after Input::beginFrame()
+	void recordFrame();
+	// Writes the recording to the file, returns false if it could not be written
+	bool stop();
+
+	unsigned int getNumFrames() const;
+	// The fixed timestep the application has to step with while recording
+	float getDeltaTime() const;
+
+private:
+	template<typename T>
+	void write(const T& value);
+
+private:
+	std::string m_path;
+	float m_deltaTime;
+	bool m_stopped;
+
+	unsigned int m_frame;
+	unsigned int m_numRecords;
+	std::vector<char> m_data;
+	std::vector<uint8_t> m_events;
+
+	// State of the previous frame, only changes are stored
+	bool m_keys[SAIL_NUM_KEYS];
+	bool m_buttons[SAIL_NUM_MOUSE_BUTTONS];
+	int m_mouseX;
+	int m_mouseY;
+
+};
\ No newline at end of file
@@ -5,21 +5,32 @@
 #include "IndexBuffer.h"
 #include "Sail/api/shader/ShaderPipeline.h"
 #include "Sail/Application.h"
+#include <memory>
+
+Mesh::CPUDataPolicy Mesh::s_defaultCPUDataPolicy = Mesh::KEEP_CPU_DATA;
 
 Mesh::Mesh(Data& buildData, Shader* shader)
 	: meshData(buildData) 
+	, boundsMin(0.f)
+	, boundsMax(0.f)
 {
-	
+	// Calculate the model space bounding box
+	if (meshData.positions && meshData.numVertices > 0) {
+		boundsMin = boundsMax = meshData.positions[0].vec;
+		for (unsigned int i = 1; i < meshData.numVertices; i++) {
+			boundsMin = glm::min(boundsMin, meshData.positions[i].vec);
+			boundsMax = glm::max(boundsMax, meshData.positions[i].vec);
+		}
+	} else if (meshData.packedVertices) {
+		boundsMin = meshData.packedBoundsMin;
+		boundsMax = meshData.packedBoundsMax;
+	}
+	// The packed vertices are only valid until the buffers are created
+	meshData.packedVertices = nullptr;
 }
 
 Mesh::~Mesh() {
-	Memory::SafeDeleteArr(meshData.indices);
-	Memory::SafeDeleteArr(meshData.positions);
-	Memory::SafeDeleteArr(meshData.normals);
-	Memory::SafeDeleteArr(meshData.bitangents);
-	Memory::SafeDeleteArr(meshData.colors);
-	Memory::SafeDeleteArr(meshData.tangents);
-	Memory::SafeDeleteArr(meshData.texCoords);
+	meshData.freeArrays();
 }
 
 Material* Mesh::getMaterial() {
@@ -41,45 +52,188 @@ const VertexBuffer& Mesh::getVertexBuffer() const {
 const IndexBuffer& Mesh::getIndexBuffer() const {
 	return *indexBuffer;
 }
+const glm::vec3& Mesh::getBoundsMin() const {
+	return boundsMin;
+}
+const glm::vec3& Mesh::getBoundsMax() const {
+	return boundsMax;
+}
 
-void Mesh::Data::deepCopy(const Data& other) {
-	this->numIndices = other.numIndices;
-	this->numVertices = other.numVertices;
-	this->numInstances = other.numInstances;
-	if (other.indices) {
-		this->indices = SAIL_NEW unsigned long[other.numIndices];
-		for (unsigned int i = 0; i < other.numIndices; i++)
-			this->indices[i] = other.indices[i];
-	}
-	unsigned int numVerts = (other.numIndices > 0) ? other.numIndices : other.numVertices;
-	if (other.positions) {
-		this->positions = SAIL_NEW Mesh::vec3[numVerts];
-		for (unsigned int i = 0; i < numVerts; i++)
-			this->positions[i] = other.positions[i];
-	}
-	if (other.normals) {
-		this->normals = SAIL_NEW Mesh::vec3[numVerts];
-		for (unsigned int i = 0; i < numVerts; i++)
-			this->normals[i] = other.normals[i];
-	}
-	if (other.colors) {
-		this->colors = SAIL_NEW Mesh::vec4[numVerts];
-		for (unsigned int i = 0; i < numVerts; i++)
-			this->colors[i] = other.colors[i];
+const Mesh::Data& Mesh::getData() const {
+	return meshData;
+}
+size_t Mesh::getCPUMemoryUsage() const {
+	return meshData.getByteSize();
+}
+size_t Mesh::getGPUMemoryUsage() const {
+	size_t size = 0;
+	if (vertexBuffer)
+		size += vertexBuffer->getVertexDataSize();
+	if (indexBuffer)
+		size += indexBuffer->getIndexDataSize();
+	return size;
+}
+
+void Mesh::releaseCPUData(CPUDataPolicy policy) {
+	if (policy == KEEP_POSITIONS_AND_INDICES)
+		meshData.shrink(Data::POSITIONS, true);
+	else if (policy == RELEASE_CPU_DATA)
+		meshData.shrink(0, false);
+}
+
+void Mesh::SetDefaultCPUDataPolicy(CPUDataPolicy policy) {
+	s_defaultCPUDataPolicy = policy;
+}
+
+Mesh::CPUDataPolicy Mesh::GetDefaultCPUDataPolicy() {
+	return s_defaultCPUDataPolicy;
+}
+
+namespace {
+	const size_t BLOCK_ALIGNMENT = 16;
+
+	size_t alignBlock(size_t offset) {
+		return (offset + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
 	}
-	if (other.texCoords) {
-		this->texCoords = SAIL_NEW Mesh::vec2[numVerts];
-		for (unsigned int i = 0; i < numVerts; i++)
-			this->texCoords[i] = other.texCoords[i];
+	// Places count default constructed elements at offset in the block and moves the offset past them
+	template<typename T>
+	T* placeArray(unsigned char* block, size_t& offset, unsigned int count) {
+		T* array = reinterpret_cast<T*>(block + offset);
+		std::uninitialized_default_construct_n(array, count);
+		offset = alignBlock(offset + sizeof(T) * count);
+		return array;
 	}
-	if (other.tangents) {
-		this->tangents = SAIL_NEW Mesh::vec3[numVerts];
-		for (unsigned int i = 0; i < numVerts; i++)
-			this->tangents[i] = other.tangents[i];
+	template<typename T>
+	void copyArray(T* dst, const T* src, unsigned int count) {
+		if (dst && src)
+			std::copy(src, src + count, dst);
 	}
-	if (other.bitangents) {
-		this->bitangents = SAIL_NEW Mesh::vec3[numVerts];
-		for (unsigned int i = 0; i < numVerts; i++)
-			this->bitangents[i] = other.bitangents[i];
+}
+
+void Mesh::Data::deepCopy(const Data& other) {
+	this->numInstances = other.numInstances;
+	allocate(other.numVertices, (other.indices) ? other.numIndices : 0, other.getAttributes());
+	copyArray(this->indices, other.indices, other.numIndices);
+	copyArray(this->positions, other.positions, other.numVertices);
+	copyArray(this->normals, other.normals, other.numVertices);
+	copyArray(this->colors, other.colors, other.numVertices);
+	copyArray(this->texCoords, other.texCoords, other.numVertices);
+	copyArray(this->tangents, other.tangents, other.numVertices);
+	copyArray(this->bitangents, other.bitangents, other.numVertices);
+	// Keep the index count of data that has had its indices released
+	this->numIndices = other.numIndices;
+	this->packedVertices = other.packedVertices;
+	this->packedStride = other.packedStride;
+	this->packedBoundsMin = other.packedBoundsMin;
+	this->packedBoundsMax = other.packedBoundsMax;
+}
+
+void Mesh::Data::allocate(unsigned int vertexCount, unsigned int indexCount, unsigned int attributes) {
+	freeArrays();
+	numVertices = vertexCount;
+	numIndices = indexCount;
+
+	// Sum up the size first, every array starts on an aligned offset
+	size_t size = alignBlock(sizeof(unsigned long) * indexCount);
+	if (attributes & POSITIONS) size += alignBlock(sizeof(Mesh::vec3) * vertexCount);
+	if (attributes & NORMALS) size += alignBlock(sizeof(Mesh::vec3) * vertexCount);
+	if (attributes & COLORS) size += alignBlock(sizeof(Mesh::vec4) * vertexCount);
+	if (attributes & TEXCOORDS) size += alignBlock(sizeof(Mesh::vec2) * vertexCount);
+	if (attributes & TANGENTS) size += alignBlock(sizeof(Mesh::vec3) * vertexCount);
+	if (attributes & BITANGENTS) size += alignBlock(sizeof(Mesh::vec3) * vertexCount);
+	if (size == 0)
+		return;
+
+	// new[] of a char array is aligned for any fundamental type, which is enough for the glm vectors
+	block = SAIL_NEW unsigned char[size];
+	size_t offset = 0;
+	indices = (indexCount > 0) ? placeArray<unsigned long>(block, offset, indexCount) : nullptr;
+	if (indices)
+		std::fill(indices, indices + indexCount, 0UL);
+	positions = (attributes & POSITIONS) ? placeArray<Mesh::vec3>(block, offset, vertexCount) : nullptr;
+	normals = (attributes & NORMALS) ? placeArray<Mesh::vec3>(block, offset, vertexCount) : nullptr;
+	colors = (attributes & COLORS) ? placeArray<Mesh::vec4>(block, offset, vertexCount) : nullptr;
+	texCoords = (attributes & TEXCOORDS) ? placeArray<Mesh::vec2>(block, offset, vertexCount) : nullptr;
+	tangents = (attributes & TANGENTS) ? placeArray<Mesh::vec3>(block, offset, vertexCount) : nullptr;
+	bitangents = (attributes & BITANGENTS) ? placeArray<Mesh::vec3>(block, offset, vertexCount) : nullptr;
+}
+
+void Mesh::Data::shrink(unsigned int attributes, bool keepIndices) {
+	attributes &= getAttributes();
+	keepIndices = keepIndices && indices;
+	if (attributes == getAttributes() && keepIndices == (indices != nullptr))
+		return;
+
+	unsigned int vertexCount = numVertices;
+	unsigned int indexCount = numIndices;
+	Data kept;
+	kept.allocate(vertexCount, (keepIndices) ? indexCount : 0, attributes);
+	copyArray(kept.indices, indices, kept.numIndices);
+	copyArray(kept.positions, positions, vertexCount);
+	copyArray(kept.normals, normals, vertexCount);
+	copyArray(kept.colors, colors, vertexCount);
+	copyArray(kept.texCoords, texCoords, vertexCount);
+	copyArray(kept.tangents, tangents, vertexCount);
+	copyArray(kept.bitangents, bitangents, vertexCount);
+	swapArrays(kept);
+	kept.freeArrays();
+	numVertices = vertexCount;
+	numIndices = indexCount;
+}
+
+void Mesh::Data::freeArrays() {
+	if (block) {
+		// The arrays hold trivially destructible types, freeing the block is enough
+		Memory::SafeDeleteArr(block);
+	} else {
+		Memory::SafeDeleteArr(indices);
+		Memory::SafeDeleteArr(positions);
+		Memory::SafeDeleteArr(normals);
+		Memory::SafeDeleteArr(bitangents);
+		Memory::SafeDeleteArr(colors);
+		Memory::SafeDeleteArr(tangents);
+		Memory::SafeDeleteArr(texCoords);
 	}
+	indices = nullptr;
+	positions = nullptr;
+	normals = nullptr;
+	colors = nullptr;
+	texCoords = nullptr;
+	tangents = nullptr;
+	bitangents = nullptr;
+}
+
+void Mesh::Data::swapArrays(Data& other) {
+	std::swap(block, other.block);
+	std::swap(numIndices, other.numIndices);
+	std::swap(numVertices, other.numVertices);
+	std::swap(indices, other.indices);
+	std::swap(positions, other.positions);
+	std::swap(normals, other.normals);
+	std::swap(colors, other.colors);
+	std::swap(texCoords, other.texCoords);
+	std::swap(tangents, other.tangents);
+	std::swap(bitangents, other.bitangents);
+}
+
+unsigned int Mesh::Data::getAttributes() const {
+	unsigned int attributes = 0;
+	if (positions) attributes |= POSITIONS;
+	if (normals) attributes |= NORMALS;
+	if (colors) attributes |= COLORS;
+	if (texCoords) attributes |= TEXCOORDS;
+	if (tangents) attributes |= TANGENTS;
+	if (bitangents) attributes |= BITANGENTS;
+	return attributes;
+}
+
+size_t Mesh::Data::getByteSize() const {
+	size_t size = (indices) ? sizeof(unsigned long) * numIndices : 0;
+	if (positions) size += sizeof(Mesh::vec3) * numVertices;
+	if (normals) size += sizeof(Mesh::vec3) * numVertices;
+	if (colors) size += sizeof(Mesh::vec4) * numVertices;
+	if (texCoords) size += sizeof(Mesh::vec2) * numVertices;
+	if (tangents) size += sizeof(Mesh::vec3) * numVertices;
+	if (bitangents) size += sizeof(Mesh::vec3) * numVertices;
+	return size;
 }
\ No newline at end of file
@@ -32,9 +32,35 @@ public:
 		}
 	};
 
+	// The data does not free its arrays by itself, it is handed over by copying and whoever ends up with it calls freeArrays()
 	struct Data {
-		Data() : numIndices(0), numInstances(0), indices(nullptr), numVertices(0), normals(nullptr), positions(nullptr), colors(nullptr), texCoords(nullptr), tangents(nullptr), bitangents(nullptr) {};
+		// Flags for the vertex arrays
+		enum Attribute {
+			POSITIONS = 1 << 0,
+			NORMALS = 1 << 1,
+			COLORS = 1 << 2,
+			TEXCOORDS = 1 << 3,
+			TANGENTS = 1 << 4,
+			BITANGENTS = 1 << 5,
+			ALL_ATTRIBUTES = (1 << 6) - 1
+		};
+
+		Data() : numIndices(0), numInstances(0), indices(nullptr), numVertices(0), normals(nullptr), positions(nullptr), colors(nullptr), texCoords(nullptr), tangents(nullptr), bitangents(nullptr), packedVertices(nullptr), packedStride(0), packedBoundsMin(0.f), packedBoundsMax(0.f), block(nullptr) {};
 		void deepCopy(const Data& other);
+		// Allocates the indices and the vertex arrays in attributes as one zeroed block, anything allocated before is freed first
+		void allocate(unsigned int vertexCount, unsigned int indexCount, unsigned int attributes);
+		// Moves the arrays into a smaller block holding only the vertex arrays in attributes and the indices if keepIndices is set
+		// The counts are left as they are, meshes still need them to draw after the arrays are gone
+		void shrink(unsigned int attributes, bool keepIndices);
+		// Frees the indices and vertex arrays, whether they share a block or were allocated one by one
+		void freeArrays();
+		// Exchanges the arrays and their counts with another data
+		void swapArrays(Data& other);
+		// Flags of the vertex arrays that are set
+		unsigned int getAttributes() const;
+		// Bytes taken by the indices and vertex arrays that are set
+		size_t getByteSize() const;
+
 		unsigned int numIndices;
 		unsigned long* indices;
 		unsigned int numVertices;
@@ -45,14 +71,31 @@ public:
 		Mesh::vec2* texCoords;
 		Mesh::vec3* tangents;
 		Mesh::vec3* bitangents;
+		// Vertices already interleaved in the order of the shader input layout, uploaded as they are instead of the arrays above
+		// Not owned by the mesh and only read while it is created, which lets cooked meshes point this into a mapped file
+		const void* packedVertices;
+		unsigned int packedStride;
+		// Model space bounds of the packed vertices
+		glm::vec3 packedBoundsMin;
+		glm::vec3 packedBoundsMax;
+		// Allocation holding all arrays above when they come from allocate(), null if they were allocated one by one
+		unsigned char* block;
+	};
+	// What to keep of the CPU copy of the mesh data once the GPU buffers are created
+	enum CPUDataPolicy {
+		KEEP_CPU_DATA,
+		// Enough for picking and collision
+		KEEP_POSITIONS_AND_INDICES,
+		RELEASE_CPU_DATA
 	};
 
 public:
+	// The mesh takes over the arrays of the data
 	static Mesh* Create(Data& buildData, Shader* shader);
 	Mesh(Data& buildData, Shader* shader);
 	virtual ~Mesh();
 
-	virtual void draw(const Renderer& renderer, void* cmdList = nullptr) = 0;
+	virtual void draw(const Renderer& renderer, void* cmdList = nullptr, unsigned int numInstances = 1) = 0;
 
 	Material* getMaterial();
 
@@ -61,6 +104,20 @@ public:
 	unsigned int getNumInstances() const;
 	const VertexBuffer& getVertexBuffer() const;
 	const IndexBuffer& getIndexBuffer() const;
+	// Bounding box in model space
+	const glm::vec3& getBoundsMin() const;
+	const glm::vec3& getBoundsMax() const;
+	// CPU copy of the mesh data, arrays released by the policy are null
+	const Data& getData() const;
+	// Bytes held by the CPU copy and by the vertex and index buffers
+	size_t getCPUMemoryUsage() const;
+	size_t getGPUMemoryUsage() const;
+
+	// Frees the parts of the CPU copy the policy does not keep, can be called any time after the mesh is created
+	void releaseCPUData(CPUDataPolicy policy);
+	// Policy applied to every mesh when its buffers have been created, meshes keep all data by default
+	static void SetDefaultCPUDataPolicy(CPUDataPolicy policy);
+	static CPUDataPolicy GetDefaultCPUDataPolicy();
 
 protected:
 	Material::SPtr material;
@@ -68,5 +125,10 @@ protected:
 	std::unique_ptr<VertexBuffer> vertexBuffer;
 	std::unique_ptr<IndexBuffer> indexBuffer;
 	Data meshData;
+	glm::vec3 boundsMin;
+	glm::vec3 boundsMax;
+
+private:
+	static CPUDataPolicy s_defaultCPUDataPolicy;
 
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "pch.h"
+#include "RenderStateCache.h"
+
+RenderStateCache::RenderStateCache() {
+	invalidate();
+}
+
+RenderStateCache::~RenderStateCache() {
+
+}
+
+void RenderStateCache::invalidate() {
+	m_pipeline = nullptr;
+	for (auto& it : m_cbuffers) it.valid = false;
+	for (auto& it : m_textures) it.valid = false;
+	for (auto& it : m_samplers) it.valid = false;
+	m_depthMask = -1;
+	m_faceCulling = -1;
+	m_blending = -1;
+}
+
+bool RenderStateCache::setPipeline(const void* pipeline) {
+	if (pipeline && m_pipeline == pipeline) {
+		m_stats.pipelineSkips++;
+		return false;
+	}
+	m_pipeline = pipeline;
+	m_stats.pipelineBinds++;
+	return true;
+}
+
+bool RenderStateCache::setCBuffer(unsigned int slot, unsigned int bindShader, uint64_t handle) {
+	return setSlot(m_cbuffers, MAX_CBUFFER_SLOTS, slot, bindShader, handle, m_stats.cbufferBinds, m_stats.cbufferSkips);
+}
+
+bool RenderStateCache::setTexture(unsigned int slot, unsigned int bindShader, uint64_t handle, uint64_t resource) {
+	if (!setSlot(m_textures, MAX_TEXTURE_SLOTS, slot, bindShader, handle, m_stats.textureBinds, m_stats.textureSkips))
+		return false;
+	if (slot < MAX_TEXTURE_SLOTS)
+		m_textureResources[slot] = resource;
+	return true;
+}
+
+bool RenderStateCache::setSampler(unsigned int slot, unsigned int bindShader, uint64_t handle) {
+	return setSlot(m_samplers, MAX_SAMPLER_SLOTS, slot, bindShader, handle, m_stats.samplerBinds, m_stats.samplerSkips);
+}
+
+bool RenderStateCache::setDepthMask(GraphicsAPI::DepthMask setting) {
+	return setRenderState(m_depthMask, setting);
+}
+
+bool RenderStateCache::setFaceCulling(GraphicsAPI::Culling setting) {
+	return setRenderState(m_faceCulling, setting);
+}
+
+bool RenderStateCache::setBlending(GraphicsAPI::Blending setting) {
+	return setRenderState(m_blending, setting);
+}
+
+void RenderStateCache::unbindResource(uint64_t resource) {
+	if (resource == 0)
+		return;
+	for (unsigned int i = 0; i < MAX_TEXTURE_SLOTS; i++) {
+		if (m_textures[i].valid && m_textureResources[i] == resource)
+			m_textures[i].valid = false;
+	}
+}
+
+const RenderStateCache::Stats& RenderStateCache::getStats() const {
+	return m_stats;
+}
+
+void RenderStateCache::resetStats() {
+	m_stats = Stats();
+}
+
+bool RenderStateCache::setSlot(SlotState* slots, unsigned int numSlots, unsigned int slot, unsigned int bindShader, uint64_t handle, unsigned int& binds, unsigned int& skips) {
+	// Slots outside of the tracked range are always bound
+	if (slot >= numSlots) {
+		binds++;
+		return true;
+	}
+	SlotState& state = slots[slot];
+	if (state.valid && state.handle == handle && state.bindShader == bindShader) {
+		skips++;
+		return false;
+	}
+	state.handle = handle;
+	state.bindShader = bindShader;
+	state.valid = true;
+	binds++;
+	return true;
+}
+
+bool RenderStateCache::setRenderState(int& current, int setting) {
+	if (current == setting) {
+		m_stats.renderStateSkips++;
+		return false;
+	}
+	current = setting;
+	m_stats.renderStateBinds++;
+	return true;
+}
+
+unsigned int RenderStateCache::Stats::totalBinds() const {
+	return pipelineBinds + cbufferBinds + textureBinds + samplerBinds + renderStateBinds;
+}
+
+unsigned int RenderStateCache::Stats::totalSkips() const {
+	return pipelineSkips + cbufferSkips + textureSkips + samplerSkips + renderStateSkips;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include "GraphicsAPI.h"
+
+// Keeps track of the currently bound pipeline state and filters out redundant binds
+// The state is stored as opaque handles, which makes it usable by all APIs
+// Each set method returns true if the state changed and the actual bind has to be made
+class RenderStateCache {
+public:
+	static const unsigned int MAX_CBUFFER_SLOTS = 16;
+	static const unsigned int MAX_TEXTURE_SLOTS = 32;
+	static const unsigned int MAX_SAMPLER_SLOTS = 16;
+
+	// Number of binds that were made and skipped since the last resetStats()
+	struct Stats {
+		unsigned int pipelineBinds = 0;
+		unsigned int pipelineSkips = 0;
+		unsigned int cbufferBinds = 0;
+		unsigned int cbufferSkips = 0;
+		unsigned int textureBinds = 0;
+		unsigned int textureSkips = 0;
+		unsigned int samplerBinds = 0;
+		unsigned int samplerSkips = 0;
+		unsigned int renderStateBinds = 0; // Blend, depth and cull state changes
+		unsigned int renderStateSkips = 0;
+
+		unsigned int totalBinds() const;
+		unsigned int totalSkips() const;
+	};
+
+public:
+	RenderStateCache();
+	~RenderStateCache();
+
+	// Forgets all bound state, the next bind of everything will go through
+	// Call this when the state might have been changed outside of the cache (new command list, ImGui, etc.)
+	void invalidate();
+
+	bool setPipeline(const void* pipeline);
+	bool setCBuffer(unsigned int slot, unsigned int bindShader, uint64_t handle);
+	// resource identifies what the view reads from, so that unbindResource can find every view of it
+	bool setTexture(unsigned int slot, unsigned int bindShader, uint64_t handle, uint64_t resource = 0);
+	bool setSampler(unsigned int slot, unsigned int bindShader, uint64_t handle);
+	bool setDepthMask(GraphicsAPI::DepthMask setting);
+	bool setFaceCulling(GraphicsAPI::Culling setting);
+	bool setBlending(GraphicsAPI::Blending setting);
+	// Forgets the texture slots reading from the resource
+	// D3D11 silently unbinds those views when the resource is bound as a render target, depth stencil or UAV,
+	// the cache would otherwise skip the next bind of the same view
+	void unbindResource(uint64_t resource);
+
+	const Stats& getStats() const;
+	void resetStats();
+
+private:
+	struct SlotState {
+		uint64_t handle;
+		unsigned int bindShader;
+		bool valid;
+	};
+	bool setSlot(SlotState* slots, unsigned int numSlots, unsigned int slot, unsigned int bindShader, uint64_t handle, unsigned int& binds, unsigned int& skips);
+	bool setRenderState(int& current, int setting);
+
+private:
+	const void* m_pipeline;
+	SlotState m_cbuffers[MAX_CBUFFER_SLOTS];
+	SlotState m_textures[MAX_TEXTURE_SLOTS];
+	uint64_t m_textureResources[MAX_TEXTURE_SLOTS];
+	SlotState m_samplers[MAX_SAMPLER_SLOTS];
+	// -1 means unknown
+	int m_depthMask;
+	int m_faceCulling;
+	int m_blending;
+
+	Stats m_stats;
+
+};
\ No newline at end of file
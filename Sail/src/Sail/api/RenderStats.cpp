@@ -0,0 +1,142 @@
+#include "pch.h"
+#include "RenderStats.h"
+#include "imgui.h"
+#include <algorithm>
+
+RenderStats::RenderStats()
+	: m_next(0)
+{
+	m_history.reserve(HISTORY_SIZE);
+}
+
+RenderStats::~RenderStats() {
+
+}
+
+void RenderStats::add(Counter counter, unsigned int value) {
+	m_current.values[counter] += value;
+}
+
+void RenderStats::addDraw(unsigned int numElements, unsigned int numInstances) {
+	m_current.values[DRAW_CALLS]++;
+	m_current.values[INSTANCES] += numInstances;
+	m_current.values[TRIANGLES] += numElements / 3 * numInstances;
+}
+
+void RenderStats::endFrame(RenderStateCache& stateCache) {
+	const RenderStateCache::Stats& binds = stateCache.getStats();
+	m_current.values[PIPELINE_BINDS] += binds.pipelineBinds;
+	m_current.values[CBUFFER_BINDS] += binds.cbufferBinds;
+	m_current.values[TEXTURE_BINDS] += binds.textureBinds;
+	m_current.values[SAMPLER_BINDS] += binds.samplerBinds;
+	m_current.values[RENDER_STATE_CHANGES] += binds.renderStateBinds;
+	m_current.values[SKIPPED_BINDS] += binds.totalSkips();
+	stateCache.resetStats();
+
+	if (m_history.size() < HISTORY_SIZE)
+		m_history.push_back(m_current);
+	else
+		m_history[m_next] = m_current;
+	m_next = (m_next + 1) % HISTORY_SIZE;
+
+	m_last = m_current;
+	m_current = FrameStats();
+}
+
+void RenderStats::clearHistory() {
+	m_history.clear();
+	m_next = 0;
+}
+
+const RenderStats::FrameStats& RenderStats::getLastFrame() const {
+	return m_last;
+}
+
+const RenderStats::FrameStats& RenderStats::getCurrentFrame() const {
+	return m_current;
+}
+
+unsigned int RenderStats::getNumFrames() const {
+	return (unsigned int)m_history.size();
+}
+
+float RenderStats::getAverage(Counter counter) const {
+	if (m_history.empty())
+		return 0.f;
+	double sum = 0.0;
+	for (const FrameStats& frame : m_history)
+		sum += frame.values[counter];
+	return (float)(sum / m_history.size());
+}
+
+unsigned int RenderStats::getPercentile(Counter counter, float percentile) const {
+	if (m_history.empty())
+		return 0;
+	m_sortScratch.resize(m_history.size());
+	for (unsigned int i = 0; i < m_history.size(); i++)
+		m_sortScratch[i] = m_history[i].values[counter];
+	unsigned int rank = Utils::percentileRank((unsigned int)m_sortScratch.size(), percentile);
+	std::nth_element(m_sortScratch.begin(), m_sortScratch.begin() + rank, m_sortScratch.end());
+	return m_sortScratch[rank];
+}
+
+unsigned int RenderStats::getMax(Counter counter) const {
+	unsigned int max = 0;
+	for (const FrameStats& frame : m_history)
+		max = std::max(max, frame.values[counter]);
+	return max;
+}
+
+const char* RenderStats::GetCounterName(Counter counter) {
+	static const char* names[NUM_COUNTERS] = {
+		"Draw calls",
+		"Instances",
+		"Triangles",
+		"Submitted objects",
+		"Culled objects",
+		"Material binds",
+		"CBuffer updates",
+		"CBuffer upload bytes",
+		"Buffer upload bytes",
+		"Descriptors used",
+		"Pipeline binds",
+		"CBuffer binds",
+		"Texture binds",
+		"Sampler binds",
+		"Render state changes",
+		"Skipped binds"
+	};
+	return names[counter];
+}
+
+void RenderStats::drawImGui() {
+	if (!ImGui::Begin("Render stats")) {
+		ImGui::End();
+		return;
+	}
+
+	ImGui::Text("%u frames", getNumFrames());
+	ImGui::SameLine();
+	if (ImGui::Button("Reset"))
+		clearHistory();
+	ImGui::Separator();
+
+	ImGui::Columns(5, "renderstats");
+	ImGui::Text("Counter"); ImGui::NextColumn();
+	ImGui::Text("Last"); ImGui::NextColumn();
+	ImGui::Text("Avg"); ImGui::NextColumn();
+	ImGui::Text("p95"); ImGui::NextColumn();
+	ImGui::Text("Max"); ImGui::NextColumn();
+	ImGui::Separator();
+	for (unsigned int i = 0; i < NUM_COUNTERS; i++) {
+		Counter counter = (Counter)i;
+		ImGui::Text("%s", GetCounterName(counter)); ImGui::NextColumn();
+		ImGui::Text("%u", m_last[counter]); ImGui::NextColumn();
+		ImGui::Text("%.1f", getAverage(counter)); ImGui::NextColumn();
+		ImGui::Text("%u", getPercentile(counter, 0.95f)); ImGui::NextColumn();
+		ImGui::Text("%u", getMax(counter)); ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+
+	ImGui::End();
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include "RenderStateCache.h"
+
+// Per frame rendering counters with a short history for rolling averages and percentiles
+// Counters are added to during the frame by the renderers, meshes, materials and shader pipelines
+// endFrame() moves the current counters into the history, together with the binds made through the RenderStateCache
+class RenderStats {
+public:
+	enum Counter {
+		DRAW_CALLS,
+		INSTANCES,
+		TRIANGLES,
+		SUBMITTED_OBJECTS,
+		CULLED_OBJECTS,
+		MATERIAL_BINDS,
+		CBUFFER_UPDATES, // Calls to ShaderPipeline::setCBufferVar and shared cbuffer uploads
+		CBUFFER_UPLOAD_BYTES, // Bytes written to GPU visible memory, counted by the backend that writes them
+		BUFFER_UPLOAD_BYTES, // Same for structured buffers, such as the world matrices
+		DESCRIPTORS_USED,
+		PIPELINE_BINDS,
+		CBUFFER_BINDS,
+		TEXTURE_BINDS,
+		SAMPLER_BINDS,
+		RENDER_STATE_CHANGES,
+		SKIPPED_BINDS, // Redundant binds filtered out by the state cache
+		NUM_COUNTERS
+	};
+	struct FrameStats {
+		unsigned int values[NUM_COUNTERS] = {};
+		unsigned int operator[](Counter counter) const { return values[counter]; }
+	};
+
+	// Number of frames kept for averages and percentiles
+	static const unsigned int HISTORY_SIZE = 240;
+
+public:
+	RenderStats();
+	~RenderStats();
+
+	void add(Counter counter, unsigned int value = 1);
+	// numElements is the number of indices, or vertices for non-indexed draws
+	void addDraw(unsigned int numElements, unsigned int numInstances);
+
+	// Finishes the current frame, takes and resets the bind counters of the state cache
+	void endFrame(RenderStateCache& stateCache);
+	void clearHistory();
+
+	// Counters of the last finished frame
+	const FrameStats& getLastFrame() const;
+	// Counters of the frame in progress
+	const FrameStats& getCurrentFrame() const;
+	unsigned int getNumFrames() const;
+	float getAverage(Counter counter) const;
+	// percentile in [0, 1] over the frames in the history
+	unsigned int getPercentile(Counter counter, float percentile) const;
+	unsigned int getMax(Counter counter) const;
+
+	static const char* GetCounterName(Counter counter);
+	void drawImGui();
+
+private:
+	FrameStats m_current;
+	FrameStats m_last;
+	// Ring buffer of finished frames, m_next is where the next frame is written
+	std::vector<FrameStats> m_history;
+	unsigned int m_next;
+	mutable std::vector<unsigned int> m_sortScratch;
+
+};
\ No newline at end of file
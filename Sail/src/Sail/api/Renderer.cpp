@@ -1,10 +1,41 @@
 #include "pch.h"
 #include "Renderer.h"
 #include "Sail/graphics/geometry/Model.h"
+#include "Sail/graphics/light/LightSetup.h"
+#include "Sail/graphics/camera/Camera.h"
+#include "Sail/graphics/shader/Shader.h"
+#include "Sail/utils/Profiler.h"
+#include "Sail/api/RenderStats.h"
+#include "Sail/Application.h"
+
+Renderer::Renderer()
+	: camera(nullptr)
+	, lightSetup(nullptr)
+	, m_lightGridDirty(false)
+	, m_lightVersion(0)
+	, m_passDirtyBegin(0)
+	, m_passDirtyEnd(0)
+	, m_passDirtyFrames(0)
+{
+	m_numFramesInFlight = Application::getInstance()->getAPI()->getNumFramesInFlight();
+
+	auto bindShader = ShaderComponent::BIND_SHADER(ShaderComponent::VS | ShaderComponent::PS);
+
+	FrameCBufferData frameData = {};
+	frameCBuffer = std::unique_ptr<ShaderComponent::ConstantBuffer>(ShaderComponent::ConstantBuffer::Create(&frameData, sizeof(frameData), bindShader, ShaderComponent::PER_FRAME));
+
+	// The pass cbuffer contains the directional light followed by the point lights
+	unsigned int passSize = sizeof(LightSetup::DirLightBuffer) + sizeof(LightSetup::PointLightsBuffer);
+	m_passData.resize(passSize, 0);
+	passCBuffer = std::unique_ptr<ShaderComponent::ConstantBuffer>(ShaderComponent::ConstantBuffer::Create(m_passData.data(), passSize, bindShader, ShaderComponent::PER_PASS));
+}
 
 void Renderer::begin(Camera* camera) {
 	this->camera = camera;
 	commandQueue.clear();
+	// Reserve view 0 for the camera, its frustum is set in end() when the camera has its final transform
+	culler.clear();
+	culler.addView(nullptr, 0);
 }
 
 void Renderer::submit(Model* model, const glm::mat4& modelMatrix) {
@@ -14,16 +45,140 @@ void Renderer::submit(Model* model, const glm::mat4& modelMatrix) {
 }
 
 void Renderer::submit(Mesh* mesh, const glm::mat4& modelMatrix) {
-	RenderCommand cmd;
+	RenderCommand cmd = {};
 	cmd.mesh = mesh;
-	cmd.transform = glm::transpose(modelMatrix);
+	cmd.transform = modelMatrix;
 	commandQueue.push_back(cmd);
 }
 
 void Renderer::setLightSetup(LightSetup* lightSetup) {
 	this->lightSetup = lightSetup;
+	// Upload everything from the new setup
+	m_passDirtyBegin = 0;
+	m_passDirtyEnd = (unsigned int)m_passData.size();
+	m_passDirtyFrames = m_numFramesInFlight;
+	m_lightVersion = (lightSetup) ? lightSetup->getVersion() : 0;
 }
 
 void Renderer::end() {
+	SAIL_PROFILE_FUNCTION();
+
+	// Transform the model space bounds to world space boxes and test them against the camera frustum
+	// Meshes outside of it are then removed from the queue
+	{
+		SAIL_PROFILE_SCOPE("Renderer::cull");
+		Frustum frustum;
+		frustum.extractPlanes(camera->getViewProjection());
+		culler.setView(0, frustum);
+
+		for (RenderCommand& command : commandQueue) {
+			const glm::mat4& world = command.transform;
+			glm::vec3 center = (command.mesh->getBoundsMin() + command.mesh->getBoundsMax()) * 0.5f;
+			glm::vec3 extents = (command.mesh->getBoundsMax() - command.mesh->getBoundsMin()) * 0.5f;
+			glm::mat3 absRotation(glm::abs(glm::vec3(world[0])), glm::abs(glm::vec3(world[1])), glm::abs(glm::vec3(world[2])));
+			glm::vec3 worldCenter = glm::vec3(world * glm::vec4(center, 1.f));
+			glm::vec3 worldExtents = absRotation * extents;
+			command.boundsMin = worldCenter - worldExtents;
+			command.boundsMax = worldCenter + worldExtents;
+			command.viewMask = culler.getMask(command.boundsMin, command.boundsMax);
+		}
+
+		unsigned int numVisible = 0;
+		for (RenderCommand& command : commandQueue) {
+			if (command.viewMask & 1)
+				commandQueue[numVisible++] = command;
+		}
+
+		RenderStats& stats = Application::getInstance()->getAPI()->getRenderStats();
+		stats.add(RenderStats::SUBMITTED_OBJECTS, (unsigned int)commandQueue.size());
+		stats.add(RenderStats::CULLED_OBJECTS, (unsigned int)commandQueue.size() - numVisible);
+		commandQueue.resize(numVisible);
+	}
+
+	// Sort meshes by shader and then by material
+	// This groups all draws using the same material, which means the material constants only have to be uploaded once
+	std::sort(commandQueue.begin(), commandQueue.end(), [](const RenderCommand& a, const RenderCommand& b) {
+		ShaderPipeline* pipelineA = a.mesh->getMaterial()->getShader()->getPipeline();
+		ShaderPipeline* pipelineB = b.mesh->getMaterial()->getShader()->getPipeline();
+		if (pipelineA != pipelineB)
+			return pipelineA < pipelineB;
+		return a.mesh->getMaterial() < b.mesh->getMaterial();
+	});
+
+	m_lightGridDirty = true;
+
+	gatherWorldMatrices();
+}
+
+const LightGrid& Renderer::getLightGrid() {
+	if (m_lightGridDirty) {
+		// Assign all point lights to the clusters of the view frustum
+		SAIL_PROFILE_SCOPE("LightGrid::build");
+		static const std::vector<PointLight> noLights;
+		lightGrid.build(camera->getViewMatrix(), camera->getProjMatrix(), (lightSetup) ? lightSetup->getPLs() : noLights);
+		m_lightGridDirty = false;
+	}
+	return lightGrid;
+}
 
+const std::vector<glm::mat4>& Renderer::getWorldMatrices() const {
+	return worldMatrices;
 }
+
+void Renderer::gatherWorldMatrices() {
+	SAIL_PROFILE_FUNCTION();
+	// A straight copy into one contiguous array, which backends can upload with a single memcpy
+	worldMatrices.resize(commandQueue.size());
+	for (size_t i = 0; i < commandQueue.size(); i++)
+		worldMatrices[i] = commandQueue[i].transform;
+}
+
+void Renderer::updateSharedCBuffers() {
+	FrameCBufferData frameData = {};
+	frameData.mVP = camera->getViewProjection();
+	frameData.cameraPos = camera->getPosition();
+	const LightGrid& grid = getLightGrid();
+	frameData.lightGridSize = glm::uvec4(grid.getNumTilesX(), grid.getNumTilesY(), grid.getNumSlices(), 0);
+	frameData.lightGridDepth = glm::vec4(grid.getNearZ(), grid.getNumSlices() / std::log(grid.getFarZ() / grid.getNearZ()), 0.f, 0.f);
+	frameCBuffer->updateData(&frameData, sizeof(frameData));
+	RenderStats& stats = Application::getInstance()->getAPI()->getRenderStats();
+	stats.add(RenderStats::CBUFFER_UPDATES);
+
+	if (!lightSetup)
+		return;
+
+	// Add the lights changed since the last upload to the range that needs uploading
+	const unsigned int plOffset = sizeof(LightSetup::DirLightBuffer);
+	const unsigned int plSize = sizeof(LightSetup::PointLightStruct);
+	bool dirLightChanged;
+	unsigned int first, count;
+	if (lightSetup->getChangesSince(m_lightVersion, dirLightChanged, first, count)) {
+		unsigned int begin = (dirLightChanged) ? 0 : plOffset + first * plSize;
+		unsigned int end = (count > 0) ? plOffset + (first + count) * plSize : plOffset;
+		if (m_passDirtyFrames > 0) {
+			begin = std::min(begin, m_passDirtyBegin);
+			end = std::max(end, m_passDirtyEnd);
+		}
+		m_passDirtyBegin = begin;
+		m_passDirtyEnd = end;
+		m_passDirtyFrames = m_numFramesInFlight;
+	}
+	m_lightVersion = lightSetup->getVersion();
+	if (m_passDirtyFrames == 0)
+		return;
+	m_passDirtyFrames--;
+
+	// Gather the dirty range from the directional and point light buffers, then upload it with a single update
+	auto& dlData = lightSetup->getDirLightData();
+	auto& plData = lightSetup->getPointLightsData();
+	if (m_passDirtyBegin < plOffset) {
+		unsigned int dlEnd = std::min(m_passDirtyEnd, plOffset);
+		memcpy(&m_passData[m_passDirtyBegin], (const char*)&dlData + m_passDirtyBegin, dlEnd - m_passDirtyBegin);
+	}
+	if (m_passDirtyEnd > plOffset) {
+		unsigned int plBegin = std::max(m_passDirtyBegin, plOffset);
+		memcpy(&m_passData[plBegin], (const char*)&plData + (plBegin - plOffset), m_passDirtyEnd - plBegin);
+	}
+	passCBuffer->updateData(&m_passData[m_passDirtyBegin], m_passDirtyEnd - m_passDirtyBegin, m_passDirtyBegin);
+	stats.add(RenderStats::CBUFFER_UPDATES);
+}
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <memory>
 #include "Sail/events/Events.h"
+#include "Sail/api/shader/ConstantBuffer.h"
+#include "Sail/graphics/light/LightGrid.h"
+#include "Sail/graphics/geometry/spatial/MultiFrustumCuller.h"
 
 class Mesh;
 class Camera;
@@ -19,6 +23,7 @@ public:
 	};
 public:
 	static Renderer* Create(Renderer::Type type);
+	Renderer();
 	virtual ~Renderer() {}
 
 	virtual void begin(Camera* camera);
@@ -29,14 +34,62 @@ public:
 	virtual void present(RenderableTexture* output = nullptr) = 0;
 	virtual bool onEvent(Event& event) override { return true; };
 
+	// Clustered point light lists, built on the first call after end()
+	// Backends upload it for the material shader's light loop, updateSharedCBuffers() fills in the grid constants
+	const LightGrid& getLightGrid();
+	// World matrices of the visible meshes in draw order, gathered in end()
+	const std::vector<glm::mat4>& getWorldMatrices() const;
+
+protected:
+	// Uploads the per frame (camera) and per pass (lights) constant data
+	// This only has to be done once per frame, the buffers are then shared by all draws
+	void updateSharedCBuffers();
+	// Copies the world matrix of every command into worldMatrices
+	void gatherWorldMatrices();
+
 protected:
 	struct RenderCommand {
 		Mesh* mesh;
-		glm::mat4 transform; // TODO: find out why having a const ptr here doesnt work
+		glm::mat4 transform; // Model matrix, uploaded as is
+		glm::vec3 boundsMin; // World space bounds, calculated in end()
+		glm::vec3 boundsMax;
+		unsigned int viewMask; // Bit 0 is set if the mesh is visible from the camera
+	};
+	// Matching shader cbuffer at register PER_FRAME
+	struct FrameCBufferData {
+		glm::mat4 mVP;
+		glm::vec4 clippingPlane;
+		glm::vec3 cameraPos;
+		float padding;
+		glm::uvec4 lightGridSize; // Tiles in x and y and the number of depth slices
+		glm::vec4 lightGridDepth; // Near z and slices per unit of log(viewZ / near)
 	};
 
 	std::vector<RenderCommand> commandQueue;
+	// Matrix i belongs to commandQueue[i], which lets APIs upload all of them with a single copy and index them with a draw id
+	// The array is contiguous and 16 byte aligned, matching a shader StructuredBuffer<float4x4>
+	std::vector<glm::mat4> worldMatrices;
 	Camera* camera;
 	LightSetup* lightSetup;
+	LightGrid lightGrid;
+	// Holds the camera as view 0, nothing else is drawn from other views yet
+	MultiFrustumCuller culler;
+
+	std::unique_ptr<ShaderComponent::ConstantBuffer> frameCBuffer;
+	std::unique_ptr<ShaderComponent::ConstantBuffer> passCBuffer;
+
+private:
+	// Set in end(), the grid is out of date until getLightGrid() builds it
+	bool m_lightGridDirty;
+	// Frames changed constant data is uploaded for, from GraphicsAPI::getNumFramesInFlight()
+	unsigned int m_numFramesInFlight;
+	// Light setup version in the pass cbuffer, kept per renderer so renderers can share a setup
+	uint64_t m_lightVersion;
+	// Byte range of the pass cbuffer that still needs to be uploaded
+	unsigned int m_passDirtyBegin;
+	unsigned int m_passDirtyEnd;
+	unsigned int m_passDirtyFrames;
+	// The directional and point light data side by side, which lets the dirty range go up in one update
+	std::vector<unsigned char> m_passData;
 
 };
\ No newline at end of file
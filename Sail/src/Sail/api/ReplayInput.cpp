@@ -0,0 +1,150 @@
+#include "pch.h"
+#include "ReplayInput.h"
+#include "Sail/utils/Utils.h"
+#include <fstream>
+
+ReplayInput::ReplayInput()
+	: m_header{}
+	, m_readOffset(0)
+	, m_nextRecordFrame(0xFFFFFFFF)
+	, m_frame(0xFFFFFFFF)
+	, m_cursorHidden(false)
+	, m_mousePos(0, 0)
+	, m_mouseDelta(0, 0)
+	, m_mouseButtons{ false }
+	, m_keys{ false }
+	, m_frameMouseButtons{ false }
+	, m_frameKeys{ false }
+{
+}
+
+ReplayInput::~ReplayInput() {}
+
+bool ReplayInput::load(const std::string& path) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		Logger::Warning("Could not open input recording " + path);
+		return false;
+	}
+	size_t size = (size_t)file.tellg();
+	file.seekg(0);
+	if (size < sizeof(InputRecorder::FileHeader)) {
+		Logger::Warning("Input recording " + path + " is too small");
+		return false;
+	}
+	file.read((char*)&m_header, sizeof(m_header));
+	if (m_header.magic != InputRecorder::FILE_MAGIC || m_header.version != InputRecorder::FILE_VERSION) {
+		Logger::Warning("Input recording " + path + " has an unknown format");
+		return false;
+	}
+	m_data.resize(size - sizeof(m_header));
+	file.read(m_data.data(), m_data.size());
+
+	m_readOffset = 0;
+	uint32_t frame;
+	m_nextRecordFrame = read(frame) ? frame : 0xFFFFFFFF;
+	m_frame = 0xFFFFFFFF;
+	return true;
+}
+
+float ReplayInput::getDeltaTime() const {
+	return m_header.deltaTime;
+}
+
+unsigned int ReplayInput::getNumFrames() const {
+	return m_header.numFrames;
+}
+
+unsigned int ReplayInput::getFrameIndex() const {
+	return m_frame;
+}
+
+bool ReplayInput::isFinished() const {
+	return m_frame != 0xFFFFFFFF && m_frame + 1 >= m_header.numFrames;
+}
+
+bool ReplayInput::isKeyPressedImpl(int keycode) {
+	return m_keys[keycode];
+}
+
+bool ReplayInput::wasKeyJustPressedImpl(int keycode) {
+	return m_frameKeys[keycode];
+}
+
+bool ReplayInput::isMouseButtonPressedImpl(int button) {
+	return m_mouseButtons[button];
+}
+
+bool ReplayInput::wasMouseButtonJustPressedImpl(int button) {
+	return m_frameMouseButtons[button];
+}
+
+glm::ivec2 ReplayInput::getMousePositionImpl() {
+	return m_mousePos;
+}
+
+glm::ivec2 ReplayInput::getMouseDeltaImpl() {
+	return m_mouseDelta;
+}
+
+void ReplayInput::hideCursorImpl(bool hide) {
+	// The application toggles the cursor the same way as when recording, no need to store it
+	m_cursorHidden = hide;
+}
+
+bool ReplayInput::isCursorHiddenImpl() {
+	return m_cursorHidden;
+}
+
+void ReplayInput::beginFrame() {
+	m_frame++;
+	m_mouseDelta = glm::ivec2(0, 0);
+	if (m_frame != m_nextRecordFrame)
+		return;
+
+	uint8_t flags = 0;
+	uint16_t numEvents = 0;
+	bool valid = read(flags) && read(numEvents);
+	int16_t x, y;
+	if (valid && (flags & InputRecorder::HAS_MOUSE_DELTA)) {
+		valid = read(x) && read(y);
+		m_mouseDelta = glm::ivec2(x, y);
+	}
+	if (valid && (flags & InputRecorder::HAS_MOUSE_POSITION)) {
+		valid = read(x) && read(y);
+		m_mousePos = glm::ivec2(x, y);
+	}
+	for (unsigned int i = 0; valid && i < numEvents; i++) {
+		uint8_t type, code;
+		valid = read(type) && read(code);
+		if (!valid)
+			break;
+		switch (type) {
+		case InputRecorder::KEY_DOWN: m_keys[code] = true; break;
+		case InputRecorder::KEY_UP: m_keys[code] = false; break;
+		case InputRecorder::KEY_JUST_PRESSED: m_frameKeys[code] = true; break;
+		case InputRecorder::BUTTON_DOWN: if (code < SAIL_NUM_MOUSE_BUTTONS) m_mouseButtons[code] = true; break;
+		case InputRecorder::BUTTON_UP: if (code < SAIL_NUM_MOUSE_BUTTONS) m_mouseButtons[code] = false; break;
+		case InputRecorder::BUTTON_JUST_PRESSED: if (code < SAIL_NUM_MOUSE_BUTTONS) m_frameMouseButtons[code] = true; break;
+		}
+	}
+	if (!valid)
+		Logger::Warning("Input recording is truncated at frame " + std::to_string(m_frame));
+
+	uint32_t frame;
+	m_nextRecordFrame = (valid && read(frame)) ? frame : 0xFFFFFFFF;
+}
+
+void ReplayInput::endFrame() {
+	std::fill(m_frameMouseButtons, m_frameMouseButtons + SAIL_NUM_MOUSE_BUTTONS, false);
+	std::fill(m_frameKeys, m_frameKeys + SAIL_NUM_KEYS, false);
+}
+
+template<typename T>
+bool ReplayInput::read(T& value) {
+	if (m_readOffset + sizeof(T) > m_data.size())
+		return false;
+	memcpy(&value, m_data.data() + m_readOffset, sizeof(T));
+	m_readOffset += sizeof(T);
+	return true;
+}
\ No newline at end of file
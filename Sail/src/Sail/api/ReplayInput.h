@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Input.h"
+#include "InputRecorder.h"
+
+// Plays back a file written by InputRecorder, frame by frame
+// Does not depend on a window, which makes it usable for headless benchmark runs
+class ReplayInput : public Input {
+public:
+	ReplayInput();
+	~ReplayInput();
+
+	// Returns false if the file could not be read or has an unknown format
+	bool load(const std::string& path);
+
+	// Timestep the recording was made with, the application should step with it while replaying
+	float getDeltaTime() const;
+	unsigned int getNumFrames() const;
+	unsigned int getFrameIndex() const;
+	bool isFinished() const;
+
+private:
+	template<typename T>
+	bool read(T& value);
+
+private:
+	InputRecorder::FileHeader m_header;
+	std::vector<char> m_data;
+	size_t m_readOffset;
+	// Frame of the next unread record
+	unsigned int m_nextRecordFrame;
+	// Increased in beginFrame(), the first frame has index 0
+	unsigned int m_frame;
+
+	bool m_cursorHidden;
+	glm::ivec2 m_mousePos;
+	glm::ivec2 m_mouseDelta;
+	bool m_mouseButtons[SAIL_NUM_MOUSE_BUTTONS];
+	bool m_keys[SAIL_NUM_KEYS];
+	// frame_ contains keys and buttons pressed this frame
+	bool m_frameMouseButtons[SAIL_NUM_MOUSE_BUTTONS];
+	bool m_frameKeys[SAIL_NUM_KEYS];
+
+protected:
+	virtual bool isKeyPressedImpl(int keycode) override;
+	virtual bool wasKeyJustPressedImpl(int keycode) override;
+
+	virtual bool isMouseButtonPressedImpl(int button) override;
+	virtual bool wasMouseButtonJustPressedImpl(int button) override;
+
+	virtual glm::ivec2 getMousePositionImpl() override;
+	virtual glm::ivec2 getMouseDeltaImpl() override;
+
+	virtual void hideCursorImpl(bool hide) override;
+	virtual bool isCursorHiddenImpl() override;
+
+	virtual void beginFrame() override;
+	virtual void endFrame() override;
+
+};
\ No newline at end of file
@@ -4,8 +4,9 @@
 
 TextureData& Texture::getTextureData(const std::string& filename) const {
 	// Load the texture file it if is not loaded already
-	if (!Application::getInstance()->getResourceManager().hasTextureData(filename)) {
-		Application::getInstance()->getResourceManager().loadTextureData(filename);
+	ResourceID id(filename);
+	if (!Application::getInstance()->getResourceManager().hasTextureData(id)) {
+		Application::getInstance()->getResourceManager().loadTextureData(id);
 	}
-	return Application::getInstance()->getResourceManager().getTextureData(filename);
+	return Application::getInstance()->getResourceManager().getTextureData(id);
 }
@@ -2,6 +2,7 @@
 
 #include <string.h>
 #include "Sail/resources/TextureData.h"
+#include "Sail/resources/ResourceHandle.h"
 
 class Texture {
 public:
@@ -33,4 +34,6 @@ public:
 protected:
 	TextureData& getTextureData(const std::string& filename) const;
 
-};
\ No newline at end of file
+};
+
+typedef ResourceHandle<Texture> TextureHandle;
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "VertexBuffer.h"
+#include "VertexPacker.h"
 #include "Sail/utils/Utils.h"
 
 VertexBuffer::VertexBuffer(const InputLayout& inputLayout, Mesh::Data& modelData) 
@@ -13,52 +14,37 @@ VertexBuffer::VertexBuffer(const InputLayout& inputLayout, Mesh::Data& modelData
 	m_byteSize = modelData.numVertices * m_stride;
 }
 
-void* VertexBuffer::getVertexData(Mesh::Data& modelData) {
-	void* vertices = malloc(modelData.numVertices * m_stride);
-
-	UINT byteOffset = 0;
-	for (UINT i = 0; i < modelData.numVertices; i++) {
-		// Loop through the input layout to get the order the data should have
-		for (const InputLayout::InputType& inputType : inputLayout.getOrderedInputs()) {
-			void* addr = (char*)vertices + byteOffset;
+const void* VertexBuffer::getVertexData(Mesh::Data& modelData) {
+	if (modelData.packedVertices && modelData.packedStride == m_stride)
+		return modelData.packedVertices;
+	void* vertices = malloc(m_byteSize);
+	writeVertexData(modelData, vertices);
+	return vertices;
+}
 
-			if (inputType == InputLayout::POSITION) {
-				UINT size = sizeof(glm::vec3);
-				memcpy(addr, &modelData.positions[i], size);
-				byteOffset += size;
-			} else if (inputType == InputLayout::TEXCOORD) {
-				UINT size = sizeof(glm::vec2);
-				// Check if model data contains texCoords
-				if (modelData.texCoords)
-					memcpy(addr, &modelData.texCoords[i], size);
-				else
-					memset(addr, 0, size);
-				byteOffset += size;
-			} else if (inputType == InputLayout::NORMAL) {
-				UINT size = sizeof(glm::vec3);
-				if (modelData.normals)
-					memcpy(addr, &modelData.normals[i], size);
-				else
-					memset(addr, 0, size);
-				byteOffset += size;
-			} else if (inputType == InputLayout::TANGENT) {
-				UINT size = sizeof(glm::vec3);
-				if (modelData.tangents)
-					memcpy(addr, &modelData.tangents[i], size);
-				else
-					memset(addr, 0, size);
-				byteOffset += size;
-			} else if (inputType == InputLayout::BITANGENT) {
-				UINT size = sizeof(glm::vec3);
-				if (modelData.bitangents)
-					memcpy(addr, &modelData.bitangents[i], size);
-				else
-					memset(addr, 0, size);
-				byteOffset += size;
-			}
+void VertexBuffer::writeVertexData(Mesh::Data& modelData, void* destination) {
+	if (modelData.packedVertices) {
+		if (modelData.packedStride == m_stride) {
+			memcpy(destination, modelData.packedVertices, m_byteSize);
+			return;
 		}
+		Logger::Error("Packed vertices have a stride of " + std::to_string(modelData.packedStride) + " bytes while the input layout needs " + std::to_string(m_stride));
+		memset(destination, 0, m_byteSize);
+		return;
 	}
-	return vertices;
+	VertexPacker packer(inputLayout.getOrderedInputs());
+	if (packer.getStride() != m_stride) {
+		Logger::Error("The input layout has a vertex size of " + std::to_string(m_stride) + " bytes while its inputs pack into " + std::to_string(packer.getStride()));
+		memset(destination, 0, m_byteSize);
+		return;
+	}
+	packer.pack(modelData, destination);
+}
+
+void VertexBuffer::freeVertexData(const void* vertices, Mesh::Data& modelData) {
+	// Packed vertices belong to whoever set them
+	if (vertices != modelData.packedVertices)
+		free(const_cast<void*>(vertices));
 }
 
 unsigned int VertexBuffer::getVertexDataSize() const {
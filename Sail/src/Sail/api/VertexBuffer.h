@@ -10,10 +10,15 @@ public:
 	virtual ~VertexBuffer() {};
 
 	virtual void bind(void* cmdList = nullptr) const = 0;
+	unsigned int getVertexDataSize() const;
 
 protected:
-	void* getVertexData(Mesh::Data& modelData);
-	unsigned int getVertexDataSize() const;
+	// Returns the packed vertices of the mesh data if it has any, otherwise they are interleaved into a new allocation
+	// Pass the result to freeVertexData() when it has been uploaded
+	const void* getVertexData(Mesh::Data& modelData);
+	// Writes the vertices into system memory that fits getVertexDataSize() bytes, copy them to write combined upload buffers afterwards
+	void writeVertexData(Mesh::Data& modelData, void* destination);
+	void freeVertexData(const void* vertices, Mesh::Data& modelData);
 	unsigned int getVertexDataStride() const;
 protected:
 	const InputLayout& inputLayout;
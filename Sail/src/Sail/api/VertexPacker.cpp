@@ -0,0 +1,194 @@
+#include "pch.h"
+#include "VertexPacker.h"
+#include "Sail/utils/Utils.h"
+#include <chrono>
+#include <cstring>
+#include <emmintrin.h>
+#include <random>
+#include <utility>
+
+namespace {
+	// Stands in for missing arrays, large enough for the widest load
+	alignas(16) const unsigned char ZEROS[16] = {};
+
+	// Copies that are wider than the input are fine inside a vertex since the inputs are written in order and the next one overwrites the extra bytes
+	// The last vertex is copied exactly to keep the loads and stores inside the arrays
+	template<unsigned int Size>
+	inline void copyWide(unsigned char* dst, const unsigned char* src) {
+		static_assert(Size == 8 || Size == 12, "Only vec2 and vec3 inputs have wide copies");
+		if (Size == 12)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+		else
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+	}
+
+	template<unsigned int... Sizes>
+	struct FixedLayout {
+		static const unsigned int NUM_INPUTS = sizeof...(Sizes);
+		static const unsigned int STRIDE = (Sizes + ...);
+		static constexpr unsigned int SIZES[NUM_INPUTS] = { Sizes... };
+
+		static constexpr unsigned int Offset(size_t input) {
+			unsigned int offset = 0;
+			for (size_t i = 0; i < input; i++)
+				offset += SIZES[i];
+			return offset;
+		}
+
+		template<size_t... I>
+		static void PackVertices(const VertexPacker::Source* sources, unsigned int numVertices, unsigned char* out, std::index_sequence<I...>) {
+			const unsigned char* src[NUM_INPUTS] = { sources[I].data... };
+			const unsigned int step[NUM_INPUTS] = { sources[I].step... };
+			for (unsigned int v = 0; v < numVertices; v++) {
+				(copyWide<SIZES[I]>(out + Offset(I), src[I]), ...);
+				((src[I] += step[I]), ...);
+				out += STRIDE;
+			}
+		}
+		static void Pack(const VertexPacker::Source* sources, unsigned int numVertices, unsigned char* out) {
+			PackVertices(sources, numVertices, out, std::make_index_sequence<NUM_INPUTS>());
+		}
+	};
+
+	struct SpecializedLayout {
+		std::vector<unsigned int> sizes;
+		VertexPacker::PackFunc func;
+	};
+	// Positions, normals, texture coordinates, tangents and bitangents in the orders the shaders use
+	const SpecializedLayout SPECIALIZED_LAYOUTS[] = {
+		{ { 12 }, &FixedLayout<12>::Pack },
+		{ { 12, 12 }, &FixedLayout<12, 12>::Pack },
+		{ { 12, 8 }, &FixedLayout<12, 8>::Pack },
+		{ { 12, 12, 8 }, &FixedLayout<12, 12, 8>::Pack },
+		{ { 12, 8, 12 }, &FixedLayout<12, 8, 12>::Pack },
+		{ { 12, 12, 8, 12, 12 }, &FixedLayout<12, 12, 8, 12, 12>::Pack },
+		{ { 12, 8, 12, 12, 12 }, &FixedLayout<12, 8, 12, 12, 12>::Pack },
+	};
+
+	const unsigned char* getSourceArray(const Mesh::Data& modelData, InputLayout::InputType inputType) {
+		switch (inputType) {
+		case InputLayout::POSITION: return reinterpret_cast<const unsigned char*>(modelData.positions);
+		case InputLayout::TEXCOORD: return reinterpret_cast<const unsigned char*>(modelData.texCoords);
+		case InputLayout::NORMAL: return reinterpret_cast<const unsigned char*>(modelData.normals);
+		case InputLayout::TANGENT: return reinterpret_cast<const unsigned char*>(modelData.tangents);
+		case InputLayout::BITANGENT: return reinterpret_cast<const unsigned char*>(modelData.bitangents);
+		}
+		return nullptr;
+	}
+}
+
+VertexPacker::VertexPacker(const std::vector<InputLayout::InputType>& inputOrder)
+	: m_stride(0)
+	, m_packFunc(nullptr)
+{
+	std::vector<unsigned int> sizes;
+	for (InputLayout::InputType inputType : inputOrder) {
+		unsigned int size = GetInputSize(inputType);
+		m_ops.push_back({ inputType, m_stride, size });
+		sizes.push_back(size);
+		m_stride += size;
+	}
+	for (const SpecializedLayout& layout : SPECIALIZED_LAYOUTS) {
+		if (layout.sizes == sizes)
+			m_packFunc = layout.func;
+	}
+}
+
+VertexPacker::~VertexPacker() {
+
+}
+
+unsigned int VertexPacker::GetInputSize(InputLayout::InputType inputType) {
+	return (inputType == InputLayout::TEXCOORD) ? sizeof(glm::vec2) : sizeof(glm::vec3);
+}
+
+void VertexPacker::pack(const Mesh::Data& modelData, void* out) const {
+	if (modelData.numVertices == 0 || m_ops.empty())
+		return;
+
+	unsigned int numOps = (unsigned int)m_ops.size();
+	// Inputs can repeat, the sources are indexed by copy rather than by input type
+	std::vector<Source> opSources(numOps);
+	for (unsigned int i = 0; i < numOps; i++) {
+		const unsigned char* data = getSourceArray(modelData, m_ops[i].input);
+		opSources[i] = (data) ? Source{ data, m_ops[i].size } : Source{ ZEROS, 0 };
+	}
+
+	unsigned char* dst = static_cast<unsigned char*>(out);
+	unsigned int numWide = 0;
+	if (m_packFunc) {
+		numWide = modelData.numVertices - 1;
+		m_packFunc(opSources.data(), numWide, dst);
+	}
+	for (unsigned int v = numWide; v < modelData.numVertices; v++) {
+		unsigned char* vertex = dst + (size_t)v * m_stride;
+		for (unsigned int i = 0; i < numOps; i++) {
+			const CopyOp& op = m_ops[i];
+			const unsigned char* src = opSources[i].data + (size_t)v * opSources[i].step;
+			// Constant sizes let the copies compile to plain moves
+			if (op.size == sizeof(glm::vec3))
+				std::memcpy(vertex + op.offset, src, sizeof(glm::vec3));
+			else
+				std::memcpy(vertex + op.offset, src, sizeof(glm::vec2));
+		}
+	}
+}
+
+unsigned int VertexPacker::getStride() const {
+	return m_stride;
+}
+
+bool VertexPacker::isSpecialized() const {
+	return m_packFunc != nullptr;
+}
+
+void VertexPacker::Benchmark(unsigned int numVertices, unsigned int iterations) {
+	typedef InputLayout L;
+	const std::vector<std::pair<std::string, std::vector<L::InputType>>> layouts = {
+		{ "P", { L::POSITION } },
+		{ "PN", { L::POSITION, L::NORMAL } },
+		{ "PNT", { L::POSITION, L::NORMAL, L::TEXCOORD } },
+		{ "PTNTB", { L::POSITION, L::TEXCOORD, L::NORMAL, L::TANGENT, L::BITANGENT } }
+	};
+
+	Mesh::Data data;
+	data.allocate(numVertices, 0, Mesh::Data::POSITIONS | Mesh::Data::NORMALS | Mesh::Data::TEXCOORDS | Mesh::Data::TANGENTS | Mesh::Data::BITANGENTS);
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> value(-1.f, 1.f);
+	for (unsigned int i = 0; i < numVertices; i++) {
+		data.positions[i] = Mesh::vec3(value(random), value(random), value(random));
+		data.normals[i] = Mesh::vec3(value(random), value(random), value(random));
+		data.texCoords[i] = Mesh::vec2(value(random), value(random));
+		data.tangents[i] = Mesh::vec3(value(random), value(random), value(random));
+		data.bitangents[i] = Mesh::vec3(value(random), value(random), value(random));
+	}
+
+	for (const auto& layout : layouts) {
+		VertexPacker packer(layout.second);
+		size_t size = (size_t)numVertices * packer.getStride();
+		std::vector<unsigned char> packed(size);
+		std::vector<unsigned char> copy(size);
+		// Touch both buffers so page faults are not timed
+		memset(packed.data(), 0, size);
+		memset(copy.data(), 0, size);
+
+		double bestPack = 0.0;
+		double bestCopy = 0.0;
+		for (unsigned int i = 0; i < iterations; i++) {
+			auto start = std::chrono::high_resolution_clock::now();
+			packer.pack(data, packed.data());
+			auto packEnd = std::chrono::high_resolution_clock::now();
+			memcpy(copy.data(), packed.data(), size);
+			auto copyEnd = std::chrono::high_resolution_clock::now();
+			double packSeconds = std::chrono::duration<double>(packEnd - start).count();
+			double copySeconds = std::chrono::duration<double>(copyEnd - packEnd).count();
+			if (i == 0 || packSeconds < bestPack)
+				bestPack = packSeconds;
+			if (i == 0 || copySeconds < bestCopy)
+				bestCopy = copySeconds;
+		}
+		Logger::Log(layout.first + (packer.isSpecialized() ? "" : " (generic)") + ": packed " + std::to_string(numVertices) + " vertices in " + std::to_string(bestPack * 1000.0) + " ms, "
+			+ std::to_string(size / bestPack / (1024.0 * 1024.0)) + " MB/s, memcpy " + std::to_string(bestCopy * 1000.0) + " ms");
+	}
+	data.freeArrays();
+}
\ No newline at end of file
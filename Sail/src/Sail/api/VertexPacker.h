@@ -0,0 +1,47 @@
+#pragma once
+
+#include "shader/InputLayout.h"
+#include "Mesh.h"
+
+// Interleaves the vertex arrays of mesh data for an input order
+// The order is compiled once into a list of copies, each taking a source array to an offset in the vertex
+// Common layouts get packing functions generated for their sizes which copy with unaligned SSE loads and stores instead of memcpy
+class VertexPacker {
+public:
+	VertexPacker(const std::vector<InputLayout::InputType>& inputOrder);
+	~VertexPacker();
+
+	// Size of one input in the interleaved vertex data
+	static unsigned int GetInputSize(InputLayout::InputType inputType);
+
+	// Writes the interleaved vertices to out, which has to fit numVertices times the stride
+	// Missing arrays are filled with zeros. The wide copies write some bytes twice, so out should be system memory
+	// rather than a write combined upload buffer, which is better filled with one memcpy of the packed vertices
+	void pack(const Mesh::Data& modelData, void* out) const;
+	unsigned int getStride() const;
+	// True if the layout has a generated packing function
+	bool isSpecialized() const;
+
+	// Packs numVertices random vertices into each common layout a number of times and logs the best times
+	// The time of a memcpy of the packed vertices is logged next to it, which is what uploading them costs on top
+	static void Benchmark(unsigned int numVertices, unsigned int iterations);
+
+public:
+	struct CopyOp {
+		InputLayout::InputType input;
+		unsigned int offset;
+		unsigned int size;
+	};
+	// Source array and bytes to step per vertex for each copy, the step is zero for missing arrays
+	struct Source {
+		const unsigned char* data;
+		unsigned int step;
+	};
+	typedef void (*PackFunc)(const Source* sources, unsigned int numVertices, unsigned char* out);
+
+private:
+	std::vector<CopyOp> m_ops;
+	unsigned int m_stride;
+	PackFunc m_packFunc;
+
+};
\ No newline at end of file
@@ -13,7 +13,7 @@ public:
 	};
 public:
 	static Window* Create(const WindowProps& props);
-	Window(const WindowProps& props) : windowWidth(props.windowWidth), windowHeight(props.windowHeight), isWindowMinimized(false), isWindowFocused(false) {}
+	Window(const WindowProps& props) : windowWidth(props.windowWidth), windowHeight(props.windowHeight), isWindowMinimized(false), isWindowFocused(false), exitCode(0) {}
 	virtual ~Window() {}
 
 	virtual bool initialize() = 0;
@@ -24,12 +24,19 @@ public:
 	virtual inline bool isMinimized() const { return isWindowMinimized; };
 	virtual inline bool isFocused() const { return isWindowFocused; };
 
+	// Handles all pending platform messages, returns false once the application should quit
+	virtual bool processMessages() = 0;
+	// Makes processMessages() return false, the exit code is returned from the game loop
+	virtual void requestClose(int exitCode) = 0;
+	inline int getExitCode() const { return exitCode; };
+
 
 protected:
 	unsigned int windowWidth;
 	unsigned int windowHeight;
 	bool isWindowMinimized;
 	bool isWindowFocused;
+	int exitCode;
 
 private:
 	// NOTE: this method is only used internally by the sail and should not be called by the user
@@ -4,9 +4,18 @@
 
 namespace ShaderComponent {
 
+	// Constant buffer registers grouped by how often their data changes
+	// These have to match the registers used in the shaders and the DX12 global root signature
+	enum CBUFFER_SLOT : unsigned int {
+		PER_OBJECT = 0,		// Updated for every draw
+		PER_MATERIAL = 1,	// Updated when the material changes
+		PER_FRAME = 2,		// Updated once per frame, owned and bound by the renderer
+		PER_PASS = 3		// Updated once per pass, owned and bound by the renderer
+	};
+
 	class ConstantBuffer {
 	public:
-		static ConstantBuffer* ConstantBuffer::Create(void* initData, unsigned int size, BIND_SHADER bindShader, unsigned int slot = 0);
+		static ConstantBuffer* Create(void* initData, unsigned int size, BIND_SHADER bindShader, unsigned int slot = 0);
 		virtual ~ConstantBuffer() {}
 
 		virtual void updateData(const void* newData, unsigned int bufferSize, unsigned int offset = 0U) = 0;
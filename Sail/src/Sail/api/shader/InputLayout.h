@@ -17,7 +17,7 @@ public:
 	};
 	
 public:
-	static InputLayout* InputLayout::Create();
+	static InputLayout* Create();
 	InputLayout();
 	virtual ~InputLayout();
 
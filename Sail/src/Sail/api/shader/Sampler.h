@@ -8,7 +8,7 @@ namespace ShaderComponent {
 	class Sampler {
 
 	public:
-		static Sampler* Sampler::Create(Texture::ADDRESS_MODE addressMode = Texture::WRAP, Texture::FILTER filter = Texture::MIN_MAG_MIP_LINEAR, BIND_SHADER bindShader = PS, unsigned int slot = 0);
+		static Sampler* Create(Texture::ADDRESS_MODE addressMode = Texture::WRAP, Texture::FILTER filter = Texture::MIN_MAG_MIP_LINEAR, BIND_SHADER bindShader = PS, unsigned int slot = 0);
 		Sampler(Texture::ADDRESS_MODE adressMode = Texture::WRAP, Texture::FILTER filter = Texture::MIN_MAG_MIP_LINEAR, BIND_SHADER bindShader = PS, unsigned int slot = 0) {}
 		virtual ~Sampler() {}
 
@@ -1,9 +1,9 @@
 #include "pch.h"
 #include "ShaderPipeline.h"
 #include "Sail/Application.h"
+#include "Sail/api/RenderStats.h"
 #include <regex>
 
-ShaderPipeline* ShaderPipeline::CurrentlyBoundShader = nullptr;
 const std::string ShaderPipeline::DEFAULT_SHADER_LOCATION = "res/shaders/";
 
 using namespace Utils::String;
@@ -15,6 +15,7 @@ ShaderPipeline::ShaderPipeline(const std::string& filename)
 	, dsBlob(nullptr)
 	, hsBlob(nullptr)
 	, filename(filename)
+	, uploadedMaterial(0)
 {
 	inputLayout = std::unique_ptr<InputLayout>(InputLayout::Create());
 }
@@ -56,22 +57,14 @@ void ShaderPipeline::finish() {
 }
 
 void ShaderPipeline::bind(void* cmdList) {
-	// Don't bind if already bound
-	// This is to cut down on shader state changes
-	if (CurrentlyBoundShader == this)
-		return;
-
+	// Constant buffers and samplers can be shared by several pipelines through their slots
+	// They check the state cache on their own to cut down on redundant binds
 	for (auto& it : parsedData.cBuffers) {
 		it.cBuffer->bind(cmdList);
 	}
 	for (auto& it : parsedData.samplers) {
 		it.sampler->bind();
 	}
-
-
-
-	// Set input layout as active
-	inputLayout->bind();
 }
 
 void ShaderPipeline::parse(const std::string& source) {
@@ -132,6 +125,10 @@ void ShaderPipeline::parseCBuffer(const std::string& source) {
 
 
 	int registerSlot = findNextIntOnLine(src);
+	// Per frame and per pass cbuffers are shared between all shaders, these are owned and updated by the renderer
+	if (registerSlot == ShaderComponent::PER_FRAME || registerSlot == ShaderComponent::PER_PASS)
+		return;
+
 	src = findToken("{", src); // Place ptr on same line as starting bracket
 	src = nextLine(src);
 
@@ -308,6 +305,7 @@ bool ShaderPipeline::trySetCBufferVar(const std::string& name, const void* data,
 			if (var.name == name) {
 				ShaderComponent::ConstantBuffer& cbuffer = *it.cBuffer.get();
 				cbuffer.updateData(data, size, var.byteOffset);
+				Application::getInstance()->getAPI()->getRenderStats().add(RenderStats::CBUFFER_UPDATES);
 				return true;
 			}
 		}
@@ -315,6 +313,14 @@ bool ShaderPipeline::trySetCBufferVar(const std::string& name, const void* data,
 	return false;
 }
 
+void ShaderPipeline::setUploadedMaterial(uint64_t materialID) {
+	uploadedMaterial = materialID;
+}
+
+uint64_t ShaderPipeline::getUploadedMaterial() const {
+	return uploadedMaterial;
+}
+
 //void ShaderPipeline::setTexture2D(const std::string& name, ID3D11ShaderResourceView* srv) {
 //
 //	UINT slot = findSlotFromName(name, parsedData.textures);
@@ -357,7 +363,8 @@ bool ShaderPipeline::trySetCBufferVar(const std::string& name, const void* data,
 
 // TODO: registerTypeSize(typeName, size)
 UINT ShaderPipeline::getSizeOfType(const std::string& typeName) const {
-	if (typeName == "float") return 4;
+	if (typeName == "float" || typeName == "uint" || typeName == "int") return 4;
+	if (typeName == "uint4" || typeName == "int4") return 4*4;
 	if (typeName == "float2") return 4*2;
 	if (typeName == "float3") return 4*3;
 	if (typeName == "float4") return 4*4;
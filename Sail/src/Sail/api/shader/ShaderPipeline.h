@@ -1,8 +1,6 @@
 #pragma once
 
 #include <memory>
-#include <d3d11.h>
-#include <d3dcompiler.h>
 #include <iostream>
 #include <glm/glm.hpp>
 
@@ -16,7 +14,6 @@
 class ShaderPipeline {
 public:
 	friend class Shader;
-	static ShaderPipeline* CurrentlyBoundShader;
 	static const std::string DEFAULT_SHADER_LOCATION;
 
 public:
@@ -40,6 +37,9 @@ public:
 
 	void setCBufferVar(const std::string& name, const void* data, UINT size);
 	bool trySetCBufferVar(const std::string& name, const void* data, UINT size);
+	// Id of the material whose constants are in the per material cbuffer, 0 when they have to be uploaded again
+	void setUploadedMaterial(uint64_t materialID);
+	uint64_t getUploadedMaterial() const;
 
 protected:
 	// Compiles shaders into blobs
@@ -75,11 +75,13 @@ protected:
 		};
 		ShaderCBuffer(std::vector<ShaderCBuffer::CBufferVariable>& vars, void* initData, UINT size, ShaderComponent::BIND_SHADER bindShader, UINT slot)
 			: vars(vars)
+			, slot(slot)
 		{
 			cBuffer = std::unique_ptr<ShaderComponent::ConstantBuffer>(ShaderComponent::ConstantBuffer::Create(initData, size, bindShader, slot));
 		}
 		std::vector<CBufferVariable> vars;
 		std::unique_ptr <ShaderComponent::ConstantBuffer> cBuffer;
+		UINT slot;
 	};
 	struct ShaderSampler {
 		ShaderSampler(ShaderResource res, Texture::ADDRESS_MODE adressMode, Texture::FILTER filter, ShaderComponent::BIND_SHADER bindShader, UINT slot)
@@ -104,6 +106,7 @@ protected:
 		}
 	};
 	ParsedData parsedData;
+	uint64_t uploadedMaterial;
 
 private:
 	//std::vector<std::unique_ptr<ComputeShader>> m_css;
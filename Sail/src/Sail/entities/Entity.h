@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <memory>
 #include "components/Component.h"
+#include "Sail/utils/Utils.h"
 
 //#define MOVE(x) std::move(x)
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Component.h"
-class Model;
+#include "Sail/graphics/geometry/Model.h"
 
 class ModelComponent : public Component {
 public:
@@ -9,15 +9,17 @@ public:
 	/*static int getStaticID() {
 		return 1;
 	}*/
-	ModelComponent(Model* model)
-		: m_model(model)
+	// Models from the ResourceManager stay loaded while the component holds their handle
+	ModelComponent(ModelHandle model)
+		: m_model(std::move(model))
 	{ }
 	~ModelComponent() { }
 
+	// nullptr while the model is loading or if it failed to load
 	Model* getModel() {
-		return m_model;
+		return m_model.get();
 	}
 
 private:
-	Model* m_model;
+	ModelHandle m_model;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "TextComponent.h"
 #include "Sail/Application.h"
 #include "Sail/api/shader/ShaderPipeline.h"
+#include "Sail/api/RenderStateCache.h"
 
 TextComponent::TextComponent() {
 	//m_spriteBatch = std::make_unique<DirectX::SpriteBatch>(Application::getInstance()->getAPI()->getDeviceContext());
@@ -31,9 +32,10 @@ void TextComponent::draw() {
 		m_spriteBatch->End();
 	}*/
 
+	// The sprite batch changes state without going through the state cache
+	dxm->getStateCache().invalidate();
+
 	// Re-enable the depth buffer and rasterizer state after 2D rendering
 	dxm->setDepthMask(GraphicsAPI::NO_MASK);
 	//dxm->setFaceCulling(GraphicsAPI::BACKFACE);
-
-	ShaderPipeline::CurrentlyBoundShader = nullptr;
 }
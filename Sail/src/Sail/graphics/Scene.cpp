@@ -6,6 +6,7 @@
 #include "../utils/Utils.h"
 #include "Sail/Application.h"
 #include "Sail/api/Renderer.h"
+#include "Sail/utils/Profiler.h"
 
 
 Scene::Scene() 
@@ -41,12 +42,13 @@ void Scene::setLightSetup(LightSetup* lights) {
 }
 
 void Scene::draw(Camera& camera) {
+	SAIL_PROFILE_FUNCTION();
 
 	m_renderer->begin(&camera);
 
 	for (Entity::SPtr& entity : m_entities) {
 		ModelComponent* model = entity->getComponent<ModelComponent>();
-		if (model) {
+		if (model && model->getModel()) {
 			TransformComponent* transform = entity->getComponent<TransformComponent>();
 			if (!transform)	Logger::Error("Tried to draw entity that is missing a TransformComponent!");
 
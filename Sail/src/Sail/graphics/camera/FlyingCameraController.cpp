@@ -93,7 +93,7 @@ void FlyingCameraController::update(float dt) {
 	}
 
 	if (Input::IsCursorHidden()) {
-		glm::ivec2& mouseDelta = Input::GetMouseDelta();
+		const glm::ivec2& mouseDelta = Input::GetMouseDelta();
 		m_pitch -= mouseDelta.y * lookSensitivityMouse;
 		m_yaw -= mouseDelta.x * lookSensitivityMouse;
 	}
@@ -3,11 +3,15 @@
 #include "Sail/api/shader/ShaderPipeline.h"
 #include "Sail/graphics/shader/Shader.h"
 #include "Sail/Application.h"
+#include "Sail/api/RenderStats.h"
+
+std::atomic<uint64_t> Material::s_nextID(1);
 
 Material::Material(Shader* shader)
 	: m_numTextures(3)
 	, m_shader(shader)
-	, m_textures {nullptr}
+	, m_id(s_nextID++)
+	, m_dirty(true)
 {
 	m_phongSettings.ka = 1.f;
 	m_phongSettings.kd = 1.f;
@@ -21,63 +25,85 @@ Material::Material(Shader* shader)
 }
 Material::~Material() { }
 
-void Material::bind(void* cmdList) {
+void Material::updateConstants() {
 	ShaderPipeline* pipeline = m_shader->getPipeline();
 	pipeline->trySetCBufferVar("sys_material", (void*)&getPhongSettings(), sizeof(PhongSettings));
+	pipeline->setUploadedMaterial(m_id);
+	m_dirty = false;
+}
+
+void Material::bind(void* cmdList) {
+	ShaderPipeline* pipeline = m_shader->getPipeline();
+	Application::getInstance()->getAPI()->getRenderStats().add(RenderStats::MATERIAL_BINDS);
+
+	// Draws sorted by material only upload once per material
+	if (m_dirty || pipeline->getUploadedMaterial() != m_id)
+		updateConstants();
 
 	if (m_phongSettings.hasDiffuseTexture)
-		pipeline->setTexture2D("sys_texDiffuse", m_textures[0], cmdList);
+		pipeline->setTexture2D("sys_texDiffuse", m_textures[0].get(), cmdList);
 	if (m_phongSettings.hasNormalTexture)
-		pipeline->setTexture2D("sys_texNormal", m_textures[1], cmdList);
+		pipeline->setTexture2D("sys_texNormal", m_textures[1].get(), cmdList);
 	if (m_phongSettings.hasSpecularTexture)
-		pipeline->setTexture2D("sys_texSpecular", m_textures[2], cmdList);
+		pipeline->setTexture2D("sys_texSpecular", m_textures[2].get(), cmdList);
 	//m_shader->bind();
 }
 
 void Material::setKa(float ka) {
 	m_phongSettings.ka = ka;
+	m_dirty = true;
 }
 void Material::setKd(float kd) {
 	m_phongSettings.kd = kd;
+	m_dirty = true;
 }
 void Material::setKs(float ks) {
 	m_phongSettings.ks = ks;
+	m_dirty = true;
 }
 void Material::setShininess(float shininess) {
 	m_phongSettings.shininess = shininess;
+	m_dirty = true;
 }
 void Material::setColor(const glm::vec4& color) {
 	m_phongSettings.modelColor = color;
+	m_dirty = true;
 }
 
 
 void Material::setDiffuseTexture(const std::string& filename) {
 	getAndInsertTexture(filename, 0);
 	m_phongSettings.hasDiffuseTexture = 1;
+	m_dirty = true;
 }
 void Material::setDiffuseTextureFromHandle(Texture* srv) {
 	m_textures[0] = srv;
 	m_phongSettings.hasDiffuseTexture = 1;
+	m_dirty = true;
 }
 
 
 void Material::setNormalTexture(const std::string& filename) {
 	getAndInsertTexture(filename, 1);
 	m_phongSettings.hasNormalTexture = 1;
+	m_dirty = true;
 }
 void Material::setNormalTextureFromHandle(Texture* srv) {
 	m_textures[1] = srv;
 	m_phongSettings.hasNormalTexture = 1;
+	m_dirty = true;
 }
 
 
 void Material::setSpecularTexture(const std::string& filename) {
 	getAndInsertTexture(filename, 2);
 	m_phongSettings.hasSpecularTexture = 1;
+	m_dirty = true;
 }
 void Material::setSpecularTextureFromHandle(Texture* srv) {
 	m_textures[2] = srv;
 	m_phongSettings.hasSpecularTexture = 1;
+	m_dirty = true;
 }
 
 
@@ -88,8 +114,8 @@ void Material::setSpecularTextureFromHandle(Texture* srv) {
 
 
 void Material::getAndInsertTexture(const std::string& filename, int arraySlot) {
-	Texture* t = &Application::getInstance()->getResourceManager().getTexture(filename);
-	m_textures[arraySlot] = t;
+	// Starts loading the texture if it is not loaded already
+	m_textures[arraySlot] = Application::getInstance()->getResourceManager().loadTextureAsync(filename);
 }
 
 //ID3D11ShaderResourceView* const* Material::getTextures(UINT& numTextures) {
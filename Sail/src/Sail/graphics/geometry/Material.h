@@ -1,10 +1,10 @@
 #pragma once
 
-#include <d3d11.h>
 #include <glm/glm.hpp>
 #include <string>
 #include <memory>
-#include "sail/api/Texture.h"
+#include <atomic>
+#include "Sail/api/Texture.h"
 
 class Shader;
 
@@ -28,6 +28,9 @@ public:
 	Material(Shader* shader);
 	~Material();
 
+	// Uploads the material constants to its shader
+	void updateConstants();
+	// Binds the textures, the constants are uploaded unless the shader still holds them from the last upload
 	void bind(void* cmdList = nullptr);
 
 	void setKa(float ka);
@@ -67,11 +70,17 @@ private:
 
 private:
 	Shader* m_shader;
+	// Identifies the material to the pipeline, addresses can be reused by later materials
+	uint64_t m_id;
+	// Set when the constants changed since the last upload
+	bool m_dirty;
+	static std::atomic<uint64_t> s_nextID;
 
 	PhongSettings m_phongSettings;
-	Texture* m_textures[3];
+	// Textures set by filename give the placeholder texture while they load
+	TextureHandle m_textures[3];
 
-	UINT m_numTextures;
+	unsigned int m_numTextures;
 
 	//ID3D11ShaderResourceView** m_customSRVs;
 
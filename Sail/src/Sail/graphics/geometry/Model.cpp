@@ -67,11 +67,11 @@ Mesh* Model::addMesh(std::unique_ptr<Mesh> mesh) {
 //
 //}
 
-void Model::draw(const Renderer& renderer) {
+void Model::draw(const Renderer& renderer, unsigned int numInstances) {
 
 	//m_material->bind();
 	for (auto& mesh : m_meshes)
-		mesh->draw(renderer);
+		mesh->draw(renderer, nullptr, numInstances);
 
 }
 
@@ -84,6 +84,19 @@ unsigned int Model::getNumberOfMeshes() const {
 	return m_meshes.size();
 }
 
+size_t Model::getCPUMemoryUsage() const {
+	size_t size = 0;
+	for (const Mesh::Ptr& mesh : m_meshes)
+		size += mesh->getCPUMemoryUsage();
+	return size;
+}
+size_t Model::getGPUMemoryUsage() const {
+	size_t size = 0;
+	for (const Mesh::Ptr& mesh : m_meshes)
+		size += mesh->getGPUMemoryUsage();
+	return size;
+}
+
 //ShaderSet* Model::getShader() const {
 //	//return m_material->getShader();
 //	return nullptr;
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <d3d11.h>
 #include <vector>
 #include "Sail/api/Mesh.h"
 #include "Sail/api/Renderer.h"
 #include "Sail/utils/Utils.h"
+#include "Sail/resources/ResourceHandle.h"
 
 // Forward declarations
 class ShaderPipeline;
@@ -27,10 +27,13 @@ public:
 	//void buildBufferForShader(ShaderSet* shader);
 
 	// Draws the model using its material
-	void draw(const Renderer& renderer);
+	void draw(const Renderer& renderer, unsigned int numInstances = 1);
 
 	Mesh* getMesh(unsigned int index);
 	unsigned int getNumberOfMeshes() const;
+	// Bytes held by all meshes, see Mesh::getCPUMemoryUsage and Mesh::getGPUMemoryUsage
+	size_t getCPUMemoryUsage() const;
+	size_t getGPUMemoryUsage() const;
 	/*ShaderSet* getShader() const;
 	Material* getMaterial();*/
 	//const AABB& getAABB() const;
@@ -47,3 +50,5 @@ private:
 	//AABB m_aabb;
 
 };
+
+typedef ResourceHandle<Model> ModelHandle;
\ No newline at end of file
@@ -23,7 +23,7 @@ namespace ModelFactory {
 			};
 
 			const int numIndices = 6;
-			ULONG* indices = SAIL_NEW ULONG[numIndices]{
+			unsigned long* indices = SAIL_NEW unsigned long[numIndices]{
 				0, 1, 2, 2, 1, 3
 			};
 
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "MultiFrustumCuller.h"
+#include "Sail/graphics/camera/Camera.h"
+#include <xmmintrin.h>
+
+MultiFrustumCuller::MultiFrustumCuller() {
+	clear();
+}
+
+MultiFrustumCuller::~MultiFrustumCuller() {
+
+}
+
+void MultiFrustumCuller::clear() {
+	// Unused planes are zero with a positive distance, which everything is in front of
+	for (PlaneRow& row : m_rows) {
+		for (unsigned int i = 0; i < MAX_VIEWS; i++) {
+			row.x[i] = row.y[i] = row.z[i] = 0.f;
+			row.absX[i] = row.absY[i] = row.absZ[i] = 0.f;
+			row.w[i] = 1.f;
+		}
+	}
+	m_numViews = 0;
+	m_numRows = 0;
+}
+
+int MultiFrustumCuller::addView(const glm::vec4* planes, unsigned int numPlanes) {
+	if (m_numViews >= MAX_VIEWS || numPlanes > MAX_PLANES)
+		return -1;
+	unsigned int view = m_numViews++;
+	setView(view, planes, numPlanes);
+	return (int)view;
+}
+
+int MultiFrustumCuller::addView(const Frustum& frustum, const glm::vec4* clippingPlane) {
+	if (m_numViews >= MAX_VIEWS)
+		return -1;
+	unsigned int view = m_numViews++;
+	setView(view, frustum, clippingPlane);
+	return (int)view;
+}
+
+void MultiFrustumCuller::setView(unsigned int view, const glm::vec4* planes, unsigned int numPlanes) {
+	numPlanes = std::min(numPlanes, MAX_PLANES);
+	for (unsigned int i = 0; i < MAX_PLANES; i++) {
+		glm::vec4 plane = (i < numPlanes) ? planes[i] : glm::vec4(0.f, 0.f, 0.f, 1.f);
+		PlaneRow& row = m_rows[i];
+		row.x[view] = plane.x;
+		row.y[view] = plane.y;
+		row.z[view] = plane.z;
+		row.w[view] = plane.w;
+		row.absX[view] = std::abs(plane.x);
+		row.absY[view] = std::abs(plane.y);
+		row.absZ[view] = std::abs(plane.z);
+	}
+	m_numRows = std::max(m_numRows, numPlanes);
+}
+
+void MultiFrustumCuller::setView(unsigned int view, const Frustum& frustum, const glm::vec4* clippingPlane) {
+	glm::vec4 planes[7];
+	for (unsigned int i = 0; i < 6; i++)
+		planes[i] = -frustum.planes[i];
+	unsigned int numPlanes = 6;
+	if (clippingPlane)
+		planes[numPlanes++] = *clippingPlane;
+	setView(view, planes, numPlanes);
+}
+
+unsigned int MultiFrustumCuller::getMask(const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int parentMask) const {
+	parentMask &= getViewMask();
+	if (parentMask == 0)
+		return 0;
+
+	glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+	glm::vec3 extents = (boundsMax - boundsMin) * 0.5f;
+	const __m128 cx = _mm_set1_ps(center.x);
+	const __m128 cy = _mm_set1_ps(center.y);
+	const __m128 cz = _mm_set1_ps(center.z);
+	const __m128 ex = _mm_set1_ps(extents.x);
+	const __m128 ey = _mm_set1_ps(extents.y);
+	const __m128 ez = _mm_set1_ps(extents.z);
+	const __m128 zero = _mm_setzero_ps();
+
+	// The box is outside of a plane if its center is further behind it than the extents reach
+	__m128 outside[2] = { zero, zero };
+	for (unsigned int i = 0; i < m_numRows; i++) {
+		const PlaneRow& row = m_rows[i];
+		for (unsigned int half = 0; half < 2; half++) {
+			unsigned int offset = half * 4;
+			__m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_load_ps(row.x + offset), cx), _mm_mul_ps(_mm_load_ps(row.y + offset), cy)),
+				_mm_add_ps(_mm_mul_ps(_mm_load_ps(row.z + offset), cz), _mm_load_ps(row.w + offset)));
+			__m128 radius = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_load_ps(row.absX + offset), ex), _mm_mul_ps(_mm_load_ps(row.absY + offset), ey)),
+				_mm_mul_ps(_mm_load_ps(row.absZ + offset), ez));
+			outside[half] = _mm_or_ps(outside[half], _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+		}
+	}
+	unsigned int outsideMask = (unsigned int)_mm_movemask_ps(outside[0]) | ((unsigned int)_mm_movemask_ps(outside[1]) << 4);
+	return parentMask & ~outsideMask;
+}
+
+unsigned int MultiFrustumCuller::getNumViews() const {
+	return m_numViews;
+}
+
+unsigned int MultiFrustumCuller::getViewMask() const {
+	return (1U << m_numViews) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+struct Frustum;
+
+// Culls bounding boxes against up to MAX_VIEWS frusta at once
+// Planes are stored view by view across SSE registers, so a box is tested against the same plane of every view
+// in a few instructions and the result is a bitmask with bit i set if the box is visible in view i
+//
+// Spatial structures pass the mask of a node on to its children, children are then only visible in views their parent was
+class MultiFrustumCuller {
+public:
+	static const unsigned int MAX_VIEWS = 8;
+	// Six frustum planes, an optional clipping plane and one spare
+	static const unsigned int MAX_PLANES = 8;
+
+public:
+	MultiFrustumCuller();
+	~MultiFrustumCuller();
+
+	// Removes all views
+	void clear();
+	// Planes point inwards, a box is visible if it is on the positive side of all of them
+	// A view without planes sees everything. Returns the index of the view, or -1 if all views are taken
+	int addView(const glm::vec4* planes, unsigned int numPlanes);
+	// Adds a camera frustum, planes extracted by Frustum point outwards and are flipped
+	// The clipping plane culls everything on its negative side, such as geometry below the water in a reflection pass
+	int addView(const Frustum& frustum, const glm::vec4* clippingPlane = nullptr);
+	// Replaces the planes of an added view
+	void setView(unsigned int view, const glm::vec4* planes, unsigned int numPlanes);
+	void setView(unsigned int view, const Frustum& frustum, const glm::vec4* clippingPlane = nullptr);
+
+	// Bit i is set if the box is visible in view i and in parentMask
+	unsigned int getMask(const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int parentMask = 0xFF) const;
+
+	unsigned int getNumViews() const;
+	// Mask with one bit set for each added view
+	unsigned int getViewMask() const;
+
+private:
+	// One plane of every view, the second half of each array holds views 4 to 7
+	struct alignas(16) PlaneRow {
+		float x[MAX_VIEWS];
+		float y[MAX_VIEWS];
+		float z[MAX_VIEWS];
+		float w[MAX_VIEWS];
+		// Absolute values of the normal, used to project the box extents onto it
+		float absX[MAX_VIEWS];
+		float absY[MAX_VIEWS];
+		float absZ[MAX_VIEWS];
+	};
+
+private:
+	PlaneRow m_rows[MAX_PLANES];
+	unsigned int m_numViews;
+	// Highest number of planes used by any view
+	unsigned int m_numRows;
+
+};
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "CascadedShadows.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+CascadedShadows::CascadedShadows()
+	: CascadedShadows(Settings())
+{
+}
+
+CascadedShadows::CascadedShadows(const Settings& settings)
+	: m_cascades{}
+{
+	setSettings(settings);
+}
+
+CascadedShadows::~CascadedShadows() {
+
+}
+
+void CascadedShadows::update(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& lightDirection) {
+	// Extract near and far from the projection matrix (left handed, depth zero to one)
+	float nearZ = -proj[3][2] / proj[2][2];
+	float farZ = proj[3][2] / (1.f - proj[2][2]);
+	farZ = std::max(std::min(farZ, m_settings.maxDistance), nearZ + 0.001f);
+
+	float splits[MAX_CASCADES + 1];
+	ComputeSplits(nearZ, farZ, m_numCascades, m_settings.splitLambda, splits);
+
+	glm::mat4 invView = glm::inverse(view);
+	glm::vec3 dir = glm::normalize(lightDirection);
+	glm::vec3 up = (std::abs(dir.y) > 0.99f) ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(0.f, 1.f, 0.f);
+	// Rotation into light space, used to snap the cascade centers to the texel grid
+	glm::mat4 lightRotation = glm::lookAtLH(glm::vec3(0.f), dir, up);
+	glm::mat4 invLightRotation = glm::transpose(lightRotation);
+
+	for (unsigned int i = 0; i < m_numCascades; i++) {
+		Cascade& cascade = m_cascades[i];
+		cascade.splitNear = splits[i];
+		cascade.splitFar = splits[i + 1];
+
+		glm::vec3 centerVS;
+		float radius;
+		FitSphere(proj, cascade.splitNear, cascade.splitFar, centerVS, radius);
+		// The radius only depends on the projection, rounding it keeps float noise from changing the texel size
+		radius = std::ceil(radius * 16.f) / 16.f;
+		float texelSize = 2.f * radius / m_settings.resolution;
+
+		// Move the center in whole texels across the light plane
+		glm::vec3 center = glm::vec3(invView * glm::vec4(centerVS, 1.f));
+		glm::vec3 centerLS = glm::vec3(lightRotation * glm::vec4(center, 1.f));
+		centerLS.x = std::floor(centerLS.x / texelSize) * texelSize;
+		centerLS.y = std::floor(centerLS.y / texelSize) * texelSize;
+		center = glm::vec3(invLightRotation * glm::vec4(centerLS, 1.f));
+
+		cascade.sphereCenter = center;
+		cascade.sphereRadius = radius;
+		cascade.texelSize = texelSize;
+		glm::vec3 eye = center - dir * (radius + m_settings.casterPullback);
+		cascade.view = glm::lookAtLH(eye, center, up);
+		cascade.proj = glm::orthoLH_ZO(-radius, radius, -radius, radius, 0.f, m_settings.casterPullback + 2.f * radius);
+		cascade.viewProj = cascade.proj * cascade.view;
+
+		// Rows of the matrix give the clip planes
+		const glm::mat4& m = cascade.viewProj;
+		glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+		glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+		glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+		glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+		cascade.cullPlanes[0] = row3 + row0;
+		cascade.cullPlanes[1] = row3 - row0;
+		cascade.cullPlanes[2] = row3 + row1;
+		cascade.cullPlanes[3] = row3 - row1;
+		cascade.cullPlanes[4] = row3 - row2;
+		for (glm::vec4& plane : cascade.cullPlanes)
+			plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+bool CascadedShadows::isCasterVisible(unsigned int cascade, const glm::vec3& boundsMin, const glm::vec3& boundsMax) const {
+	for (const glm::vec4& plane : m_cascades[cascade].cullPlanes) {
+		// Corner furthest along the plane normal
+		glm::vec3 corner(
+			(plane.x > 0.f) ? boundsMax.x : boundsMin.x,
+			(plane.y > 0.f) ? boundsMax.y : boundsMin.y,
+			(plane.z > 0.f) ? boundsMax.z : boundsMin.z);
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.f)
+			return false;
+	}
+	return true;
+}
+
+unsigned int CascadedShadows::getCasterMask(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const {
+	unsigned int mask = 0;
+	for (unsigned int i = 0; i < m_numCascades; i++) {
+		if (isCasterVisible(i, boundsMin, boundsMax))
+			mask |= 1 << i;
+	}
+	return mask;
+}
+
+void CascadedShadows::setSettings(const Settings& settings) {
+	m_settings = settings;
+	m_settings.resolution = std::max(m_settings.resolution, 1U);
+	m_numCascades = glm::clamp(settings.numCascades, 1U, MAX_CASCADES);
+}
+
+const CascadedShadows::Settings& CascadedShadows::getSettings() const {
+	return m_settings;
+}
+
+unsigned int CascadedShadows::getNumCascades() const {
+	return m_numCascades;
+}
+
+const CascadedShadows::Cascade& CascadedShadows::getCascade(unsigned int index) const {
+	return m_cascades[index];
+}
+
+void CascadedShadows::ComputeSplits(float nearZ, float farZ, unsigned int numCascades, float lambda, float* outSplits) {
+	outSplits[0] = nearZ;
+	for (unsigned int i = 1; i < numCascades; i++) {
+		float t = (float)i / numCascades;
+		float logSplit = nearZ * std::pow(farZ / nearZ, t);
+		float uniformSplit = nearZ + (farZ - nearZ) * t;
+		outSplits[i] = lambda * logSplit + (1.f - lambda) * uniformSplit;
+	}
+	outSplits[numCascades] = farZ;
+}
+
+void CascadedShadows::FitSphere(const glm::mat4& proj, float sliceNear, float sliceFar, glm::vec3& outCenter, float& outRadius) {
+	// Squared distance from the view axis to a corner of the slice, per unit of depth
+	float tanX = 1.f / proj[0][0];
+	float tanY = 1.f / proj[1][1];
+	float k2 = tanX * tanX + tanY * tanY;
+
+	// The center is on the view axis, where the near and far corners are equally far away
+	float z = 0.5f * (sliceNear + sliceFar) * (1.f + k2);
+	// Wide slices are enclosed by the sphere around the far plane rectangle
+	z = std::min(z, sliceFar);
+
+	float nearDist2 = (z - sliceNear) * (z - sliceNear) + sliceNear * sliceNear * k2;
+	float farDist2 = (sliceFar - z) * (sliceFar - z) + sliceFar * sliceFar * k2;
+	outCenter = glm::vec3(0.f, 0.f, z);
+	outRadius = std::sqrt(std::max(nearDist2, farDist2));
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// CPU side of cascaded shadow maps for a directional light
+// The view frustum is split in depth, each split gets its own orthographic light camera fitted to a bounding sphere of the split
+// The sphere makes the cascade size independent of camera rotation, and moving the center in whole texels keeps the shadow edges from shimmering
+//
+// Only the math is implemented, no renderer draws a shadow depth pass or samples the cascades yet
+// A pass would render each cascade with viewProj into its own shadow map, and shaders pick the cascade by view depth from splitNear and splitFar
+//
+// Casters are culled per cascade against the sides and far plane of the light frustum only
+// Anything between the light and the cascade can cast into it, so the near plane is left out of the test
+// Casters closer than the near plane have to be rendered with depth clipping disabled, which clamps them to the near plane
+class CascadedShadows {
+public:
+	static const unsigned int MAX_CASCADES = 4;
+
+	struct Settings {
+		unsigned int numCascades = 4;
+		unsigned int resolution = 2048;
+		// Blend between uniform (0) and logarithmic (1) split distances
+		float splitLambda = 0.75f;
+		// Shadows end here, or at the camera far plane if it is closer
+		float maxDistance = 100.f;
+		// How far behind the cascade sphere the light near plane is placed
+		float casterPullback = 50.f;
+	};
+	struct Cascade {
+		// View space depth range covered by the cascade
+		float splitNear;
+		float splitFar;
+		glm::vec3 sphereCenter;
+		float sphereRadius;
+		float texelSize; // World units per shadow map texel
+		glm::mat4 view;
+		glm::mat4 proj;
+		glm::mat4 viewProj;
+		// Normalized, pointing inwards, in order of left, right, bottom, top, far
+		glm::vec4 cullPlanes[5];
+	};
+
+public:
+	CascadedShadows();
+	CascadedShadows(const Settings& settings);
+	~CascadedShadows();
+
+	// Fits all cascades to the camera, proj has to be a left handed perspective projection with depth zero to one
+	void update(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& lightDirection);
+
+	// True if a caster with the world space bounds can cast a shadow into the cascade
+	bool isCasterVisible(unsigned int cascade, const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+	// Bit i is set if the caster is visible in cascade i
+	unsigned int getCasterMask(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+
+	void setSettings(const Settings& settings);
+	const Settings& getSettings() const;
+	unsigned int getNumCascades() const;
+	const Cascade& getCascade(unsigned int index) const;
+
+	// Writes numCascades + 1 view depths, the first is near and the last far
+	static void ComputeSplits(float nearZ, float farZ, unsigned int numCascades, float lambda, float* outSplits);
+	// Smallest sphere containing the part of the frustum between two view depths, in view space
+	static void FitSphere(const glm::mat4& proj, float sliceNear, float sliceFar, glm::vec3& outCenter, float& outRadius);
+
+private:
+	Settings m_settings;
+	unsigned int m_numCascades;
+	Cascade m_cascades[MAX_CASCADES];
+
+};
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "pch.h"
+#include "LightGrid.h"
+#include "Sail/utils/ThreadPool.h"
+
+LightGrid::LightGrid(unsigned int numTilesX, unsigned int numTilesY, unsigned int numSlices)
+	: m_numTilesX(numTilesX)
+	, m_numTilesY(numTilesY)
+	, m_numSlices(numSlices)
+	, m_nearZ(0.1f)
+	, m_farZ(1000.f)
+	, m_logFarOverNear(std::log(1000.f / 0.1f))
+	, m_projScaleX(1.f)
+	, m_projScaleY(1.f)
+{
+	m_sliceResults.resize(m_numSlices);
+	m_sliceOffsets.resize(m_numSlices);
+	m_clusters.resize(getNumClusters(), { 0, 0 });
+}
+
+LightGrid::~LightGrid() {
+
+}
+
+void LightGrid::build(const glm::mat4& view, const glm::mat4& proj, const std::vector<PointLight>& lights) {
+	// Extract near and far from the projection matrix (left handed, depth zero to one)
+	m_nearZ = -proj[3][2] / proj[2][2];
+	m_farZ = proj[3][2] / (1.f - proj[2][2]);
+	m_logFarOverNear = std::log(m_farZ / m_nearZ);
+	m_projScaleX = proj[0][0];
+	m_projScaleY = proj[1][1];
+
+	// Copy the light data and find the depth slices each light overlaps
+	m_lightData.resize(lights.size());
+	m_viewLights.resize(lights.size());
+	for (unsigned int i = 0; i < lights.size(); i++) {
+		const PointLight& pl = lights[i];
+		LightData& data = m_lightData[i];
+		data.color = pl.getColor();
+		data.radius = pl.getRadius();
+		data.position = pl.getPosition();
+		data.attConstant = pl.getAttenuation().constant;
+		data.attLinear = pl.getAttenuation().linear;
+		data.attQuadratic = pl.getAttenuation().quadratic;
+
+		ViewLight& vl = m_viewLights[i];
+		vl.position = glm::vec3(view * glm::vec4(pl.getPosition(), 1.f));
+		vl.radius = pl.getRadius();
+		float minZ = vl.position.z - vl.radius;
+		float maxZ = vl.position.z + vl.radius;
+		if (maxZ < m_nearZ || minZ > m_farZ) {
+			// Outside of the depth range, mark as culled
+			vl.firstSlice = 1;
+			vl.lastSlice = 0;
+		} else {
+			vl.firstSlice = getSlice(minZ);
+			vl.lastSlice = getSlice(maxZ);
+		}
+	}
+
+	// Assign lights to clusters, one slice at a time
+	runParallel(&LightGrid::buildSlice);
+
+	// Find where each slice starts in the compact index list
+	unsigned int numIndices = 0;
+	for (unsigned int i = 0; i < m_numSlices; i++) {
+		m_sliceOffsets[i] = numIndices;
+		numIndices += (unsigned int)m_sliceResults[i].indices.size();
+	}
+	m_lightIndices.resize(numIndices);
+
+	runParallel(&LightGrid::writeSlice);
+}
+
+unsigned int LightGrid::getNumTilesX() const {
+	return m_numTilesX;
+}
+unsigned int LightGrid::getNumTilesY() const {
+	return m_numTilesY;
+}
+unsigned int LightGrid::getNumSlices() const {
+	return m_numSlices;
+}
+unsigned int LightGrid::getNumClusters() const {
+	return m_numTilesX * m_numTilesY * m_numSlices;
+}
+float LightGrid::getNearZ() const {
+	return m_nearZ;
+}
+float LightGrid::getFarZ() const {
+	return m_farZ;
+}
+
+unsigned int LightGrid::getClusterIndex(unsigned int tileX, unsigned int tileY, unsigned int slice) const {
+	return tileX + tileY * m_numTilesX + slice * m_numTilesX * m_numTilesY;
+}
+
+unsigned int LightGrid::getSlice(float viewZ) const {
+	if (viewZ <= m_nearZ)
+		return 0;
+	unsigned int slice = (unsigned int)(std::log(viewZ / m_nearZ) / m_logFarOverNear * m_numSlices);
+	return std::min(slice, m_numSlices - 1);
+}
+
+const std::vector<LightGrid::Cluster>& LightGrid::getClusters() const {
+	return m_clusters;
+}
+const std::vector<unsigned int>& LightGrid::getLightIndices() const {
+	return m_lightIndices;
+}
+const std::vector<LightGrid::LightData>& LightGrid::getLightData() const {
+	return m_lightData;
+}
+
+void LightGrid::buildSlice(unsigned int slice) {
+	SliceResult& result = m_sliceResults[slice];
+	unsigned int numTiles = m_numTilesX * m_numTilesY;
+	result.pairs.clear();
+	result.tileCounts.assign(numTiles, 0);
+
+	float sliceNear = getSliceDepth(slice);
+	float sliceFar = getSliceDepth(slice + 1);
+	float tileSizeX = 2.f / m_numTilesX;
+	float tileSizeY = 2.f / m_numTilesY;
+
+	for (unsigned int i = 0; i < m_viewLights.size(); i++) {
+		const ViewLight& vl = m_viewLights[i];
+		if (slice < vl.firstSlice || slice > vl.lastSlice)
+			continue;
+
+		// Bounding box of the light clipped to the slice
+		glm::vec3 boxMin = vl.position - vl.radius;
+		glm::vec3 boxMax = vl.position + vl.radius;
+		float z0 = std::max(boxMin.z, sliceNear);
+		float z1 = std::min(boxMax.z, sliceFar);
+
+		// Project the box to find the range of tiles it might touch
+		float ndcMinX = m_projScaleX * ((boxMin.x < 0.f) ? boxMin.x / z0 : boxMin.x / z1);
+		float ndcMaxX = m_projScaleX * ((boxMax.x > 0.f) ? boxMax.x / z0 : boxMax.x / z1);
+		float ndcMinY = m_projScaleY * ((boxMin.y < 0.f) ? boxMin.y / z0 : boxMin.y / z1);
+		float ndcMaxY = m_projScaleY * ((boxMax.y > 0.f) ? boxMax.y / z0 : boxMax.y / z1);
+		if (ndcMaxX < -1.f || ndcMinX > 1.f || ndcMaxY < -1.f || ndcMinY > 1.f)
+			continue;
+
+		// Tile rows go from the top of the screen and down
+		int tileMinX = glm::clamp((int)((ndcMinX + 1.f) / tileSizeX), 0, (int)m_numTilesX - 1);
+		int tileMaxX = glm::clamp((int)((ndcMaxX + 1.f) / tileSizeX), 0, (int)m_numTilesX - 1);
+		int tileMinY = glm::clamp((int)((1.f - ndcMaxY) / tileSizeY), 0, (int)m_numTilesY - 1);
+		int tileMaxY = glm::clamp((int)((1.f - ndcMinY) / tileSizeY), 0, (int)m_numTilesY - 1);
+
+		float radiusSq = vl.radius * vl.radius;
+		for (int y = tileMinY; y <= tileMaxY; y++) {
+			float ndcTop = 1.f - y * tileSizeY;
+			float ndcBottom = ndcTop - tileSizeY;
+			float clusterMinY = std::min(ndcBottom * sliceNear, ndcBottom * sliceFar) / m_projScaleY;
+			float clusterMaxY = std::max(ndcTop * sliceNear, ndcTop * sliceFar) / m_projScaleY;
+			for (int x = tileMinX; x <= tileMaxX; x++) {
+				float ndcLeft = x * tileSizeX - 1.f;
+				float ndcRight = ndcLeft + tileSizeX;
+				glm::vec3 clusterMin(std::min(ndcLeft * sliceNear, ndcLeft * sliceFar) / m_projScaleX, clusterMinY, sliceNear);
+				glm::vec3 clusterMax(std::max(ndcRight * sliceNear, ndcRight * sliceFar) / m_projScaleX, clusterMaxY, sliceFar);
+
+				// Sphere vs cluster bounding box
+				glm::vec3 closest = glm::clamp(vl.position, clusterMin, clusterMax);
+				glm::vec3 diff = closest - vl.position;
+				if (glm::dot(diff, diff) > radiusSq)
+					continue;
+
+				unsigned int tile = x + y * m_numTilesX;
+				result.pairs.emplace_back(tile, i);
+				result.tileCounts[tile]++;
+			}
+		}
+	}
+
+	// Sort the light indices by tile
+	std::vector<unsigned int> tileOffsets(numTiles);
+	unsigned int offset = 0;
+	for (unsigned int t = 0; t < numTiles; t++) {
+		tileOffsets[t] = offset;
+		offset += result.tileCounts[t];
+	}
+	result.indices.resize(result.pairs.size());
+	for (auto& pair : result.pairs) {
+		result.indices[tileOffsets[pair.first]++] = pair.second;
+	}
+}
+
+void LightGrid::writeSlice(unsigned int slice) {
+	SliceResult& result = m_sliceResults[slice];
+	unsigned int numTiles = m_numTilesX * m_numTilesY;
+	unsigned int offset = m_sliceOffsets[slice];
+
+	for (unsigned int t = 0; t < numTiles; t++) {
+		Cluster& cluster = m_clusters[t + slice * numTiles];
+		cluster.offset = offset;
+		cluster.count = result.tileCounts[t];
+		offset += cluster.count;
+	}
+	if (!result.indices.empty())
+		memcpy(&m_lightIndices[m_sliceOffsets[slice]], result.indices.data(), result.indices.size() * sizeof(unsigned int));
+}
+
+float LightGrid::getSliceDepth(unsigned int slice) const {
+	return m_nearZ * std::pow(m_farZ / m_nearZ, (float)slice / m_numSlices);
+}
+
+void LightGrid::runParallel(void (LightGrid::*func)(unsigned int)) {
+	// Each slice only writes its own results, so they can be processed in any order
+	ThreadPool::GetShared().parallelFor(m_numSlices, [this, func](unsigned int slice) {
+		(this->*func)(slice);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include "PointLight.h"
+
+// Clustered light culling done on the CPU
+// The view frustum is divided into screen tiles and exponentially distributed depth slices
+// Each point light is assigned to all clusters its bounding sphere (from PointLight::getRadius()) overlaps
+//
+// Finding the cluster of a pixel in a shader:
+//   tileX = floor(pixelPos.x / screenWidth * numTilesX)
+//   tileY = floor(pixelPos.y / screenHeight * numTilesY)
+//   slice = floor(log(viewZ / near) / log(far / near) * numSlices)
+//   cluster = tileX + tileY * numTilesX + slice * numTilesX * numTilesY
+// Lights of the cluster are then lightData[lightIndices[clusters[cluster].offset + i]] for i < clusters[cluster].count
+class LightGrid {
+public:
+	// Matching shader struct
+	struct LightData {
+		glm::vec3 color;
+		float radius;
+		glm::vec3 position;
+		float attConstant;
+		float attLinear;
+		float attQuadratic;
+		float padding[2];
+	};
+	// Matching shader struct
+	struct Cluster {
+		unsigned int offset;
+		unsigned int count;
+	};
+
+public:
+	LightGrid(unsigned int numTilesX = 16, unsigned int numTilesY = 9, unsigned int numSlices = 24);
+	~LightGrid();
+
+	// Rebuilds the grid for the given camera and lights
+	// proj has to be a perspective projection, near and far are extracted from it
+	// Slices are built in parallel on the shared ThreadPool
+	void build(const glm::mat4& view, const glm::mat4& proj, const std::vector<PointLight>& lights);
+
+	unsigned int getNumTilesX() const;
+	unsigned int getNumTilesY() const;
+	unsigned int getNumSlices() const;
+	unsigned int getNumClusters() const;
+	float getNearZ() const;
+	float getFarZ() const;
+
+	unsigned int getClusterIndex(unsigned int tileX, unsigned int tileY, unsigned int slice) const;
+	unsigned int getSlice(float viewZ) const;
+
+	const std::vector<Cluster>& getClusters() const;
+	const std::vector<unsigned int>& getLightIndices() const;
+	const std::vector<LightData>& getLightData() const;
+
+private:
+	struct ViewLight {
+		glm::vec3 position;
+		float radius;
+		unsigned int firstSlice;
+		unsigned int lastSlice;
+	};
+	struct SliceResult {
+		// Light indices per tile in this slice, sorted by tile
+		std::vector<unsigned int> indices;
+		std::vector<unsigned int> tileCounts;
+		// Scratch list of (tile, light) pairs
+		std::vector<std::pair<unsigned int, unsigned int>> pairs;
+	};
+
+	void buildSlice(unsigned int slice);
+	float getSliceDepth(unsigned int slice) const;
+	void runParallel(void (LightGrid::*func)(unsigned int));
+	void writeSlice(unsigned int slice);
+
+private:
+	unsigned int m_numTilesX;
+	unsigned int m_numTilesY;
+	unsigned int m_numSlices;
+
+	float m_nearZ;
+	float m_farZ;
+	float m_logFarOverNear;
+	float m_projScaleX;
+	float m_projScaleY;
+
+	std::vector<ViewLight> m_viewLights;
+	std::vector<SliceResult> m_sliceResults;
+	std::vector<unsigned int> m_sliceOffsets;
+
+	std::vector<Cluster> m_clusters;
+	std::vector<unsigned int> m_lightIndices;
+	std::vector<LightData> m_lightData;
+
+};
\ No newline at end of file
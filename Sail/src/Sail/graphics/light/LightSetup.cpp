@@ -1,18 +1,28 @@
 #include "pch.h"
 #include "LightSetup.h"
+#include "Sail/utils/Utils.h"
 
 LightSetup::LightSetup()
 	: m_numPls(0)
+	, m_version(0)
+	, m_dlVersion(0)
+	, m_plVersions(MAX_POINTLIGHTS, 0)
 { }
 LightSetup::~LightSetup() {}
 
 void LightSetup::addPointLight(const PointLight& pl) {
+	if (m_pls.size() == MAX_POINTLIGHTS)
+		Logger::Warning("Too many point lights added to LightSetup, only the first " + std::to_string(MAX_POINTLIGHTS) + " will be used for shading");
 	m_pls.push_back(pl);
-	updateBufferData();
+	updatePointLightData((unsigned int)m_pls.size() - 1);
+}
+void LightSetup::setPointLight(unsigned int index, const PointLight& pl) {
+	m_pls[index] = pl;
+	updatePointLightData(index);
 }
 void LightSetup::setDirectionalLight(const DirectionalLight& dl) {
 	m_dl = dl;
-	updateBufferData();
+	updateDirLightData();
 }
 
 const DirectionalLight& LightSetup::getDL() const {
@@ -30,16 +40,46 @@ const LightSetup::PointLightsBuffer& LightSetup::getPointLightsData() const {
 	return m_plData;
 }
 
-void LightSetup::updateBufferData() {
+uint64_t LightSetup::getVersion() const {
+	return m_version;
+}
+
+bool LightSetup::getChangesSince(uint64_t version, bool& dirLightChanged, unsigned int& firstPointLight, unsigned int& numPointLights) const {
+	dirLightChanged = m_dlVersion > version;
+	firstPointLight = 0;
+	numPointLights = 0;
+	if (m_version <= version)
+		return false;
+
+	unsigned int end = 0;
+	unsigned int numBuffered = std::min((unsigned int)m_pls.size(), MAX_POINTLIGHTS);
+	for (unsigned int i = 0; i < numBuffered; i++) {
+		if (m_plVersions[i] > version) {
+			if (end == 0)
+				firstPointLight = i;
+			end = i + 1;
+		}
+	}
+	numPointLights = (end > 0) ? end - firstPointLight : 0;
+	return dirLightChanged || numPointLights > 0;
+}
+
+void LightSetup::updateDirLightData() {
 	m_dlData.color = m_dl.getColor();
 	m_dlData.direction = m_dl.getDirection();
-	// Copy the x first lights into the buffer
-	for (unsigned int i = 0; i < MAX_POINTLIGHTS_FORWARD_RENDERING; i++) {
-		if (i >= m_pls.size()) break;
-		m_plData.pLights[i].attConstant = m_pls[i].getAttenuation().constant;
-		/*m_plData.pLights[i].attLinear = m_pls[i].getAttenuation().linear;
-		m_plData.pLights[i].attQuadratic = m_pls[i].getAttenuation().quadratic;*/
-		m_plData.pLights[i].color = m_pls[i].getColor();
-		m_plData.pLights[i].position = m_pls[i].getPosition();
-	}
+	m_dlVersion = ++m_version;
+}
+
+void LightSetup::updatePointLightData(unsigned int index) {
+	// Lights outside of the buffer are still available through getPLs()
+	if (index >= MAX_POINTLIGHTS)
+		return;
+
+	m_plData.pLights[index].attConstant = m_pls[index].getAttenuation().constant;
+	/*m_plData.pLights[index].attLinear = m_pls[index].getAttenuation().linear;
+	m_plData.pLights[index].attQuadratic = m_pls[index].getAttenuation().quadratic;*/
+	m_plData.pLights[index].color = m_pls[index].getColor();
+	m_plData.pLights[index].position = m_pls[index].getPosition();
+
+	m_plVersions[index] = ++m_version;
 }
\ No newline at end of file
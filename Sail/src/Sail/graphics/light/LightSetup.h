@@ -7,7 +7,8 @@
 class LightSetup {
 public:
 
-	static const UINT MAX_POINTLIGHTS_FORWARD_RENDERING = 8;  // Max number of lights as set in shader
+	static const UINT MAX_POINTLIGHTS = 512;  // Max number of lights in the light buffer as set in shader
+	static const UINT MAX_POINTLIGHTS_PER_OBJECT = 8;  // Max number of lights affecting each object as set in shader
 
 	struct PointLightStruct {
 		glm::vec3 color = glm::vec3(0.f);
@@ -27,7 +28,7 @@ public:
 	};
 	struct PointLightsBuffer {
 		PointLightsBuffer() { };
-		PointLightStruct pLights[MAX_POINTLIGHTS_FORWARD_RENDERING];
+		PointLightStruct pLights[MAX_POINTLIGHTS];
 	};
 
 
@@ -36,6 +37,7 @@ public:
 	~LightSetup();
 
 	void addPointLight(const PointLight& pl);
+	void setPointLight(unsigned int index, const PointLight& pl);
 	void setDirectionalLight(const DirectionalLight& dl);
 
 	const DirectionalLight& getDL() const;
@@ -44,8 +46,15 @@ public:
 	const DirLightBuffer& getDirLightData() const;
 	const PointLightsBuffer& getPointLightsData() const;
 
+	// Increased by every change to the lights
+	uint64_t getVersion() const;
+	// Changes made after the given version, returns false if there are none
+	// Users remember the version they last uploaded, which lets several renderers share a setup
+	bool getChangesSince(uint64_t version, bool& dirLightChanged, unsigned int& firstPointLight, unsigned int& numPointLights) const;
+
 private:
-	void updateBufferData();
+	void updateDirLightData();
+	void updatePointLightData(unsigned int index);
 private:
 
 	DirectionalLight m_dl;
@@ -55,4 +64,9 @@ private:
 	DirLightBuffer m_dlData;
 	PointLightsBuffer m_plData;
 
+	// Version of the last change to each light
+	uint64_t m_version;
+	uint64_t m_dlVersion;
+	std::vector<uint64_t> m_plVersions;
+
 };
\ No newline at end of file
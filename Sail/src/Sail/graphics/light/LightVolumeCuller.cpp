@@ -0,0 +1,75 @@
+#include "pch.h"
+#include "LightVolumeCuller.h"
+#include "../camera/Camera.h"
+
+LightVolumeCuller::LightVolumeCuller()
+	: m_numCulled(0)
+{
+
+}
+
+LightVolumeCuller::~LightVolumeCuller() {
+
+}
+
+void LightVolumeCuller::cull(Camera& camera, const std::vector<PointLight>& lights) {
+	m_outside.clear();
+	m_inside.clear();
+	m_numCulled = 0;
+
+	// The frustum planes are not normalized, normalize them to be able to test against the sphere radius
+	glm::vec4 planes[6];
+	const Frustum& frustum = camera.getFrustum();
+	for (int i = 0; i < 6; i++)
+		planes[i] = frustum.planes[i] / glm::length(glm::vec3(frustum.planes[i]));
+
+	// The camera counts as inside a volume if any part of the near plane might be inside it
+	// Distance to the near plane corners (left handed, depth zero to one projection)
+	const glm::mat4& proj = camera.getProjMatrix();
+	float nearZ = -proj[3][2] / proj[2][2];
+	float nearCornerDist = nearZ * std::sqrt(1.f + 1.f / (proj[0][0] * proj[0][0]) + 1.f / (proj[1][1] * proj[1][1]));
+	const glm::vec3& camPos = camera.getPosition();
+
+	for (const PointLight& pl : lights) {
+		glm::vec4 center(pl.getPosition(), 1.f);
+		float radius = pl.getRadius();
+
+		bool visible = true;
+		for (int i = 0; i < 6; i++) {
+			if (glm::dot(planes[i], center) > radius) {
+				visible = false;
+				break;
+			}
+		}
+		if (!visible) {
+			m_numCulled++;
+			continue;
+		}
+
+		LightVolume volume;
+		volume.position = pl.getPosition();
+		volume.radius = radius;
+		volume.color = pl.getColor();
+		volume.attConstant = pl.getAttenuation().constant;
+		volume.attLinear = pl.getAttenuation().linear;
+		volume.attQuadratic = pl.getAttenuation().quadratic;
+		volume.padding[0] = volume.padding[1] = 0.f;
+
+		float insideDist = radius + nearCornerDist;
+		glm::vec3 diff = pl.getPosition() - camPos;
+		if (glm::dot(diff, diff) < insideDist * insideDist)
+			m_inside.push_back(volume);
+		else
+			m_outside.push_back(volume);
+	}
+}
+
+const std::vector<LightVolumeCuller::LightVolume>& LightVolumeCuller::getOutsideVolumes() const {
+	return m_outside;
+}
+const std::vector<LightVolumeCuller::LightVolume>& LightVolumeCuller::getInsideVolumes() const {
+	return m_inside;
+}
+unsigned int LightVolumeCuller::getNumCulled() const {
+	return m_numCulled;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include "PointLight.h"
+
+class Camera;
+
+// Prepares point light volumes for instanced deferred shading
+// Light spheres outside of the view frustum are culled and the remaining ones are split depending on
+// if the camera is inside of the sphere or not
+//   Outside - draw front faces with depth testing, pixels behind the volume are still shaded
+//   Inside  - draw back faces without depth testing, the front faces would be clipped by the near plane
+class LightVolumeCuller {
+public:
+	// Matching shader struct, one per instance
+	struct LightVolume {
+		glm::vec3 position;
+		float radius;
+		glm::vec3 color;
+		float attConstant;
+		float attLinear;
+		float attQuadratic;
+		float padding[2];
+	};
+
+public:
+	LightVolumeCuller();
+	~LightVolumeCuller();
+
+	void cull(Camera& camera, const std::vector<PointLight>& lights);
+
+	const std::vector<LightVolume>& getOutsideVolumes() const;
+	const std::vector<LightVolume>& getInsideVolumes() const;
+	unsigned int getNumCulled() const;
+
+private:
+	std::vector<LightVolume> m_outside;
+	std::vector<LightVolume> m_inside;
+	unsigned int m_numCulled;
+
+};
\ No newline at end of file
@@ -1,5 +1,4 @@
 #pragma once
-#include <d3d11.h>
 #include <glm/glm.hpp>
 
 class PointLight {
@@ -10,7 +9,7 @@ public:
 		float quadratic;
 	};
 public:
-	PointLight() : m_color(glm::vec3(0.f)), m_position(glm::vec3(0.f)), m_attenuation({ 1.f, 1.f, 1.f }) { }
+	PointLight() : m_color(glm::vec3(0.f)), m_position(glm::vec3(0.f)), m_attenuation({ 1.f, 1.f, 1.f }) { calculateRadius(); }
 	void setColor(const glm::vec3& color) { m_color = color; }
 	const glm::vec3& getColor() const { return m_color; }
 	void setPosition(const glm::vec3& position) { m_position = position; }
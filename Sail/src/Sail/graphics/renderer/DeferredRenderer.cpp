@@ -16,7 +16,7 @@ DeferredRenderer::DeferredRenderer() {
 	m_dirLightShader = &resman.getShaderSet<DeferredDirectionalLightShader>();
 
 	// Create light volume model
-	m_pointLightVolumeModel = &resman.getModel("normalizedSphere.fbx", m_pointLightShader);
+	m_pointLightVolumeModel = resman.loadModel("normalizedSphere.fbx", m_pointLightShader);
 
 	// Create the fullscreen quad model used for light pass
 	m_screenQuadModel = ModelFactory::ScreenQuadModel::Create(m_dirLightShader);
@@ -156,19 +156,20 @@ void DeferredRenderer::doLightPass(DX11RenderableTexture* output) {
 	m_pointLightShader->setTexture2D("def_texSpecular", *m_gBuffers[SPECULAR_GBUFFER]->getColorSRV());
 	m_pointLightShader->setTexture2D("def_texDepth", *m_gBuffers[DIFFUSE_GBUFFER]->getDepthSRV());
 
-	for (const PointLight& pl : m_lightSetup->getPLs()) {
+	// Cull the light spheres and split them by if the camera is inside them or not
+	m_lightVolumeCuller.cull(*m_camera, m_lightSetup->getPLs());
 
-		m_pointLightShader->setLight(pl, m_camera);
+	// Camera outside of the volume, draw the front faces with depth testing
+	dxm->setDepthMask(GraphicsAPI::WRITE_MASK);
+	dxm->setFaceCulling(GraphicsAPI::BACKFACE);
+	drawLightVolumes(m_lightVolumeCuller.getOutsideVolumes());
 
-		Matrix transform;
-		transform *= Matrix::CreateScale(pl.getRadius());
-		transform *= Matrix::CreateTranslation(pl.getPosition());
-
-		m_pointLightShader->setCBufferVar("sys_mWorld", &transform.Transpose(), sizeof(Matrix));
-		m_pointLightVolumeModel->draw(*this);
-
-	}
+	// Camera inside of the volume, draw the back faces since the front faces might be clipped by the near plane
+	dxm->setDepthMask(GraphicsAPI::BUFFER_DISABLED);
+	dxm->setFaceCulling(GraphicsAPI::FRONTFACE);
+	drawLightVolumes(m_lightVolumeCuller.getInsideVolumes());
 
+	dxm->setFaceCulling(GraphicsAPI::NO_CULLING);
 	dxm->setDepthMask(GraphicsAPI::NO_MASK);
 	dxm->setBlending(GraphicsAPI::NO_BLENDING);
 
@@ -177,6 +178,15 @@ void DeferredRenderer::doLightPass(DX11RenderableTexture* output) {
 
 }
 
+void DeferredRenderer::drawLightVolumes(const std::vector<LightVolumeCuller::LightVolume>& volumes) {
+	// One instanced draw per batch of lights that fit in the instance cbuffer
+	for (unsigned int first = 0; first < volumes.size(); first += DeferredPointLightShader::MAX_INSTANCES) {
+		unsigned int count = std::min((unsigned int)volumes.size() - first, DeferredPointLightShader::MAX_INSTANCES);
+		m_pointLightShader->setLightVolumes(&volumes[first], count);
+		m_pointLightVolumeModel.get()->draw(*this, count);
+	}
+}
+
 void DeferredRenderer::onEvent(Event& event) {
 	EventHandler::dispatch<WindowResizeEvent>(event, FUNC(&DeferredRenderer::onResize));
 }
@@ -2,8 +2,9 @@
 
 #include "Renderer.h"
 #include "API/DX11/DX11RenderableTexture.h"
+#include "../light/LightVolumeCuller.h"
+#include "../geometry/Model.h"
 
-class Model;
 class DeferredPointLightShader;
 class DeferredDirectionalLightShader;
 
@@ -36,6 +37,7 @@ private:
 
 	void beginGeometryPass() const;
 	void doLightPass(DX11RenderableTexture* output);
+	void drawLightVolumes(const std::vector<LightVolumeCuller::LightVolume>& volumes);
 
 private:
 	Camera* m_camera;
@@ -44,9 +46,10 @@ private:
 	std::unique_ptr<DX11RenderableTexture> m_gBuffers[NUM_GBUFFERS - 1];
 
 	std::unique_ptr<Model> m_screenQuadModel;
-	Model* m_pointLightVolumeModel;
+	ModelHandle m_pointLightVolumeModel;
 	DeferredPointLightShader* m_pointLightShader;
 	DeferredDirectionalLightShader* m_dirLightShader;
+	LightVolumeCuller m_lightVolumeCuller;
 
 	// Pointers to the shader resource views used as gbuffers
 	ID3D11RenderTargetView* m_gBufferRTVs[NUM_GBUFFERS];
@@ -0,0 +1,498 @@
+#include "pch.h"
+#include "RenderGraph.h"
+#include "RenderTargetPool.h"
+#include "Sail/api/RenderableTexture.h"
+#include "Sail/utils/Utils.h"
+#include <queue>
+
+namespace {
+	const unsigned int NO_PASS = 0xFFFFFFFF;
+}
+
+bool RenderGraph::TextureDesc::operator==(const TextureDesc& other) const {
+	return width == other.width && height == other.height && format == other.format && flags == other.flags;
+}
+
+unsigned int RenderGraph::TextureDesc::getSizeInBytes() const {
+	unsigned int bytesPerPixel = 4;
+	switch (format) {
+	case R16G16B16A16_FLOAT: bytesPerPixel = 8; break;
+	case R32G32B32A32_FLOAT: bytesPerPixel = 16; break;
+	default: break;
+	}
+	return width * height * bytesPerPixel;
+}
+
+bool RenderGraph::TextureDesc::isDepthFormat() const {
+	return format == D24_UNORM_S8_UINT || format == D32_FLOAT;
+}
+
+RenderGraph::PassBuilder::PassBuilder(RenderGraph& graph, unsigned int pass)
+	: m_graph(graph)
+	, m_pass(pass)
+{
+
+}
+
+RenderGraph::ResourceHandle RenderGraph::PassBuilder::create(const std::string& name, const TextureDesc& desc) {
+	Resource res;
+	res.name = name;
+	res.desc = desc;
+	res.imported = false;
+	res.output = false;
+	res.importedTexture = nullptr;
+	ResourceHandle handle = (ResourceHandle)m_graph.m_resources.size();
+	m_graph.m_resources.push_back(res);
+	m_graph.m_passes[m_pass].creates.push_back(handle);
+	// Creating a resource means writing its first contents
+	return write(handle);
+}
+
+RenderGraph::ResourceHandle RenderGraph::PassBuilder::read(ResourceHandle resource) {
+	if (!m_graph.isValidResource(resource)) {
+		Logger::Error("RenderGraph: pass \"" + m_graph.m_passes[m_pass].name + "\" reads an invalid resource");
+		m_graph.m_valid = false;
+		return INVALID_RESOURCE;
+	}
+	m_graph.m_passes[m_pass].reads.push_back(resource);
+	return resource;
+}
+
+RenderGraph::ResourceHandle RenderGraph::PassBuilder::write(ResourceHandle resource) {
+	if (!m_graph.isValidResource(resource)) {
+		Logger::Error("RenderGraph: pass \"" + m_graph.m_passes[m_pass].name + "\" writes an invalid resource");
+		m_graph.m_valid = false;
+		return INVALID_RESOURCE;
+	}
+	// Writing a resource the pass already writes, such as one it created, adds nothing
+	std::vector<ResourceHandle>& writes = m_graph.m_passes[m_pass].writes;
+	if (std::find(writes.begin(), writes.end(), resource) != writes.end())
+		return resource;
+	writes.push_back(resource);
+	m_graph.m_resources[resource].writers.push_back(m_pass);
+	return resource;
+}
+
+void RenderGraph::PassBuilder::setSideEffect() {
+	m_graph.m_passes[m_pass].sideEffect = true;
+}
+
+RenderGraph::PassResources::PassResources(const RenderGraph& graph)
+	: m_graph(graph)
+{
+
+}
+
+const RenderGraph::TextureDesc& RenderGraph::PassResources::getDesc(ResourceHandle resource) const {
+	return m_graph.m_resources[resource].desc;
+}
+
+RenderableTexture* RenderGraph::PassResources::getTexture(ResourceHandle resource) const {
+	const Resource& res = m_graph.m_resources[resource];
+	if (res.imported)
+		return res.importedTexture;
+	if (res.physical == INVALID_RESOURCE)
+		return nullptr;
+	const Physical& phys = m_graph.m_physical[res.physical];
+	return (phys.pooled) ? phys.pooled : phys.texture.get();
+}
+
+RenderGraph::RenderGraph()
+	: m_pool(nullptr)
+	, m_compiled(false)
+	, m_valid(true)
+{
+
+}
+
+RenderGraph::~RenderGraph() {
+
+}
+
+void RenderGraph::setAllocator(AllocateFunc allocator) {
+	m_allocator = allocator;
+	// Textures from the previous allocator might not be compatible
+	m_physical.clear();
+	m_compiled = false;
+}
+
+void RenderGraph::setPool(RenderTargetPool* pool) {
+	m_pool = pool;
+	m_physical.clear();
+	m_compiled = false;
+}
+
+void RenderGraph::reset() {
+	m_passes.clear();
+	m_resources.clear();
+	m_compiled = false;
+	m_valid = true;
+}
+
+void RenderGraph::addPass(const std::string& name, SetupFunc setup, ExecuteFunc execute) {
+	Pass pass;
+	pass.name = name;
+	pass.execute = execute;
+	pass.sideEffect = false;
+	pass.refCount = 0;
+	pass.culled = false;
+	m_passes.push_back(pass);
+	m_compiled = false;
+
+	PassBuilder builder(*this, (unsigned int)m_passes.size() - 1);
+	if (setup)
+		setup(builder);
+}
+
+RenderGraph::ResourceHandle RenderGraph::importTexture(const std::string& name, const TextureDesc& desc, RenderableTexture* texture) {
+	Resource res;
+	res.name = name;
+	res.desc = desc;
+	res.imported = true;
+	res.output = true;
+	res.importedTexture = texture;
+	m_resources.push_back(res);
+	m_compiled = false;
+	return (ResourceHandle)m_resources.size() - 1;
+}
+
+void RenderGraph::markOutput(ResourceHandle resource) {
+	if (!isValidResource(resource)) {
+		Logger::Error("RenderGraph: tried to mark an invalid resource as output");
+		m_valid = false;
+		return;
+	}
+	m_resources[resource].output = true;
+}
+
+bool RenderGraph::compile() {
+	m_compiled = false;
+	if (!m_valid)
+		return false;
+
+	// Transient resources have to be written by some pass before they can be read
+	for (const Pass& pass : m_passes) {
+		for (ResourceHandle read : pass.reads) {
+			const Resource& res = m_resources[read];
+			if (!res.imported && res.writers.empty()) {
+				Logger::Error("RenderGraph: pass \"" + pass.name + "\" reads \"" + res.name + "\" which no pass writes");
+				return false;
+			}
+		}
+	}
+
+	if (!sortPasses())
+		return false;
+	cullPasses();
+	computeLifetimes();
+	assignPhysical();
+	computeBarriers();
+
+	m_compiled = true;
+	return true;
+}
+
+void RenderGraph::execute() {
+	if (!m_compiled && !compile())
+		return;
+
+	allocatePhysical();
+
+	PassResources resources(*this);
+	for (unsigned int i = 0; i < m_order.size(); i++) {
+		Pass& pass = m_passes[m_order[i]];
+		if (!pass.culled && pass.execute)
+			pass.execute(resources);
+
+		if (m_pool) {
+			// Give back targets that are no longer needed, outputs are kept until the end of the frame
+			for (Physical& phys : m_physical) {
+				if (phys.pooled && phys.lastPass == i) {
+					m_pool->release(phys.pooled);
+					phys.pooled = nullptr;
+				}
+			}
+		}
+	}
+}
+
+const RenderGraph::Stats& RenderGraph::getStats() const {
+	return m_stats;
+}
+
+bool RenderGraph::isPassCulled(const std::string& name) const {
+	for (const Pass& pass : m_passes) {
+		if (pass.name == name)
+			return pass.culled;
+	}
+	return true;
+}
+
+const std::vector<unsigned int>& RenderGraph::getExecutionOrder() const {
+	return m_order;
+}
+
+const std::vector<RenderGraph::Barrier>& RenderGraph::getBarriers(const std::string& name) const {
+	static const std::vector<Barrier> none;
+	for (const Pass& pass : m_passes) {
+		if (pass.name == name)
+			return (pass.culled) ? none : pass.barriers;
+	}
+	return none;
+}
+
+unsigned int RenderGraph::getPhysicalIndex(ResourceHandle resource) const {
+	if (!isValidResource(resource))
+		return INVALID_RESOURCE;
+	return m_resources[resource].physical;
+}
+
+bool RenderGraph::isValidResource(ResourceHandle resource) const {
+	return resource < m_resources.size();
+}
+
+bool RenderGraph::sortPasses() {
+	unsigned int numPasses = (unsigned int)m_passes.size();
+	std::vector<std::vector<unsigned int>> dependents(numPasses);
+	std::vector<unsigned int> numDependencies(numPasses, 0);
+	auto addEdge = [&](unsigned int before, unsigned int after) {
+		if (before == after)
+			return;
+		dependents[before].push_back(after);
+		numDependencies[after]++;
+	};
+
+	// Writers are listed in the order their passes were added
+	for (const Resource& res : m_resources) {
+		for (unsigned int i = 1; i < res.writers.size(); i++)
+			addEdge(res.writers[i - 1], res.writers[i]);
+	}
+	for (unsigned int p = 0; p < numPasses; p++) {
+		for (ResourceHandle read : m_passes[p].reads) {
+			const std::vector<unsigned int>& writers = m_resources[read].writers;
+			auto next = std::lower_bound(writers.begin(), writers.end(), p);
+			bool writesToo = next != writers.end() && *next == p;
+			if (next != writers.begin()) {
+				addEdge(*(next - 1), p);
+				// The next writer may not overwrite the contents before this pass has read them
+				auto later = std::upper_bound(writers.begin(), writers.end(), p);
+				if (later != writers.end())
+					addEdge(p, *later);
+			} else if (!writesToo && !writers.empty()) {
+				// Every writer was added after the reader, it reads what the last of them leaves
+				addEdge(writers.back(), p);
+			}
+		}
+	}
+
+	// Always take the first added pass that is ready, so independent passes keep the order they were added in
+	std::priority_queue<unsigned int, std::vector<unsigned int>, std::greater<unsigned int>> ready;
+	for (unsigned int p = 0; p < numPasses; p++) {
+		if (numDependencies[p] == 0)
+			ready.push(p);
+	}
+	m_order.clear();
+	while (!ready.empty()) {
+		unsigned int p = ready.top();
+		ready.pop();
+		m_order.push_back(p);
+		for (unsigned int dependent : dependents[p]) {
+			if (--numDependencies[dependent] == 0)
+				ready.push(dependent);
+		}
+	}
+	if (m_order.size() < numPasses) {
+		std::string names;
+		for (unsigned int p = 0; p < numPasses; p++) {
+			if (numDependencies[p] > 0)
+				names += ((names.empty()) ? "\"" : ", \"") + m_passes[p].name + "\"";
+		}
+		Logger::Error("RenderGraph: passes " + names + " depend on each other in a cycle");
+		m_order.clear();
+		return false;
+	}
+	return true;
+}
+
+void RenderGraph::cullPasses() {
+	// Passes are referenced by the resources they write, resources by the passes reading them
+	for (Pass& pass : m_passes) {
+		pass.refCount = (unsigned int)pass.writes.size();
+		pass.culled = false;
+	}
+	for (Resource& res : m_resources)
+		res.refCount = 0;
+	for (Pass& pass : m_passes) {
+		for (ResourceHandle read : pass.reads)
+			m_resources[read].refCount++;
+	}
+
+	// Remove unreferenced resources, and passes that end up with nothing referencing their results
+	std::vector<ResourceHandle> unreferenced;
+	for (unsigned int i = 0; i < m_resources.size(); i++) {
+		if (m_resources[i].refCount == 0 && !m_resources[i].output)
+			unreferenced.push_back(i);
+	}
+	while (!unreferenced.empty()) {
+		ResourceHandle handle = unreferenced.back();
+		unreferenced.pop_back();
+		for (unsigned int writer : m_resources[handle].writers) {
+			Pass& pass = m_passes[writer];
+			if (pass.refCount == 0 || --pass.refCount > 0 || pass.sideEffect)
+				continue;
+			pass.culled = true;
+			for (ResourceHandle read : pass.reads) {
+				Resource& res = m_resources[read];
+				if (--res.refCount == 0 && !res.output)
+					unreferenced.push_back(read);
+			}
+		}
+	}
+	// Passes not writing anything are only kept if they have side effects
+	for (Pass& pass : m_passes) {
+		if (pass.writes.empty() && !pass.sideEffect)
+			pass.culled = true;
+	}
+}
+
+void RenderGraph::computeLifetimes() {
+	for (Resource& res : m_resources) {
+		res.firstPass = NO_PASS;
+		res.lastPass = 0;
+		res.physical = INVALID_RESOURCE;
+	}
+	unsigned int numPasses = (unsigned int)m_order.size();
+	m_stats = Stats();
+	m_stats.numPasses = numPasses;
+	for (unsigned int i = 0; i < numPasses; i++) {
+		Pass& pass = m_passes[m_order[i]];
+		if (pass.culled) {
+			m_stats.numCulledPasses++;
+			continue;
+		}
+		auto use = [&](ResourceHandle handle) {
+			Resource& res = m_resources[handle];
+			res.firstPass = std::min(res.firstPass, i);
+			res.lastPass = std::max(res.lastPass, i);
+		};
+		for (ResourceHandle handle : pass.reads) use(handle);
+		for (ResourceHandle handle : pass.writes) use(handle);
+	}
+	for (Resource& res : m_resources) {
+		// Outputs have to stay alive until the end of the frame
+		if (res.output && res.firstPass != NO_PASS)
+			res.lastPass = numPasses;
+	}
+}
+
+void RenderGraph::assignPhysical() {
+	// Transient resources in the order they are first used
+	std::vector<ResourceHandle> transients;
+	for (unsigned int i = 0; i < m_resources.size(); i++) {
+		if (!m_resources[i].imported && m_resources[i].firstPass != NO_PASS)
+			transients.push_back(i);
+	}
+	std::stable_sort(transients.begin(), transients.end(), [&](ResourceHandle a, ResourceHandle b) {
+		return m_resources[a].firstPass < m_resources[b].firstPass;
+	});
+
+	// Keep the previously allocated textures around so matching ones can be reused
+	std::vector<Physical> previous;
+	previous.swap(m_physical);
+
+	for (ResourceHandle handle : transients) {
+		Resource& res = m_resources[handle];
+		m_stats.numTransientResources++;
+		m_stats.transientMemory += res.desc.getSizeInBytes();
+
+		// Reuse the first physical target with the same description that is free by the time this resource is needed
+		for (unsigned int p = 0; p < m_physical.size(); p++) {
+			Physical& phys = m_physical[p];
+			if (phys.desc == res.desc && phys.lastPass < res.firstPass) {
+				res.physical = p;
+				phys.lastPass = res.lastPass;
+				break;
+			}
+		}
+		if (res.physical == INVALID_RESOURCE) {
+			Physical phys;
+			phys.desc = res.desc;
+			phys.pooled = nullptr;
+			phys.lastPass = res.lastPass;
+			res.physical = (unsigned int)m_physical.size();
+			m_physical.push_back(std::move(phys));
+			m_stats.aliasedMemory += res.desc.getSizeInBytes();
+		}
+	}
+	m_stats.numPhysicalResources = (unsigned int)m_physical.size();
+
+	for (Physical& phys : m_physical) {
+		for (Physical& old : previous) {
+			if (old.texture && old.desc == phys.desc) {
+				phys.texture = std::move(old.texture);
+				break;
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < m_passes.size(); i++) {
+		unsigned long long live = 0;
+		for (ResourceHandle handle : transients) {
+			const Resource& res = m_resources[handle];
+			if (res.firstPass <= i && i <= res.lastPass)
+				live += res.desc.getSizeInBytes();
+		}
+		m_stats.peakLiveMemory = std::max(m_stats.peakLiveMemory, live);
+	}
+}
+
+void RenderGraph::computeBarriers() {
+	std::vector<ResourceState> physicalStates(m_physical.size(), UNDEFINED);
+	std::vector<ResourceState> importedStates(m_resources.size(), UNDEFINED);
+	for (Pass& pass : m_passes)
+		pass.barriers.clear();
+
+	for (unsigned int p : m_order) {
+		Pass& pass = m_passes[p];
+		if (pass.culled)
+			continue;
+		// A target can only be in one state during a pass, writing it wins over reading it
+		std::vector<std::pair<ResourceHandle, ResourceState>> uses;
+		auto use = [&uses](ResourceHandle handle, ResourceState state) {
+			for (auto& it : uses) {
+				if (it.first == handle) {
+					if (state != SHADER_READ)
+						it.second = state;
+					return;
+				}
+			}
+			uses.push_back({ handle, state });
+		};
+		for (ResourceHandle handle : pass.reads)
+			use(handle, SHADER_READ);
+		for (ResourceHandle handle : pass.writes)
+			use(handle, (m_resources[handle].desc.isDepthFormat()) ? DEPTH_WRITE : RENDER_TARGET);
+
+		for (auto& it : uses) {
+			const Resource& res = m_resources[it.first];
+			ResourceState& current = (res.imported) ? importedStates[it.first] : physicalStates[res.physical];
+			if (current != it.second)
+				pass.barriers.push_back({ it.first, current, it.second });
+			current = it.second;
+		}
+	}
+}
+
+void RenderGraph::allocatePhysical() {
+	if (m_pool) {
+		for (Physical& phys : m_physical)
+			phys.pooled = m_pool->acquire(phys.desc);
+		return;
+	}
+	if (!m_allocator)
+		return;
+	for (Physical& phys : m_physical) {
+		if (!phys.texture)
+			phys.texture = std::unique_ptr<RenderableTexture>(m_allocator(phys.desc));
+	}
+}
\ No newline at end of file
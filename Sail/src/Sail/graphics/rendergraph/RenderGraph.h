@@ -0,0 +1,191 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class RenderableTexture;
+class RenderTargetPool;
+
+// Frame graph of render passes and the render targets they use
+// Passes declare which resources they create, read and write. compile() then
+//   - orders the passes by their dependencies, keeping the order they were added in where it is free to choose
+//   - culls passes whose results are never used
+//   - finds the first and last pass using each transient resource
+//   - lets transient resources with identical descriptions and non-overlapping lifetimes share one physical target
+//   - plans the state transitions of the targets between the passes
+// compile() does not touch the graphics API, physical targets are only created in execute() through the allocator or pool
+class RenderGraph {
+public:
+	typedef unsigned int ResourceHandle;
+	static const ResourceHandle INVALID_RESOURCE = 0xFFFFFFFF;
+
+	enum Format {
+		R8G8B8A8_UNORM,
+		R10G10B10A2_UNORM,
+		R16G16B16A16_FLOAT,
+		R32G32B32A32_FLOAT,
+		R32_FLOAT,
+		D24_UNORM_S8_UINT,
+		D32_FLOAT
+	};
+	// How a pass uses a resource, and the state its target has to be in for it
+	enum ResourceState {
+		UNDEFINED,
+		RENDER_TARGET,
+		DEPTH_WRITE,
+		SHADER_READ
+	};
+	// Transition to issue before a pass runs
+	// Aliased resources share the state of their physical target, imported ones start out UNDEFINED every frame
+	struct Barrier {
+		ResourceHandle resource;
+		ResourceState before;
+		ResourceState after;
+	};
+
+	struct TextureDesc {
+		unsigned int width;
+		unsigned int height;
+		Format format;
+		unsigned int flags; // API specific bind flags, for example unordered access
+		bool operator==(const TextureDesc& other) const;
+		unsigned int getSizeInBytes() const;
+		bool isDepthFormat() const;
+	};
+
+	// Memory figures are in bytes
+	struct Stats {
+		unsigned int numPasses = 0;
+		unsigned int numCulledPasses = 0;
+		unsigned int numTransientResources = 0;
+		unsigned int numPhysicalResources = 0;
+		// All transient resources allocated separately
+		unsigned long long transientMemory = 0;
+		// Highest sum of transient resources alive during a single pass, the lower bound for aliasing
+		unsigned long long peakLiveMemory = 0;
+		// Memory of the physical resources after aliasing
+		unsigned long long aliasedMemory = 0;
+	};
+
+	// Used in the setup function of a pass to declare the resources it uses
+	class PassBuilder {
+	public:
+		ResourceHandle create(const std::string& name, const TextureDesc& desc);
+		ResourceHandle read(ResourceHandle resource);
+		ResourceHandle write(ResourceHandle resource);
+		// The pass is never culled, use for passes with results outside of the graph (readbacks, debug output, etc.)
+		void setSideEffect();
+
+	private:
+		friend class RenderGraph;
+		PassBuilder(RenderGraph& graph, unsigned int pass);
+		RenderGraph& m_graph;
+		unsigned int m_pass;
+	};
+
+	// Used in the execute function of a pass to get the resources it declared
+	class PassResources {
+	public:
+		const TextureDesc& getDesc(ResourceHandle resource) const;
+		// Returns nullptr when the graph has no allocator or pool
+		// The contents of a transient texture are undefined in the first pass using it
+		RenderableTexture* getTexture(ResourceHandle resource) const;
+
+	private:
+		friend class RenderGraph;
+		PassResources(const RenderGraph& graph);
+		const RenderGraph& m_graph;
+	};
+
+	typedef std::function<void(PassBuilder&)> SetupFunc;
+	typedef std::function<void(const PassResources&)> ExecuteFunc;
+	typedef std::function<RenderableTexture*(const TextureDesc&)> AllocateFunc;
+
+public:
+	RenderGraph();
+	~RenderGraph();
+
+	// Sets the function creating physical targets, the graph takes ownership of the returned textures
+	void setAllocator(AllocateFunc allocator);
+	// Acquires the physical targets from the pool in execute() instead of owning them
+	// Each target is released back to the pool after the last pass using it
+	void setPool(RenderTargetPool* pool);
+
+	// Removes all passes and resources, physical targets are kept and reused by the next compile if they match
+	void reset();
+
+	void addPass(const std::string& name, SetupFunc setup, ExecuteFunc execute);
+	// Resources owned outside of the graph, these are never aliased and passes writing to them are never culled
+	ResourceHandle importTexture(const std::string& name, const TextureDesc& desc, RenderableTexture* texture);
+	// Keeps the passes producing a transient resource even if no pass reads it
+	void markOutput(ResourceHandle resource);
+
+	// Returns false if the graph is invalid or its passes depend on each other in a cycle, errors are logged
+	// Readers run after the writers added before them, or after all writers if every writer was added later
+	// Writers of the same resource keep the order they were added in, and run after the readers added between them
+	bool compile();
+	void execute();
+
+	const Stats& getStats() const;
+	bool isPassCulled(const std::string& name) const;
+	// Pass indices, in the order they were added, sorted in the order execute() runs them
+	const std::vector<unsigned int>& getExecutionOrder() const;
+	// Transitions before the pass in the order they have to be issued, empty for culled and unknown passes
+	const std::vector<Barrier>& getBarriers(const std::string& name) const;
+	// Index of the physical target a resource was assigned, INVALID_RESOURCE for imported resources
+	unsigned int getPhysicalIndex(ResourceHandle resource) const;
+
+private:
+	struct Pass {
+		std::string name;
+		ExecuteFunc execute;
+		std::vector<ResourceHandle> creates;
+		std::vector<ResourceHandle> reads;
+		std::vector<ResourceHandle> writes;
+		bool sideEffect;
+		unsigned int refCount;
+		bool culled;
+		std::vector<Barrier> barriers;
+	};
+	struct Resource {
+		std::string name;
+		TextureDesc desc;
+		bool imported;
+		bool output;
+		RenderableTexture* importedTexture;
+		std::vector<unsigned int> writers;
+		unsigned int refCount;
+		// Positions in the execution order
+		unsigned int firstPass;
+		unsigned int lastPass;
+		unsigned int physical;
+	};
+	struct Physical {
+		TextureDesc desc;
+		unsigned int lastPass;
+		std::unique_ptr<RenderableTexture> texture;
+		RenderableTexture* pooled;
+	};
+
+	bool isValidResource(ResourceHandle resource) const;
+	bool sortPasses();
+	void cullPasses();
+	void computeLifetimes();
+	void assignPhysical();
+	void computeBarriers();
+	void allocatePhysical();
+
+private:
+	AllocateFunc m_allocator;
+	RenderTargetPool* m_pool;
+	std::vector<Pass> m_passes;
+	std::vector<Resource> m_resources;
+	std::vector<Physical> m_physical;
+	std::vector<unsigned int> m_order;
+	bool m_compiled;
+	bool m_valid;
+	Stats m_stats;
+
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "pch.h"
+#include "RenderTargetPool.h"
+#include "Sail/api/RenderableTexture.h"
+#include "Sail/utils/Utils.h"
+
+RenderTargetPool::RenderTargetPool(AllocateFunc allocator, unsigned int maxUnusedFrames)
+	: m_allocator(allocator)
+	, m_maxUnusedFrames(maxUnusedFrames)
+	, m_frame(0)
+{
+
+}
+
+RenderTargetPool::~RenderTargetPool() {
+
+}
+
+RenderableTexture* RenderTargetPool::acquire(const Desc& desc) {
+	for (Entry& entry : m_entries) {
+		if (!entry.inUse && entry.desc == desc) {
+			entry.inUse = true;
+			entry.lastUsedFrame = m_frame;
+			m_stats.numInUse++;
+			m_stats.numReuses++;
+			return entry.target.get();
+		}
+	}
+
+	RenderableTexture* target = (m_allocator) ? m_allocator(desc) : nullptr;
+	if (!target) {
+		Logger::Error("RenderTargetPool: failed to create a render target");
+		return nullptr;
+	}
+	Entry entry;
+	entry.desc = desc;
+	entry.target = std::unique_ptr<RenderableTexture>(target);
+	entry.inUse = true;
+	entry.lastUsedFrame = m_frame;
+	m_entries.push_back(std::move(entry));
+
+	m_stats.numTargets++;
+	m_stats.numInUse++;
+	m_stats.numAllocations++;
+	m_stats.memory += desc.getSizeInBytes();
+	return target;
+}
+
+void RenderTargetPool::release(RenderableTexture* target) {
+	for (Entry& entry : m_entries) {
+		if (entry.target.get() == target) {
+			if (entry.inUse) {
+				entry.inUse = false;
+				m_stats.numInUse--;
+			}
+			return;
+		}
+	}
+	Logger::Warning("RenderTargetPool: tried to release a target not owned by the pool");
+}
+
+void RenderTargetPool::endFrame() {
+	for (unsigned int i = (unsigned int)m_entries.size(); i-- > 0;) {
+		Entry& entry = m_entries[i];
+		entry.inUse = false;
+		if (m_frame - entry.lastUsedFrame > m_maxUnusedFrames)
+			evict(i);
+	}
+	m_stats.numInUse = 0;
+	m_frame++;
+}
+
+void RenderTargetPool::trim() {
+	for (unsigned int i = (unsigned int)m_entries.size(); i-- > 0;) {
+		if (!m_entries[i].inUse)
+			evict(i);
+	}
+}
+
+void RenderTargetPool::setMaxUnusedFrames(unsigned int maxUnusedFrames) {
+	m_maxUnusedFrames = maxUnusedFrames;
+}
+
+const RenderTargetPool::Stats& RenderTargetPool::getStats() const {
+	return m_stats;
+}
+
+void RenderTargetPool::evict(unsigned int index) {
+	m_stats.numTargets--;
+	m_stats.numEvictions++;
+	m_stats.memory -= m_entries[index].desc.getSizeInBytes();
+	// Order does not matter, move the last entry into the free spot
+	if (index != m_entries.size() - 1)
+		m_entries[index] = std::move(m_entries.back());
+	m_entries.pop_back();
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "RenderGraph.h"
+
+class RenderableTexture;
+
+// Shares render targets between users needing targets of the same size, format and flags
+// Targets are acquired for the current frame and returned to the pool on endFrame(), or earlier through release()
+// Targets that have not been acquired for a number of frames are destroyed, which also cleans up targets of old sizes after a resize
+class RenderTargetPool {
+public:
+	typedef RenderGraph::TextureDesc Desc;
+	typedef std::function<RenderableTexture*(const Desc&)> AllocateFunc;
+
+	struct Stats {
+		unsigned int numTargets = 0;
+		unsigned int numInUse = 0;
+		unsigned long long memory = 0; // In bytes
+		// Counted since the pool was created
+		unsigned int numAllocations = 0;
+		unsigned int numReuses = 0;
+		unsigned int numEvictions = 0;
+	};
+
+public:
+	RenderTargetPool(AllocateFunc allocator, unsigned int maxUnusedFrames = 3);
+	~RenderTargetPool();
+
+	// Returns a free target matching the description, creating a new one if there is none
+	RenderableTexture* acquire(const Desc& desc);
+	// Returns the target to the pool before the end of the frame so that later users can get it
+	void release(RenderableTexture* target);
+	// Returns all acquired targets and evicts targets unused for more than maxUnusedFrames frames
+	void endFrame();
+	// Destroys all targets not currently acquired
+	void trim();
+
+	void setMaxUnusedFrames(unsigned int maxUnusedFrames);
+	const Stats& getStats() const;
+
+private:
+	struct Entry {
+		Desc desc;
+		std::unique_ptr<RenderableTexture> target;
+		bool inUse;
+		unsigned long long lastUsedFrame;
+	};
+
+	void evict(unsigned int index);
+
+private:
+	AllocateFunc m_allocator;
+	unsigned int m_maxUnusedFrames;
+	unsigned long long m_frame;
+	std::vector<Entry> m_entries;
+	Stats m_stats;
+
+};
\ No newline at end of file
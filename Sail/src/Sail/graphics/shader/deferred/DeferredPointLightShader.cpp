@@ -13,18 +13,9 @@ DeferredPointLightShader::DeferredPointLightShader()
 DeferredPointLightShader::~DeferredPointLightShader() {
 }
 
-void DeferredPointLightShader::setLight(const PointLight& pl, Camera* camera) {
-
-	LightDataBuffer data;
-	data.color = pl.getColor();
-	data.attCostant = pl.getAttenuation().constant;
-	data.attLinear = pl.getAttenuation().linear;
-	data.attQuadratic = pl.getAttenuation().quadratic;
-	// Set position in view space
-	data.positionVS = glm::vec4(pl.getPosition(), 1.0) * camera->getViewMatrix();
-
-	setCBufferVar("def_pointLightInput", &data, sizeof(data));
-
+void DeferredPointLightShader::setLightVolumes(const LightVolumeCuller::LightVolume* volumes, unsigned int count) {
+	count = std::min(count, MAX_INSTANCES);
+	setCBufferVar("def_lightVolumes", volumes, sizeof(LightVolumeCuller::LightVolume) * count);
 }
 
 
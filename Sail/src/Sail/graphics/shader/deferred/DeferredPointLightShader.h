@@ -1,16 +1,21 @@
 #pragma once
 
 #include "../ShaderPipeline.h"
-#include "../../light/PointLight.h"
+#include "../../light/LightVolumeCuller.h"
 
 class DeferredPointLightShader : public ShaderPipeline {
+public:
+	// Has to match MAX_LIGHT_VOLUMES in the shader
+	static const unsigned int MAX_INSTANCES = 512;
+
 public:
 	DeferredPointLightShader();
 	~DeferredPointLightShader();
 
 	void bind() override;
 
-	void setLight(const PointLight& pl, Camera* camera);
+	// Uploads up to MAX_INSTANCES light volumes, drawn as one instance each
+	void setLightVolumes(const LightVolumeCuller::LightVolume* volumes, unsigned int count);
 
 private:
 
@@ -19,15 +24,6 @@ private:
 	//	glm::mat4 mWV;
 	//	glm::mat4 mP;
 	//};
-	struct LightDataBuffer {
-		glm::vec3 color;
-		float attCostant;
-		float attLinear;
-		float attQuadratic;
-		float padding[2];
-		glm::vec3 positionVS; // View space position of pointlight
-		float padding2;
-	};
 	//glm::mat4 m_mV;
 	//glm::mat4 m_mP;
 
@@ -4,7 +4,7 @@
 
 const std::wstring SailFont::DEFAULT_SPRITEFONT_LOCATION = L"res/fonts/";
 
-SailFont::SailFont(LPCWSTR fontFilename) {
+SailFont::SailFont(const wchar_t* fontFilename) {
 
 	//m_font = std::make_unique<SpriteFont>(Application::getInstance()->getAPI()->getDevice(), (DEFAULT_SPRITEFONT_LOCATION + fontFilename).c_str());
 
@@ -8,7 +8,7 @@ public:
 	static const std::wstring DEFAULT_SPRITEFONT_LOCATION;
 
 public:
-	SailFont(LPCWSTR fontFilename = L"courierNew.spritefont");
+	SailFont(const wchar_t* fontFilename = L"courierNew.spritefont");
 	~SailFont();
 
 	//DirectX::SpriteFont* get();
@@ -0,0 +1,207 @@
+#include "pch.h"
+#include "MipGenerator.h"
+#include "Sail/utils/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <emmintrin.h>
+#include <vector>
+
+namespace {
+	// Rows are handed to the shared pool in groups of at least this many pixels
+	const unsigned int MIN_PIXELS_PER_JOB = 64 * 1024;
+
+	// Conversion tables between sRGB bytes and linear floats
+	// The way back is indexed by 16 bit linear values, fine enough to give the nearest byte even in the darkest part of the curve
+	struct SRGBTables {
+		float toLinear[256];
+		unsigned char fromLinear[65536];
+
+		SRGBTables() {
+			for (unsigned int i = 0; i < 256; i++) {
+				float c = i / 255.f;
+				toLinear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			for (unsigned int i = 0; i < 65536; i++) {
+				float l = i / 65535.f;
+				float c = (l <= 0.0031308f) ? l * 12.92f : 1.055f * std::pow(l, 1.f / 2.4f) - 0.055f;
+				fromLinear[i] = (unsigned char)std::min(255.f, c * 255.f + 0.5f);
+			}
+		}
+	};
+	const SRGBTables& getSRGBTables() {
+		static const SRGBTables tables;
+		return tables;
+	}
+
+	// Sums of the four source pixels of each destination pixel in rows [firstRow, lastRow)
+	// src1 is the second source row, which is the same as the first when the source is one pixel high
+	void filterRowsLinear(const unsigned char* src, unsigned int srcWidth, unsigned int srcHeight, unsigned char* dst, unsigned int dstWidth, unsigned int firstRow, unsigned int lastRow) {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i rounding = _mm_set1_epi16(2);
+		for (unsigned int y = firstRow; y < lastRow; y++) {
+			const unsigned char* src0 = src + (size_t)std::min(y * 2, srcHeight - 1) * srcWidth * 4;
+			const unsigned char* src1 = src + (size_t)std::min(y * 2 + 1, srcHeight - 1) * srcWidth * 4;
+			unsigned char* row = dst + (size_t)y * dstWidth * 4;
+			unsigned int x = 0;
+			// Four destination pixels from eight source pixels in each row, only when the source row has an even width to pair up
+			if (srcWidth == dstWidth * 2) {
+				for (; x + 4 <= dstWidth; x += 4) {
+					__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src0 + x * 8));
+					__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src0 + x * 8 + 16));
+					__m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src1 + x * 8));
+					__m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src1 + x * 8 + 16));
+					// Add the rows as 16 bit channels, then each pixel to its horizontal neighbour
+					__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+					__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+					__m128i lo1 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+					__m128i hi1 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+					__m128i sum0 = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+					__m128i sum1 = _mm_add_epi16(_mm_unpacklo_epi64(lo1, hi1), _mm_unpackhi_epi64(lo1, hi1));
+					sum0 = _mm_srli_epi16(_mm_add_epi16(sum0, rounding), 2);
+					sum1 = _mm_srli_epi16(_mm_add_epi16(sum1, rounding), 2);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(row + x * 4), _mm_packus_epi16(sum0, sum1));
+				}
+			}
+			for (; x < dstWidth; x++) {
+				unsigned int x0 = std::min(x * 2, srcWidth - 1) * 4;
+				unsigned int x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+				for (unsigned int c = 0; c < 4; c++)
+					row[x * 4 + c] = (unsigned char)((src0[x0 + c] + src0[x1 + c] + src1[x0 + c] + src1[x1 + c] + 2) >> 2);
+			}
+		}
+	}
+
+	void filterRowsSRGB(const unsigned char* src, unsigned int srcWidth, unsigned int srcHeight, unsigned char* dst, unsigned int dstWidth, unsigned int firstRow, unsigned int lastRow) {
+		const SRGBTables& tables = getSRGBTables();
+		const __m128 quarter = _mm_set1_ps(0.25f);
+		// Color goes to 16 bit linear for the table lookup, alpha is linear already and goes straight back to a byte
+		const __m128 scale = _mm_setr_ps(65535.f, 65535.f, 65535.f, 255.f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		auto load = [&](const unsigned char* p) {
+			return _mm_setr_ps(tables.toLinear[p[0]], tables.toLinear[p[1]], tables.toLinear[p[2]], (float)p[3] / 255.f);
+		};
+		for (unsigned int y = firstRow; y < lastRow; y++) {
+			const unsigned char* src0 = src + (size_t)std::min(y * 2, srcHeight - 1) * srcWidth * 4;
+			const unsigned char* src1 = src + (size_t)std::min(y * 2 + 1, srcHeight - 1) * srcWidth * 4;
+			unsigned char* row = dst + (size_t)y * dstWidth * 4;
+			for (unsigned int x = 0; x < dstWidth; x++) {
+				unsigned int x0 = std::min(x * 2, srcWidth - 1) * 4;
+				unsigned int x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+				__m128 sum = _mm_add_ps(_mm_add_ps(load(src0 + x0), load(src0 + x1)), _mm_add_ps(load(src1 + x0), load(src1 + x1)));
+				__m128i scaled = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(sum, quarter), scale), half));
+				alignas(16) int values[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(values), scaled);
+				row[x * 4 + 0] = tables.fromLinear[values[0]];
+				row[x * 4 + 1] = tables.fromLinear[values[1]];
+				row[x * 4 + 2] = tables.fromLinear[values[2]];
+				row[x * 4 + 3] = (unsigned char)values[3];
+			}
+		}
+	}
+
+	void filterRowsNormalMap(const unsigned char* src, unsigned int srcWidth, unsigned int srcHeight, unsigned char* dst, unsigned int dstWidth, unsigned int firstRow, unsigned int lastRow) {
+		// Bytes map to [-1, 1] for the vector and [0, 1] for alpha
+		const __m128 decodeScale = _mm_setr_ps(2.f / 255.f, 2.f / 255.f, 2.f / 255.f, 1.f / 255.f);
+		const __m128 decodeBias = _mm_setr_ps(-1.f, -1.f, -1.f, 0.f);
+		const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+		auto load = [&](const unsigned char* p) {
+			__m128i pixel = _mm_cvtsi32_si128(*reinterpret_cast<const int*>(p));
+			pixel = _mm_unpacklo_epi16(_mm_unpacklo_epi8(pixel, _mm_setzero_si128()), _mm_setzero_si128());
+			return _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(pixel), decodeScale), decodeBias);
+		};
+		for (unsigned int y = firstRow; y < lastRow; y++) {
+			const unsigned char* src0 = src + (size_t)std::min(y * 2, srcHeight - 1) * srcWidth * 4;
+			const unsigned char* src1 = src + (size_t)std::min(y * 2 + 1, srcHeight - 1) * srcWidth * 4;
+			unsigned char* row = dst + (size_t)y * dstWidth * 4;
+			for (unsigned int x = 0; x < dstWidth; x++) {
+				unsigned int x0 = std::min(x * 2, srcWidth - 1) * 4;
+				unsigned int x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+				__m128 sum = _mm_add_ps(_mm_add_ps(load(src0 + x0), load(src0 + x1)), _mm_add_ps(load(src1 + x0), load(src1 + x1)));
+				__m128 average = _mm_mul_ps(sum, _mm_set1_ps(0.25f));
+
+				// Normalize the vector, normals that cancel out point straight out of the surface
+				__m128 xyz = _mm_and_ps(average, xyzMask);
+				__m128 squared = _mm_mul_ps(xyz, xyz);
+				float lengthSquared = _mm_cvtss_f32(squared) + _mm_cvtss_f32(_mm_shuffle_ps(squared, squared, 1)) + _mm_cvtss_f32(_mm_shuffle_ps(squared, squared, 2));
+				if (lengthSquared > 1e-8f)
+					xyz = _mm_div_ps(xyz, _mm_set1_ps(std::sqrt(lengthSquared)));
+				else
+					xyz = _mm_setr_ps(0.f, 0.f, 1.f, 0.f);
+				__m128 normal = _mm_or_ps(xyz, _mm_andnot_ps(xyzMask, average));
+
+				// Back to bytes
+				__m128 encoded = _mm_mul_ps(_mm_sub_ps(normal, decodeBias), _mm_setr_ps(127.5f, 127.5f, 127.5f, 255.f));
+				__m128i values = _mm_cvttps_epi32(_mm_add_ps(encoded, _mm_set1_ps(0.5f)));
+				values = _mm_packs_epi32(values, values);
+				*reinterpret_cast<int*>(row + x * 4) = _mm_cvtsi128_si32(_mm_packus_epi16(values, values));
+			}
+		}
+	}
+}
+
+unsigned int MipGenerator::GetNumLevels(unsigned int width, unsigned int height) {
+	unsigned int levels = 1;
+	unsigned int size = std::max(width, height);
+	while (size > 1) {
+		size >>= 1;
+		levels++;
+	}
+	return levels;
+}
+
+unsigned int MipGenerator::GetLevelWidth(unsigned int width, unsigned int level) {
+	return std::max(width >> level, 1U);
+}
+
+size_t MipGenerator::GetLevelOffset(unsigned int width, unsigned int height, unsigned int level) {
+	return GetChainSize(width, height, level);
+}
+
+size_t MipGenerator::GetChainSize(unsigned int width, unsigned int height, unsigned int numLevels) {
+	size_t size = 0;
+	for (unsigned int level = 0; level < numLevels; level++)
+		size += (size_t)GetLevelWidth(width, level) * GetLevelWidth(height, level) * 4;
+	return size;
+}
+
+void MipGenerator::Generate(unsigned char* chain, unsigned int width, unsigned int height, unsigned int numLevels, Filter filter) {
+	auto filterRows = (filter == SRGB) ? &filterRowsSRGB : (filter == NORMAL_MAP) ? &filterRowsNormalMap : &filterRowsLinear;
+	// Build the tables before any jobs need them
+	if (filter == SRGB)
+		getSRGBTables();
+
+	for (unsigned int level = 1; level < numLevels; level++) {
+		unsigned int srcWidth = GetLevelWidth(width, level - 1);
+		unsigned int srcHeight = GetLevelWidth(height, level - 1);
+		unsigned int dstWidth = GetLevelWidth(width, level);
+		unsigned int dstHeight = GetLevelWidth(height, level);
+		const unsigned char* src = chain + GetLevelOffset(width, height, level - 1);
+		unsigned char* dst = chain + GetLevelOffset(width, height, level);
+
+		// Each level reads the one above, so the jobs split the rows of one level at a time
+		// Textures decoded on a pool worker filter the whole level on that thread instead of oversubscribing the cores
+		unsigned int rowsPerJob = std::max(MIN_PIXELS_PER_JOB / dstWidth, 1U);
+		unsigned int numJobs = (dstHeight + rowsPerJob - 1) / rowsPerJob;
+		ThreadPool::GetShared().parallelFor(numJobs, [&](unsigned int job) {
+			unsigned int first = job * rowsPerJob;
+			filterRows(src, srcWidth, srcHeight, dst, dstWidth, first, std::min(first + rowsPerJob, dstHeight));
+		});
+	}
+}
+
+MipGenerator::Filter MipGenerator::GetFilterForFile(const std::string& filename) {
+	std::string name = filename.substr(0, filename.find_last_of('.'));
+	std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+	auto endsWith = [&name](const std::string& suffix) {
+		return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+	};
+	for (const char* suffix : { "_ddn", "_normal", "_nrm", "_n" }) {
+		if (endsWith(suffix))
+			return NORMAL_MAP;
+	}
+	for (const char* suffix : { "_spec", "_mask", "_rough", "_roughness", "_metal", "_metallic", "_ao", "_height", "_bump" }) {
+		if (endsWith(suffix))
+			return LINEAR;
+	}
+	return SRGB;
+}
\ No newline at end of file
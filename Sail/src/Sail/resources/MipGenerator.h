@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+// Builds mip chains of RGBA8 images on the CPU
+// The chain is stored level after level in one buffer, each level tightly packed and half the size of the one above
+// Every level is a 2x2 box filter of the previous one, large levels are split across the shared ThreadPool by rows
+class MipGenerator {
+public:
+	enum Filter {
+		// Color stored as sRGB, averaged in linear space so that the smaller levels do not get darker
+		SRGB,
+		// Data such as masks and specular maps, averaged as stored
+		LINEAR,
+		// Tangent space normals, averaged as vectors and renormalized so that they keep unit length
+		NORMAL_MAP
+	};
+
+public:
+	// Levels down to and including 1x1
+	static unsigned int GetNumLevels(unsigned int width, unsigned int height);
+	static unsigned int GetLevelWidth(unsigned int width, unsigned int level);
+	// Byte offset of a level in the chain
+	static size_t GetLevelOffset(unsigned int width, unsigned int height, unsigned int level);
+	// Bytes taken by the first numLevels levels
+	static size_t GetChainSize(unsigned int width, unsigned int height, unsigned int numLevels);
+
+	// Fills levels 1 to numLevels - 1 of the chain from level 0, which has to be in place at the start of it
+	static void Generate(unsigned char* chain, unsigned int width, unsigned int height, unsigned int numLevels, Filter filter);
+	// Filter for a texture file based on the usual naming conventions, such as a _ddn or _normal suffix for normal maps
+	static Filter GetFilterForFile(const std::string& filename);
+
+};
\ No newline at end of file
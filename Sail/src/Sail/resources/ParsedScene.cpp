@@ -2,6 +2,10 @@
 #include "ParsedScene.h"
 #include "../graphics/geometry/Model.h"
 #include "../utils/Utils.h"
+#include "loaders/CookedMeshLoader.h"
+#include "loaders/MeshCooker.h"
+#include "Sail/graphics/shader/Shader.h"
+#include "Sail/api/shader/ShaderPipeline.h"
 
 const std::string ParsedScene::DEFAULT_MODEL_LOCATION = "res/models/";
 
@@ -11,10 +15,31 @@ ParsedScene::ParsedScene(const std::string& filename, Shader* shader) {
 		Logger::Error("Only FBX models are currently supported! Tried to load \"" + filename + "\"");
 	}
 
+	// Prefer the cooked file, it skips the FBX SDK and uploads the vertices straight from the file
+	std::unique_ptr<CookedMeshLoader> cooked = OpenCookedModel(filename, shader);
+	if (cooked) {
+		cooked->createModel(shader, false);
+		m_model = std::move(cooked->getModel());
+		return;
+	}
+
 	FBXLoader loader(DEFAULT_MODEL_LOCATION + filename, shader);
 	m_model = std::move(loader.getModel());
 }
 
+std::unique_ptr<CookedMeshLoader> ParsedScene::OpenCookedModel(const std::string& filename, Shader* shader) {
+	std::string path = DEFAULT_MODEL_LOCATION + filename;
+	auto cooked = std::make_unique<CookedMeshLoader>(MeshCooker::GetCookedPath(path), path, shader->getPipeline()->getInputLayout().getOrderedInputs());
+	if (!cooked->isValid())
+		return nullptr;
+	return cooked;
+}
+
+ParsedScene::ParsedScene(std::unique_ptr<Model> model)
+	: m_model(std::move(model))
+{
+}
+
 ParsedScene::~ParsedScene() {
 }
 
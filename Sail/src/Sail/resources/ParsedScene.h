@@ -3,6 +3,7 @@
 #include "loaders/FBXLoader.h"
 
 class Model;
+class CookedMeshLoader;
 
 class ParsedScene {
 public:
@@ -10,6 +11,10 @@ public:
 
 public:
 	ParsedScene(const std::string& filename, Shader* shader);
+	// Takes a model created by an FBXLoader that was parsed separately
+	ParsedScene(std::unique_ptr<Model> model);
+	// Maps the cooked file of the model if it is up to date and packed for the input layout of the shader, otherwise returns nullptr
+	static std::unique_ptr<CookedMeshLoader> OpenCookedModel(const std::string& filename, Shader* shader);
 
 	~ParsedScene();
 	Model* getModel();
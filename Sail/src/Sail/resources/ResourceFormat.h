@@ -1,12 +1,60 @@
 #pragma once
 
+#include <cstdint>
+
 namespace ResourceFormat {
 
+	// Block compressed formats store 4x4 pixel blocks, 8 bytes per block for BC1 and 16 for the others
+	enum TextureFormat {
+		R8G8B8A8,
+		BC1, // RGB, for opaque color
+		BC3, // RGB with a separate alpha channel
+		BC5, // Red and green only, for normal maps with z rebuilt in the shader
+		BC7 // RGBA in higher quality than BC3
+	};
+
+	// textureData holds mipLevels levels after each other, starting with the full size image
 	struct TextureData {
 		unsigned int width;
 		unsigned int height;
 		unsigned int channels;
 		unsigned char* textureData;
+		unsigned int mipLevels;
+		TextureFormat format;
+	};
+
+	// Cooked mesh files written by MeshCooker
+	// The file starts with a CookedMeshHeader followed by one CookedMeshEntry per mesh, the texture names and then the vertex and index data
+	// Vertex and index data start at COOKED_MESH_ALIGNMENT byte offsets so they can be used straight from a mapped file
+	const uint32_t COOKED_MESH_MAGIC = 0x48534D53; // "SMSH"
+	const uint32_t COOKED_MESH_VERSION = 2;
+	const uint32_t COOKED_MESH_ALIGNMENT = 16;
+	const uint32_t COOKED_MESH_MAX_INPUTS = 8;
+
+	struct CookedMeshHeader {
+		uint32_t magic;
+		uint32_t version;
+		// Last write time and size of the source file, the cooked file is outdated when they change
+		int64_t sourceTime;
+		uint64_t sourceSize;
+		uint32_t numMeshes;
+		uint32_t vertexStride;
+		uint32_t numInputs;
+		uint8_t inputs[COOKED_MESH_MAX_INPUTS]; // InputLayout::InputType in the order the vertices are interleaved
+		uint32_t padding;
+	};
+	struct CookedMeshEntry {
+		uint32_t numVertices;
+		uint32_t numIndices;
+		uint64_t vertexOffset; // Bytes from the start of the file
+		uint64_t indexOffset; // 32 bit indices
+		float boundsMin[3];
+		float boundsMax[3];
+		uint32_t hasPhong;
+		float ka, kd, ks, shininess;
+		// Diffuse, specular and normal texture names, length 0 if the mesh does not have one
+		uint32_t textureNameOffsets[3];
+		uint32_t textureNameLengths[3];
 	};
 
-}
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "pch.h"
+#include "ResourceHandle.h"
+
+std::atomic<uint64_t> ResourceReferences::s_currentFrame(0);
+
+void ResourceReferences::SetCurrentFrame(uint64_t frame) {
+	s_currentFrame = frame;
+}
+
+uint64_t ResourceReferences::GetCurrentFrame() {
+	return s_currentFrame;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include "ResourceID.h"
+
+// Reference count of a managed resource, shared by the slots of every resource type
+// The frame a resource lost its last reference orders the unreferenced resources for eviction, oldest first
+class ResourceReferences {
+public:
+	ResourceReferences() : m_count(0), m_releaseFrame(0) {}
+
+	void addReference() {
+		m_count++;
+	}
+	void removeReference() {
+		if (--m_count == 0)
+			m_releaseFrame = s_currentFrame.load();
+	}
+	// Restarts the eviction order and delay from the current frame, for references that were not counted
+	void markReleased() {
+		m_releaseFrame = s_currentFrame.load();
+	}
+	unsigned int getReferenceCount() const {
+		return m_count;
+	}
+	// Frame the last reference was removed, only meaningful while the count is zero
+	uint64_t getReleaseFrame() const {
+		return m_releaseFrame;
+	}
+
+	// Advanced by the ResourceManager once per frame
+	static void SetCurrentFrame(uint64_t frame);
+	static uint64_t GetCurrentFrame();
+
+private:
+	std::atomic<unsigned int> m_count;
+	std::atomic<uint64_t> m_releaseFrame;
+	static std::atomic<uint64_t> s_currentFrame;
+
+};
+
+// Reference to a resource that may still be loading
+// Handles from the ResourceManager point to a slot it owns for each resource, so every copy becomes ready when the load is finished
+// get() returns the fallback until then, which lets pending resources be used as if they were loaded
+// Managed handles keep their resource from being evicted, the resource can be freed once the last handle to it is destroyed
+// Pointers returned by get() are only valid while a handle to the resource is held
+template <typename T>
+class ResourceHandle {
+public:
+	enum State {
+		PENDING,
+		READY,
+		FAILED
+	};
+	// Load state of a managed resource, shared by all handles to it
+	struct Slot : public ResourceReferences {
+		Slot(T* fallback = nullptr) : resource(nullptr), fallback(fallback), state(PENDING) {}
+		// Finishes the load for all handles to the slot, a nullptr marks it as failed
+		void resolve(T* resource) {
+			this->resource = resource;
+			state = (resource) ? READY : FAILED;
+		}
+		T* resource;
+		T* fallback;
+		std::atomic<State> state;
+	};
+
+public:
+	// Empty handle, get() returns nullptr
+	ResourceHandle() : m_slot(nullptr), m_resource(nullptr) {}
+	// Handle to a resource that is not managed, it is always ready
+	ResourceHandle(T* resource) : m_slot(nullptr), m_resource(resource) {}
+	// Handle to a managed resource, the slot is kept alive by the reference the handle adds to it
+	ResourceHandle(ResourceID id, Slot* slot) : m_id(id), m_slot(slot), m_resource(nullptr) {
+		if (m_slot)
+			m_slot->addReference();
+	}
+	ResourceHandle(const ResourceHandle& other) : m_id(other.m_id), m_slot(other.m_slot), m_resource(other.m_resource) {
+		if (m_slot)
+			m_slot->addReference();
+	}
+	ResourceHandle(ResourceHandle&& other) : m_id(other.m_id), m_slot(other.m_slot), m_resource(other.m_resource) {
+		other.m_id = ResourceID();
+		other.m_slot = nullptr;
+		other.m_resource = nullptr;
+	}
+	~ResourceHandle() {
+		if (m_slot)
+			m_slot->removeReference();
+	}
+	ResourceHandle& operator=(ResourceHandle other) {
+		std::swap(m_id, other.m_id);
+		std::swap(m_slot, other.m_slot);
+		std::swap(m_resource, other.m_resource);
+		return *this;
+	}
+
+	bool isValid() const { return m_slot || m_resource; }
+	bool isReady() const { return (m_slot) ? m_slot->state == READY : m_resource != nullptr; }
+	bool isPending() const { return m_slot && m_slot->state == PENDING; }
+	bool hasFailed() const { return m_slot && m_slot->state == FAILED; }
+	// Invalid for resources that are not managed
+	ResourceID getID() const { return m_id; }
+	// Drops the reference to the resource and empties the handle
+	void reset() { *this = ResourceHandle(); }
+
+	// The resource if it is ready, otherwise the fallback
+	T* get() const {
+		if (!m_slot)
+			return m_resource;
+		return (m_slot->state == READY) ? m_slot->resource : m_slot->fallback;
+	}
+
+	bool operator==(const ResourceHandle& other) const { return m_id == other.m_id && m_slot == other.m_slot && m_resource == other.m_resource; }
+	bool operator!=(const ResourceHandle& other) const { return !(*this == other); }
+
+private:
+	ResourceID m_id;
+	Slot* m_slot;
+	T* m_resource;
+
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "pch.h"
+#include "ResourceID.h"
+#include "ResourceTable.h"
+#include "Sail/utils/Utils.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace {
+	// Every interned path by its hash, ids can be made on the loading threads so the table is locked
+	struct InternTable {
+		std::mutex mutex;
+		ResourceTable<std::unique_ptr<std::string>> paths;
+	};
+	InternTable& getInternTable() {
+		static InternTable table;
+		return table;
+	}
+}
+
+ResourceID::ResourceID(const std::string& path) {
+	intern(path.data(), path.size());
+}
+
+ResourceID::ResourceID(const char* path) {
+	intern(path, strlen(path));
+}
+
+uint64_t ResourceID::Hash(const char* data, size_t size) {
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 0x100000001B3ULL;
+	}
+	return (hash != 0) ? hash : 1;
+}
+
+const std::string& ResourceID::getPath() const {
+	static const std::string invalid = "<invalid resource id>";
+	InternTable& table = getInternTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	const std::unique_ptr<std::string>* path = table.paths.find(*this);
+	return (path) ? **path : invalid;
+}
+
+void ResourceID::intern(const char* path, size_t size) {
+	m_hash = Hash(path, size);
+	InternTable& table = getInternTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	// Hash() is never 0, so the insert always succeeds
+	std::unique_ptr<std::string>& interned = *table.paths.insert(*this, nullptr);
+	if (!interned)
+		interned = std::make_unique<std::string>(path, size);
+	else if (interned->compare(0, std::string::npos, path, size) != 0) {
+		// Using the id would load the first path under the name of this one, so the lookup fails instead
+		Logger::Error("Resource paths \"" + *interned + "\" and \"" + std::string(path, size) + "\" have the same hash, rename one of them");
+		m_hash = 0;
+	}
+}
+
+void ResourceID::BenchmarkLookups(unsigned int numPaths, unsigned int iterations) {
+	std::vector<std::string> paths;
+	for (unsigned int i = 0; i < numPaths; i++)
+		paths.push_back("sponza/textures/texture_" + std::to_string(i) + ".tga");
+	std::vector<ResourceID> ids(paths.begin(), paths.end());
+	std::map<std::string, unsigned int> map;
+	ResourceTable<unsigned int> table;
+	for (unsigned int i = 0; i < numPaths; i++) {
+		map[paths[i]] = i;
+		table.insert(ids[i], i);
+	}
+
+	// The sum keeps the lookups from being optimized away
+	volatile unsigned int sink = 0;
+	auto time = [&](const std::string& name, auto lookup) {
+		unsigned int sum = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (unsigned int iteration = 0; iteration < iterations; iteration++) {
+			for (unsigned int i = 0; i < numPaths; i++)
+				sum += lookup(i);
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+		sink = sink + sum;
+		Logger::Log(name + ": " + std::to_string(seconds * 1e9 / ((double)numPaths * iterations)) + " ns per lookup");
+	};
+	time("std::map by path", [&](unsigned int i) { return map.find(paths[i])->second; });
+	time("ResourceTable by path", [&](unsigned int i) { return *table.find(ResourceID(paths[i])); });
+	time("ResourceTable by stored id", [&](unsigned int i) { return *table.find(ids[i]); });
+}
\ No newline at end of file
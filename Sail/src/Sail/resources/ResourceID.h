@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+
+// Interned id of a resource path
+// The path is hashed once where it enters the engine, after that resources are looked up and compared by the 64 bit hash alone
+// Every path is registered with its hash, a second path with the same hash is reported and gets the invalid id instead of mixing up their resources
+class ResourceID {
+public:
+	// Invalid id
+	ResourceID() : m_hash(0) {}
+	ResourceID(const std::string& path);
+	ResourceID(const char* path);
+
+	// Id for resources that are looked up by type instead of path, the name is only hashed once per type
+	template <typename T>
+	static ResourceID OfType() {
+		static const ResourceID id(typeid(T).name());
+		return id;
+	}
+	// 64 bit FNV-1a of the data, never 0 since that is the invalid id
+	static uint64_t Hash(const char* data, size_t size);
+	// Looks up numPaths texture like paths in a std::map by string, in a ResourceTable by ids made from the strings
+	// and in a ResourceTable by stored ids, then logs the average time of each lookup
+	static void BenchmarkLookups(unsigned int numPaths, unsigned int iterations);
+
+	uint64_t getHash() const { return m_hash; }
+	bool isValid() const { return m_hash != 0; }
+	// The path the id was made from, for messages and for loading the resource
+	const std::string& getPath() const;
+
+	bool operator==(const ResourceID& other) const { return m_hash == other.m_hash; }
+	bool operator!=(const ResourceID& other) const { return m_hash != other.m_hash; }
+
+private:
+	void intern(const char* path, size_t size);
+
+private:
+	uint64_t m_hash;
+
+};
\ No newline at end of file
@@ -2,52 +2,362 @@
 #include "ResourceManager.h"
 //#include "../graphics/shader/deferred/DeferredGeometryShader.h"
 //#include "audio/SoundManager.h"
+#include "loaders/CookedMeshLoader.h"
 #include "Sail/graphics/shader/Shader.h"
+#include "Sail/graphics/geometry/factory/CubeModel.h"
 #include "Sail/api/shader/ShaderPipeline.h"
+#include "Sail/utils/Profiler.h"
+#include "Sail/Application.h"
+#include <algorithm>
 
-ResourceManager::ResourceManager() {
+const std::string ResourceManager::PLACEHOLDER_TEXTURE = "missing.tga";
+
+ResourceManager::ResourceManager()
+	: m_cpuUsage(0)
+	, m_gpuUsage(0)
+	, m_cpuBudget(SIZE_MAX)
+	, m_gpuBudget(SIZE_MAX)
+	, m_frame(0)
+	, m_evictionDelay(0)
+{
 	//m_soundManager = std::make_unique<SoundManager>();
+	m_failedTexture.resolve(nullptr);
+	m_failedModel.resolve(nullptr);
 }
 ResourceManager::~ResourceManager() {
-	for (auto it : m_shaderSets) {
-		delete it.second;
+	m_shaderSets.forEach([](Shader* shader) {
+		delete shader;
+	});
+}
+
+void ResourceManager::update() {
+	SAIL_PROFILE_FUNCTION();
+	ResourceReferences::SetCurrentFrame(++m_frame);
+	auto isDone = [](auto& future) {
+		return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	};
+	// Finishing a model can start new texture loads, so models go first
+	for (unsigned int i = 0; i < m_pendingModels.size();) {
+		if (isDone(m_pendingModels[i].loader)) {
+			PendingModel pending = std::move(m_pendingModels[i]);
+			m_pendingModels.erase(m_pendingModels.begin() + i);
+			finishModel(pending);
+		} else {
+			i++;
+		}
+	}
+	for (unsigned int i = 0; i < m_pendingTextures.size();) {
+		if (isDone(m_pendingTextures[i].data)) {
+			PendingTexture pending = std::move(m_pendingTextures[i]);
+			m_pendingTextures.erase(m_pendingTextures.begin() + i);
+			finishTexture(pending);
+		} else {
+			i++;
+		}
+	}
+	evictToBudget();
+}
+
+void ResourceManager::waitForPendingLoads() {
+	SAIL_PROFILE_FUNCTION();
+	while (!m_pendingModels.empty() || !m_pendingTextures.empty()) {
+		for (PendingModel& pending : m_pendingModels)
+			pending.loader.wait();
+		for (PendingTexture& pending : m_pendingTextures)
+			pending.data.wait();
+		update();
+	}
+}
+
+unsigned int ResourceManager::getNumPendingLoads() const {
+	return (unsigned int)(m_pendingTextures.size() + m_pendingModels.size());
+}
+
+ResourceManager::MemoryUsage ResourceManager::getMemoryUsage(ResourceType type) const {
+	MemoryUsage usage = { 0, 0, 0, 0 };
+	auto count = [&](const Entry& entry, const ResourceReferences& references, bool loaded) {
+		if (!loaded)
+			return;
+		usage.cpuBytes += entry.cpuBytes;
+		usage.gpuBytes += entry.gpuBytes;
+		usage.numResources++;
+		if (!entry.pinned && references.getReferenceCount() == 0)
+			usage.numUnreferenced++;
+	};
+	if (type == TEXTURE) {
+		m_textures.forEach([&](const std::unique_ptr<TextureEntry>& entry) {
+			count(*entry, entry->slot, entry->data || entry->texture);
+		});
+	} else {
+		m_models.forEach([&](const std::unique_ptr<ModelEntry>& entry) {
+			count(*entry, entry->slot, entry->scene != nullptr);
+		});
+	}
+	return usage;
+}
+
+void ResourceManager::setMemoryBudget(size_t cpuBytes, size_t gpuBytes) {
+	m_cpuBudget = cpuBytes;
+	m_gpuBudget = gpuBytes;
+}
+
+void ResourceManager::evictToBudget() {
+	size_t gpuTarget = m_gpuBudget;
+	// The API counts everything on the GPU in MB, the overshoot is taken from the resources since they are all that can be freed
+	GraphicsAPI* api = Application::getInstance()->getAPI();
+	unsigned int apiUsage = api->getMemoryUsage();
+	unsigned int apiBudget = api->getMemoryBudget();
+	if (apiUsage > apiBudget) {
+		size_t overshoot = (size_t)(apiUsage - apiBudget) * 1000000;
+		gpuTarget = std::min(gpuTarget, (m_gpuUsage > overshoot) ? m_gpuUsage - overshoot : 0);
+	}
+	if (m_cpuUsage > m_cpuBudget || m_gpuUsage > gpuTarget)
+		evict(m_cpuBudget, gpuTarget);
+}
+
+void ResourceManager::evictUnreferenced() {
+	evict(0, 0);
+}
+
+void ResourceManager::evict(size_t cpuTarget, size_t gpuTarget) {
+	SAIL_PROFILE_FUNCTION();
+	// One more than the frames in flight, a resource released during a frame can be used until that frame is done
+	if (m_evictionDelay == 0)
+		m_evictionDelay = Application::getInstance()->getAPI()->getNumFramesInFlight() + 1;
+	struct Candidate {
+		ResourceType type;
+		ResourceID id;
+		uint64_t releaseFrame;
+	};
+	std::vector<Candidate> candidates;
+	m_textures.forEach([&](std::unique_ptr<TextureEntry>& entry) {
+		// Data loaded without a texture is only reachable through getTextureData, which can not count its references
+		if (entry->texture && isEvictable(*entry, entry->slot))
+			candidates.push_back({ TEXTURE, entry->id, entry->slot.getReleaseFrame() });
+	});
+	m_models.forEach([&](std::unique_ptr<ModelEntry>& entry) {
+		if (entry->scene && isEvictable(*entry, entry->slot))
+			candidates.push_back({ MODEL, entry->id, entry->slot.getReleaseFrame() });
+	});
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+		return a.releaseFrame < b.releaseFrame;
+	});
+
+	// Freeing a model drops the handles of its materials, those textures are evicted once their delay has passed
+	for (const Candidate& candidate : candidates) {
+		if (m_cpuUsage <= cpuTarget && m_gpuUsage <= gpuTarget)
+			break;
+		if (candidate.type == TEXTURE) {
+			setUsage(**m_textures.find(candidate.id), 0, 0);
+			m_textures.erase(candidate.id);
+		} else {
+			setUsage(**m_models.find(candidate.id), 0, 0);
+			m_models.erase(candidate.id);
+		}
+	}
+}
+
+bool ResourceManager::isEvictable(const Entry& entry, const ResourceReferences& references) const {
+	return !entry.pinned && references.getReferenceCount() == 0 && references.getReleaseFrame() + m_evictionDelay <= m_frame;
+}
+
+void ResourceManager::updateUsage(TextureEntry& entry) {
+	size_t size = (entry.data) ? entry.data->getByteSize() : 0;
+	setUsage(entry, size, (entry.texture) ? size : 0);
+}
+
+void ResourceManager::updateUsage(ModelEntry& entry) {
+	Model* model = (entry.scene) ? entry.scene->getModel() : nullptr;
+	setUsage(entry, (model) ? model->getCPUMemoryUsage() : 0, (model) ? model->getGPUMemoryUsage() : 0);
+}
+
+void ResourceManager::setUsage(Entry& entry, size_t cpuBytes, size_t gpuBytes) {
+	m_cpuUsage += cpuBytes - entry.cpuBytes;
+	m_gpuUsage += gpuBytes - entry.gpuBytes;
+	entry.cpuBytes = cpuBytes;
+	entry.gpuBytes = gpuBytes;
+}
+
+ResourceManager::TextureEntry& ResourceManager::getTextureEntry(ResourceID id) {
+	std::unique_ptr<TextureEntry>& entry = *m_textures.insert(id, nullptr);
+	if (!entry)
+		entry = std::make_unique<TextureEntry>(id);
+	return *entry;
+}
+
+ResourceManager::ModelEntry& ResourceManager::getModelEntry(ResourceID id) {
+	std::unique_ptr<ModelEntry>& entry = *m_models.insert(id, nullptr);
+	if (!entry)
+		entry = std::make_unique<ModelEntry>(id);
+	return *entry;
+}
+
+void ResourceManager::finishTexture(PendingTexture& pending) {
+	TextureEntry& entry = getTextureEntry(pending.id);
+	// Errors while decoding are rethrown by get(), and creating the texture throws if the API rejects the data
+	// Either fails the load for every handle, which then keep showing the placeholder
+	try {
+		// A synchronous load of the same file could have finished first
+		std::unique_ptr<TextureData> data = pending.data.get();
+		if (!entry.data)
+			entry.data = std::move(data);
+		loadTexture(pending.id);
+	} catch (const std::exception& e) {
+		Logger::Warning("Failed to load the texture \"" + pending.id.getPath() + "\" (" + e.what() + ")");
+		// A texture from a synchronous load is kept
+		if (!entry.texture) {
+			entry.data.reset();
+			updateUsage(entry);
+			entry.slot.resolve(nullptr);
+		}
 	}
 }
 
+void ResourceManager::finishModel(PendingModel& pending) {
+	ModelEntry& entry = getModelEntry(pending.id);
+	try {
+		std::unique_ptr<FBXLoader> loader = pending.loader.get();
+		if (!entry.scene) {
+			loader->createModel(pending.shader, true);
+			entry.scene = std::make_unique<ParsedScene>(std::move(loader->getModel()));
+			entry.slot.resolve(entry.scene->getModel());
+			updateUsage(entry);
+		}
+	} catch (const std::exception& e) {
+		Logger::Warning("Failed to load the model \"" + pending.id.getPath() + "\" (" + e.what() + ")");
+		if (!entry.scene)
+			entry.slot.resolve(nullptr);
+	}
+}
+
+bool ResourceManager::finishPendingTexture(ResourceID id) {
+	for (auto it = m_pendingTextures.begin(); it != m_pendingTextures.end(); ++it) {
+		if (it->id == id) {
+			PendingTexture pending = std::move(*it);
+			m_pendingTextures.erase(it);
+			finishTexture(pending);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ResourceManager::finishPendingModel(ResourceID id) {
+	for (auto it = m_pendingModels.begin(); it != m_pendingModels.end(); ++it) {
+		if (it->id == id) {
+			PendingModel pending = std::move(*it);
+			m_pendingModels.erase(it);
+			finishModel(pending);
+			return true;
+		}
+	}
+	return false;
+}
+
 //
 // TextureData
 //
 
-void ResourceManager::loadTextureData(const std::string& filename) {
-	m_textureDatas.insert({ filename, std::make_unique<TextureData>(filename) });
+void ResourceManager::loadTextureData(ResourceID id) {
+	if (!id.isValid())
+		return;
+	TextureEntry& entry = getTextureEntry(id);
+	if (!entry.data) {
+		entry.data = std::make_unique<TextureData>(id.getPath());
+		updateUsage(entry);
+	}
 }
-TextureData& ResourceManager::getTextureData(const std::string& filename) {
-	auto pos = m_textureDatas.find(filename);
-	if (pos == m_textureDatas.end())
-		Logger::Error("Tried to access a resource that was not loaded. (" + filename + ") \n Use Application::getInstance()->getResourceManager().LoadTextureData(\"filename\") before accessing it.");
+TextureData& ResourceManager::getTextureData(ResourceID id) {
+	if (!id.isValid()) {
+		static const ResourceID placeholder(PLACEHOLDER_TEXTURE);
+		loadTextureData(placeholder);
+		return getTextureData(placeholder);
+	}
+	std::unique_ptr<TextureEntry>* entry = m_textures.find(id);
+	if (!entry || !(*entry)->data)
+		Logger::Error("Tried to access a resource that was not loaded. (" + id.getPath() + ") \n Use Application::getInstance()->getResourceManager().LoadTextureData(\"filename\") before accessing it.");
 
-	return *pos->second;
+	return *(*entry)->data;
 }
-bool ResourceManager::hasTextureData(const std::string& filename) {
-	return m_textureDatas.find(filename) != m_textureDatas.end();
+bool ResourceManager::hasTextureData(ResourceID id) {
+	std::unique_ptr<TextureEntry>* entry = m_textures.find(id);
+	return entry && (*entry)->data;
 }
 
 //
 // DXTexture
 //
 
-void ResourceManager::loadTexture(const std::string& filename) {
-	m_textures.insert({ filename, std::unique_ptr<Texture>(Texture::Create(filename)) });
+void ResourceManager::loadTexture(ResourceID id) {
+	if (!id.isValid())
+		return;
+	TextureEntry& entry = getTextureEntry(id);
+	if (!entry.texture) {
+		entry.texture = std::unique_ptr<Texture>(Texture::Create(id.getPath()));
+		entry.slot.resolve(entry.texture.get());
+		updateUsage(entry);
+	}
+}
+Texture& ResourceManager::getTexture(ResourceID id) {
+	if (!id.isValid())
+		return getPlaceholderTexture();
+	std::unique_ptr<TextureEntry>* entry = m_textures.find(id);
+	if ((!entry || !(*entry)->texture) && finishPendingTexture(id))
+		entry = m_textures.find(id);
+	if (!entry || !(*entry)->texture)
+		Logger::Error("Tried to access a resource that was not loaded. (" + id.getPath() + ") \n Use Application::getInstance()->getResourceManager().loadTexture(\"" + id.getPath() + "\") before accessing it.");
+
+	(*entry)->pinned = true;
+	return *(*entry)->texture;
+}
+bool ResourceManager::hasTexture(ResourceID id) {
+	std::unique_ptr<TextureEntry>* entry = m_textures.find(id);
+	return entry && (*entry)->texture;
 }
-Texture& ResourceManager::getTexture(const std::string& filename) {
-	auto pos = m_textures.find(filename);
-	if (pos == m_textures.end())
-		Logger::Error("Tried to access a resource that was not loaded. (" + filename + ") \n Use Application::getInstance()->getResourceManager().loadTexture(\"" + filename + "\") before accessing it.");
+TextureHandle ResourceManager::loadTextureAsync(ResourceID id) {
+	if (!id.isValid()) {
+		m_failedTexture.fallback = &getPlaceholderTexture();
+		return TextureHandle(id, &m_failedTexture);
+	}
+	TextureEntry& entry = getTextureEntry(id);
+	TextureHandle handle(id, &entry.slot);
+	if (entry.texture)
+		return handle;
+	for (PendingTexture& pending : m_pendingTextures) {
+		if (pending.id == id)
+			return handle;
+	}
+	// Only the upload is left if the data is already loaded
+	if (entry.data) {
+		loadTexture(id);
+		return handle;
+	}
 
-	return *pos->second;
+	entry.slot.fallback = &getPlaceholderTexture();
+	PendingTexture pending;
+	pending.id = id;
+	std::string filename = id.getPath();
+	pending.data = m_loaders.push([filename]() {
+		SAIL_PROFILE_SCOPE("ResourceManager::decodeTexture");
+		return std::make_unique<TextureData>(filename);
+	});
+	m_pendingTextures.push_back(std::move(pending));
+	return handle;
 }
-bool ResourceManager::hasTexture(const std::string& filename) {
-	return m_textures.find(filename) != m_textures.end();
+Texture& ResourceManager::getPlaceholderTexture() {
+	if (!m_placeholder.isReady()) {
+		static const ResourceID id(PLACEHOLDER_TEXTURE);
+		loadTexture(id);
+		m_placeholder = TextureHandle(id, &getTextureEntry(id).slot);
+	}
+	return *m_placeholder.get();
+}
+void ResourceManager::releaseTexture(ResourceID id) {
+	std::unique_ptr<TextureEntry>* entry = m_textures.find(id);
+	if (entry && (*entry)->pinned) {
+		(*entry)->pinned = false;
+		(*entry)->slot.markReleased();
+	}
 }
 
 
@@ -55,24 +365,86 @@ bool ResourceManager::hasTexture(const std::string& filename) {
 // Model
 //
 
-void ResourceManager::loadModel(const std::string& filename, Shader* shader) {
-	// Insert the new model
-	m_fbxModels.insert({ filename, std::make_unique<ParsedScene>(filename, shader) });
+ModelHandle ResourceManager::loadModel(ResourceID id, Shader* shader) {
+	if (!id.isValid())
+		return ModelHandle(id, &m_failedModel);
+	ModelEntry& entry = getModelEntry(id);
+	if (!entry.scene && !finishPendingModel(id)) {
+		entry.scene = std::make_unique<ParsedScene>(id.getPath(), shader);
+		entry.slot.resolve(entry.scene->getModel());
+		updateUsage(entry);
+	}
+	return ModelHandle(id, &entry.slot);
 }
-Model& ResourceManager::getModel(const std::string& filename, Shader* shader) {
-	auto pos = m_fbxModels.find(filename);
-	if (pos == m_fbxModels.end()) {
+Model& ResourceManager::getModel(ResourceID id, Shader* shader) {
+	if (!id.isValid()) {
+		// The same stand in as for FBX files that could not be loaded
+		if (!m_missingModel)
+			m_missingModel = ModelFactory::CubeModel::Create(glm::vec3(0.5f), shader);
+		return *m_missingModel;
+	}
+	std::unique_ptr<ModelEntry>* entry = m_models.find(id);
+	if ((!entry || !(*entry)->scene) && finishPendingModel(id))
+		entry = m_models.find(id);
+	if (!entry || !(*entry)->scene) {
 		// Model was not yet loaded, load it and return
-		loadModel(filename, shader);
-		
-		return *m_fbxModels.find(filename)->second->getModel();
+		loadModel(id, shader);
+		ModelEntry& loaded = getModelEntry(id);
+		loaded.pinned = true;
+		return *loaded.scene->getModel();
 		//Logger::Error("Tried to access an fbx model that was not loaded. (" + filename + ") \n Use Application::getInstance()->getResourceManager().LoadFBXModel(" + filename + ") before accessing it.");
 	}
 
-	return *pos->second->getModel();
+	(*entry)->pinned = true;
+	return *(*entry)->scene->getModel();
+}
+bool ResourceManager::hasModel(ResourceID id) {
+	std::unique_ptr<ModelEntry>* entry = m_models.find(id);
+	return entry && (*entry)->scene;
+}
+void ResourceManager::releaseModel(ResourceID id) {
+	std::unique_ptr<ModelEntry>* entry = m_models.find(id);
+	if (entry && (*entry)->pinned) {
+		(*entry)->pinned = false;
+		(*entry)->slot.markReleased();
+	}
 }
-bool ResourceManager::hasModel(const std::string& filename) {
-	return m_fbxModels.find(filename) != m_fbxModels.end();
+ModelHandle ResourceManager::loadModelAsync(ResourceID id, Shader* shader) {
+	if (!id.isValid())
+		return ModelHandle(id, &m_failedModel);
+	ModelEntry& entry = getModelEntry(id);
+	ModelHandle handle(id, &entry.slot);
+	if (entry.scene)
+		return handle;
+	for (PendingModel& pending : m_pendingModels) {
+		if (pending.id == id)
+			return handle;
+	}
+	const std::string& filename = id.getPath();
+	if (filename.substr(filename.size() - 3) != "fbx") {
+		Logger::Error("Only FBX models are currently supported! Tried to load \"" + filename + "\"");
+	}
+	// Cooked models only need their buffers created, which has to happen on the main thread anyway
+	// The file that was mapped and validated here is used for that, instead of opening it again
+	std::unique_ptr<CookedMeshLoader> cooked = ParsedScene::OpenCookedModel(filename, shader);
+	if (cooked) {
+		cooked->createModel(shader, true);
+		entry.scene = std::make_unique<ParsedScene>(std::move(cooked->getModel()));
+		entry.slot.resolve(entry.scene->getModel());
+		updateUsage(entry);
+		return handle;
+	}
+
+	PendingModel pending;
+	pending.id = id;
+	pending.shader = shader;
+	std::string path = ParsedScene::DEFAULT_MODEL_LOCATION + filename;
+	pending.loader = m_loaders.push([path]() {
+		SAIL_PROFILE_SCOPE("ResourceManager::parseModel");
+		return std::make_unique<FBXLoader>(path);
+	});
+	m_pendingModels.push_back(std::move(pending));
+	return handle;
 }
 
 //void ResourceManager::reloadShaders() {
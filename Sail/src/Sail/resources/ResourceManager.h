@@ -1,35 +1,94 @@
 #pragma once
 
-#include <Map>
 #include <memory>
+#include <future>
 #include "TextureData.h"
 #include "Sail/api/Texture.h"
 #include "ParsedScene.h"
+#include "ResourceHandle.h"
+#include "ResourceTable.h"
+#include "Sail/utils/ThreadPool.h"
 
 //class DeferredGeometryShader;
 class ShaderPipeline;
 class Shader;
 //class SoundManager;
 
+// Async loads decode files on worker threads, update() then creates the GPU resources of finished loads on the main thread
+// The get methods wait for a pending load of the same file instead of loading it again
+// Resources are looked up by ResourceID, file names passed as strings are hashed into one on the way in
+// Textures and models held only through handles are evicted once the last handle is gone and a memory budget is exceeded
+// References from the get methods pin their resource instead, it then stays loaded until it is released
+// Invalid ids, such as those of paths whose hash collides with another path, load nothing
+// Their handles fail right away, and the get methods return the placeholder texture or a cube
 class ResourceManager {
+public:
+	static const std::string PLACEHOLDER_TEXTURE;
+
+	enum ResourceType {
+		TEXTURE,
+		MODEL
+	};
+	// Memory held by the loaded resources of one type, textures count their CPU copy and the texture created from it
+	struct MemoryUsage {
+		size_t cpuBytes;
+		size_t gpuBytes;
+		unsigned int numResources;
+		// Resources no handle or get call is keeping loaded
+		unsigned int numUnreferenced;
+	};
+
 public:
 	ResourceManager();
 	~ResourceManager();
 
+	// Finishes the async loads whose decoding is done and evicts resources while over budget, called once per frame
+	void update();
+	// Blocks until every async load is finished, including textures started by finished models
+	void waitForPendingLoads();
+	unsigned int getNumPendingLoads() const;
+
+	// Shader sets are not counted, there is one of each type and they are never evicted
+	MemoryUsage getMemoryUsage(ResourceType type) const;
+	// Budgets in bytes for all textures and models, both are unlimited by default
+	// The GPU budget is also exceeded while the graphics API reports more usage than its own budget
+	void setMemoryBudget(size_t cpuBytes, size_t gpuBytes);
+	// Evicts unreferenced resources, least recently used first, until the budgets are met
+	void evictToBudget();
+	// Evicts every unreferenced resource, such as when a level is unloaded
+	// Resources released while the GPU may still be drawing with them are left to a later update()
+	void evictUnreferenced();
+
 	// TextureData
-	void loadTextureData(const std::string& filename);
-	TextureData& getTextureData(const std::string& filename);
-	bool hasTextureData(const std::string& filename);
+	void loadTextureData(ResourceID id);
+	// Data loaded on its own is never evicted, data that a texture was created from goes with the texture
+	TextureData& getTextureData(ResourceID id);
+	bool hasTextureData(ResourceID id);
 
 	// Texture
-	void loadTexture(const std::string& filename);
-	Texture& getTexture(const std::string& filename);
-	bool hasTexture(const std::string& filename);
+	void loadTexture(ResourceID id);
+	Texture& getTexture(ResourceID id);
+	bool hasTexture(ResourceID id);
+	// The handle gives the placeholder texture until the texture is ready and keeps the texture loaded while it is held
+	// A file that can not be decoded or uploaded fails the handle, which then keeps giving the placeholder
+	TextureHandle loadTextureAsync(ResourceID id);
+	// Shown in place of textures that are loading, it is held by the manager and never evicted
+	Texture& getPlaceholderTexture();
+	// Unpins a texture from getTexture, references from it are invalid once the texture is evicted
+	void releaseTexture(ResourceID id);
 
 	// Models
-	void loadModel(const std::string& filename, Shader* shader);
-	Model& getModel(const std::string& filename, Shader* shader);
-	bool hasModel(const std::string& filename);
+	// Loads the model unless it is loaded, a pending async load of it is finished instead of parsing the file again
+	// The model and its textures stay loaded while the handle is held
+	ModelHandle loadModel(ResourceID id, Shader* shader);
+	Model& getModel(ResourceID id, Shader* shader);
+	bool hasModel(ResourceID id);
+	// Unpins a model from getModel, references from it are invalid once the model is evicted
+	void releaseModel(ResourceID id);
+	// The handle gives nullptr until the model is ready, its textures are then loaded asynchronously
+	// The handle fails if the file can not be parsed or its buffers can not be created
+	// The model and its textures stay loaded while the handle is held
+	ModelHandle loadModelAsync(ResourceID id, Shader* shader);
 
 	// ShaderSets
 	template <typename T>
@@ -37,29 +96,29 @@ public:
 
 	template <typename T>
 	T& getShaderSet() {
-		auto pos = m_shaderSets.find(typeid(T).name());
-		if (pos == m_shaderSets.end()) {
+		Shader** shader = m_shaderSets.find(ResourceID::OfType<T>());
+		if (!shader) {
 			// ShaderSet was not yet loaded, load it and return
 			loadShaderSet<T>();
-			return dynamic_cast<T&>(*(m_shaderSets.find(typeid(T).name())->second));
+			shader = m_shaderSets.find(ResourceID::OfType<T>());
 		}
 
-		return dynamic_cast<T&>(*pos->second);
+		return dynamic_cast<T&>(**shader);
 	}
 	template <typename T>
 	bool hasShaderSet() {
-		return m_shaderSets.find(typeid(T).name()) != m_shaderSets.end();
+		return m_shaderSets.contains(ResourceID::OfType<T>());
 	}
 
 	template <typename T>
 	void reloadShader() {
-		std::string name = typeid(T).name();
-		auto it = m_shaderSets.find(name);
-		if (it == m_shaderSets.end()) {
+		const std::string& name = ResourceID::OfType<T>().getPath();
+		Shader** it = m_shaderSets.find(ResourceID::OfType<T>());
+		if (!it) {
 			Logger::Log("Cannot reload shader " + name + " since it is not loaded in the first place.");
 			return;
 		}
-		T* shader = dynamic_cast<T*>(it->second);
+		T* shader = dynamic_cast<T*>(*it);
 		shader->~T();
 		shader = new (shader) T();
 		Logger::Log("Reloaded shader " + name);
@@ -69,21 +128,91 @@ public:
 	//SoundManager* getSoundManager();
 
 private:
-	// Textures mapped to their filenames
-	std::map<std::string, std::unique_ptr<TextureData>> m_textureDatas;
-	std::map<std::string, std::unique_ptr<Texture>> m_textures;
-	// Models mapped to their filenames
-	std::map<std::string, std::unique_ptr<ParsedScene>> m_fbxModels;
-	// ShaderSets mapped to their identifiers
-	std::map<std::string, Shader*> m_shaderSets;
+	struct Entry {
+		Entry(ResourceID id) : id(id), pinned(false), cpuBytes(0), gpuBytes(0) {}
+		ResourceID id;
+		// Set when a reference is handed out without a handle to count it
+		bool pinned;
+		// Memory counted for the entry in the usage totals
+		size_t cpuBytes;
+		size_t gpuBytes;
+	};
+	// Everything loaded for one texture file, the slot is shared by the handles to it
+	struct TextureEntry : public Entry {
+		TextureEntry(ResourceID id) : Entry(id) {}
+		std::unique_ptr<TextureData> data;
+		std::unique_ptr<Texture> texture;
+		TextureHandle::Slot slot;
+	};
+	struct ModelEntry : public Entry {
+		ModelEntry(ResourceID id) : Entry(id) {}
+		std::unique_ptr<ParsedScene> scene;
+		ModelHandle::Slot slot;
+	};
+	struct PendingTexture {
+		ResourceID id;
+		std::future<std::unique_ptr<TextureData>> data;
+	};
+	struct PendingModel {
+		ResourceID id;
+		Shader* shader;
+		std::future<std::unique_ptr<FBXLoader>> loader;
+	};
+
+private:
+	// Finds or adds the entry of the file, the id has to be valid
+	TextureEntry& getTextureEntry(ResourceID id);
+	ModelEntry& getModelEntry(ResourceID id);
+	void finishTexture(PendingTexture& pending);
+	void finishModel(PendingModel& pending);
+	// Waits for and finishes the pending load of the file, returns false if there is none
+	bool finishPendingTexture(ResourceID id);
+	bool finishPendingModel(ResourceID id);
+	// Recounts the memory of an entry after something was loaded into it
+	void updateUsage(TextureEntry& entry);
+	void updateUsage(ModelEntry& entry);
+	void setUsage(Entry& entry, size_t cpuBytes, size_t gpuBytes);
+	bool isEvictable(const Entry& entry, const ResourceReferences& references) const;
+	// Evicts unreferenced resources, least recently released first, until the usage is down to the targets
+	void evict(size_t cpuTarget, size_t gpuTarget);
+
+private:
+	// Entries are allocated separately so that handles can point to their slots while the tables grow
+	// Models are destroyed before the textures their materials hold handles to
+	ResourceTable<std::unique_ptr<TextureEntry>> m_textures;
+	ResourceTable<std::unique_ptr<ModelEntry>> m_models;
+	// Declared after the tables so that its reference is dropped before they are destroyed
+	TextureHandle m_placeholder;
+	// ShaderSets mapped to their types
+	ResourceTable<Shader*> m_shaderSets;
 	// SoundManager containing all sounds
 	//std::unique_ptr<SoundManager> m_soundManager;
 
+	// Shared by the handles and get calls of invalid ids
+	TextureHandle::Slot m_failedTexture;
+	ModelHandle::Slot m_failedModel;
+	std::unique_ptr<Model> m_missingModel;
+
+	// Only touched by the main thread, the workers just return their results through the futures
+	std::vector<PendingTexture> m_pendingTextures;
+	std::vector<PendingModel> m_pendingModels;
+
+	// Bytes held by all texture and model entries
+	size_t m_cpuUsage;
+	size_t m_gpuUsage;
+	size_t m_cpuBudget;
+	size_t m_gpuBudget;
+	uint64_t m_frame;
+	// Frames an unreferenced resource is kept before it can be evicted, the GPU may still be drawing with it
+	// Queried from the API on the first eviction, it does not exist yet when the manager is created
+	unsigned int m_evictionDelay;
+	// Declared last to be destroyed first, which waits for the running jobs
+	ThreadPool m_loaders;
+
 };
 
 template <typename T>
 void ResourceManager::loadShaderSet() {
 	// Insert and get the new ShaderSet
-	//m_shaderSets.insert({ typeid(T).name(), std::make_unique<T>() });
-	m_shaderSets.insert({ typeid(T).name(), SAIL_NEW T() });
+	m_shaderSets.insert(ResourceID::OfType<T>(), SAIL_NEW T());
 }
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+#include "ResourceID.h"
+
+// Flat open addressing table from resource ids to values
+// Ids are already well mixed hashes, so their low bits pick the slot and collisions probe linearly to the next slots
+// Values move when the table grows, resources that are pointed to from elsewhere have to be stored through a pointer
+template <typename T>
+class ResourceTable {
+public:
+	ResourceTable() : m_count(0) {}
+
+	T* find(ResourceID id) {
+		if (m_slots.empty() || !id.isValid())
+			return nullptr;
+		size_t mask = m_slots.size() - 1;
+		for (size_t i = id.getHash() & mask;; i = (i + 1) & mask) {
+			if (m_slots[i].key == id.getHash())
+				return &m_slots[i].value;
+			if (m_slots[i].key == 0)
+				return nullptr;
+		}
+	}
+	const T* find(ResourceID id) const {
+		return const_cast<ResourceTable*>(this)->find(id);
+	}
+	bool contains(ResourceID id) const {
+		return find(id) != nullptr;
+	}
+
+	// Inserts the value unless the id is already in the table, returns the value in the table either way
+	// The invalid id marks empty slots and can not be a key, inserting it returns nullptr and leaves the table unchanged
+	T* insert(ResourceID id, T value) {
+		if (!id.isValid())
+			return nullptr;
+		// Grow at half full to keep the probe sequences short
+		if ((m_count + 1) * 2 > m_slots.size())
+			grow();
+		return &insertKey(id.getHash(), std::move(value));
+	}
+
+	// Removes the entry of the id, returns false if it was not in the table
+	// The entries after it in the probe sequence are shifted back into the gap, so lookups never need tombstones
+	bool erase(ResourceID id) {
+		if (m_slots.empty() || !id.isValid())
+			return false;
+		size_t mask = m_slots.size() - 1;
+		size_t gap = id.getHash() & mask;
+		for (; m_slots[gap].key != id.getHash(); gap = (gap + 1) & mask) {
+			if (m_slots[gap].key == 0)
+				return false;
+		}
+		for (size_t i = (gap + 1) & mask; m_slots[i].key != 0; i = (i + 1) & mask) {
+			// Entries whose home slot lies after the gap, up to where they are now, have to stay to be found
+			size_t home = m_slots[i].key & mask;
+			bool reachable = (gap < i) ? (home > gap && home <= i) : (home > gap || home <= i);
+			if (!reachable) {
+				m_slots[gap] = std::move(m_slots[i]);
+				gap = i;
+			}
+		}
+		m_slots[gap].key = 0;
+		m_slots[gap].value = T();
+		m_count--;
+		return true;
+	}
+
+	size_t size() const {
+		return m_count;
+	}
+	// Calls function with the value of every entry, in no particular order
+	template <typename Function>
+	void forEach(Function function) {
+		for (Slot& slot : m_slots) {
+			if (slot.key != 0)
+				function(slot.value);
+		}
+	}
+	template <typename Function>
+	void forEach(Function function) const {
+		for (const Slot& slot : m_slots) {
+			if (slot.key != 0)
+				function(slot.value);
+		}
+	}
+	void clear() {
+		m_slots.clear();
+		m_count = 0;
+	}
+
+private:
+	T& insertKey(uint64_t key, T value) {
+		size_t mask = m_slots.size() - 1;
+		size_t i = key & mask;
+		for (; m_slots[i].key != 0; i = (i + 1) & mask) {
+			if (m_slots[i].key == key)
+				return m_slots[i].value;
+		}
+		m_slots[i].key = key;
+		m_slots[i].value = std::move(value);
+		m_count++;
+		return m_slots[i].value;
+	}
+	void grow() {
+		std::vector<Slot> old = std::move(m_slots);
+		m_slots = std::vector<Slot>(old.empty() ? 16 : old.size() * 2);
+		m_count = 0;
+		for (Slot& slot : old) {
+			if (slot.key != 0)
+				insertKey(slot.key, std::move(slot.value));
+		}
+	}
+
+private:
+	struct Slot {
+		uint64_t key = 0;
+		T value = T();
+	};
+	std::vector<Slot> m_slots;
+	size_t m_count;
+
+};
\ No newline at end of file
@@ -0,0 +1,474 @@
+#include "pch.h"
+#include "TextureCompressor.h"
+#include "Sail/utils/Utils.h"
+#include "Sail/utils/ThreadPool.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+namespace {
+	// Rows are handed to the shared pool in groups of at least this many blocks
+	const unsigned int MIN_BLOCKS_PER_JOB = 1024;
+	// Interpolation weights out of 64 for the 4 bit indices of BC7
+	const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	// Principal axis of the points through their mean, found by power iteration on the covariance matrix
+	// Returns false if the points are all the same
+	template<int N>
+	bool principalAxis(const float (*points)[4], float* mean, float* axis) {
+		for (int c = 0; c < N; c++) {
+			mean[c] = 0.f;
+			for (int i = 0; i < 16; i++)
+				mean[c] += points[i][c];
+			mean[c] /= 16.f;
+		}
+		float covariance[N][N] = {};
+		for (int i = 0; i < 16; i++) {
+			for (int a = 0; a < N; a++) {
+				for (int b = a; b < N; b++)
+					covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+			}
+		}
+		for (int a = 0; a < N; a++) {
+			for (int b = 0; b < a; b++)
+				covariance[a][b] = covariance[b][a];
+		}
+		for (int c = 0; c < N; c++)
+			axis[c] = 1.f;
+		for (int iteration = 0; iteration < 8; iteration++) {
+			float next[N];
+			float largest = 0.f;
+			for (int a = 0; a < N; a++) {
+				next[a] = 0.f;
+				for (int b = 0; b < N; b++)
+					next[a] += covariance[a][b] * axis[b];
+				largest = std::max(largest, std::abs(next[a]));
+			}
+			if (largest < 1e-6f)
+				return false;
+			for (int c = 0; c < N; c++)
+				axis[c] = next[c] / largest;
+		}
+		return true;
+	}
+
+	// Picks the two points furthest apart along the principal axis as the starting endpoints
+	template<int N>
+	void findEndpoints(const float (*points)[4], float* end0, float* end1) {
+		float mean[N], axis[N];
+		if (!principalAxis<N>(points, mean, axis)) {
+			for (int c = 0; c < N; c++)
+				end0[c] = end1[c] = points[0][c];
+			return;
+		}
+		float minProjection = 0.f, maxProjection = 0.f;
+		int minIndex = 0, maxIndex = 0;
+		for (int i = 0; i < 16; i++) {
+			float projection = 0.f;
+			for (int c = 0; c < N; c++)
+				projection += (points[i][c] - mean[c]) * axis[c];
+			if (i == 0 || projection < minProjection) {
+				minProjection = projection;
+				minIndex = i;
+			}
+			if (i == 0 || projection > maxProjection) {
+				maxProjection = projection;
+				maxIndex = i;
+			}
+		}
+		for (int c = 0; c < N; c++) {
+			end0[c] = points[maxIndex][c];
+			end1[c] = points[minIndex][c];
+		}
+	}
+
+	// Least squares endpoints for points interpolated with the weights t, returns false if the weights do not constrain both endpoints
+	template<int N>
+	bool fitEndpoints(const float (*points)[4], const float* t, float* end0, float* end1) {
+		float aa = 0.f, ab = 0.f, bb = 0.f;
+		float ax[N] = {}, bx[N] = {};
+		for (int i = 0; i < 16; i++) {
+			float a = 1.f - t[i];
+			float b = t[i];
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (int c = 0; c < N; c++) {
+				ax[c] += a * points[i][c];
+				bx[c] += b * points[i][c];
+			}
+		}
+		float determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f)
+			return false;
+		for (int c = 0; c < N; c++) {
+			end0[c] = std::min(255.f, std::max(0.f, (ax[c] * bb - bx[c] * ab) / determinant));
+			end1[c] = std::min(255.f, std::max(0.f, (bx[c] * aa - ax[c] * ab) / determinant));
+		}
+		return true;
+	}
+
+	// BC1 color block
+
+	uint16_t packRGB565(const float* color) {
+		int r = (int)(color[0] * 31.f / 255.f + 0.5f);
+		int g = (int)(color[1] * 63.f / 255.f + 0.5f);
+		int b = (int)(color[2] * 31.f / 255.f + 0.5f);
+		return (uint16_t)((r << 11) | (g << 5) | b);
+	}
+	void unpackRGB565(uint16_t packed, int* color) {
+		int r = (packed >> 11) & 31;
+		int g = (packed >> 5) & 63;
+		int b = packed & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+	// Picks the nearest of the four colors for each pixel, returns the total squared error
+	int matchColors(const float (*points)[4], uint16_t packed0, uint16_t packed1, uint32_t& indices) {
+		int palette[4][3];
+		unpackRGB565(packed0, palette[0]);
+		unpackRGB565(packed1, palette[1]);
+		for (int c = 0; c < 3; c++) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		int totalError = 0;
+		indices = 0;
+		for (int i = 0; i < 16; i++) {
+			int bestError = INT_MAX;
+			uint32_t bestIndex = 0;
+			for (uint32_t p = 0; p < 4; p++) {
+				int error = 0;
+				for (int c = 0; c < 3; c++) {
+					int difference = (int)points[i][c] - palette[p][c];
+					error += difference * difference;
+				}
+				if (error < bestError) {
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (i * 2);
+			totalError += bestError;
+		}
+		return totalError;
+	}
+	void encodeColorBlock(const float (*points)[4], unsigned char* out) {
+		static const float INDEX_WEIGHTS[4] = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+
+		float end0[3], end1[3];
+		findEndpoints<3>(points, end0, end1);
+		uint16_t packed0 = packRGB565(end0);
+		uint16_t packed1 = packRGB565(end1);
+		uint32_t indices;
+		int error = matchColors(points, packed0, packed1, indices);
+
+		// One round of refitting the endpoints to the chosen indices
+		float t[16];
+		for (int i = 0; i < 16; i++)
+			t[i] = INDEX_WEIGHTS[(indices >> (i * 2)) & 3];
+		if (error > 0 && fitEndpoints<3>(points, t, end0, end1)) {
+			uint16_t refit0 = packRGB565(end0);
+			uint16_t refit1 = packRGB565(end1);
+			uint32_t refitIndices;
+			int refitError = matchColors(points, refit0, refit1, refitIndices);
+			if (refitError < error) {
+				packed0 = refit0;
+				packed1 = refit1;
+				indices = refitIndices;
+			}
+		}
+
+		// The four color mode needs the first endpoint to be the larger one
+		if (packed0 < packed1) {
+			std::swap(packed0, packed1);
+			indices ^= 0x55555555;
+		} else if (packed0 == packed1) {
+			indices = 0;
+		}
+		out[0] = (unsigned char)(packed0 & 0xFF);
+		out[1] = (unsigned char)(packed0 >> 8);
+		out[2] = (unsigned char)(packed1 & 0xFF);
+		out[3] = (unsigned char)(packed1 >> 8);
+		for (int i = 0; i < 4; i++)
+			out[4 + i] = (unsigned char)(indices >> (i * 8));
+	}
+
+	// BC4 single channel block, used for the alpha of BC3 and both channels of BC5
+
+	void encodeChannelBlock(const float (*points)[4], int channel, unsigned char* out) {
+		int values[16];
+		int low = 255, high = 0;
+		for (int i = 0; i < 16; i++) {
+			values[i] = (int)points[i][channel];
+			low = std::min(low, values[i]);
+			high = std::max(high, values[i]);
+		}
+		memset(out, 0, 8);
+		out[0] = (unsigned char)high;
+		out[1] = (unsigned char)low;
+		if (low == high)
+			return;
+
+		// Eight values from the highest to the lowest
+		int palette[8];
+		palette[0] = high;
+		palette[1] = low;
+		for (int p = 2; p < 8; p++)
+			palette[p] = ((8 - p) * high + (p - 1) * low) / 7;
+		uint64_t indices = 0;
+		for (int i = 0; i < 16; i++) {
+			int bestError = INT_MAX;
+			uint64_t bestIndex = 0;
+			for (int p = 0; p < 8; p++) {
+				int error = std::abs(values[i] - palette[p]);
+				if (error < bestError) {
+					bestError = error;
+					bestIndex = (uint64_t)p;
+				}
+			}
+			indices |= bestIndex << (i * 3);
+		}
+		for (int i = 0; i < 6; i++)
+			out[2 + i] = (unsigned char)(indices >> (i * 8));
+	}
+
+	// BC7 block in mode 6, one subset with 7 bit RGBA endpoints, a shared low bit per endpoint and 4 bit indices
+	// The other modes split blocks into partitions, which looks better on sharp edges but takes a much larger search
+
+	struct BC7Endpoints {
+		int quantized[2][4]; // 7 bits
+		int pBits[2];
+		int values[2][4]; // Expanded to 8 bits
+	};
+	void quantizeBC7(const float* end0, const float* end1, int pBit0, int pBit1, BC7Endpoints& endpoints) {
+		const float* ends[2] = { end0, end1 };
+		endpoints.pBits[0] = pBit0;
+		endpoints.pBits[1] = pBit1;
+		for (int e = 0; e < 2; e++) {
+			for (int c = 0; c < 4; c++) {
+				int quantized = (int)std::floor((ends[e][c] - endpoints.pBits[e]) / 2.f + 0.5f);
+				endpoints.quantized[e][c] = std::min(127, std::max(0, quantized));
+				endpoints.values[e][c] = (endpoints.quantized[e][c] << 1) | endpoints.pBits[e];
+			}
+		}
+	}
+	int matchBC7(const float (*points)[4], const BC7Endpoints& endpoints, int* indices) {
+		int palette[16][4];
+		for (int p = 0; p < 16; p++) {
+			for (int c = 0; c < 4; c++)
+				palette[p][c] = ((64 - BC7_WEIGHTS[p]) * endpoints.values[0][c] + BC7_WEIGHTS[p] * endpoints.values[1][c] + 32) >> 6;
+		}
+		int totalError = 0;
+		for (int i = 0; i < 16; i++) {
+			int bestError = INT_MAX;
+			for (int p = 0; p < 16; p++) {
+				int error = 0;
+				for (int c = 0; c < 4; c++) {
+					int difference = (int)points[i][c] - palette[p][c];
+					error += difference * difference;
+				}
+				if (error < bestError) {
+					bestError = error;
+					indices[i] = p;
+				}
+			}
+			totalError += bestError;
+		}
+		return totalError;
+	}
+	// Tries all four combinations of the shared bits, returns the lowest error
+	int quantizeBestBC7(const float (*points)[4], const float* end0, const float* end1, BC7Endpoints& best, int* bestIndices) {
+		int bestError = INT_MAX;
+		for (int pBits = 0; pBits < 4; pBits++) {
+			BC7Endpoints endpoints;
+			int indices[16];
+			quantizeBC7(end0, end1, pBits & 1, pBits >> 1, endpoints);
+			int error = matchBC7(points, endpoints, indices);
+			if (error < bestError) {
+				bestError = error;
+				best = endpoints;
+				memcpy(bestIndices, indices, sizeof(indices));
+			}
+		}
+		return bestError;
+	}
+	class BitWriter {
+	public:
+		BitWriter(unsigned char* out) : m_out(out), m_position(0) {
+			memset(out, 0, 16);
+		}
+		void write(uint32_t value, int numBits) {
+			for (int i = 0; i < numBits; i++, m_position++) {
+				if ((value >> i) & 1)
+					m_out[m_position >> 3] |= (unsigned char)(1 << (m_position & 7));
+			}
+		}
+	private:
+		unsigned char* m_out;
+		int m_position;
+	};
+	void encodeBC7Block(const float (*points)[4], unsigned char* out) {
+		float end0[4], end1[4];
+		findEndpoints<4>(points, end0, end1);
+		BC7Endpoints endpoints;
+		int indices[16];
+		int error = quantizeBestBC7(points, end0, end1, endpoints, indices);
+
+		// One round of refitting the endpoints to the chosen indices
+		float t[16];
+		for (int i = 0; i < 16; i++)
+			t[i] = BC7_WEIGHTS[indices[i]] / 64.f;
+		if (error > 0 && fitEndpoints<4>(points, t, end0, end1)) {
+			BC7Endpoints refit;
+			int refitIndices[16];
+			if (quantizeBestBC7(points, end0, end1, refit, refitIndices) < error) {
+				endpoints = refit;
+				memcpy(indices, refitIndices, sizeof(indices));
+			}
+		}
+
+		// The highest bit of the first index is left out of the block, so it has to be zero
+		if (indices[0] >= 8) {
+			std::swap(endpoints.quantized[0], endpoints.quantized[1]);
+			std::swap(endpoints.pBits[0], endpoints.pBits[1]);
+			for (int i = 0; i < 16; i++)
+				indices[i] = 15 - indices[i];
+		}
+
+		BitWriter writer(out);
+		writer.write(1 << 6, 7);
+		for (int c = 0; c < 4; c++) {
+			writer.write(endpoints.quantized[0][c], 7);
+			writer.write(endpoints.quantized[1][c], 7);
+		}
+		writer.write(endpoints.pBits[0], 1);
+		writer.write(endpoints.pBits[1], 1);
+		writer.write(indices[0], 3);
+		for (int i = 1; i < 16; i++)
+			writer.write(indices[i], 4);
+	}
+
+	void encodeBlock(ResourceFormat::TextureFormat format, const float (*points)[4], unsigned char* out) {
+		switch (format) {
+		case ResourceFormat::BC1:
+			encodeColorBlock(points, out);
+			break;
+		case ResourceFormat::BC3:
+			encodeChannelBlock(points, 3, out);
+			encodeColorBlock(points, out + 8);
+			break;
+		case ResourceFormat::BC5:
+			encodeChannelBlock(points, 0, out);
+			encodeChannelBlock(points, 1, out + 8);
+			break;
+		case ResourceFormat::BC7:
+			encodeBC7Block(points, out);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Encodes the block rows [firstRow, lastRow) of one level
+	// Blocks that reach past the edge of the smallest levels repeat the last row and column
+	void encodeRows(ResourceFormat::TextureFormat format, const unsigned char* src, unsigned int width, unsigned int height, unsigned char* dst, unsigned int firstRow, unsigned int lastRow) {
+		size_t rowPitch = TextureCompressor::GetRowPitch(format, width);
+		size_t blockSize = rowPitch / ((width + 3) / 4);
+		float points[16][4];
+		for (unsigned int by = firstRow; by < lastRow; by++) {
+			for (unsigned int bx = 0; bx < (width + 3) / 4; bx++) {
+				for (unsigned int i = 0; i < 16; i++) {
+					unsigned int x = std::min(bx * 4 + (i & 3), width - 1);
+					unsigned int y = std::min(by * 4 + (i >> 2), height - 1);
+					const unsigned char* pixel = src + ((size_t)y * width + x) * 4;
+					for (int c = 0; c < 4; c++)
+						points[i][c] = pixel[c];
+				}
+				encodeBlock(format, points, dst + by * rowPitch + bx * blockSize);
+			}
+		}
+	}
+}
+
+size_t TextureCompressor::GetRowPitch(ResourceFormat::TextureFormat format, unsigned int width) {
+	switch (format) {
+	case ResourceFormat::BC1:
+		return (size_t)((width + 3) / 4) * 8;
+	case ResourceFormat::BC3:
+	case ResourceFormat::BC5:
+	case ResourceFormat::BC7:
+		return (size_t)((width + 3) / 4) * 16;
+	default:
+		return (size_t)width * 4;
+	}
+}
+
+unsigned int TextureCompressor::GetNumRows(ResourceFormat::TextureFormat format, unsigned int height) {
+	return IsCompressed(format) ? (height + 3) / 4 : height;
+}
+
+size_t TextureCompressor::GetLevelSize(ResourceFormat::TextureFormat format, unsigned int width, unsigned int height, unsigned int level) {
+	return GetRowPitch(format, MipGenerator::GetLevelWidth(width, level)) * GetNumRows(format, MipGenerator::GetLevelWidth(height, level));
+}
+
+size_t TextureCompressor::GetChainSize(ResourceFormat::TextureFormat format, unsigned int width, unsigned int height, unsigned int numLevels) {
+	size_t size = 0;
+	for (unsigned int level = 0; level < numLevels; level++)
+		size += GetLevelSize(format, width, height, level);
+	return size;
+}
+
+bool TextureCompressor::IsCompressed(ResourceFormat::TextureFormat format) {
+	return format != ResourceFormat::R8G8B8A8;
+}
+
+ResourceFormat::TextureFormat TextureCompressor::ChooseFormat(const ResourceFormat::TextureData& data, MipGenerator::Filter filter) {
+	if (data.format != ResourceFormat::R8G8B8A8 || data.width % 4 != 0 || data.height % 4 != 0)
+		return data.format;
+	if (filter == MipGenerator::NORMAL_MAP)
+		return ResourceFormat::BC5;
+	size_t numPixels = (size_t)data.width * data.height;
+	for (size_t i = 0; i < numPixels; i++) {
+		if (data.textureData[i * 4 + 3] != 255)
+			return ResourceFormat::BC7;
+	}
+	return ResourceFormat::BC1;
+}
+
+bool TextureCompressor::Compress(ResourceFormat::TextureData& data, ResourceFormat::TextureFormat format) {
+	if (data.format != ResourceFormat::R8G8B8A8 || data.channels != 4 || !data.textureData)
+		return false;
+	if (format == ResourceFormat::R8G8B8A8)
+		return true;
+	// Only the full size level has to be whole blocks, the smaller levels are padded
+	if (data.width % 4 != 0 || data.height % 4 != 0) {
+		Logger::Warning("Textures need sides that are multiples of 4 to be block compressed, got " + std::to_string(data.width) + "x" + std::to_string(data.height));
+		return false;
+	}
+
+	unsigned char* compressed = SAIL_NEW unsigned char[GetChainSize(format, data.width, data.height, data.mipLevels)];
+	for (unsigned int level = 0; level < data.mipLevels; level++) {
+		unsigned int width = MipGenerator::GetLevelWidth(data.width, level);
+		unsigned int height = MipGenerator::GetLevelWidth(data.height, level);
+		const unsigned char* src = data.textureData + MipGenerator::GetLevelOffset(data.width, data.height, level);
+		unsigned char* dst = compressed + GetChainSize(format, data.width, data.height, level);
+
+		unsigned int numRows = GetNumRows(format, height);
+		unsigned int blocksPerRow = (width + 3) / 4;
+		unsigned int rowsPerJob = std::max(MIN_BLOCKS_PER_JOB / blocksPerRow, 1U);
+		unsigned int numJobs = (numRows + rowsPerJob - 1) / rowsPerJob;
+		// Each job writes its own rows, loads already running on a pool worker encode the level on that thread
+		ThreadPool::GetShared().parallelFor(numJobs, [&](unsigned int job) {
+			unsigned int first = job * rowsPerJob;
+			encodeRows(format, src, width, height, dst, first, std::min(first + rowsPerJob, numRows));
+		});
+	}
+
+	Memory::SafeDeleteArr(data.textureData);
+	data.textureData = compressed;
+	data.format = format;
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ResourceFormat.h"
+#include "MipGenerator.h"
+
+// Encodes RGBA8 mip chains into the block compressed formats in ResourceFormat::TextureFormat
+// Meant for the texture cooker, encoding is too slow to run while loading
+// Blocks are encoded independently so each level is split across the shared ThreadPool by rows of blocks
+class TextureCompressor {
+public:
+	// Bytes per row of pixels, or per row of 4x4 blocks for compressed formats
+	static size_t GetRowPitch(ResourceFormat::TextureFormat format, unsigned int width);
+	// Rows of pixels, or rows of blocks for compressed formats
+	static unsigned int GetNumRows(ResourceFormat::TextureFormat format, unsigned int height);
+	static size_t GetLevelSize(ResourceFormat::TextureFormat format, unsigned int width, unsigned int height, unsigned int level);
+	// Bytes taken by the first numLevels levels, which is also the offset of level numLevels
+	static size_t GetChainSize(ResourceFormat::TextureFormat format, unsigned int width, unsigned int height, unsigned int numLevels);
+	static bool IsCompressed(ResourceFormat::TextureFormat format);
+
+	// Format the cooker picks for an image, BC5 for normal maps, BC7 for images using alpha and BC1 for the rest
+	// Images with sides that are not multiples of 4 are kept as RGBA8 since they can not be created with a block compressed format
+	static ResourceFormat::TextureFormat ChooseFormat(const ResourceFormat::TextureData& data, MipGenerator::Filter filter);
+	// Replaces the RGBA8 levels of data with the compressed ones, returns false if data can not be compressed to the format
+	static bool Compress(ResourceFormat::TextureData& data, ResourceFormat::TextureFormat format);
+
+};
\ No newline at end of file
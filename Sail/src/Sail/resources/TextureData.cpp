@@ -1,5 +1,8 @@
 #include "pch.h"
 #include "TextureData.h"
+#include "TextureCompressor.h"
+#include "loaders/DDSLoader.h"
+#include "loaders/TextureCooker.h"
 
 const std::string TextureData::DEFAULT_TEXTURE_LOCATION = "res/textures/";
 
@@ -8,6 +11,8 @@ TextureData::TextureData() {
 	m_data.height = 0;
 	m_data.width = 0;
 	m_data.textureData = nullptr;
+	m_data.mipLevels = 1;
+	m_data.format = ResourceFormat::R8G8B8A8;
 }
 TextureData::TextureData(const std::string& filename) {
 	load(filename);
@@ -17,7 +22,33 @@ TextureData::~TextureData() {
 }
 
 void TextureData::load(const std::string& filename) {
-	FileLoader::TGALoader TGALoader(DEFAULT_TEXTURE_LOCATION + filename, m_data);
+	std::string path = DEFAULT_TEXTURE_LOCATION + filename;
+	std::string cookedPath = TextureCooker::GetCookedPath(path);
+	if (cookedPath == path || TextureCooker::IsCookedFileCurrent(path, cookedPath)) {
+		if (FileLoader::DDSLoader::Load(cookedPath, m_data))
+			return;
+		Logger::Warning("Texture file \"" + cookedPath + "\" could not be read!");
+		if (cookedPath == path)
+			path = DEFAULT_TEXTURE_LOCATION + "missing.tga";
+	}
+	FileLoader::TGALoader TGALoader(path, m_data);
+	generateMips(MipGenerator::GetFilterForFile(filename));
+}
+
+void TextureData::generateMips(MipGenerator::Filter filter) {
+	if (!m_data.textureData || m_data.channels != 4 || m_data.format != ResourceFormat::R8G8B8A8)
+		return;
+	unsigned int numLevels = MipGenerator::GetNumLevels(m_data.width, m_data.height);
+	if (numLevels == m_data.mipLevels)
+		return;
+
+	// The full chain is a third larger than the image, so the image is moved into a new buffer with room for the rest of the levels
+	unsigned char* chain = SAIL_NEW unsigned char[MipGenerator::GetChainSize(m_data.width, m_data.height, numLevels)];
+	memcpy(chain, m_data.textureData, MipGenerator::GetChainSize(m_data.width, m_data.height, 1));
+	Memory::SafeDeleteArr(m_data.textureData);
+	m_data.textureData = chain;
+	m_data.mipLevels = numLevels;
+	MipGenerator::Generate(chain, m_data.width, m_data.height, numLevels, filter);
 }
 
 unsigned int TextureData::getWidth() const {
@@ -33,11 +64,37 @@ unsigned int TextureData::getBytesPerPixel() const {
 	return (m_data.channels * bitsPerChannel) / 8;
 }
 
+ResourceFormat::TextureFormat TextureData::getFormat() const {
+	return m_data.format;
+}
+
 unsigned char* TextureData::getTextureData() const {
 	return m_data.textureData;
 }
+unsigned int TextureData::getMipLevels() const {
+	return m_data.mipLevels;
+}
+unsigned int TextureData::getMipWidth(unsigned int level) const {
+	return MipGenerator::GetLevelWidth(m_data.width, level);
+}
+unsigned int TextureData::getMipHeight(unsigned int level) const {
+	return MipGenerator::GetLevelWidth(m_data.height, level);
+}
+size_t TextureData::getMipRowPitch(unsigned int level) const {
+	return TextureCompressor::GetRowPitch(m_data.format, getMipWidth(level));
+}
+unsigned int TextureData::getMipNumRows(unsigned int level) const {
+	return TextureCompressor::GetNumRows(m_data.format, getMipHeight(level));
+}
+unsigned char* TextureData::getMipData(unsigned int level) const {
+	return m_data.textureData + TextureCompressor::GetChainSize(m_data.format, m_data.width, m_data.height, level);
+}
+size_t TextureData::getByteSize() const {
+	return TextureCompressor::GetChainSize(m_data.format, m_data.width, m_data.height, m_data.mipLevels);
+}
 glm::vec4 TextureData::getPixel(unsigned int x, unsigned int y) {
 
+	if (m_data.format != ResourceFormat::R8G8B8A8) return glm::vec4(0.f);
 	if (x < 0 || x > m_data.width - 1) return glm::vec4(0.f);
 	if (y < 0 || y > m_data.height - 1) return glm::vec4(0.f);
 
@@ -1,9 +1,9 @@
 #pragma once
 
-#include <d3d11.h>
 #include <string>
 #include "loaders/TGALoader.h"
 #include "ResourceFormat.h"
+#include "MipGenerator.h"
 
 class TextureData {
 public:
@@ -14,12 +14,28 @@ public:
 	TextureData(const std::string& filename);
 	~TextureData();
 
+	// Loads the image and builds its mip chain, the filter is picked from the file name
+	// A cooked DDS file next to a targa file is loaded in its place when it is up to date, it already has its mip chain
 	void load(const std::string& filename);
+	// Replaces any existing levels below the full size image with a full chain down to 1x1, only for RGBA8 data
+	void generateMips(MipGenerator::Filter filter);
 
 	unsigned int getWidth() const;
 	unsigned int getHeight() const;
+	// Only meaningful for RGBA8 data, block compressed levels are laid out by getMipRowPitch and getMipNumRows
 	unsigned int getBytesPerPixel() const;
+	ResourceFormat::TextureFormat getFormat() const;
 	unsigned char* getTextureData() const;
+	unsigned int getMipLevels() const;
+	unsigned int getMipWidth(unsigned int level) const;
+	unsigned int getMipHeight(unsigned int level) const;
+	// Bytes per row of pixels, or per row of 4x4 blocks for compressed formats
+	size_t getMipRowPitch(unsigned int level) const;
+	unsigned int getMipNumRows(unsigned int level) const;
+	// Start of a level in the texture data, levels are tightly packed with getMipRowPitch(level) bytes per row
+	unsigned char* getMipData(unsigned int level) const;
+	// Bytes taken by all levels
+	size_t getByteSize() const;
 	glm::vec4 getPixel(unsigned int x, unsigned int y);
 
 private:
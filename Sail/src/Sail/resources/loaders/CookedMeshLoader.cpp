@@ -0,0 +1,115 @@
+#include "pch.h"
+#include "CookedMeshLoader.h"
+#include "FBXLoader.h"
+#include "MeshCooker.h"
+#include "Sail/resources/ResourceFormat.h"
+#include "Sail/utils/Utils.h"
+
+using namespace ResourceFormat;
+
+CookedMeshLoader::CookedMeshLoader(const std::string& cookedPath, const std::string& sourcePath, const std::vector<InputLayout::InputType>& inputOrder)
+	: m_path(cookedPath)
+	, m_valid(false)
+{
+	if (!m_file.open(cookedPath))
+		return;
+	m_valid = validate(sourcePath, inputOrder);
+	if (!m_valid)
+		m_file.close();
+}
+
+CookedMeshLoader::~CookedMeshLoader() {
+
+}
+
+bool CookedMeshLoader::isValid() const {
+	return m_valid;
+}
+
+void CookedMeshLoader::createModel(Shader* shader, bool asyncTextures) {
+	const char* base = m_file.getData();
+	const CookedMeshHeader& header = *(const CookedMeshHeader*)base;
+	const CookedMeshEntry* entries = (const CookedMeshEntry*)(base + sizeof(CookedMeshHeader));
+
+	m_model = std::make_unique<Model>();
+	for (unsigned int i = 0; i < header.numMeshes; i++) {
+		const CookedMeshEntry& entry = entries[i];
+		Mesh::Data data;
+		// The mesh owns its indices, which are stored as unsigned long, the vertices are used straight from the file
+		data.allocate(entry.numVertices, entry.numIndices, 0);
+		data.packedVertices = base + entry.vertexOffset;
+		data.packedStride = header.vertexStride;
+		data.packedBoundsMin = glm::vec3(entry.boundsMin[0], entry.boundsMin[1], entry.boundsMin[2]);
+		data.packedBoundsMax = glm::vec3(entry.boundsMax[0], entry.boundsMax[1], entry.boundsMax[2]);
+		if (entry.numIndices > 0) {
+			const uint32_t* indices = (const uint32_t*)(base + entry.indexOffset);
+			std::copy(indices, indices + entry.numIndices, data.indices);
+		}
+		std::unique_ptr<Mesh> mesh = std::unique_ptr<Mesh>(Mesh::Create(data, shader));
+
+		FBXLoader::ParsedMaterial material;
+		material.hasPhong = entry.hasPhong != 0;
+		material.ka = entry.ka;
+		material.kd = entry.kd;
+		material.ks = entry.ks;
+		material.shininess = entry.shininess;
+		std::string* textures[3] = { &material.diffuseTexture, &material.specularTexture, &material.normalTexture };
+		for (unsigned int t = 0; t < 3; t++)
+			textures[t]->assign(base + entry.textureNameOffsets[t], entry.textureNameLengths[t]);
+		FBXLoader::ApplyMaterial(material, mesh->getMaterial(), asyncTextures);
+
+		m_model->addMesh(std::move(mesh));
+	}
+	// Everything has been uploaded
+	m_file.close();
+}
+
+std::unique_ptr<Model>& CookedMeshLoader::getModel() {
+	return m_model;
+}
+
+bool CookedMeshLoader::validate(const std::string& sourcePath, const std::vector<InputLayout::InputType>& inputOrder) {
+	const char* base = m_file.getData();
+	uint64_t size = m_file.getSize();
+	if (size < sizeof(CookedMeshHeader))
+		return false;
+	const CookedMeshHeader& header = *(const CookedMeshHeader*)base;
+	if (header.magic != COOKED_MESH_MAGIC || header.version != COOKED_MESH_VERSION) {
+		Logger::Warning("Cooked mesh " + m_path + " has an unknown format, cook it again");
+		return false;
+	}
+
+	int64_t sourceTime;
+	uint64_t sourceSize;
+	if (MeshCooker::GetSourceStamp(sourcePath, sourceTime, sourceSize) && (sourceTime != header.sourceTime || sourceSize != header.sourceSize)) {
+		Logger::Log("Cooked mesh " + m_path + " is older than " + sourcePath + ", loading the source instead");
+		return false;
+	}
+
+	bool sameInputs = header.numInputs == inputOrder.size();
+	for (unsigned int i = 0; sameInputs && i < header.numInputs; i++)
+		sameInputs = header.inputs[i] == (uint8_t)inputOrder[i];
+	if (!sameInputs) {
+		Logger::Log("Cooked mesh " + m_path + " was cooked for another input layout, loading the source instead");
+		return false;
+	}
+
+	// Everything the entries point to has to be inside of the file
+	uint64_t entriesEnd = sizeof(CookedMeshHeader) + (uint64_t)header.numMeshes * sizeof(CookedMeshEntry);
+	if (header.numMeshes == 0 || entriesEnd > size)
+		return false;
+	const CookedMeshEntry* entries = (const CookedMeshEntry*)(base + sizeof(CookedMeshHeader));
+	for (unsigned int i = 0; i < header.numMeshes; i++) {
+		const CookedMeshEntry& entry = entries[i];
+		bool valid = entry.vertexOffset % COOKED_MESH_ALIGNMENT == 0 && entry.indexOffset % COOKED_MESH_ALIGNMENT == 0
+			&& entry.vertexOffset + (uint64_t)entry.numVertices * header.vertexStride <= size
+			&& entry.indexOffset + (uint64_t)entry.numIndices * sizeof(uint32_t) <= size;
+		for (unsigned int t = 0; valid && t < 3; t++)
+			valid = (uint64_t)entry.textureNameOffsets[t] + entry.textureNameLengths[t] <= size;
+		if (!valid) {
+			Logger::Warning("Cooked mesh " + m_path + " is broken, cook it again");
+			return false;
+		}
+	}
+	return true;
+}
\ No newline at end of file
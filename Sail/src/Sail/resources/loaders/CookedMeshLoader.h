@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include "Sail/utils/MappedFile.h"
+#include "Sail/api/shader/InputLayout.h"
+#include "../../graphics/geometry/Model.h"
+
+// Loads meshes written by MeshCooker
+// The file is mapped and the vertex data is handed to the vertex buffers as it is, nothing is converted on load
+class CookedMeshLoader {
+public:
+	// Maps the file and checks that it can be used, see isValid()
+	CookedMeshLoader(const std::string& cookedPath, const std::string& sourcePath, const std::vector<InputLayout::InputType>& inputOrder);
+	~CookedMeshLoader();
+
+	// False if the file is missing, broken, older than the source or cooked for another input order
+	// A missing source is fine, cooked files can be shipped without the FBX files
+	bool isValid() const;
+	// Creates the meshes, has to be called from the main thread
+	void createModel(Shader* shader, bool asyncTextures);
+	std::unique_ptr<Model>& getModel();
+
+private:
+	bool validate(const std::string& sourcePath, const std::vector<InputLayout::InputType>& inputOrder);
+
+private:
+	std::string m_path;
+	MappedFile m_file;
+	bool m_valid;
+	std::unique_ptr<Model> m_model;
+
+};
\ No newline at end of file
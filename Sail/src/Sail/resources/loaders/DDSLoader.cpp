@@ -0,0 +1,259 @@
+#include "pch.h"
+#include "DDSLoader.h"
+#include "../TextureCompressor.h"
+#include "Sail/utils/MappedFile.h"
+#include "Sail/utils/Utils.h"
+#include <fstream>
+
+namespace FileLoader {
+
+	namespace {
+		const uint32_t FOURCC_DXT1 = 0x31545844; // "DXT1"
+		const uint32_t FOURCC_DXT5 = 0x35545844; // "DXT5"
+		const uint32_t FOURCC_ATI2 = 0x32495441; // "ATI2"
+		const uint32_t FOURCC_BC5U = 0x55354342; // "BC5U"
+		const uint32_t FOURCC_DX10 = 0x30315844; // "DX10"
+		const uint32_t CUBEMAP_FLAGS = 0x200;
+
+		uint32_t read32(const unsigned char* data) {
+			return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+		}
+		void write32(unsigned char* data, uint32_t value) {
+			data[0] = (unsigned char)value;
+			data[1] = (unsigned char)(value >> 8);
+			data[2] = (unsigned char)(value >> 16);
+			data[3] = (unsigned char)(value >> 24);
+		}
+	}
+
+	bool DDSLoader::Load(const std::string& filename, ResourceFormat::TextureData& textureData) {
+		MappedFile file;
+		if (!file.open(filename)) {
+			textureData = ResourceFormat::TextureData{ 0, 0, 4, nullptr, 1, ResourceFormat::R8G8B8A8 };
+			return false;
+		}
+		if (!Decode(reinterpret_cast<const unsigned char*>(file.getData()), file.getSize(), textureData)) {
+			Logger::Warning("Could not read the texture in " + filename);
+			return false;
+		}
+		return true;
+	}
+
+	bool DDSLoader::Decode(const unsigned char* file, size_t fileSize, ResourceFormat::TextureData& textureData) {
+		textureData = ResourceFormat::TextureData{ 0, 0, 4, nullptr, 1, ResourceFormat::R8G8B8A8 };
+		if (fileSize < 4 + HEADER_SIZE || read32(file) != MAGIC || read32(file + 4) != HEADER_SIZE)
+			return false;
+
+		Header header;
+		header.flags = read32(file + 8);
+		header.height = read32(file + 12);
+		header.width = read32(file + 16);
+		header.pitchOrLinearSize = read32(file + 20);
+		header.mipMapCount = read32(file + 28);
+		header.pixelFlags = read32(file + 80);
+		header.fourCC = read32(file + 84);
+		header.rgbBitCount = read32(file + 88);
+		for (unsigned int i = 0; i < 4; i++)
+			header.masks[i] = read32(file + 92 + i * 4);
+		header.caps = read32(file + 108);
+		header.caps2 = read32(file + 112);
+		size_t offset = 4 + HEADER_SIZE;
+
+		if (header.width == 0 || header.height == 0)
+			return false;
+		if (header.caps2 & CUBEMAP_FLAGS) {
+			Logger::Warning("Cube map DDS files are not supported");
+			return false;
+		}
+
+		ResourceFormat::TextureFormat format;
+		// BGRA files are converted to RGBA after they are copied
+		bool swapRedBlue = false;
+		bool opaque = false;
+		if ((header.pixelFlags & PIXEL_FOURCC) && header.fourCC == FOURCC_DX10) {
+			if (fileSize < offset + DX10_HEADER_SIZE)
+				return false;
+			uint32_t dxgiFormat = read32(file + offset);
+			uint32_t dimension = read32(file + offset + 4);
+			uint32_t miscFlag = read32(file + offset + 8);
+			uint32_t arraySize = read32(file + offset + 12);
+			offset += DX10_HEADER_SIZE;
+			if (dimension != DIMENSION_TEXTURE2D || arraySize > 1 || (miscFlag & 0x4)) {
+				Logger::Warning("Only single 2D textures are supported in DDS files");
+				return false;
+			}
+			if (!FormatFromDXGI(dxgiFormat, format)) {
+				Logger::Warning("Unsupported DXGI format " + std::to_string(dxgiFormat) + " in DDS file");
+				return false;
+			}
+		} else if (header.pixelFlags & PIXEL_FOURCC) {
+			if (!FormatFromFourCC(header.fourCC, format)) {
+				Logger::Warning("Unsupported four character code " + std::to_string(header.fourCC) + " in DDS file");
+				return false;
+			}
+		} else if ((header.pixelFlags & PIXEL_RGB) && header.rgbBitCount == 32 && header.masks[1] == 0x0000FF00) {
+			format = ResourceFormat::R8G8B8A8;
+			if (header.masks[0] == 0x00FF0000 && header.masks[2] == 0x000000FF)
+				swapRedBlue = true;
+			else if (header.masks[0] != 0x000000FF || header.masks[2] != 0x00FF0000)
+				return false;
+			opaque = !(header.pixelFlags & PIXEL_ALPHA) || header.masks[3] == 0;
+		} else {
+			Logger::Warning("Unsupported pixel format in DDS file");
+			return false;
+		}
+
+		// The APIs only create block compressed textures whose full size level is whole blocks, the same rule TextureCompressor::Compress follows
+		if (TextureCompressor::IsCompressed(format) && (header.width % 4 != 0 || header.height % 4 != 0)) {
+			Logger::Warning("Block compressed DDS files need sides that are multiples of 4, got " + std::to_string(header.width) + "x" + std::to_string(header.height));
+			return false;
+		}
+
+		unsigned int mipLevels = (header.flags & FLAG_MIPMAP_COUNT) ? std::max(header.mipMapCount, 1U) : 1;
+		mipLevels = std::min(mipLevels, MipGenerator::GetNumLevels(header.width, header.height));
+		size_t size = TextureCompressor::GetChainSize(format, header.width, header.height, mipLevels);
+		if (fileSize - offset < size) {
+			Logger::Warning("DDS file ended before all " + std::to_string(mipLevels) + " mip levels were read");
+			return false;
+		}
+
+		unsigned char* data = SAIL_NEW unsigned char[size];
+		memcpy(data, file + offset, size);
+		if (swapRedBlue || opaque) {
+			for (size_t i = 0; i < size; i += 4) {
+				if (swapRedBlue)
+					std::swap(data[i], data[i + 2]);
+				if (opaque)
+					data[i + 3] = 0xFF;
+			}
+		}
+
+		textureData.width = header.width;
+		textureData.height = header.height;
+		textureData.channels = 4;
+		textureData.textureData = data;
+		textureData.mipLevels = mipLevels;
+		textureData.format = format;
+		return true;
+	}
+
+	bool DDSLoader::Write(const std::string& filename, const ResourceFormat::TextureData& textureData) {
+		if (!textureData.textureData || textureData.channels != 4)
+			return false;
+
+		bool compressed = TextureCompressor::IsCompressed(textureData.format);
+		bool dx10 = textureData.format == ResourceFormat::BC5 || textureData.format == ResourceFormat::BC7;
+		unsigned char header[4 + HEADER_SIZE + DX10_HEADER_SIZE] = {};
+		write32(header, MAGIC);
+		write32(header + 4, HEADER_SIZE);
+		uint32_t flags = FLAG_CAPS | FLAG_HEIGHT | FLAG_WIDTH | FLAG_PIXEL_FORMAT;
+		flags |= compressed ? FLAG_LINEAR_SIZE : FLAG_PITCH;
+		if (textureData.mipLevels > 1)
+			flags |= FLAG_MIPMAP_COUNT;
+		write32(header + 8, flags);
+		write32(header + 12, textureData.height);
+		write32(header + 16, textureData.width);
+		write32(header + 20, (uint32_t)(compressed ? TextureCompressor::GetLevelSize(textureData.format, textureData.width, textureData.height, 0) : TextureCompressor::GetRowPitch(textureData.format, textureData.width)));
+		write32(header + 28, textureData.mipLevels);
+
+		// Pixel format
+		write32(header + 76, 32);
+		if (textureData.format == ResourceFormat::R8G8B8A8) {
+			write32(header + 80, PIXEL_RGB | PIXEL_ALPHA);
+			write32(header + 88, 32);
+			write32(header + 92, 0x000000FF);
+			write32(header + 96, 0x0000FF00);
+			write32(header + 100, 0x00FF0000);
+			write32(header + 104, 0xFF000000);
+		} else {
+			write32(header + 80, PIXEL_FOURCC);
+			write32(header + 84, dx10 ? FOURCC_DX10 : (textureData.format == ResourceFormat::BC1) ? FOURCC_DXT1 : FOURCC_DXT5);
+		}
+
+		uint32_t caps = CAPS_TEXTURE;
+		if (textureData.mipLevels > 1)
+			caps |= CAPS_COMPLEX | CAPS_MIPMAP;
+		write32(header + 108, caps);
+
+		size_t headerSize = 4 + HEADER_SIZE;
+		if (dx10) {
+			write32(header + headerSize, GetDXGIFormat(textureData.format));
+			write32(header + headerSize + 4, DIMENSION_TEXTURE2D);
+			write32(header + headerSize + 12, 1);
+			headerSize += DX10_HEADER_SIZE;
+		}
+
+		std::ofstream file(filename, std::ios::binary);
+		if (!file.is_open()) {
+			Logger::Warning("Could not open " + filename + " to write the texture");
+			return false;
+		}
+		file.write((const char*)header, headerSize);
+		file.write((const char*)textureData.textureData, TextureCompressor::GetChainSize(textureData.format, textureData.width, textureData.height, textureData.mipLevels));
+		if (!file.good()) {
+			Logger::Warning("Failed to write the texture " + filename);
+			return false;
+		}
+		return true;
+	}
+
+	bool DDSLoader::FormatFromFourCC(uint32_t fourCC, ResourceFormat::TextureFormat& format) {
+		switch (fourCC) {
+		case FOURCC_DXT1:
+			format = ResourceFormat::BC1;
+			return true;
+		case FOURCC_DXT5:
+			format = ResourceFormat::BC3;
+			return true;
+		case FOURCC_ATI2:
+		case FOURCC_BC5U:
+			format = ResourceFormat::BC5;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool DDSLoader::FormatFromDXGI(uint32_t dxgiFormat, ResourceFormat::TextureFormat& format) {
+		// Values of DXGI_FORMAT, the sRGB variants are read as the plain ones since textures are created as UNORM
+		switch (dxgiFormat) {
+		case 28: // R8G8B8A8_UNORM
+		case 29: // R8G8B8A8_UNORM_SRGB
+			format = ResourceFormat::R8G8B8A8;
+			return true;
+		case 71: // BC1_UNORM
+		case 72: // BC1_UNORM_SRGB
+			format = ResourceFormat::BC1;
+			return true;
+		case 77: // BC3_UNORM
+		case 78: // BC3_UNORM_SRGB
+			format = ResourceFormat::BC3;
+			return true;
+		case 83: // BC5_UNORM
+			format = ResourceFormat::BC5;
+			return true;
+		case 98: // BC7_UNORM
+		case 99: // BC7_UNORM_SRGB
+			format = ResourceFormat::BC7;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	uint32_t DDSLoader::GetDXGIFormat(ResourceFormat::TextureFormat format) {
+		switch (format) {
+		case ResourceFormat::BC1:
+			return 71;
+		case ResourceFormat::BC3:
+			return 77;
+		case ResourceFormat::BC5:
+			return 83;
+		case ResourceFormat::BC7:
+			return 98;
+		default:
+			return 28;
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include "../ResourceFormat.h"
+
+namespace FileLoader {
+
+	// Reads and writes DirectDraw Surface files holding a single 2D texture with its mip chain
+	// Handles the formats in ResourceFormat::TextureFormat, both with the legacy four character codes and with the DX10 header
+	class DDSLoader {
+
+	public:
+		// Returns false and leaves textureData empty if the file could not be read
+		static bool Load(const std::string& filename, ResourceFormat::TextureData& textureData);
+		static bool Decode(const unsigned char* file, size_t fileSize, ResourceFormat::TextureData& textureData);
+		static bool Write(const std::string& filename, const ResourceFormat::TextureData& textureData);
+
+	private:
+		static const uint32_t MAGIC = 0x20534444; // "DDS "
+		static const uint32_t HEADER_SIZE = 124;
+		static const uint32_t DX10_HEADER_SIZE = 20;
+
+		// Flags and codes used from the header
+		static const uint32_t FLAG_CAPS = 0x1;
+		static const uint32_t FLAG_HEIGHT = 0x2;
+		static const uint32_t FLAG_WIDTH = 0x4;
+		static const uint32_t FLAG_PITCH = 0x8;
+		static const uint32_t FLAG_PIXEL_FORMAT = 0x1000;
+		static const uint32_t FLAG_MIPMAP_COUNT = 0x20000;
+		static const uint32_t FLAG_LINEAR_SIZE = 0x80000;
+		static const uint32_t PIXEL_ALPHA = 0x1;
+		static const uint32_t PIXEL_FOURCC = 0x4;
+		static const uint32_t PIXEL_RGB = 0x40;
+		static const uint32_t CAPS_COMPLEX = 0x8;
+		static const uint32_t CAPS_TEXTURE = 0x1000;
+		static const uint32_t CAPS_MIPMAP = 0x400000;
+		static const uint32_t DIMENSION_TEXTURE2D = 3;
+
+		// The parts of DDS_HEADER and DDS_PIXELFORMAT that are used, the layout in the file is written out field by field
+		struct Header {
+			uint32_t flags;
+			uint32_t height;
+			uint32_t width;
+			uint32_t pitchOrLinearSize;
+			uint32_t mipMapCount;
+			uint32_t pixelFlags;
+			uint32_t fourCC;
+			uint32_t rgbBitCount;
+			uint32_t masks[4];
+			uint32_t caps;
+			uint32_t caps2;
+		};
+
+		static bool FormatFromFourCC(uint32_t fourCC, ResourceFormat::TextureFormat& format);
+		static bool FormatFromDXGI(uint32_t dxgiFormat, ResourceFormat::TextureFormat& format);
+		static uint32_t GetDXGIFormat(ResourceFormat::TextureFormat format);
+
+	};
+
+}
\ No newline at end of file
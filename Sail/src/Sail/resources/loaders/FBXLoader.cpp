@@ -1,57 +1,109 @@
 #include "pch.h"
 #include "FBXLoader.h"
 
-#include <d3d11.h>
 #include "../../utils/Utils.h"
+#include "MeshOptimizer.h"
 #include "../../graphics/geometry/factory/CubeModel.h"
 #include "Sail/Application.h"
 
 FbxManager* FBXLoader::s_manager = FbxManager::Create();
 FbxIOSettings* FBXLoader::s_ios = FbxIOSettings::Create(s_manager, IOSROOT);
 
+std::mutex FBXLoader::s_sdkMutex;
+
 FBXLoader::FBXLoader(const std::string& filepath, Shader* shader)
-	: m_filepath(filepath)
-	, m_shader(shader)
+	: FBXLoader(filepath)
 {
-	s_manager->SetIOSettings(s_ios);
+	createModel(shader, false);
+}
 
-	m_model = std::make_unique<Model>();
-	m_scene = parseFBX(filepath);
-	
-	// Triangulate all meshes in the scene
-	FbxGeometryConverter geoConverter(s_manager);
-	geoConverter.Triangulate(m_scene, true);
-
-	if (m_scene != nullptr) {
-
-		loadNode(m_scene->GetRootNode());
-		/*m_model->getMaterial()->setKa(m_matSettings.ka);
-		m_model->getMaterial()->setKd(m_matSettings.kd);
-		m_model->getMaterial()->setKs(m_matSettings.ks);
-		m_model->getMaterial()->setShininess(m_matSettings.shininess);
-		if (m_matDiffuseTex != "")
-			m_model->getMaterial()->setDiffuseTexture(m_matDiffuseTex);
-		if (m_matNormalTex != "")
-			m_model->getMaterial()->setDiffuseTexture(m_matNormalTex);
-		if (m_matSpecularTex != "")
-			m_model->getMaterial()->setDiffuseTexture(m_matSpecularTex);*/
-
-	} else {
-		Logger::Warning("Failed to load fbx file '" + filepath + "', using default cube.");
+FBXLoader::FBXLoader(const std::string& filepath)
+	: m_scene(nullptr)
+	, m_filepath(filepath)
+{
+	parse();
+}
+
+FBXLoader::~FBXLoader() {
+	// Mesh data that never got a mesh
+	for (ParsedMesh& parsed : m_meshes)
+		parsed.data.freeArrays();
+}
+
+void FBXLoader::parse() {
+	{
+		std::lock_guard<std::mutex> lock(s_sdkMutex);
+		s_manager->SetIOSettings(s_ios);
+
+		m_scene = parseFBX(m_filepath);
+		if (m_scene != nullptr) {
+			// Triangulate all meshes in the scene
+			FbxGeometryConverter geoConverter(s_manager);
+			geoConverter.Triangulate(m_scene, true);
+
+			loadNode(m_scene->GetRootNode());
+			// Everything needed is copied out, the scene can go
+			m_scene->Destroy();
+			m_scene = nullptr;
+		}
+	}
+
+	// The geometry is read as triangle soup, weld and reorder it before it is uploaded or cooked
+	// This only touches the copied data, so loaders on other threads can use the SDK meanwhile
+	for (ParsedMesh& parsed : m_meshes)
+		MeshOptimizer::Optimize(parsed.data);
+}
+
+void FBXLoader::createModel(Shader* shader, bool asyncTextures) {
+	if (m_meshes.empty()) {
+		Logger::Warning("Failed to load fbx file '" + m_filepath + "', using default cube.");
 		glm::vec3 halfSizes = glm::vec3(0.5, 0.5, 0.5);
 		m_model = ModelFactory::CubeModel::Create(halfSizes, shader);
+		return;
 	}
-}
 
-FBXLoader::~FBXLoader() {
-	if (m_scene)
-		m_scene->Destroy();
+	m_model = std::make_unique<Model>();
+	for (ParsedMesh& parsed : m_meshes) {
+		std::unique_ptr<Mesh> mesh = std::unique_ptr<Mesh>(Mesh::Create(parsed.data, shader));
+		// The mesh owns the data now
+		parsed.data = Mesh::Data();
+		ApplyMaterial(parsed.material, mesh->getMaterial(), asyncTextures);
+		m_model->addMesh(std::move(mesh));
+	}
+	m_meshes.clear();
 }
 
 std::unique_ptr<Model>& FBXLoader::getModel() {
 	return m_model;
 }
 
+const std::vector<FBXLoader::ParsedMesh>& FBXLoader::getParsedMeshes() const {
+	return m_meshes;
+}
+
+void FBXLoader::ApplyMaterial(const ParsedMaterial& parsedMaterial, Material* material, bool asyncTextures) {
+	if (!parsedMaterial.hasPhong)
+		return;
+
+	auto& resman = Application::getInstance()->getResourceManager();
+	auto setTexture = [&](const std::string& filename, void (Material::*set)(const std::string&)) {
+		if (filename.empty())
+			return;
+		// Materials load textures that are not loaded yet asynchronously
+		if (!asyncTextures && !resman.hasTexture(filename))
+			resman.loadTexture(filename);
+		(material->*set)(filename);
+	};
+	setTexture(parsedMaterial.diffuseTexture, &Material::setDiffuseTexture);
+	setTexture(parsedMaterial.specularTexture, &Material::setSpecularTexture);
+	setTexture(parsedMaterial.normalTexture, &Material::setNormalTexture);
+
+	material->setKa(parsedMaterial.ka);
+	material->setKs(parsedMaterial.ks);
+	material->setKd(parsedMaterial.kd);
+	material->setShininess(parsedMaterial.shininess);
+}
+
 FbxScene* FBXLoader::parseFBX(const std::string& filename) {
 	FbxImporter* importer = FbxImporter::Create(s_manager, "");
 
@@ -79,11 +131,10 @@ void FBXLoader::loadNode(FbxNode* pNode) {
 			// Gets the mesh (only one mesh per model is supported)
 			mesh = (FbxMesh*)nodeAttributeFbx;
 
-			Mesh::Data meshData;
-			getGeometry(mesh, meshData);
-			std::unique_ptr<Mesh> mesh = std::unique_ptr<Mesh>(Mesh::Create(meshData, m_shader));
-			getMaterial(pNode, mesh->getMaterial());
-			m_model->addMesh(std::move(mesh));
+			m_meshes.emplace_back();
+			ParsedMesh& parsed = m_meshes.back();
+			getGeometry(mesh, parsed.data);
+			getMaterial(pNode, parsed.material);
 
 		}
 
@@ -140,19 +191,15 @@ FbxVector2 FBXLoader::getTexCoord(int cpIndex, FbxGeometryElementUV* geUV, FbxMe
 void FBXLoader::getGeometry(FbxMesh* mesh, Mesh::Data& buildData) {
 
 	// Number of polygon vertices 
-	buildData.numVertices = mesh->GetPolygonVertexCount();
+	unsigned int numPolygonVertices = mesh->GetPolygonVertexCount();
 	int* indices = mesh->GetPolygonVertices();
 
-	if (int(buildData.numVertices / 3) != mesh->GetPolygonCount()) {
+	if (int(numPolygonVertices / 3) != mesh->GetPolygonCount()) {
 		Logger::Error("The mesh in '" + m_filepath + "' has to be triangulated.");
 		return;
 	}
 
-	buildData.positions = SAIL_NEW Mesh::vec3[buildData.numVertices];
-	buildData.normals = SAIL_NEW Mesh::vec3[buildData.numVertices];
-	buildData.texCoords = SAIL_NEW Mesh::vec2[buildData.numVertices];
-	buildData.tangents = SAIL_NEW Mesh::vec3[buildData.numVertices];
-	buildData.bitangents = SAIL_NEW Mesh::vec3[buildData.numVertices];
+	buildData.allocate(numPolygonVertices, 0, Mesh::Data::POSITIONS | Mesh::Data::NORMALS | Mesh::Data::TEXCOORDS | Mesh::Data::TANGENTS | Mesh::Data::BITANGENTS);
 
 	bool norms = true, uvs = true, tangs = true, bitangs = true;
 
@@ -323,38 +370,31 @@ void FBXLoader::getGeometry(FbxMesh* mesh, Mesh::Data& buildData) {
 
 }
 
-void FBXLoader::getMaterial(FbxNode* pNode, Material* material) {
+void FBXLoader::getMaterial(FbxNode* pNode, ParsedMaterial& material) {
+	material.hasPhong = false;
 
 	// Gets the model's phong constants
 	if (pNode->GetSrcObjectCount<FbxSurfacePhong>() > 0) {
 
 		auto phong = pNode->GetSrcObject<FbxSurfacePhong>();
-		auto& resman = Application::getInstance()->getResourceManager();
+		material.hasPhong = true;
 
+		// Only the names are stored, the textures are loaded when the model is created
 		FbxFileTexture* diffTex = phong->Diffuse.GetSrcObject<FbxFileTexture>();
-		if (diffTex) {
-			std::string filename = diffTex->GetRelativeFileName();
-			resman.loadTexture(filename);
-			material->setDiffuseTexture(filename);
-		}
+		if (diffTex)
+			material.diffuseTexture = diffTex->GetRelativeFileName();
 		FbxFileTexture* specTex = phong->Specular.GetSrcObject<FbxFileTexture>();
-		if (specTex) {
-			std::string filename = specTex->GetRelativeFileName();
-			resman.loadTexture(filename);
-			material->setSpecularTexture(specTex->GetRelativeFileName());
-		}
+		if (specTex)
+			material.specularTexture = specTex->GetRelativeFileName();
 		FbxFileTexture* normTex = phong->NormalMap.GetSrcObject<FbxFileTexture>();
-		if (normTex) {
-			std::string filename = normTex->GetRelativeFileName();
-			resman.loadTexture(filename);
-			material->setNormalTexture(normTex->GetRelativeFileName());
-		}
+		if (normTex)
+			material.normalTexture = normTex->GetRelativeFileName();
 
-		material->setKa(static_cast<float>(phong->AmbientFactor.Get()));
-		material->setKs(static_cast<float>(phong->SpecularFactor.Get()));
-		material->setKd (static_cast<float>(phong->DiffuseFactor.Get()));
-		material->setShininess(static_cast<float>(phong->Shininess.Get()));
+		material.ka = static_cast<float>(phong->AmbientFactor.Get());
+		material.ks = static_cast<float>(phong->SpecularFactor.Get());
+		material.kd = static_cast<float>(phong->DiffuseFactor.Get());
+		material.shininess = static_cast<float>(phong->Shininess.Get());
 
 	}
 
-}
+}
\ No newline at end of file
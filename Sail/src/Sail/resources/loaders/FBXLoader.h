@@ -1,31 +1,62 @@
 #pragma once
 
 #include <fbxsdk.h>
+#include <mutex>
 #include <string>
 #include "../../graphics/geometry/Model.h"
 
+// Loading is split in two steps
+//   Parsing reads the file into mesh data and material descriptions, it does not use the graphics API and can run on any thread
+//   createModel() then creates the meshes and has to run on the main thread
 class FBXLoader {
 public:
+	// Parses the file and creates the model right away, loading its textures before returning
 	FBXLoader(const std::string& filepath, Shader* shader);
+	// Only parses the file
+	FBXLoader(const std::string& filepath);
 	~FBXLoader();
 
+	struct ParsedMaterial {
+		bool hasPhong;
+		float ka, kd, ks, shininess;
+		std::string diffuseTexture;
+		std::string specularTexture;
+		std::string normalTexture;
+	};
+	struct ParsedMesh {
+		Mesh::Data data;
+		ParsedMaterial material;
+	};
+
+public:
+	// Creates the meshes from the parsed data, asyncTextures makes the materials use placeholders while their textures load
+	void createModel(Shader* shader, bool asyncTextures);
 	std::unique_ptr<Model>& getModel();
+	// Meshes that have been parsed but not created yet
+	const std::vector<ParsedMesh>& getParsedMeshes() const;
+
+	// Sets the constants and textures of a parsed material
+	static void ApplyMaterial(const ParsedMaterial& parsedMaterial, Material* material, bool asyncTextures);
 
 private:
+	void parse();
 	FbxScene* parseFBX(const std::string& filename);
 
 	void loadNode(FbxNode* pNode);
 	FbxVector2 getTexCoord(int cpIndex, FbxGeometryElementUV* geUV, FbxMesh* mesh, int polyIndex, int vertIndex) const;
 	void getGeometry(FbxMesh* mesh, Mesh::Data& buildData);
-	void getMaterial(FbxNode* pNode, Material* material);
+	void getMaterial(FbxNode* pNode, ParsedMaterial& material);
 
 private:
 	static FbxManager* s_manager;
 	static FbxIOSettings* s_ios;
+	// The manager is shared and not thread safe, loaders on different threads take turns using the SDK
+	static std::mutex s_sdkMutex;
 	FbxScene* m_scene;
 
 	std::string m_filepath;
-	Shader* m_shader;
+	// Owns the mesh data until the meshes are created
+	std::vector<ParsedMesh> m_meshes;
 	std::unique_ptr<Model> m_model;
 	//std::vector<Mesh::Data> m_meshDataList;
 
@@ -0,0 +1,152 @@
+#include "pch.h"
+#include "MeshCooker.h"
+#include "FBXLoader.h"
+#include "Sail/api/VertexPacker.h"
+#include "Sail/resources/ResourceFormat.h"
+#include "Sail/utils/Utils.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+	uint64_t align(uint64_t offset) {
+		const uint64_t alignment = ResourceFormat::COOKED_MESH_ALIGNMENT;
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+const std::vector<InputLayout::InputType>& MeshCooker::GetDefaultInputOrder() {
+	static const std::vector<InputLayout::InputType> order = {
+		InputLayout::POSITION, InputLayout::TEXCOORD, InputLayout::NORMAL, InputLayout::TANGENT, InputLayout::BITANGENT
+	};
+	return order;
+}
+
+bool MeshCooker::Cook(const std::string& sourcePath, const std::string& cookedPath, const std::vector<InputLayout::InputType>& inputOrder) {
+	using namespace ResourceFormat;
+
+	CookedMeshHeader header = {};
+	header.magic = COOKED_MESH_MAGIC;
+	header.version = COOKED_MESH_VERSION;
+	if (!GetSourceStamp(sourcePath, header.sourceTime, header.sourceSize)) {
+		Logger::Warning("Could not find " + sourcePath + " to cook");
+		return false;
+	}
+	if (inputOrder.empty() || inputOrder.size() > COOKED_MESH_MAX_INPUTS) {
+		Logger::Warning("Meshes can be cooked with 1 to " + std::to_string(COOKED_MESH_MAX_INPUTS) + " inputs");
+		return false;
+	}
+	header.numInputs = (uint32_t)inputOrder.size();
+	for (unsigned int i = 0; i < header.numInputs; i++) {
+		header.inputs[i] = (uint8_t)inputOrder[i];
+		header.vertexStride += VertexPacker::GetInputSize(inputOrder[i]);
+	}
+
+	FBXLoader loader(sourcePath);
+	const auto& meshes = loader.getParsedMeshes();
+	if (meshes.empty()) {
+		Logger::Warning("Found no meshes to cook in " + sourcePath);
+		return false;
+	}
+	header.numMeshes = (uint32_t)meshes.size();
+
+	// Lay out the texture names after the entries and the vertex and index data after the names
+	std::vector<CookedMeshEntry> entries(meshes.size());
+	std::string names;
+	uint64_t namesOffset = sizeof(CookedMeshHeader) + entries.size() * sizeof(CookedMeshEntry);
+	for (unsigned int i = 0; i < meshes.size(); i++) {
+		const FBXLoader::ParsedMesh& mesh = meshes[i];
+		CookedMeshEntry& entry = entries[i];
+		if (!mesh.data.positions || mesh.data.numVertices == 0) {
+			Logger::Warning("Mesh " + std::to_string(i) + " in " + sourcePath + " has no vertices");
+			return false;
+		}
+		entry.numVertices = mesh.data.numVertices;
+		entry.numIndices = mesh.data.numIndices;
+
+		glm::vec3 boundsMin = mesh.data.positions[0].vec;
+		glm::vec3 boundsMax = boundsMin;
+		for (unsigned int v = 1; v < mesh.data.numVertices; v++) {
+			boundsMin = glm::min(boundsMin, mesh.data.positions[v].vec);
+			boundsMax = glm::max(boundsMax, mesh.data.positions[v].vec);
+		}
+		memcpy(entry.boundsMin, &boundsMin, sizeof(entry.boundsMin));
+		memcpy(entry.boundsMax, &boundsMax, sizeof(entry.boundsMax));
+
+		const FBXLoader::ParsedMaterial& material = mesh.material;
+		entry.hasPhong = material.hasPhong;
+		entry.ka = material.ka;
+		entry.kd = material.kd;
+		entry.ks = material.ks;
+		entry.shininess = material.shininess;
+		const std::string* textures[3] = { &material.diffuseTexture, &material.specularTexture, &material.normalTexture };
+		for (unsigned int t = 0; t < 3; t++) {
+			entry.textureNameOffsets[t] = (uint32_t)(namesOffset + names.size());
+			entry.textureNameLengths[t] = (uint32_t)textures[t]->size();
+			names += *textures[t];
+		}
+	}
+	uint64_t offset = align(namesOffset + names.size());
+	for (CookedMeshEntry& entry : entries) {
+		entry.vertexOffset = offset;
+		offset = align(offset + (uint64_t)entry.numVertices * header.vertexStride);
+		entry.indexOffset = offset;
+		offset = align(offset + (uint64_t)entry.numIndices * sizeof(uint32_t));
+	}
+
+	std::ofstream file(cookedPath, std::ios::binary);
+	if (!file.is_open()) {
+		Logger::Warning("Could not open " + cookedPath + " to write the cooked mesh");
+		return false;
+	}
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)entries.data(), entries.size() * sizeof(CookedMeshEntry));
+	file.write(names.data(), names.size());
+
+	const char padding[COOKED_MESH_ALIGNMENT] = {};
+	auto padTo = [&](uint64_t target) {
+		uint64_t position = (uint64_t)file.tellp();
+		file.write(padding, (std::streamsize)(target - position));
+	};
+	VertexPacker packer(inputOrder);
+	std::vector<char> vertices;
+	std::vector<uint32_t> indices;
+	for (unsigned int i = 0; i < meshes.size(); i++) {
+		const Mesh::Data& data = meshes[i].data;
+		padTo(entries[i].vertexOffset);
+		vertices.resize((size_t)data.numVertices * header.vertexStride);
+		packer.pack(data, vertices.data());
+		file.write(vertices.data(), vertices.size());
+
+		padTo(entries[i].indexOffset);
+		indices.assign(data.indices, data.indices + data.numIndices);
+		file.write((const char*)indices.data(), indices.size() * sizeof(uint32_t));
+	}
+	padTo(offset);
+
+	if (!file.good()) {
+		Logger::Warning("Failed to write the cooked mesh " + cookedPath);
+		return false;
+	}
+	Logger::Log("Cooked " + sourcePath + " to " + cookedPath);
+	return true;
+}
+
+std::string MeshCooker::GetCookedPath(const std::string& sourcePath) {
+	size_t dot = sourcePath.find_last_of('.');
+	size_t slash = sourcePath.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return sourcePath + ".smesh";
+	return sourcePath.substr(0, dot) + ".smesh";
+}
+
+bool MeshCooker::GetSourceStamp(const std::string& sourcePath, int64_t& time, uint64_t& size) {
+	std::error_code error;
+	auto writeTime = std::filesystem::last_write_time(sourcePath, error);
+	if (error)
+		return false;
+	size = (uint64_t)std::filesystem::file_size(sourcePath, error);
+	if (error)
+		return false;
+	time = (int64_t)writeTime.time_since_epoch().count();
+	return true;
+}
\ No newline at end of file
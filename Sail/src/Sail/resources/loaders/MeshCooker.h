@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Sail/api/shader/InputLayout.h"
+
+// Converts FBX files into the cooked mesh format described in ResourceFormat.h
+// Cooked files are loaded without the FBX SDK, their vertices are already interleaved for the input layout they were cooked for
+class MeshCooker {
+public:
+	// Input order of MaterialShader, used by the models loaded through the ResourceManager
+	static const std::vector<InputLayout::InputType>& GetDefaultInputOrder();
+
+	// Parses the FBX file and writes the cooked file, returns false on failure
+	static bool Cook(const std::string& sourcePath, const std::string& cookedPath, const std::vector<InputLayout::InputType>& inputOrder = GetDefaultInputOrder());
+	// The extension of the source file is replaced with .smesh
+	static std::string GetCookedPath(const std::string& sourcePath);
+	// Last write time and size of the file, returns false if it does not exist
+	static bool GetSourceStamp(const std::string& sourcePath, int64_t& time, uint64_t& size);
+
+};
\ No newline at end of file
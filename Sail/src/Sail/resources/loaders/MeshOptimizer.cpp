@@ -0,0 +1,286 @@
+#include "pch.h"
+#include "MeshOptimizer.h"
+#include "Sail/utils/Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+	const unsigned int INVALID = 0xFFFFFFFF;
+	// Vertices used by more triangles than this get the same valence score
+	const unsigned int MAX_VALENCE = 32;
+
+	template<typename T>
+	void hashElement(uint64_t& hash, const T* array, unsigned int index) {
+		if (!array)
+			return;
+		// FNV-1a over the bytes of the attribute
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&array[index]);
+		for (size_t i = 0; i < sizeof(T); i++) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+	}
+	template<typename T>
+	bool equalElements(const T* array, unsigned int a, unsigned int b) {
+		return !array || std::memcmp(&array[a], &array[b], sizeof(T)) == 0;
+	}
+	template<typename T>
+	void remapArray(T* remapped, const T* array, const std::vector<unsigned int>& newToOld) {
+		if (!array)
+			return;
+		for (size_t i = 0; i < newToOld.size(); i++)
+			remapped[i] = array[newToOld[i]];
+	}
+
+	uint64_t hashVertex(const Mesh::Data& data, unsigned int index) {
+		uint64_t hash = 14695981039346656037ULL;
+		hashElement(hash, data.positions, index);
+		hashElement(hash, data.normals, index);
+		hashElement(hash, data.colors, index);
+		hashElement(hash, data.texCoords, index);
+		hashElement(hash, data.tangents, index);
+		hashElement(hash, data.bitangents, index);
+		return hash;
+	}
+	// Attributes are compared bit for bit, welding never changes what is rendered
+	bool equalVertices(const Mesh::Data& data, unsigned int a, unsigned int b) {
+		return equalElements(data.positions, a, b)
+			&& equalElements(data.normals, a, b)
+			&& equalElements(data.colors, a, b)
+			&& equalElements(data.texCoords, a, b)
+			&& equalElements(data.tangents, a, b)
+			&& equalElements(data.bitangents, a, b);
+	}
+	// Vertex i of the result is vertex newToOld[i] of the input, the arrays are replaced by a new block together with the indices
+	void remapVertices(Mesh::Data& data, const std::vector<unsigned int>& newToOld, const unsigned long* indices, unsigned int numIndices) {
+		Mesh::Data remapped;
+		remapped.allocate((unsigned int)newToOld.size(), numIndices, data.getAttributes());
+		remapArray(remapped.positions, data.positions, newToOld);
+		remapArray(remapped.normals, data.normals, newToOld);
+		remapArray(remapped.colors, data.colors, newToOld);
+		remapArray(remapped.texCoords, data.texCoords, newToOld);
+		remapArray(remapped.tangents, data.tangents, newToOld);
+		remapArray(remapped.bitangents, data.bitangents, newToOld);
+		std::copy(indices, indices + numIndices, remapped.indices);
+		data.swapArrays(remapped);
+		remapped.freeArrays();
+	}
+
+	bool hasValidIndices(const Mesh::Data& data) {
+		if (!data.indices || data.numIndices == 0)
+			return false;
+		for (unsigned int i = 0; i < data.numIndices; i++) {
+			if (data.indices[i] >= data.numVertices) {
+				Logger::Warning("Skipped optimizing a mesh with indices out of range");
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Scores from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+	struct ScoreTables {
+		float cache[MeshOptimizer::CACHE_SIZE];
+		float valence[MAX_VALENCE + 1];
+
+		ScoreTables() {
+			for (unsigned int i = 0; i < MeshOptimizer::CACHE_SIZE; i++) {
+				// The last triangle's vertices get a fixed score so that strips are not favoured over fans
+				if (i < 3)
+					cache[i] = 0.75f;
+				else
+					cache[i] = std::pow(1.f - float(i - 3) / float(MeshOptimizer::CACHE_SIZE - 3), 1.5f);
+			}
+			// Boosts vertices with few triangles left, finishing them off keeps lone triangles from being left behind
+			valence[0] = 0.f;
+			for (unsigned int i = 1; i <= MAX_VALENCE; i++)
+				valence[i] = 2.f / std::sqrt(float(i));
+		}
+	};
+
+	float vertexScore(int cachePosition, unsigned int remainingTriangles) {
+		static const ScoreTables tables;
+		if (remainingTriangles == 0)
+			return -1.f;
+		float score = (cachePosition >= 0) ? tables.cache[cachePosition] : 0.f;
+		return score + tables.valence[std::min(remainingTriangles, MAX_VALENCE)];
+	}
+}
+
+void MeshOptimizer::Optimize(Mesh::Data& data) {
+	WeldVertices(data);
+	OptimizeVertexCache(data);
+	OptimizeVertexFetch(data);
+}
+
+void MeshOptimizer::WeldVertices(Mesh::Data& data) {
+	if (data.indices || !data.positions || data.numVertices == 0)
+		return;
+
+	// Open addressing table of the unique vertices, kept at most half full
+	unsigned int numSoupVertices = data.numVertices;
+	size_t tableSize = 1;
+	while (tableSize < (size_t)numSoupVertices * 2)
+		tableSize <<= 1;
+	std::vector<unsigned int> table(tableSize, INVALID);
+	std::vector<unsigned int> newToOld;
+	newToOld.reserve(numSoupVertices);
+
+	std::vector<unsigned long> indices(numSoupVertices);
+	for (unsigned int i = 0; i < numSoupVertices; i++) {
+		size_t slot = hashVertex(data, i) & (tableSize - 1);
+		while (table[slot] != INVALID && !equalVertices(data, newToOld[table[slot]], i))
+			slot = (slot + 1) & (tableSize - 1);
+		if (table[slot] == INVALID) {
+			table[slot] = (unsigned int)newToOld.size();
+			newToOld.push_back(i);
+		}
+		indices[i] = table[slot];
+	}
+
+	remapVertices(data, newToOld, indices.data(), numSoupVertices);
+}
+
+void MeshOptimizer::OptimizeVertexCache(Mesh::Data& data) {
+	if (!hasValidIndices(data) || data.numIndices < 6)
+		return;
+	unsigned int numTriangles = data.numIndices / 3;
+	unsigned int numVertices = data.numVertices;
+
+	// Triangles using each vertex, the first remaining[v] entries of a vertex's range are the ones not emitted yet
+	std::vector<unsigned int> remaining(numVertices, 0);
+	for (unsigned int i = 0; i < numTriangles * 3; i++)
+		remaining[data.indices[i]]++;
+	std::vector<unsigned int> offsets(numVertices + 1, 0);
+	for (unsigned int v = 0; v < numVertices; v++)
+		offsets[v + 1] = offsets[v] + remaining[v];
+	std::vector<unsigned int> adjacency(numTriangles * 3);
+	{
+		std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+		for (unsigned int i = 0; i < numTriangles * 3; i++)
+			adjacency[fill[data.indices[i]]++] = i / 3;
+	}
+
+	std::vector<int> cachePosition(numVertices, -1);
+	std::vector<float> scores(numVertices);
+	for (unsigned int v = 0; v < numVertices; v++)
+		scores[v] = vertexScore(-1, remaining[v]);
+	std::vector<float> triangleScores(numTriangles);
+	for (unsigned int t = 0; t < numTriangles; t++) {
+		const unsigned long* tri = &data.indices[t * 3];
+		triangleScores[t] = scores[tri[0]] + scores[tri[1]] + scores[tri[2]];
+	}
+	std::vector<bool> emitted(numTriangles, false);
+
+	// The cache holds up to three extra entries while the vertices pushed out of it are rescored
+	std::vector<unsigned int> cache, newCache;
+	cache.reserve(CACHE_SIZE + 3);
+	newCache.reserve(CACHE_SIZE + 3);
+
+	std::vector<unsigned long> ordered(data.numIndices);
+	unsigned int nextUnemitted = 0;
+	unsigned int best = INVALID;
+	for (unsigned int emit = 0; emit < numTriangles; emit++) {
+		// Start over from the first triangle left when nothing in the cache has triangles left
+		if (best == INVALID) {
+			while (emitted[nextUnemitted])
+				nextUnemitted++;
+			best = nextUnemitted;
+		}
+
+		const unsigned long* tri = &data.indices[best * 3];
+		emitted[best] = true;
+		newCache.clear();
+		for (unsigned int i = 0; i < 3; i++) {
+			unsigned int v = tri[i];
+			ordered[emit * 3 + i] = v;
+
+			// Remove the triangle from the vertex's remaining ones
+			unsigned int* begin = &adjacency[offsets[v]];
+			unsigned int* end = begin + remaining[v];
+			*std::find(begin, end, best) = *(end - 1);
+			remaining[v]--;
+
+			if (std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+				newCache.push_back(v);
+		}
+		for (unsigned int v : cache) {
+			if (std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+				newCache.push_back(v);
+		}
+
+		// Rescore everything that was touched, the vertices that fell out of the cache included
+		best = INVALID;
+		float bestScore = -1.f;
+		for (unsigned int i = 0; i < newCache.size(); i++) {
+			unsigned int v = newCache[i];
+			cachePosition[v] = (i < CACHE_SIZE) ? (int)i : -1;
+			float score = vertexScore(cachePosition[v], remaining[v]);
+			float delta = score - scores[v];
+			scores[v] = score;
+			for (unsigned int j = offsets[v]; j < offsets[v] + remaining[v]; j++)
+				triangleScores[adjacency[j]] += delta;
+		}
+		for (unsigned int i = 0; i < newCache.size() && i < CACHE_SIZE; i++) {
+			unsigned int v = newCache[i];
+			for (unsigned int j = offsets[v]; j < offsets[v] + remaining[v]; j++) {
+				unsigned int t = adjacency[j];
+				if (triangleScores[t] > bestScore) {
+					bestScore = triangleScores[t];
+					best = t;
+				}
+			}
+		}
+
+		if (newCache.size() > CACHE_SIZE)
+			newCache.resize(CACHE_SIZE);
+		std::swap(cache, newCache);
+	}
+
+	// Leftover indices that do not form a triangle are kept at the end
+	for (unsigned int i = numTriangles * 3; i < data.numIndices; i++)
+		ordered[i] = data.indices[i];
+	std::copy(ordered.begin(), ordered.end(), data.indices);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(Mesh::Data& data) {
+	if (!hasValidIndices(data))
+		return;
+
+	std::vector<unsigned int> oldToNew(data.numVertices, INVALID);
+	std::vector<unsigned int> newToOld;
+	newToOld.reserve(data.numVertices);
+	for (unsigned int i = 0; i < data.numIndices; i++) {
+		unsigned int& newIndex = oldToNew[data.indices[i]];
+		if (newIndex == INVALID) {
+			newIndex = (unsigned int)newToOld.size();
+			newToOld.push_back(data.indices[i]);
+		}
+		data.indices[i] = newIndex;
+	}
+	remapVertices(data, newToOld, data.indices, data.numIndices);
+}
+
+float MeshOptimizer::ComputeACMR(const Mesh::Data& data, unsigned int cacheSize) {
+	if (!data.indices)
+		return 3.f;
+	unsigned int numTriangles = data.numIndices / 3;
+	if (numTriangles == 0)
+		return 0.f;
+
+	// A vertex is still in the FIFO if fewer than cacheSize misses happened since it was added
+	std::vector<unsigned int> addedAt(data.numVertices, INVALID);
+	unsigned int misses = 0;
+	for (unsigned int i = 0; i < numTriangles * 3; i++) {
+		unsigned int v = data.indices[i];
+		if (v >= data.numVertices)
+			continue;
+		if (addedAt[v] == INVALID || misses - addedAt[v] >= cacheSize) {
+			addedAt[v] = misses;
+			misses++;
+		}
+	}
+	return (float)misses / numTriangles;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Sail/api/Mesh.h"
+
+// Turns the triangle soup produced by the loaders into indexed meshes laid out for the GPU
+// Welding lets the post transform cache reuse shaded vertices, the reorders then make that reuse likely
+// and keep the vertex fetches close to each other in memory
+class MeshOptimizer {
+public:
+	// Size of the simulated post transform cache used when ordering triangles
+	static const unsigned int CACHE_SIZE = 32;
+
+	// Welds, orders the triangles for the vertex cache and then the vertices for fetch locality
+	static void Optimize(Mesh::Data& data);
+
+	// Merges vertices with identical attributes into a shared vertex array indexed by the triangles
+	// Meshes that already have indices are left as they are
+	static void WeldVertices(Mesh::Data& data);
+	// Reorders the triangles to reuse recently transformed vertices, using Forsyth's linear speed vertex cache optimization
+	static void OptimizeVertexCache(Mesh::Data& data);
+	// Renumbers the vertices in the order the triangles first use them, vertices without triangles are dropped
+	static void OptimizeVertexFetch(Mesh::Data& data);
+
+	// Average number of vertices transformed per triangle with a FIFO cache of cacheSize entries
+	// 3 means no reuse at all, a regular grid approaches 0.5
+	static float ComputeACMR(const Mesh::Data& data, unsigned int cacheSize = 16);
+
+};
\ No newline at end of file
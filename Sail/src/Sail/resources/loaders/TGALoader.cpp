@@ -1,8 +1,48 @@
 #include "pch.h"
 #include "TGALoader.h"
+#include "Sail/utils/MappedFile.h"
+#include <chrono>
+#include <emmintrin.h>
 
 namespace FileLoader {
 
+	namespace {
+		// Converts BGRA pixels to RGBA by swapping the red and blue bytes, four pixels at a time
+		void convertBGRA(const unsigned char* src, unsigned char* dst, unsigned int numPixels) {
+			unsigned int i = 0;
+			const __m128i greenAlpha = _mm_set1_epi32(0xFF00FF00);
+			const __m128i lowByte = _mm_set1_epi32(0x000000FF);
+			for (; i + 4 <= numPixels; i += 4) {
+				__m128i bgra = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+				__m128i red = _mm_and_si128(_mm_srli_epi32(bgra, 16), lowByte);
+				__m128i blue = _mm_slli_epi32(_mm_and_si128(bgra, lowByte), 16);
+				__m128i rgba = _mm_or_si128(_mm_and_si128(bgra, greenAlpha), _mm_or_si128(red, blue));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), rgba);
+			}
+			for (; i < numPixels; i++) {
+				dst[i * 4 + 0] = src[i * 4 + 2];
+				dst[i * 4 + 1] = src[i * 4 + 1];
+				dst[i * 4 + 2] = src[i * 4 + 0];
+				dst[i * 4 + 3] = src[i * 4 + 3];
+			}
+		}
+		// Converts BGR pixels to RGBA with an opaque alpha
+		void convertBGR(const unsigned char* src, unsigned char* dst, unsigned int numPixels) {
+			for (unsigned int i = 0; i < numPixels; i++) {
+				dst[i * 4 + 0] = src[i * 3 + 2];
+				dst[i * 4 + 1] = src[i * 3 + 1];
+				dst[i * 4 + 2] = src[i * 3 + 0];
+				dst[i * 4 + 3] = 0xFF;
+			}
+		}
+		void convertPixels(const unsigned char* src, unsigned char* dst, unsigned int numPixels, unsigned int bytesPerPixel) {
+			if (bytesPerPixel == 4)
+				convertBGRA(src, dst, numPixels);
+			else
+				convertBGR(src, dst, numPixels);
+		}
+	}
+
 	TGALoader::TGALoader(std::string filename, ResourceFormat::TextureData& textureData) {
 
 		bool result;
@@ -18,98 +58,172 @@ namespace FileLoader {
 
 	TGALoader::~TGALoader() {
 	}
-	
-	bool TGALoader::loadTarga(std::string filename, ResourceFormat::TextureData& textureData) {
 
-		textureData.channels = 4;
-
-		int error, bpp, imageSize, index;
-		unsigned int i, j, k;
-		FILE* filePtr;
-		unsigned int count;
-		TargaHeader targaFileHeader;
-		unsigned char* targaImage;
-
-
-		// Open the targa file for reading in binary.
-		error = fopen_s(&filePtr, filename.c_str(), "rb");
-		if (error != 0) {
+	bool TGALoader::loadTarga(std::string filename, ResourceFormat::TextureData& textureData) {
+		// The mapping is closed when the file goes out of scope, whichever way the decoding ends
+		MappedFile file;
+		if (!file.open(filename)) {
+			textureData = ResourceFormat::TextureData{ 0, 0, 4, nullptr, 1, ResourceFormat::R8G8B8A8 };
 			return false;
 		}
+		return Decode(reinterpret_cast<const unsigned char*>(file.getData()), file.getSize(), textureData);
+	}
 
-		// Read in the file header.
-		count = (unsigned int)fread(&targaFileHeader, sizeof(TargaHeader), 1, filePtr);
-		if (count != 1) {
+	bool TGALoader::Decode(const unsigned char* file, size_t fileSize, ResourceFormat::TextureData& textureData) {
+		textureData = ResourceFormat::TextureData{ 0, 0, 4, nullptr, 1, ResourceFormat::R8G8B8A8 };
+		if (fileSize < HEADER_SIZE)
 			return false;
-		}
 
-		// Get the important information from the header.
-		textureData.height = (int)targaFileHeader.height;
-		textureData.width = (int)targaFileHeader.width;
-		bpp = (int)targaFileHeader.bpp;
-
-		// Check that it is 32 bit and not 24 bit.
-		if (bpp != 32) {
-			Logger::Warning("Tried to load texture with " + std::to_string(bpp) + " bpp, requires 32 bpp");
+		TargaHeader header;
+		header.idLength = file[0];
+		header.colorMapType = file[1];
+		header.imageType = file[2];
+		header.colorMapLength = (unsigned short)(file[5] | (file[6] << 8));
+		header.colorMapEntrySize = file[7];
+		header.width = (unsigned short)(file[12] | (file[13] << 8));
+		header.height = (unsigned short)(file[14] | (file[15] << 8));
+		header.bpp = file[16];
+		header.descriptor = file[17];
+
+		if (header.imageType != UNCOMPRESSED_TRUE_COLOR && header.imageType != RLE_TRUE_COLOR) {
+			Logger::Warning("Tried to load targa image of type " + std::to_string(header.imageType) + ", only true color images are supported");
 			return false;
 		}
-
-		// Calculate the size of the 32 bit image data.
-		imageSize = textureData.width * textureData.height * 4;
-
-		// Allocate memory for the targa image data.
-		targaImage = SAIL_NEW unsigned char[imageSize];
-		if (!targaImage) {
+		if (header.bpp != 24 && header.bpp != 32) {
+			Logger::Warning("Tried to load texture with " + std::to_string(header.bpp) + " bpp, requires 24 or 32 bpp");
 			return false;
 		}
-
-		// Read in the targa image data.
-		count = (unsigned int)fread(targaImage, 1, imageSize, filePtr);
-		if (count != imageSize) {
+		if (header.width == 0 || header.height == 0)
 			return false;
-		}
 
-		// Close the file.
-		error = fclose(filePtr);
-		if (error != 0) {
+		// Skip the image id and any color map, true color images do not use it
+		size_t offset = HEADER_SIZE + header.idLength;
+		if (header.colorMapType == 1)
+			offset += (size_t)header.colorMapLength * ((header.colorMapEntrySize + 7) / 8);
+		const unsigned char* src = file + offset;
+		const unsigned char* end = file + fileSize;
+		if (offset > fileSize)
 			return false;
+
+		unsigned int width = header.width;
+		unsigned int height = header.height;
+		unsigned int bytesPerPixel = header.bpp / 8;
+		size_t rowSize = (size_t)width * 4;
+		// Rows are stored bottom up unless bit 5 of the descriptor is set
+		bool topDown = (header.descriptor & 0x20) != 0;
+		unsigned char* pixels = SAIL_NEW unsigned char[rowSize * height];
+
+		bool complete = true;
+		if (header.imageType == UNCOMPRESSED_TRUE_COLOR) {
+			size_t srcRowSize = (size_t)width * bytesPerPixel;
+			if ((size_t)(end - src) < srcRowSize * height) {
+				complete = false;
+			} else {
+				for (unsigned int y = 0; y < height; y++) {
+					unsigned char* dst = pixels + rowSize * (topDown ? y : height - 1 - y);
+					convertPixels(src + srcRowSize * y, dst, width, bytesPerPixel);
+				}
+			}
+		} else {
+			// Packets can continue across rows, a run or raw packet that is cut by the end of a row carries over into the next one
+			unsigned int packetLeft = 0;
+			bool isRun = false;
+			unsigned char runColor[4];
+			for (unsigned int y = 0; y < height && complete; y++) {
+				unsigned char* dst = pixels + rowSize * (topDown ? y : height - 1 - y);
+				unsigned int x = 0;
+				while (x < width) {
+					if (packetLeft == 0) {
+						if (src >= end) {
+							complete = false;
+							break;
+						}
+						unsigned char packet = *src++;
+						isRun = (packet & 0x80) != 0;
+						packetLeft = (packet & 0x7F) + 1u;
+						if (isRun) {
+							if ((size_t)(end - src) < bytesPerPixel) {
+								complete = false;
+								break;
+							}
+							convertPixels(src, runColor, 1, bytesPerPixel);
+							src += bytesPerPixel;
+						}
+					}
+					unsigned int count = std::min(packetLeft, width - x);
+					if (isRun) {
+						uint32_t color;
+						memcpy(&color, runColor, 4);
+						uint32_t* dstPixels = reinterpret_cast<uint32_t*>(dst) + x;
+						std::fill(dstPixels, dstPixels + count, color);
+					} else {
+						if ((size_t)(end - src) < (size_t)count * bytesPerPixel) {
+							complete = false;
+							break;
+						}
+						convertPixels(src, dst + (size_t)x * 4, count, bytesPerPixel);
+						src += (size_t)count * bytesPerPixel;
+					}
+					x += count;
+					packetLeft -= count;
+				}
+			}
 		}
 
-		// Allocate memory for the targa destination data.
-		textureData.textureData = SAIL_NEW unsigned char[imageSize];
-		if (!textureData.textureData) {
+		if (!complete) {
+			Logger::Warning("Targa file ended before all " + std::to_string(width) + "x" + std::to_string(height) + " pixels were read");
+			Memory::SafeDeleteArr(pixels);
 			return false;
 		}
 
-		// Initialize the index into the targa destination data array.
-		index = 0;
-
-		// Initialize the index into the targa image data.
-		k = (textureData.width * textureData.height * 4) - (textureData.width * 4);
-
-		// Now copy the targa image data into the targa destination array in the correct order since the targa format is stored upside down.
-		for (j = 0; j < textureData.height; j++) {
-			for (i = 0; i < textureData.width; i++) {
-				textureData.textureData[index + 0] = targaImage[k + 2];  // Red.
-				textureData.textureData[index + 1] = targaImage[k + 1];  // Green.
-				textureData.textureData[index + 2] = targaImage[k + 0];  // Blue
-				textureData.textureData[index + 3] = targaImage[k + 3];  // Alpha
+		textureData.width = width;
+		textureData.height = height;
+		textureData.channels = 4;
+		textureData.textureData = pixels;
+		textureData.mipLevels = 1;
+		textureData.format = ResourceFormat::R8G8B8A8;
+		return true;
+	}
 
-																// Increment the indexes into the targa data.
-				k += 4;
-				index += 4;
+	void TGALoader::BenchmarkDecode(const std::vector<std::string>& filenames, unsigned int iterations) {
+		double totalSeconds = 0.0;
+		double totalBytes = 0.0;
+		for (const std::string& filename : filenames) {
+			// Map and touch the file first so the timings only include decoding
+			MappedFile file;
+			if (!file.open(filename)) {
+				Logger::Warning("Could not open " + filename + " to benchmark");
+				continue;
 			}
-
-			// Set the targa image data index back to the preceding row at the beginning of the column since its reading it in upside down.
-			k -= (textureData.width * 8);
+			const unsigned char* data = reinterpret_cast<const unsigned char*>(file.getData());
+			volatile unsigned char touch = 0;
+			for (size_t i = 0; i < file.getSize(); i += 4096)
+				touch ^= data[i];
+
+			double bestSeconds = 0.0;
+			size_t decodedBytes = 0;
+			for (unsigned int i = 0; i < iterations; i++) {
+				ResourceFormat::TextureData textureData;
+				auto start = std::chrono::high_resolution_clock::now();
+				bool decoded = Decode(data, file.getSize(), textureData);
+				double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+				if (!decoded)
+					break;
+				decodedBytes = (size_t)textureData.width * textureData.height * 4;
+				Memory::SafeDeleteArr(textureData.textureData);
+				if (i == 0 || seconds < bestSeconds)
+					bestSeconds = seconds;
+			}
+			if (decodedBytes == 0) {
+				Logger::Warning("Could not decode " + filename);
+				continue;
+			}
+			totalSeconds += bestSeconds;
+			totalBytes += (double)decodedBytes;
+			Logger::Log(filename + ": " + std::to_string(bestSeconds * 1000.0) + " ms, " + std::to_string(decodedBytes / bestSeconds / (1024.0 * 1024.0)) + " MB/s");
 		}
-
-		// Release the targa image data now that it was copied into the destination array.
-		delete[] targaImage;
-		targaImage = 0;
-
-		return true;
-
+		if (totalSeconds > 0.0)
+			Logger::Log("Decoded " + std::to_string(totalBytes / (1024.0 * 1024.0)) + " MB in " + std::to_string(totalSeconds * 1000.0) + " ms, " + std::to_string(totalBytes / totalSeconds / (1024.0 * 1024.0)) + " MB/s");
 	}
 
 }
\ No newline at end of file
@@ -1,30 +1,46 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "../ResourceFormat.h"
 #include "../../utils/Utils.h"
 
 namespace FileLoader {
 
+	// Decodes 24 and 32 bit true color targa files, uncompressed or run length encoded, into top down RGBA
+	// The file is mapped and converted straight into the final buffer, the swizzle and flip happen in the same pass
 	class TGALoader {
 
 	public:
 		TGALoader(std::string filename, ResourceFormat::TextureData& textureData);
 		~TGALoader();
 
+		// Decodes a whole targa file held in memory, textureData is left empty on failure
+		static bool Decode(const unsigned char* file, size_t fileSize, ResourceFormat::TextureData& textureData);
+		// Decodes each file a number of times and logs the throughput in megabytes of decoded pixels per second
+		static void BenchmarkDecode(const std::vector<std::string>& filenames, unsigned int iterations);
 
 	private:
 		bool loadTarga(std::string filename, ResourceFormat::TextureData& textureData);
 
 	private:
-
+		enum ImageType {
+			UNCOMPRESSED_TRUE_COLOR = 2,
+			RLE_TRUE_COLOR = 10
+		};
+		// Header fields, read byte by byte since the file layout is not aligned
 		struct TargaHeader {
-			unsigned char data1[12];
+			unsigned char idLength;
+			unsigned char colorMapType;
+			unsigned char imageType;
+			unsigned short colorMapLength;
+			unsigned char colorMapEntrySize;
 			unsigned short width;
 			unsigned short height;
 			unsigned char bpp;
-			unsigned char data2;
+			unsigned char descriptor;
 		};
+		static const unsigned int HEADER_SIZE = 18;
 
 	};
 
@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "TextureCooker.h"
+#include "TGALoader.h"
+#include "DDSLoader.h"
+#include "../MipGenerator.h"
+#include "../TextureCompressor.h"
+#include "Sail/utils/MappedFile.h"
+#include "Sail/utils/Utils.h"
+#include <chrono>
+#include <filesystem>
+
+bool TextureCooker::Cook(const std::string& sourcePath, const std::string& cookedPath) {
+	auto start = std::chrono::high_resolution_clock::now();
+
+	ResourceFormat::TextureData data;
+	{
+		MappedFile file;
+		if (!file.open(sourcePath)) {
+			Logger::Warning("Could not find " + sourcePath + " to cook");
+			return false;
+		}
+		if (!FileLoader::TGALoader::Decode(reinterpret_cast<const unsigned char*>(file.getData()), file.getSize(), data)) {
+			Logger::Warning("Could not decode " + sourcePath + " to cook");
+			return false;
+		}
+	}
+
+	// Build the mip chain in place of the decoded image
+	MipGenerator::Filter filter = MipGenerator::GetFilterForFile(sourcePath);
+	unsigned int numLevels = MipGenerator::GetNumLevels(data.width, data.height);
+	unsigned char* chain = SAIL_NEW unsigned char[MipGenerator::GetChainSize(data.width, data.height, numLevels)];
+	memcpy(chain, data.textureData, MipGenerator::GetChainSize(data.width, data.height, 1));
+	Memory::SafeDeleteArr(data.textureData);
+	data.textureData = chain;
+	data.mipLevels = numLevels;
+	MipGenerator::Generate(chain, data.width, data.height, numLevels, filter);
+
+	ResourceFormat::TextureFormat format = TextureCompressor::ChooseFormat(data, filter);
+	bool result = TextureCompressor::Compress(data, format) && FileLoader::DDSLoader::Write(cookedPath, data);
+	Memory::SafeDeleteArr(data.textureData);
+	if (!result) {
+		Logger::Warning("Failed to cook " + sourcePath);
+		return false;
+	}
+
+	static const char* FORMAT_NAMES[] = { "RGBA8", "BC1", "BC3", "BC5", "BC7" };
+	double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	Logger::Log("Cooked " + sourcePath + " to " + cookedPath + " as " + FORMAT_NAMES[format] + " in " + std::to_string(seconds * 1000.0) + " ms");
+	return true;
+}
+
+std::string TextureCooker::GetCookedPath(const std::string& sourcePath) {
+	size_t dot = sourcePath.find_last_of('.');
+	size_t slash = sourcePath.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return sourcePath + ".dds";
+	return sourcePath.substr(0, dot) + ".dds";
+}
+
+bool TextureCooker::IsCookedFileCurrent(const std::string& sourcePath, const std::string& cookedPath) {
+	std::error_code error;
+	auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+	if (error)
+		return false;
+	auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+	return error || cookedTime >= sourceTime;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include "../ResourceFormat.h"
+
+// Converts targa files into block compressed DDS files with a full mip chain
+// TextureData loads the cooked file in place of the targa file when it is newer, so cooking needs no changes to materials
+class TextureCooker {
+public:
+	// Decodes the source, builds its mip chain and writes it compressed to the format picked by TextureCompressor::ChooseFormat
+	// Returns false on failure
+	static bool Cook(const std::string& sourcePath, const std::string& cookedPath);
+	// The extension of the source file is replaced with .dds
+	static std::string GetCookedPath(const std::string& sourcePath);
+	// True if the cooked file exists and is at least as new as the source, a missing source is fine
+	static bool IsCookedFileCurrent(const std::string& sourcePath, const std::string& cookedPath);
+
+};
\ No newline at end of file
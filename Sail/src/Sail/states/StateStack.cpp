@@ -72,7 +72,12 @@ void StateStack::render(float dt) {
 		Application::getInstance()->getImGuiHandler()->end();
 	}
 
+	Benchmark* benchmark = Application::getInstance()->getBenchmark();
+	if (benchmark)
+		benchmark->beginPhase(Benchmark::PRESENT);
 	Application::getInstance()->getAPI()->present(false);
+	if (benchmark)
+		benchmark->endPhase(Benchmark::PRESENT);
 }
 
 void StateStack::onEvent(Event& event) {
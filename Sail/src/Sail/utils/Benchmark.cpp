@@ -0,0 +1,264 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "Profiler.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// Whole string has to be a number, anything else fails instead of throwing like std::stoul
+static bool ParseUInt(const std::string& text, unsigned int& value) {
+	if (text.empty() || text[0] == '-')
+		return false;
+	char* end;
+	errno = 0;
+	unsigned long parsed = std::strtoul(text.c_str(), &end, 10);
+	if (*end != '\0' || errno == ERANGE || parsed > UINT_MAX)
+		return false;
+	value = (unsigned int)parsed;
+	return true;
+}
+
+static bool ParseFloat(const std::string& text, float& value) {
+	if (text.empty())
+		return false;
+	char* end;
+	errno = 0;
+	float parsed = std::strtof(text.c_str(), &end);
+	if (*end != '\0' || errno == ERANGE || !std::isfinite(parsed))
+		return false;
+	value = parsed;
+	return true;
+}
+
+Benchmark::Benchmark(const Settings& settings)
+	: m_settings(settings)
+	, m_frameIndex(0)
+	, m_frameStart(0)
+	, m_phaseStart{}
+	, m_current{}
+{
+	m_settings.numFrames = std::max(m_settings.numFrames, 1U);
+	m_frames.reserve(m_settings.numFrames);
+}
+
+Benchmark::~Benchmark() {
+
+}
+
+Benchmark::ParseResult Benchmark::ParseCommandLine(const std::string& commandLine, Settings& settings) {
+	std::istringstream stream(commandLine);
+	std::vector<std::string> args;
+	std::string arg;
+	while (stream >> arg)
+		args.push_back(arg);
+
+	bool enabled = false;
+	bool valid = true;
+	for (unsigned int i = 0; i < args.size() && valid; i++) {
+		const std::string& option = args[i];
+		if (option == "-benchmark") {
+			enabled = true;
+			continue;
+		}
+		if (option != "-frames" && option != "-warmup" && option != "-budget" && option != "-percentile" && option != "-out")
+			continue;
+		if (i + 1 >= args.size()) {
+			Logger::Warning("Benchmark option " + option + " is missing its value");
+			valid = false;
+			break;
+		}
+		const std::string& value = args[++i];
+		float percentile = 0.f;
+		if (option == "-frames") {
+			valid = ParseUInt(value, settings.numFrames);
+		} else if (option == "-warmup") {
+			valid = ParseUInt(value, settings.warmupFrames);
+		} else if (option == "-budget") {
+			valid = ParseFloat(value, settings.budgetMs) && settings.budgetMs >= 0.f;
+		} else if (option == "-percentile") {
+			valid = ParseFloat(value, percentile) && percentile >= 0.f && percentile <= 100.f;
+			settings.budgetPercentile = percentile / 100.f;
+		} else {
+			settings.outputPath = value;
+		}
+		if (!valid)
+			Logger::Warning("Invalid value \"" + value + "\" for benchmark option " + option);
+	}
+	if (!valid)
+		return INVALID_ARGUMENTS;
+	return (enabled) ? ENABLED : DISABLED;
+}
+
+void Benchmark::beginFrame() {
+	m_current = FrameTimes();
+	m_frameStart = Profiler::GetTimeNs();
+}
+
+void Benchmark::beginPhase(Phase phase) {
+	m_phaseStart[phase] = Profiler::GetTimeNs();
+}
+
+void Benchmark::endPhase(Phase phase) {
+	m_current.phases[phase] += (Profiler::GetTimeNs() - m_phaseStart[phase]) / 1000000.0;
+}
+
+void Benchmark::endFrame() {
+	m_current.total = (Profiler::GetTimeNs() - m_frameStart) / 1000000.0;
+	// Present is called from within render
+	m_current.phases[RENDER] = std::max(m_current.phases[RENDER] - m_current.phases[PRESENT], 0.0);
+
+	if (m_frameIndex >= m_settings.warmupFrames && !isFinished())
+		m_frames.push_back(m_current);
+	m_frameIndex++;
+}
+
+bool Benchmark::isFinished() const {
+	return m_frames.size() >= m_settings.numFrames;
+}
+
+int Benchmark::finish() {
+	bool withinBudget = true;
+	if (m_settings.budgetMs > 0.f && !m_frames.empty()) {
+		std::vector<double> totals(m_frames.size());
+		for (unsigned int i = 0; i < m_frames.size(); i++)
+			totals[i] = m_frames[i].total;
+		std::sort(totals.begin(), totals.end());
+		unsigned int rank = Utils::percentileRank((unsigned int)totals.size(), m_settings.budgetPercentile);
+		if (totals[rank] > m_settings.budgetMs) {
+			withinBudget = false;
+			Logger::Warning("Benchmark exceeded the frame budget, p" + std::to_string((int)(m_settings.budgetPercentile * 100.f)) + " was " + std::to_string(totals[rank]) + " ms with a budget of " + std::to_string(m_settings.budgetMs) + " ms");
+		}
+	}
+
+	bool written = writeCSV(m_settings.outputPath + ".csv");
+	written &= writeJSON(m_settings.outputPath + ".json", withinBudget);
+	if (!written) {
+		Logger::Warning("Failed to write the benchmark reports to " + m_settings.outputPath);
+		return EXIT_FAILED;
+	}
+	Summary total = getSummary(NUM_PHASES);
+	Logger::Log("Benchmark finished, " + std::to_string(m_frames.size()) + " frames, mean " + std::to_string(total.mean) + " ms, p99 " + std::to_string(total.p99) + " ms");
+	return withinBudget ? 0 : 1;
+}
+
+void Benchmark::setCameraPath(const std::vector<CameraKeyframe>& path) {
+	m_cameraPath = path;
+}
+
+bool Benchmark::hasCameraPath() const {
+	return !m_cameraPath.empty();
+}
+
+void Benchmark::getCameraPose(glm::vec3& position, glm::vec3& direction) const {
+	if (m_cameraPath.empty())
+		return;
+	float time = m_frameIndex * m_settings.fixedDeltaTime;
+
+	// Find the keyframes surrounding the current time
+	auto next = std::upper_bound(m_cameraPath.begin(), m_cameraPath.end(), time, [](float t, const CameraKeyframe& key) {
+		return t < key.time;
+	});
+	const CameraKeyframe& a = (next == m_cameraPath.begin()) ? *next : *(next - 1);
+	const CameraKeyframe& b = (next == m_cameraPath.end()) ? m_cameraPath.back() : *next;
+	float t = (b.time > a.time) ? glm::clamp((time - a.time) / (b.time - a.time), 0.f, 1.f) : 0.f;
+
+	position = glm::mix(a.position, b.position, t);
+	glm::vec3 target = glm::mix(a.target, b.target, t);
+	if (glm::length(target - position) > 1e-5f)
+		direction = glm::normalize(target - position);
+}
+
+const Benchmark::Settings& Benchmark::getSettings() const {
+	return m_settings;
+}
+
+unsigned int Benchmark::getFrameIndex() const {
+	return m_frameIndex;
+}
+
+Benchmark::Summary Benchmark::getSummary(Phase phase) const {
+	Summary summary = {};
+	if (m_frames.empty())
+		return summary;
+
+	std::vector<double> times(m_frames.size());
+	double sum = 0.0;
+	for (unsigned int i = 0; i < m_frames.size(); i++) {
+		times[i] = getTime(m_frames[i], phase);
+		sum += times[i];
+		if (times[i] > summary.worst) {
+			summary.worst = times[i];
+			summary.worstFrame = m_settings.warmupFrames + i;
+		}
+	}
+	std::sort(times.begin(), times.end());
+	auto percentile = [&](float p) {
+		return times[Utils::percentileRank((unsigned int)times.size(), p)];
+	};
+	summary.mean = sum / times.size();
+	summary.p50 = percentile(0.5f);
+	summary.p95 = percentile(0.95f);
+	summary.p99 = percentile(0.99f);
+	return summary;
+}
+
+const char* Benchmark::GetPhaseName(Phase phase) {
+	switch (phase) {
+	case INPUT: return "input";
+	case UPDATE: return "update";
+	case RENDER: return "render";
+	case PRESENT: return "present";
+	default: return "total";
+	}
+}
+
+double Benchmark::getTime(const FrameTimes& frame, Phase phase) const {
+	return (phase == NUM_PHASES) ? frame.total : frame.phases[phase];
+}
+
+bool Benchmark::writeCSV(const std::string& path) const {
+	std::ofstream file(path);
+	if (!file.is_open())
+		return false;
+
+	file << "frame";
+	for (unsigned int p = 0; p <= NUM_PHASES; p++)
+		file << "," << GetPhaseName((Phase)p) << "_ms";
+	file << "\n";
+	for (unsigned int i = 0; i < m_frames.size(); i++) {
+		file << m_settings.warmupFrames + i;
+		for (unsigned int p = 0; p <= NUM_PHASES; p++)
+			file << "," << getTime(m_frames[i], (Phase)p);
+		file << "\n";
+	}
+	return file.good();
+}
+
+bool Benchmark::writeJSON(const std::string& path, bool withinBudget) const {
+	std::ofstream file(path);
+	if (!file.is_open())
+		return false;
+
+	file << "{\n";
+	file << "\t\"frames\": " << m_frames.size() << ",\n";
+	file << "\t\"warmupFrames\": " << m_settings.warmupFrames << ",\n";
+	file << "\t\"budgetMs\": " << m_settings.budgetMs << ",\n";
+	file << "\t\"budgetPercentile\": " << m_settings.budgetPercentile << ",\n";
+	file << "\t\"withinBudget\": " << (withinBudget ? "true" : "false") << ",\n";
+	file << "\t\"phases\": {\n";
+	for (unsigned int p = 0; p <= NUM_PHASES; p++) {
+		Summary s = getSummary((Phase)p);
+		file << "\t\t\"" << GetPhaseName((Phase)p) << "\": { ";
+		file << "\"mean\": " << s.mean << ", \"p50\": " << s.p50 << ", \"p95\": " << s.p95 << ", \"p99\": " << s.p99;
+		file << ", \"worst\": " << s.worst << ", \"worstFrame\": " << s.worstFrame << " }";
+		file << ((p < NUM_PHASES) ? ",\n" : "\n");
+	}
+	file << "\t}\n";
+	file << "}\n";
+	return file.good();
+}
\ No newline at end of file
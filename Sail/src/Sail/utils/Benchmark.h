@@ -0,0 +1,106 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+// Runs the application for a fixed number of frames and records the CPU time of each phase of the frame
+// When finished, per frame times are written to <outputPath>.csv and a summary to <outputPath>.json
+// The summary contains mean, p50, p95, p99 and the worst frame of every phase
+//
+// Enabled from the command line with
+//   -benchmark [-frames N] [-warmup N] [-budget MS] [-percentile P] [-out PATH]
+// or from code through Application::startBenchmark()
+class Benchmark {
+public:
+	enum Phase {
+		INPUT,
+		UPDATE,
+		RENDER, // Everything in Application::render() except the API present
+		PRESENT,
+		NUM_PHASES
+	};
+	// Exit code of runs that could not produce a result, such as when the reports can not be written or the arguments are invalid
+	static const int EXIT_FAILED = 2;
+
+	struct Settings {
+		unsigned int numFrames = 1000;
+		// Frames run before recording starts, lets caches and pools settle
+		unsigned int warmupFrames = 60;
+		// Delta time given to the application every frame, makes runs reproducible
+		float fixedDeltaTime = 1.f / 60.f;
+		std::string outputPath = "benchmark";
+		// The run fails if this percentile of the total frame time is above the budget, 0 disables the check
+		float budgetMs = 0.f;
+		float budgetPercentile = 0.99f;
+	};
+	enum ParseResult {
+		DISABLED,
+		ENABLED,
+		// A value is missing or malformed, the error is logged
+		INVALID_ARGUMENTS
+	};
+	struct CameraKeyframe {
+		float time;
+		glm::vec3 position;
+		glm::vec3 target;
+	};
+	struct Summary {
+		double mean;
+		double p50;
+		double p95;
+		double p99;
+		double worst;
+		unsigned int worstFrame;
+	};
+
+public:
+	Benchmark(const Settings& settings);
+	~Benchmark();
+
+	// ENABLED if the command line contains -benchmark, the other arguments are read into settings
+	static ParseResult ParseCommandLine(const std::string& commandLine, Settings& settings);
+
+	void beginFrame();
+	void beginPhase(Phase phase);
+	void endPhase(Phase phase);
+	void endFrame();
+	bool isFinished() const;
+
+	// Writes the reports, returns the process exit code
+	// 0 if the budget was kept, 1 if it was exceeded and EXIT_FAILED if the reports could not be written
+	int finish();
+
+	// Keyframes have to be sorted by time, the camera is linearly interpolated between them
+	void setCameraPath(const std::vector<CameraKeyframe>& path);
+	bool hasCameraPath() const;
+	// Camera pose at the current benchmark time, which is advanced by the fixed delta time each frame
+	void getCameraPose(glm::vec3& position, glm::vec3& direction) const;
+
+	const Settings& getSettings() const;
+	unsigned int getFrameIndex() const;
+	// Summary of the total frame time when phase is NUM_PHASES
+	Summary getSummary(Phase phase) const;
+
+	static const char* GetPhaseName(Phase phase);
+
+private:
+	struct FrameTimes {
+		double phases[NUM_PHASES]; // Milliseconds
+		double total;
+	};
+	double getTime(const FrameTimes& frame, Phase phase) const;
+	bool writeCSV(const std::string& path) const;
+	bool writeJSON(const std::string& path, bool withinBudget) const;
+
+private:
+	Settings m_settings;
+	std::vector<CameraKeyframe> m_cameraPath;
+
+	unsigned int m_frameIndex;
+	long long m_frameStart;
+	long long m_phaseStart[NUM_PHASES];
+	FrameTimes m_current;
+	std::vector<FrameTimes> m_frames;
+
+};
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "pch.h"
+#include "MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+	: m_data(nullptr)
+	, m_size(0)
+#ifdef _WIN32
+	, m_file(INVALID_HANDLE_VALUE)
+	, m_mapping(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open(const std::string& path) {
+	close();
+#ifdef _WIN32
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+		close();
+		return false;
+	}
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping) {
+		close();
+		return false;
+	}
+	m_data = (const char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_data) {
+		close();
+		return false;
+	}
+	m_size = (size_t)size.QuadPart;
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0) {
+		::close(file);
+		return false;
+	}
+	void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	// The mapping keeps the file alive
+	::close(file);
+	if (data == MAP_FAILED)
+		return false;
+	m_data = (const char*)data;
+	m_size = (size_t)info.st_size;
+#endif
+	return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
+	m_mapping = nullptr;
+	m_file = INVALID_HANDLE_VALUE;
+#else
+	if (m_data)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool MappedFile::isOpen() const {
+	return m_data != nullptr;
+}
+
+const char* MappedFile::getData() const {
+	return m_data;
+}
+
+size_t MappedFile::getSize() const {
+	return m_size;
+}
\ No newline at end of file
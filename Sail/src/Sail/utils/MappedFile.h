@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+// Read only view of a whole file mapped into memory
+// Pages are loaded by the OS when they are first read, so nothing is copied until the data is used
+class MappedFile {
+public:
+	MappedFile();
+	~MappedFile();
+	// The mapping is released by the destructor, so copies would unmap it twice
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Returns false if the file could not be opened or is empty
+	bool open(const std::string& path);
+	void close();
+
+	bool isOpen() const;
+	const char* getData() const;
+	size_t getSize() const;
+
+private:
+	const char* m_data;
+	size_t m_size;
+#ifdef _WIN32
+	void* m_file;
+	void* m_mapping;
+#endif
+
+};
\ No newline at end of file
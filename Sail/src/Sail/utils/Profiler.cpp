@@ -0,0 +1,246 @@
+#include "pch.h"
+#include "Profiler.h"
+#include "Utils.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace {
+	// Number of events listed in the ImGui window
+	const unsigned int MAX_DISPLAYED_EVENTS = 512;
+
+	std::mutex s_bufferMutex;
+	std::vector<std::unique_ptr<Profiler::ThreadBuffer>> s_buffers;
+	unsigned int s_nextThreadID = 0;
+	thread_local Profiler::ThreadBuffer* t_buffer = nullptr;
+
+	// Flags the buffer of its thread when the thread exits, EndFrame() frees it once the remaining events are collected
+	struct ThreadExitNotifier {
+		Profiler::ThreadBuffer* buffer = nullptr;
+		~ThreadExitNotifier() {
+			if (buffer)
+				buffer->exited.store(true, std::memory_order_release);
+		}
+	};
+	thread_local ThreadExitNotifier t_exitNotifier;
+
+	// Scope names usually are literals or __FUNCTION__, but may still contain quotes or backslashes
+	std::string EscapeJSON(const char* text) {
+		std::string escaped;
+		for (const char* c = text; *c; c++) {
+			switch (*c) {
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if ((unsigned char)*c < 0x20) {
+					char code[8];
+					snprintf(code, sizeof(code), "\\u%04x", (unsigned int)(unsigned char)*c);
+					escaped += code;
+				} else {
+					escaped += *c;
+				}
+			}
+		}
+		return escaped;
+	}
+
+	// Ticks are converted to nanoseconds by comparing against the OS clock from the first frame to the latest
+	long long s_calibrationTicks = Profiler::Now();
+	long long s_calibrationNs = Profiler::GetTimeNs();
+	double s_nsPerTick = 1.0;
+
+	long long s_frameStart = 0;
+	double s_lastFrameTime = 0.0;
+	std::vector<Profiler::Event> s_lastFrameEvents;
+	unsigned long long s_lostEvents = 0;
+
+	unsigned int s_captureFramesLeft = 0;
+	std::vector<Profiler::Event> s_captureEvents;
+	std::vector<std::pair<long long, long long>> s_captureFrames;
+}
+
+std::atomic<bool> Profiler::s_enabled(true);
+
+void Profiler::SetEnabled(bool enabled) {
+	s_enabled = enabled;
+}
+
+bool Profiler::IsEnabled() {
+	return s_enabled;
+}
+
+void Profiler::BeginFrame() {
+	s_frameStart = GetTimeNs();
+}
+
+void Profiler::EndFrame() {
+	long long frameEnd = GetTimeNs();
+	s_lastFrameTime = (frameEnd - s_frameStart) / 1000000.0;
+
+#ifdef SAIL_PROFILER_RDTSC
+	long long ticks = Now();
+	if (frameEnd - s_calibrationNs > 1000000 && ticks != s_calibrationTicks)
+		s_nsPerTick = (double)(frameEnd - s_calibrationNs) / (double)(ticks - s_calibrationTicks);
+#endif
+	auto toNs = [](long long ticks) {
+		return s_calibrationNs + (long long)((ticks - s_calibrationTicks) * s_nsPerTick);
+	};
+
+	// Collect the new events of all threads
+	s_lastFrameEvents.clear();
+	{
+		std::lock_guard<std::mutex> lock(s_bufferMutex);
+		for (auto& buffer : s_buffers) {
+			// Read before the write index so the events written before the thread exited are all collected
+			bool exited = buffer->exited.load(std::memory_order_acquire);
+			unsigned long long write = buffer->writeIndex.load(std::memory_order_acquire);
+			if (write - buffer->readIndex > RING_BUFFER_SIZE) {
+				// The thread wrote more events than fit in the ring buffer since the last frame
+				s_lostEvents += write - buffer->readIndex - RING_BUFFER_SIZE;
+				buffer->readIndex = write - RING_BUFFER_SIZE;
+			}
+			size_t firstEvent = s_lastFrameEvents.size();
+			for (unsigned long long i = buffer->readIndex; i < write; i++) {
+				const ThreadBuffer::Slot& slot = buffer->events[i & (RING_BUFFER_SIZE - 1)];
+				Event event;
+				event.name = slot.name.load(std::memory_order_relaxed);
+				event.start = slot.start.load(std::memory_order_relaxed);
+				event.end = slot.end.load(std::memory_order_relaxed);
+				event.depth = slot.depth.load(std::memory_order_relaxed);
+				event.threadID = buffer->threadID;
+				s_lastFrameEvents.push_back(event);
+			}
+			// The thread keeps writing while the events are copied, any slot it started to overwrite in the meantime may be torn
+			// Slot i is reused by event i + RING_BUFFER_SIZE, which is written once the write index has reached it
+			std::atomic_thread_fence(std::memory_order_acquire);
+			unsigned long long writeAfter = buffer->writeIndex.load(std::memory_order_relaxed);
+			if (writeAfter + 1 > buffer->readIndex + RING_BUFFER_SIZE) {
+				unsigned long long numTorn = std::min(writeAfter + 1 - RING_BUFFER_SIZE - buffer->readIndex, write - buffer->readIndex);
+				s_lastFrameEvents.erase(s_lastFrameEvents.begin() + firstEvent, s_lastFrameEvents.begin() + firstEvent + (size_t)numTorn);
+				s_lostEvents += numTorn;
+			}
+			buffer->readIndex = write;
+			if (exited)
+				buffer.reset();
+		}
+		s_buffers.erase(std::remove(s_buffers.begin(), s_buffers.end(), nullptr), s_buffers.end());
+	}
+	for (Event& event : s_lastFrameEvents) {
+		event.start = toNs(event.start);
+		event.end = toNs(event.end);
+	}
+	std::sort(s_lastFrameEvents.begin(), s_lastFrameEvents.end(), [](const Event& a, const Event& b) {
+		return (a.threadID != b.threadID) ? a.threadID < b.threadID : a.start < b.start;
+	});
+
+	if (s_captureFramesLeft > 0) {
+		s_captureEvents.insert(s_captureEvents.end(), s_lastFrameEvents.begin(), s_lastFrameEvents.end());
+		s_captureFrames.emplace_back(s_frameStart, frameEnd);
+		s_captureFramesLeft--;
+	}
+}
+
+void Profiler::StartCapture(unsigned int numFrames) {
+	s_captureEvents.clear();
+	s_captureFrames.clear();
+	s_captureFramesLeft = numFrames;
+}
+
+bool Profiler::IsCapturing() {
+	return s_captureFramesLeft > 0;
+}
+
+bool Profiler::SaveCapture(const std::string& path) {
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		Logger::Error("Profiler: could not open " + path + " for writing");
+		return false;
+	}
+
+	// Timestamps are written in microseconds relative to the first frame
+	long long origin = (s_captureFrames.empty()) ? 0 : s_captureFrames.front().first;
+	file << "{\"traceEvents\":[\n";
+	bool first = true;
+	for (unsigned int i = 0; i < s_captureFrames.size(); i++) {
+		auto& frame = s_captureFrames[i];
+		file << (first ? "" : ",\n") << "{\"name\":\"Frame " << i << "\",\"ph\":\"X\",\"pid\":0,\"tid\":\"Frames\",\"ts\":" << (frame.first - origin) / 1000.0 << ",\"dur\":" << (frame.second - frame.first) / 1000.0 << "}";
+		first = false;
+	}
+	for (const Event& event : s_captureEvents) {
+		file << (first ? "" : ",\n") << "{\"name\":\"" << EscapeJSON(event.name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.threadID << ",\"ts\":" << (event.start - origin) / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+		first = false;
+	}
+	file << "\n]}\n";
+	return true;
+}
+
+const std::vector<Profiler::Event>& Profiler::GetLastFrameEvents() {
+	return s_lastFrameEvents;
+}
+
+double Profiler::GetLastFrameTime() {
+	return s_lastFrameTime;
+}
+
+void Profiler::DrawImGui() {
+	if (!ImGui::Begin("Profiler")) {
+		ImGui::End();
+		return;
+	}
+
+	bool enabled = IsEnabled();
+	if (ImGui::Checkbox("Enabled", &enabled))
+		SetEnabled(enabled);
+	ImGui::Text("Frame: %.3f ms", s_lastFrameTime);
+	if (s_lostEvents > 0)
+		ImGui::Text("Lost events: %llu", s_lostEvents);
+
+	if (IsCapturing()) {
+		ImGui::Text("Capturing, %u frames left", s_captureFramesLeft);
+	} else {
+		if (ImGui::Button("Capture 60 frames"))
+			StartCapture(60);
+		if (!s_captureFrames.empty()) {
+			ImGui::SameLine();
+			if (ImGui::Button("Save profile_capture.json"))
+				SaveCapture("profile_capture.json");
+		}
+	}
+	ImGui::Separator();
+
+	// Events are sorted by start time, which lists parents before their children
+	unsigned int lastThread = 0xFFFFFFFF;
+	unsigned int numEvents = std::min((unsigned int)s_lastFrameEvents.size(), MAX_DISPLAYED_EVENTS);
+	for (unsigned int i = 0; i < numEvents; i++) {
+		const Event& event = s_lastFrameEvents[i];
+		if (event.threadID != lastThread) {
+			ImGui::Text("Thread %u", event.threadID);
+			lastThread = event.threadID;
+		}
+		ImGui::Text("%*s%s  %.3f ms", (event.depth + 1) * 2, "", event.name, (event.end - event.start) / 1000000.0);
+	}
+
+	ImGui::End();
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+	if (!t_buffer) {
+		// First scope on this thread, the buffer is owned by the profiler so the events of an exited thread can still be collected
+		auto buffer = std::make_unique<ThreadBuffer>();
+		buffer->writeIndex = 0;
+		buffer->exited = false;
+		buffer->readIndex = 0;
+		buffer->depth = 0;
+		std::lock_guard<std::mutex> lock(s_bufferMutex);
+		buffer->threadID = s_nextThreadID++;
+		t_buffer = buffer.get();
+		t_exitNotifier.buffer = t_buffer;
+		s_buffers.push_back(std::move(buffer));
+	}
+	return t_buffer;
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SAIL_PROFILER_RDTSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Hierarchical CPU profiler
+// Scopes are recorded into per thread ring buffers which are only written by their own thread
+// The main thread collects the events of all threads in EndFrame(), where they are shown in the ImGui window or saved to a capture
+// Events a thread overwrites while EndFrame() copies them are detected through the write index and dropped
+// The buffer of a thread is freed in the first EndFrame() after the thread exited
+// Captures are saved in the Chrome trace event format, open them in chrome://tracing
+//
+// Usage:
+//   SAIL_PROFILE_SCOPE("Scene::draw");
+//   SAIL_PROFILE_FUNCTION();
+// Define SAIL_DISABLE_PROFILING to compile out all scopes
+class Profiler {
+public:
+	// Has to be a power of two
+	static const unsigned int RING_BUFFER_SIZE = 1 << 14;
+
+	struct Event {
+		const char* name; // Has to be a string literal or otherwise outlive the profiler
+		long long start;  // Ticks from Now() in the ring buffers, converted to nanoseconds when collected
+		long long end;
+		unsigned int depth;
+		unsigned int threadID;
+	};
+	struct ThreadBuffer {
+		// Written by the owning thread while EndFrame() might read it, the fields are atomic to make that defined
+		// Relaxed atomic loads and stores compile to plain moves
+		struct Slot {
+			std::atomic<const char*> name;
+			std::atomic<long long> start;
+			std::atomic<long long> end;
+			std::atomic<unsigned int> depth;
+		};
+		Slot events[RING_BUFFER_SIZE];
+		std::atomic<unsigned long long> writeIndex;
+		std::atomic<bool> exited; // Set when the thread exits
+		unsigned long long readIndex; // Only used by the thread calling EndFrame()
+		unsigned int threadID;
+		unsigned int depth;
+	};
+
+public:
+	static void SetEnabled(bool enabled);
+	static bool IsEnabled();
+
+	// Call once per frame from the main thread
+	static void BeginFrame();
+	static void EndFrame();
+
+	// Records all events of the following numFrames frames
+	static void StartCapture(unsigned int numFrames);
+	static bool IsCapturing();
+	// Writes the last capture as Chrome trace event JSON, returns false on failure
+	static bool SaveCapture(const std::string& path);
+
+	// Events of the last finished frame, sorted by thread and start time
+	static const std::vector<Event>& GetLastFrameEvents();
+	static double GetLastFrameTime(); // Milliseconds
+
+	// Draws the profiler window, call between ImGuiHandler::begin() and end()
+	static void DrawImGui();
+
+	static ThreadBuffer* GetThreadBuffer();
+	// Timestamp in ticks, the time stamp counter is used where available since it is a lot cheaper to read than the OS clocks
+	inline static long long Now() {
+#ifdef SAIL_PROFILER_RDTSC
+		return (long long)__rdtsc();
+#else
+		return GetTimeNs();
+#endif
+	}
+	inline static long long GetTimeNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	inline static bool IsEnabledFast() {
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+private:
+	static std::atomic<bool> s_enabled;
+
+};
+
+class ProfileScope {
+public:
+	inline ProfileScope(const char* name)
+		: m_name(name)
+		, m_buffer(nullptr)
+	{
+		if (Profiler::IsEnabledFast()) {
+			m_buffer = Profiler::GetThreadBuffer();
+			m_depth = m_buffer->depth++;
+			m_start = Profiler::Now();
+		}
+	}
+	inline ~ProfileScope() {
+		if (!m_buffer)
+			return;
+		long long end = Profiler::Now();
+		m_buffer->depth--;
+		unsigned long long index = m_buffer->writeIndex.load(std::memory_order_relaxed);
+		// Keeps the slot from being overwritten before the index saying so is visible to EndFrame(), free on x86
+		std::atomic_thread_fence(std::memory_order_release);
+		Profiler::ThreadBuffer::Slot& slot = m_buffer->events[index & (Profiler::RING_BUFFER_SIZE - 1)];
+		slot.name.store(m_name, std::memory_order_relaxed);
+		slot.start.store(m_start, std::memory_order_relaxed);
+		slot.end.store(end, std::memory_order_relaxed);
+		slot.depth.store(m_depth, std::memory_order_relaxed);
+		// Publish the event to the reading thread
+		m_buffer->writeIndex.store(index + 1, std::memory_order_release);
+	}
+
+private:
+	const char* m_name;
+	Profiler::ThreadBuffer* m_buffer;
+	long long m_start;
+	unsigned int m_depth;
+};
+
+#ifdef SAIL_DISABLE_PROFILING
+#define SAIL_PROFILE_SCOPE(name)
+#define SAIL_PROFILE_FUNCTION()
+#else
+#define SAIL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SAIL_PROFILE_CONCAT(a, b) SAIL_PROFILE_CONCAT_IMPL(a, b)
+#define SAIL_PROFILE_SCOPE(name) ProfileScope SAIL_PROFILE_CONCAT(sailProfileScope, __LINE__)(name)
+#define SAIL_PROFILE_FUNCTION() SAIL_PROFILE_SCOPE(__FUNCTION__)
+#endif
\ No newline at end of file
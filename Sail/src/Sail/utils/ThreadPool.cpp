@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "ThreadPool.h"
+
+thread_local bool ThreadPool::s_isWorker = false;
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+	: m_stopping(false)
+{
+	if (numThreads == 0)
+		numThreads = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+	m_threads.reserve(numThreads);
+	for (unsigned int i = 0; i < numThreads; i++)
+		m_threads.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (auto& thread : m_threads)
+		thread.join();
+}
+
+void ThreadPool::parallelFor(unsigned int count, const std::function<void(unsigned int)>& job) {
+	unsigned int numHelpers = (count > 0) ? std::min(getNumThreads(), count - 1) : 0;
+	if (numHelpers == 0 || s_isWorker) {
+		for (unsigned int i = 0; i < count; i++)
+			job(i);
+		return;
+	}
+
+	// Helpers that start after every index is taken return right away, the shared state keeps them valid after this returns
+	struct Loop {
+		std::atomic<unsigned int> next;
+		std::atomic<unsigned int> done;
+		unsigned int count;
+		const std::function<void(unsigned int)>* job;
+		std::mutex mutex;
+		std::condition_variable finished;
+		// First exception thrown by a call, rethrown on the calling thread once every call is done
+		std::exception_ptr error;
+	};
+	auto loop = std::make_shared<Loop>();
+	loop->next = 0;
+	loop->done = 0;
+	loop->count = count;
+	loop->job = &job;
+	auto run = [](Loop& loop) {
+		unsigned int i;
+		while ((i = loop.next++) < loop.count) {
+			try {
+				(*loop.job)(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(loop.mutex);
+				if (!loop.error)
+					loop.error = std::current_exception();
+			}
+			if (++loop.done == loop.count) {
+				std::lock_guard<std::mutex> lock(loop.mutex);
+				loop.finished.notify_all();
+			}
+		}
+	};
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (unsigned int i = 0; i < numHelpers; i++)
+			m_jobs.emplace([loop, run]() { run(*loop); });
+	}
+	m_condition.notify_all();
+
+	run(*loop);
+	std::unique_lock<std::mutex> lock(loop->mutex);
+	loop->finished.wait(lock, [&loop]() { return loop->done == loop->count; });
+	if (loop->error)
+		std::rethrow_exception(loop->error);
+}
+
+unsigned int ThreadPool::getNumThreads() const {
+	return (unsigned int)m_threads.size();
+}
+
+bool ThreadPool::IsWorkerThread() {
+	return s_isWorker;
+}
+
+ThreadPool& ThreadPool::GetShared() {
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::work() {
+	s_isWorker = true;
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+			if (m_jobs.empty())
+				return;
+			job = std::move(m_jobs.front());
+			m_jobs.pop();
+		}
+		job();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed number of worker threads running jobs in the order they were pushed
+// Jobs left in the queue are still run before the destructor returns
+class ThreadPool {
+public:
+	// 0 uses one thread per core except the one running the main thread
+	ThreadPool(unsigned int numThreads = 0);
+	~ThreadPool();
+
+	// Runs the job on a worker, the future holds its return value
+	template<typename F>
+	auto push(F&& job) -> std::future<decltype(job())>;
+
+	// Calls job(i) for every i below count, split between the workers and the calling thread, and returns when all calls are done
+	// On a worker of any pool the loop runs on that thread alone, so nested loops neither oversubscribe nor wait on busy workers
+	// If calls throw, the remaining calls still run and the first exception is rethrown here
+	void parallelFor(unsigned int count, const std::function<void(unsigned int)>& job);
+
+	unsigned int getNumThreads() const;
+
+	// True on the worker threads of every pool
+	static bool IsWorkerThread();
+	// Pool for short work split by parallelFor during a frame, created on first use
+	// Long jobs such as file loads belong in a pool of their own so they do not hold up the frame
+	static ThreadPool& GetShared();
+
+private:
+	void work();
+
+private:
+	std::vector<std::thread> m_threads;
+	std::queue<std::function<void()>> m_jobs;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping;
+	static thread_local bool s_isWorker;
+
+};
+
+template<typename F>
+auto ThreadPool::push(F&& job) -> std::future<decltype(job())> {
+	// std::function has to be copyable, so the task is shared
+	auto task = std::make_shared<std::packaged_task<decltype(job())()>>(std::forward<F>(job));
+	auto future = task->get_future();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.emplace([task]() { (*task)(); });
+	}
+	m_condition.notify_one();
+	return future;
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <time.h>
+#include <chrono>
 
 class Timer {
 
@@ -8,46 +8,34 @@ public:
 
 	void startTimer() {
 
-		LARGE_INTEGER frequencyCount;
-		QueryPerformanceFrequency(&frequencyCount);
-
-		m_countsPerSecond = static_cast<double>(frequencyCount.QuadPart);
-
-		QueryPerformanceCounter(&frequencyCount);
-		m_counterStart = frequencyCount.QuadPart;
+		m_counterStart = Clock::now();
+		m_oldframeTime = m_counterStart;
 
 	}
 
+	// Seconds since startTimer()
 	double getTime() {
 
-		LARGE_INTEGER currentTime;
-		QueryPerformanceCounter(&currentTime);
-
-		return static_cast<double>(currentTime.QuadPart - m_counterStart / m_countsPerSecond);
+		return std::chrono::duration<double>(Clock::now() - m_counterStart).count();
 
 	}
 
+	// Seconds since the last call
 	double getFrameTime() {
 
-		LARGE_INTEGER currentTime;
-		INT64 elapsedTime;
-		QueryPerformanceCounter(&currentTime);
+		Clock::time_point currentTime = Clock::now();
+		double elapsedTime = std::chrono::duration<double>(currentTime - m_oldframeTime).count();
+		m_oldframeTime = currentTime;
 
-		elapsedTime = currentTime.QuadPart - m_oldframeTime;
-		m_oldframeTime = currentTime.QuadPart;
-
-		if (elapsedTime < 0)
-			elapsedTime = 0;
-
-		return elapsedTime / m_countsPerSecond;
+		return elapsedTime;
 
 	}
 
 private:
-	double m_countsPerSecond = 0.0;
-	INT64 m_counterStart = 0;
-
-	INT64 m_oldframeTime = 0;
+	// Steady clock, uses QueryPerformanceCounter on windows
+	typedef std::chrono::steady_clock Clock;
 
-};
+	Clock::time_point m_counterStart;
+	Clock::time_point m_oldframeTime;
 
+};
\ No newline at end of file
@@ -47,6 +47,12 @@ float Utils::smootherstep(float edge0, float edge1, float x) {
 }
 
 
+unsigned int Utils::percentileRank(unsigned int count, float percentile) {
+	if (count == 0)
+		return 0;
+	return (unsigned int)(clamp(percentile, 0.f, 1.f) * (count - 1) + 0.5f);
+}
+
 glm::vec4 Utils::getRandomColor() {
 	return glm::vec4(Utils::rnd(), Utils::rnd(), Utils::rnd(), 1);
 }
@@ -66,7 +72,7 @@ const char* Utils::String::findToken(const std::string& token, const char* sourc
 	if (match = strstr(source, token.c_str())) {
 		bool left = match == source || isspace((match - 1)[0]);
 		match += token.size();
-		bool right = match != '\0' || isspace(match[0]); // might need to be match + 1
+		bool right = *match != '\0' || isspace(match[0]); // might need to be match + 1
 		return match;
 	}
 	return nullptr;
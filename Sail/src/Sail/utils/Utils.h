@@ -15,7 +15,7 @@
 		throw std::exception(); \
 
 // Macro to easier track down memory leaks
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
 #define SAIL_NEW new ( _NORMAL_BLOCK , __FILE__ , __LINE__ )
 #else
 #define SAIL_NEW new
@@ -77,36 +77,12 @@ class Logger {
 public:
 
 	inline static void Log(const std::string& msg) {
-
-		HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
-
-		// Save currently set color
-		CONSOLE_SCREEN_BUFFER_INFO csbi;
-		GetConsoleScreenBufferInfo(hstdout, &csbi);
-
-		SetConsoleTextAttribute(hstdout, 0x0F);
-		std::cout << "LOG: " << msg << std::endl;
-
-		// Revert color
-		SetConsoleTextAttribute(hstdout, csbi.wAttributes);
-
-
+		Print("LOG: ", msg, 0x0F);
 	}
 
 
 	inline static void Warning(const std::string& msg) {
-		
-		HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
-
-		// Save currently set color
-		CONSOLE_SCREEN_BUFFER_INFO csbi;
-		GetConsoleScreenBufferInfo(hstdout, &csbi);
-
-		SetConsoleTextAttribute(hstdout, 0xE0);
-		std::cout << "WARNING: " << msg << std::endl;
-
-		// Revert color
-		SetConsoleTextAttribute(hstdout, csbi.wAttributes);
+		Print("WARNING: ", msg, 0xE0);
 
 #ifdef _SAIL_BREAK_ON_WARNING
  		__debugbreak();
@@ -114,22 +90,31 @@ public:
 	}
 
 	inline static void Error(const std::string& msg) {
+		Print("ERROR: ", msg, 0xC0);
+
+#ifdef _SAIL_BREAK_ON_ERROR
+		__debugbreak();
+#endif
+	}
 
+private:
+	// Prints in the given console color attributes, the previous colors are restored afterwards
+	// Other platforms print without colors
+	inline static void Print(const char* prefix, const std::string& msg, unsigned short color) {
+#ifdef _WIN32
 		HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
 
 		// Save currently set color
 		CONSOLE_SCREEN_BUFFER_INFO csbi;
 		GetConsoleScreenBufferInfo(hstdout, &csbi);
 
-		SetConsoleTextAttribute(hstdout, 0xC0);
-		std::cout << "ERROR: " << msg << std::endl;
+		SetConsoleTextAttribute(hstdout, color);
+		std::cout << prefix << msg << std::endl;
 
 		// Revert color
 		SetConsoleTextAttribute(hstdout, csbi.wAttributes);
-
-
-#ifdef _SAIL_BREAK_ON_ERROR
-		__debugbreak();
+#else
+		std::cout << prefix << msg << std::endl;
 #endif
 	}
 
@@ -144,6 +129,8 @@ namespace Utils {
 	glm::vec4 getRandomColor();
 	float clamp(float val, float min, float max);
 	float smootherstep(float edge0, float edge1, float x);
+	// Index of the nearest rank for a percentile in [0, 1] of count sorted values
+	unsigned int percentileRank(unsigned int count, float percentile);
 
 	static std::random_device rd;
 	static std::mt19937 gen(rd());
@@ -1,5 +1,6 @@
 #pragma once
 
+#ifdef _WIN32
 // Memory leak detection for debug
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
@@ -11,6 +12,11 @@
 #else
 #define SAIL_NEW new
 #endif
+#else
+#include <stdlib.h>
+#define SAIL_NEW new
+#endif
+#include "Sail/Platform.h"
 
 #define NOMINMAX // Removes min max macros which cause issues
 // Exclude some less used APIs to speed up the build process on windows
@@ -26,9 +32,10 @@
 //#include <windows.h>
 
 #include <memory>
+#ifdef _WIN32
 #include <comdef.h> 
+#endif
 #include <string>
-#include <Memory>
 #include <algorithm>
 #include <iostream>
 #include <vector>
@@ -0,0 +1,50 @@
+#include "Test.h"
+#include "Sail/utils/Benchmark.h"
+#include "Sail/utils/Utils.h"
+
+TEST(PercentileRankEdgeCases) {
+	// A single sample is every percentile
+	CHECK(Utils::percentileRank(1, 0.f) == 0);
+	CHECK(Utils::percentileRank(1, 0.5f) == 0);
+	CHECK(Utils::percentileRank(1, 1.f) == 0);
+	// p0 is the smallest and p100 the largest value
+	CHECK(Utils::percentileRank(100, 0.f) == 0);
+	CHECK(Utils::percentileRank(100, 1.f) == 99);
+	// Rounded to the nearest rank
+	CHECK(Utils::percentileRank(100, 0.5f) == 50);
+	CHECK(Utils::percentileRank(101, 0.5f) == 50);
+	CHECK(Utils::percentileRank(100, 0.99f) == 98);
+	// Out of range percentiles are clamped and no values gives the first index
+	CHECK(Utils::percentileRank(10, -1.f) == 0);
+	CHECK(Utils::percentileRank(10, 2.f) == 9);
+	CHECK(Utils::percentileRank(0, 0.5f) == 0);
+}
+
+TEST(BenchmarkParsesCommandLine) {
+	Benchmark::Settings settings;
+	CHECK(Benchmark::ParseCommandLine("-record input.rec", settings) == Benchmark::DISABLED);
+	CHECK(Benchmark::ParseCommandLine("-benchmark -frames 500 -warmup 20 -budget 16.6 -percentile 95 -out bench", settings) == Benchmark::ENABLED);
+	CHECK(settings.numFrames == 500);
+	CHECK(settings.warmupFrames == 20);
+	CHECK_NEAR(settings.budgetMs, 16.6f, 0.0001f);
+	CHECK_NEAR(settings.budgetPercentile, 0.95f, 0.0001f);
+	CHECK(settings.outputPath == "bench");
+}
+
+TEST(BenchmarkRejectsMalformedArguments) {
+	const char* commandLines[] = {
+		"-benchmark -frames abc",
+		"-benchmark -frames 10abc",
+		"-benchmark -frames -5",
+		"-benchmark -frames 99999999999999999999",
+		"-benchmark -warmup",
+		"-benchmark -budget fast",
+		"-benchmark -budget -1",
+		"-benchmark -percentile 101",
+		"-benchmark -percentile 1e99",
+	};
+	for (const char* commandLine : commandLines) {
+		Benchmark::Settings settings;
+		CHECK(Benchmark::ParseCommandLine(commandLine, settings) == Benchmark::INVALID_ARGUMENTS);
+	}
+}
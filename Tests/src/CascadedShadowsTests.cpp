@@ -0,0 +1,146 @@
+#include "Test.h"
+#include "Sail/graphics/light/CascadedShadows.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+	const float NEAR_Z = 0.1f;
+	const float FAR_Z = 500.f;
+
+	glm::mat4 CameraProj() {
+		return glm::perspectiveFovLH_ZO(glm::radians(70.f), 1280.f, 720.f, NEAR_Z, FAR_Z);
+	}
+
+	// World space corners of the part of the view frustum between two view depths
+	void SliceCorners(const glm::mat4& view, const glm::mat4& proj, float sliceNear, float sliceFar, glm::vec3* outCorners) {
+		glm::mat4 invView = glm::inverse(view);
+		float tanX = 1.f / proj[0][0];
+		float tanY = 1.f / proj[1][1];
+		unsigned int i = 0;
+		for (float z : { sliceNear, sliceFar }) {
+			for (float x : { -1.f, 1.f }) {
+				for (float y : { -1.f, 1.f })
+					outCorners[i++] = glm::vec3(invView * glm::vec4(x * z * tanX, y * z * tanY, z, 1.f));
+			}
+		}
+	}
+
+	// Position of the cascade center on the light plane, in texels
+	glm::vec2 CenterInTexels(const CascadedShadows::Cascade& cascade, const glm::vec3& lightDirection) {
+		glm::mat4 lightRotation = glm::lookAtLH(glm::vec3(0.f), glm::normalize(lightDirection), glm::vec3(0.f, 1.f, 0.f));
+		glm::vec3 centerLS = glm::vec3(lightRotation * glm::vec4(cascade.sphereCenter, 1.f));
+		return glm::vec2(centerLS) / cascade.texelSize;
+	}
+}
+
+TEST(CascadedShadowsSplitsBlendUniformAndLogarithmic) {
+	float uniform[5], logarithmic[5], blended[5];
+	CascadedShadows::ComputeSplits(1.f, 81.f, 4, 0.f, uniform);
+	CascadedShadows::ComputeSplits(1.f, 81.f, 4, 1.f, logarithmic);
+	CascadedShadows::ComputeSplits(1.f, 81.f, 4, 0.5f, blended);
+
+	for (unsigned int i = 0; i <= 4; i++) {
+		CHECK_NEAR(uniform[i], 1.f + 20.f * i, 1e-4f);
+		CHECK_NEAR(logarithmic[i], std::pow(3.f, (float)i), 1e-3f);
+		CHECK_NEAR(blended[i], 0.5f * (uniform[i] + logarithmic[i]), 1e-3f);
+	}
+	for (unsigned int i = 0; i < 4; i++)
+		CHECK(blended[i] < blended[i + 1]);
+}
+
+TEST(CascadedShadowsSphereEnclosesSlice) {
+	glm::mat4 proj = CameraProj();
+	float tanX = 1.f / proj[0][0];
+	float tanY = 1.f / proj[1][1];
+	float slices[][2] = { { 0.1f, 2.f }, { 2.f, 10.f }, { 10.f, 40.f }, { 40.f, 100.f }, { 0.1f, 500.f } };
+
+	for (auto& slice : slices) {
+		glm::vec3 center;
+		float radius;
+		CascadedShadows::FitSphere(proj, slice[0], slice[1], center, radius);
+		CHECK(center.x == 0.f && center.y == 0.f);
+		CHECK(center.z <= slice[1]);
+
+		// Every corner is inside, and the furthest one is on the sphere so it can not be smaller
+		float maxDistance = 0.f;
+		for (float z : { slice[0], slice[1] }) {
+			float distance = glm::length(glm::vec3(z * tanX, z * tanY, z) - center);
+			CHECK(distance <= radius * 1.0001f);
+			maxDistance = std::max(maxDistance, distance);
+		}
+		CHECK_NEAR(maxDistance, radius, radius * 1e-4f);
+	}
+}
+
+TEST(CascadedShadowsCascadesContainTheirSlice) {
+	glm::mat4 view = glm::lookAtLH(glm::vec3(3.f, 5.f, -8.f), glm::vec3(10.f, 2.f, 30.f), glm::vec3(0.f, 1.f, 0.f));
+	glm::mat4 proj = CameraProj();
+	CascadedShadows shadows;
+	shadows.update(view, proj, glm::vec3(0.4f, -1.f, 0.3f));
+	CHECK(shadows.getNumCascades() == 4);
+	CHECK_NEAR(shadows.getCascade(0).splitNear, NEAR_Z, 1e-4f);
+	CHECK_NEAR(shadows.getCascade(3).splitFar, shadows.getSettings().maxDistance, 1e-3f);
+
+	for (unsigned int i = 0; i < shadows.getNumCascades(); i++) {
+		const CascadedShadows::Cascade& cascade = shadows.getCascade(i);
+		if (i > 0)
+			CHECK(cascade.splitNear == shadows.getCascade(i - 1).splitFar);
+		CHECK_NEAR(cascade.texelSize, 2.f * cascade.sphereRadius / shadows.getSettings().resolution, 1e-6f);
+
+		// The crop matrix maps the whole slice into the shadow map and depth range
+		glm::vec3 corners[8];
+		SliceCorners(view, proj, cascade.splitNear, cascade.splitFar, corners);
+		for (const glm::vec3& corner : corners) {
+			glm::vec4 clip = cascade.viewProj * glm::vec4(corner, 1.f);
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			CHECK(std::abs(ndc.x) <= 1.f && std::abs(ndc.y) <= 1.f);
+			CHECK(ndc.z >= 0.f && ndc.z <= 1.f);
+			CHECK(shadows.isCasterVisible(i, corner - 0.01f, corner + 0.01f));
+		}
+	}
+}
+
+TEST(CascadedShadowsSnapCentersToTexels) {
+	glm::mat4 proj = CameraProj();
+	glm::vec3 lightDirection(0.3f, -1.f, 0.5f);
+	CascadedShadows shadows;
+	shadows.update(glm::lookAtLH(glm::vec3(0.f, 2.f, 0.f), glm::vec3(0.f, 2.f, 1.f), glm::vec3(0.f, 1.f, 0.f)), proj, lightDirection);
+	CascadedShadows::Cascade before = shadows.getCascade(1);
+
+	// Moving and turning the camera keeps the size of the cascade and moves it in whole texels
+	shadows.update(glm::lookAtLH(glm::vec3(0.013f, 2.f, 0.007f), glm::vec3(0.6f, 1.8f, 1.f), glm::vec3(0.f, 1.f, 0.f)), proj, lightDirection);
+	const CascadedShadows::Cascade& after = shadows.getCascade(1);
+	CHECK(after.sphereRadius == before.sphereRadius);
+	CHECK(after.texelSize == before.texelSize);
+
+	glm::vec2 texelsBefore = CenterInTexels(before, lightDirection);
+	glm::vec2 texelsAfter = CenterInTexels(after, lightDirection);
+	CHECK_NEAR(texelsBefore.x, std::round(texelsBefore.x), 1e-2f);
+	CHECK_NEAR(texelsBefore.y, std::round(texelsBefore.y), 1e-2f);
+	CHECK_NEAR(texelsAfter.x, std::round(texelsAfter.x), 1e-2f);
+	CHECK_NEAR(texelsAfter.y, std::round(texelsAfter.y), 1e-2f);
+}
+
+TEST(CascadedShadowsCullCasters) {
+	glm::mat4 view = glm::lookAtLH(glm::vec3(0.f, 2.f, 0.f), glm::vec3(0.f, 2.f, 1.f), glm::vec3(0.f, 1.f, 0.f));
+	CascadedShadows shadows;
+	// Straight down, so the light frustums are vertical columns
+	shadows.update(view, CameraProj(), glm::vec3(0.f, -1.f, 0.f));
+	const CascadedShadows::Cascade& first = shadows.getCascade(0);
+
+	// Far above the cascade, between it and the light, still casts into it
+	glm::vec3 above = first.sphereCenter + glm::vec3(0.f, first.sphereRadius + 500.f, 0.f);
+	CHECK(shadows.isCasterVisible(0, above - 1.f, above + 1.f));
+	// Below the cascade it can not
+	glm::vec3 below = first.sphereCenter - glm::vec3(0.f, 3.f * first.sphereRadius + shadows.getSettings().casterPullback, 0.f);
+	CHECK(!shadows.isCasterVisible(0, below - 0.1f, below + 0.1f));
+	// Beside it neither
+	glm::vec3 beside = first.sphereCenter + glm::vec3(2.f * first.sphereRadius, 0.f, 0.f);
+	CHECK(!shadows.isCasterVisible(0, beside - 0.1f, beside + 0.1f));
+
+	// Close to the camera is in the first cascade only, the cascades are stacked in depth
+	glm::vec3 close(0.f, 2.f, 0.5f);
+	CHECK((shadows.getCasterMask(close - 0.1f, close + 0.1f) & 1) == 1);
+	glm::vec3 distant(0.f, 2.f, shadows.getCascade(3).splitFar - 1.f);
+	CHECK((shadows.getCasterMask(distant - 0.1f, distant + 0.1f) & 1) == 0);
+	CHECK((shadows.getCasterMask(distant - 0.1f, distant + 0.1f) & 8) == 8);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "Test.h"
+#include "TestApplication.h"
+#include "API/NULL/NullInput.h"
+#include <cstdio>
+
+namespace {
+	const unsigned int NUM_FRAMES = 16;
+	const char* RECORDING_PATH = "tests_input.rec";
+
+	// Input state the application sees in one frame
+	struct FrameInput {
+		bool w, wJustPressed;
+		bool a, aJustPressed;
+		bool left, leftJustPressed;
+		glm::ivec2 mousePosition;
+		glm::ivec2 mouseDelta;
+		float dt;
+
+		bool operator==(const FrameInput& other) const {
+			return w == other.w && wJustPressed == other.wJustPressed && a == other.a && aJustPressed == other.aJustPressed
+				&& left == other.left && leftJustPressed == other.leftJustPressed
+				&& mousePosition == other.mousePosition && mouseDelta == other.mouseDelta && dt == other.dt;
+		}
+	};
+
+	FrameInput Sample(float dt) {
+		return {
+			Input::IsKeyPressed(SAIL_KEY_W), Input::WasKeyJustPressed(SAIL_KEY_W),
+			Input::IsKeyPressed(SAIL_KEY_A), Input::WasKeyJustPressed(SAIL_KEY_A),
+			Input::IsMouseButtonPressed(SAIL_MOUSE_LEFT_BUTTON), Input::WasMouseButtonJustPressed(SAIL_MOUSE_LEFT_BUTTON),
+			Input::GetMousePosition(), Input::GetMouseDelta(), dt
+		};
+	}
+
+	// Sets the input seen from the next frame on
+	void Script(NullInput& input, unsigned int frame) {
+		switch (frame) {
+		case 2: input.setKeyState(SAIL_KEY_W, true); break;
+		case 5: input.setMousePosition(glm::ivec2(100, 50)); input.setMouseButtonState(SAIL_MOUSE_LEFT_BUTTON, true); break;
+		case 6: input.setMousePosition(glm::ivec2(130, 40)); break;
+		case 8: input.setKeyState(SAIL_KEY_W, false); input.setKeyState(SAIL_KEY_A, true); break;
+		case 9: input.setMouseButtonState(SAIL_MOUSE_LEFT_BUTTON, false); break;
+		case 12: input.setKeyState(SAIL_KEY_A, false); input.setMousePosition(glm::ivec2(0, 0)); break;
+		}
+	}
+}
+
+TEST(InputReplayReproducesRecording) {
+	TestApplication& app = TestApplication::Get();
+	NullInput& input = *Input::GetPlatformInstance<NullInput>();
+
+	std::vector<FrameInput> recorded;
+	app.startInputRecording(RECORDING_PATH);
+	app.runFrames(NUM_FRAMES, [&](unsigned int frame, float dt) {
+		recorded.push_back(Sample(dt));
+		Script(input, frame);
+	});
+	CHECK(app.stopInputRecording());
+	// The script has to show up in the recorded frames, or the comparison below proves nothing
+	CHECK(recorded.size() == NUM_FRAMES);
+	CHECK(recorded[3].w && recorded[3].wJustPressed && !recorded[4].wJustPressed);
+	CHECK(recorded[6].left && recorded[6].leftJustPressed && recorded[6].mouseDelta == glm::ivec2(100, 50));
+	CHECK(recorded[7].mouseDelta == glm::ivec2(30, -10));
+	CHECK(!recorded[9].w && recorded[9].aJustPressed);
+
+	std::vector<FrameInput> replayed;
+	CHECK(app.startInputReplay(RECORDING_PATH));
+	app.runFrames(NUM_FRAMES, [&](unsigned int frame, float dt) {
+		replayed.push_back(Sample(dt));
+	});
+	app.stopInputReplay();
+	std::remove(RECORDING_PATH);
+
+	CHECK(replayed.size() == recorded.size());
+	for (unsigned int i = 0; i < recorded.size() && i < replayed.size(); i++)
+		CHECK(replayed[i] == recorded[i]);
+	CHECK(Input::GetInstance() == &input);
+}
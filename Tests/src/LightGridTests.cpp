@@ -0,0 +1,108 @@
+#include "Test.h"
+#include "Sail/graphics/light/LightGrid.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <set>
+
+namespace {
+	// 16x9 tiles over a 16:9 view, so every tile covers the same angle in x and y
+	const unsigned int TILES_X = 16;
+	const unsigned int TILES_Y = 9;
+	const unsigned int SLICES = 24;
+
+	// Attenuation giving a radius just below one unit
+	PointLight MakeLight(const glm::vec3& position) {
+		PointLight light;
+		light.setColor(glm::vec3(1.f));
+		light.setAttenuation(1.f, 0.f, 100.f);
+		light.setPosition(position);
+		return light;
+	}
+
+	// Clusters the light was assigned to, as cluster indices
+	std::set<unsigned int> ClustersOf(const LightGrid& grid, unsigned int light) {
+		std::set<unsigned int> clusters;
+		for (unsigned int c = 0; c < grid.getNumClusters(); c++) {
+			const LightGrid::Cluster& cluster = grid.getClusters()[c];
+			for (unsigned int i = 0; i < cluster.count; i++) {
+				if (grid.getLightIndices()[cluster.offset + i] == light)
+					clusters.insert(c);
+			}
+		}
+		return clusters;
+	}
+}
+
+TEST(LightGridAssignsKnownLightsToTiles) {
+	// At the origin looking down +z, depth from 1 to 100
+	glm::mat4 view = glm::lookAtLH(glm::vec3(0.f), glm::vec3(0.f, 0.f, 1.f), glm::vec3(0.f, 1.f, 0.f));
+	glm::mat4 proj = glm::perspectiveFovLH_ZO(glm::radians(90.f), 16.f, 9.f, 1.f, 100.f);
+
+	std::vector<PointLight> lights;
+	// In the middle of tile (12, 2) at depth 50, far from every tile and slice border
+	// Tile 12 is centered on ndc x 0.5625 and row 2 on ndc y 0.4444, x and y are ndc times depth over the projection scale
+	lights.push_back(MakeLight(glm::vec3(0.5625f / proj[0][0] * 50.f, 0.4444f * 50.f, 50.f)));
+	// On the border between tiles 7 and 8 of row 4, at depth 20
+	lights.push_back(MakeLight(glm::vec3(0.f, 0.f, 20.f)));
+	// Behind the camera and outside of the side planes
+	lights.push_back(MakeLight(glm::vec3(0.f, 0.f, -10.f)));
+	lights.push_back(MakeLight(glm::vec3(100.f, 0.f, 10.f)));
+
+	LightGrid grid(TILES_X, TILES_Y, SLICES);
+	grid.build(view, proj, lights);
+	CHECK_NEAR(grid.getNearZ(), 1.f, 1e-4f);
+	CHECK_NEAR(grid.getFarZ(), 100.f, 1e-2f);
+	CHECK(grid.getNumClusters() == TILES_X * TILES_Y * SLICES);
+	CHECK(grid.getLightData().size() == lights.size());
+
+	// Exponential slices, slice = log(z / near) / log(far / near) * slices
+	CHECK(grid.getSlice(50.f) == 20);
+	CHECK(grid.getSlice(20.f) == 15);
+	CHECK(grid.getSlice(0.5f) == 0);
+	CHECK(grid.getSlice(1000.f) == SLICES - 1);
+
+	std::set<unsigned int> expected = { grid.getClusterIndex(12, 2, 20) };
+	CHECK(ClustersOf(grid, 0) == expected);
+	expected = { grid.getClusterIndex(7, 4, 15), grid.getClusterIndex(8, 4, 15) };
+	CHECK(ClustersOf(grid, 1) == expected);
+	CHECK(ClustersOf(grid, 2).empty());
+	CHECK(ClustersOf(grid, 3).empty());
+
+	// The lists are compact and in cluster order
+	unsigned int offset = 0;
+	for (const LightGrid::Cluster& cluster : grid.getClusters()) {
+		CHECK(cluster.offset == offset);
+		offset += cluster.count;
+	}
+	CHECK(offset == 3);
+	CHECK(grid.getLightIndices().size() == 3);
+
+	// The light data is copied for the shaders
+	const LightGrid::LightData& data = grid.getLightData()[1];
+	CHECK(data.position == glm::vec3(0.f, 0.f, 20.f));
+	CHECK_NEAR(data.radius, lights[1].getRadius(), 1e-5f);
+	CHECK(data.attConstant == 1.f && data.attLinear == 0.f && data.attQuadratic == 100.f);
+}
+
+TEST(LightGridSpreadsLargeLightOverNeighbours) {
+	glm::mat4 view = glm::lookAtLH(glm::vec3(0.f), glm::vec3(0.f, 0.f, 1.f), glm::vec3(0.f, 1.f, 0.f));
+	glm::mat4 proj = glm::perspectiveFovLH_ZO(glm::radians(90.f), 16.f, 9.f, 1.f, 100.f);
+
+	// Radius of ten at depth 30, reaching several tiles and slices around the center of the view
+	PointLight light = MakeLight(glm::vec3(0.f, 0.f, 30.f));
+	light.setAttenuation(1.f, 0.f, 1.f);
+	LightGrid grid(TILES_X, TILES_Y, SLICES);
+	grid.build(view, proj, { light });
+
+	std::set<unsigned int> clusters = ClustersOf(grid, 0);
+	CHECK(!clusters.empty());
+	// Center tiles of every slice the sphere spans, and nothing outside of its depth range
+	for (unsigned int slice = grid.getSlice(30.f - light.getRadius()); slice <= grid.getSlice(30.f + light.getRadius()); slice++)
+		CHECK(clusters.count(grid.getClusterIndex(7, 4, slice)) == 1);
+	for (unsigned int c : clusters) {
+		unsigned int slice = c / (TILES_X * TILES_Y);
+		CHECK(slice >= grid.getSlice(30.f - light.getRadius()) && slice <= grid.getSlice(30.f + light.getRadius()));
+	}
+	// Corner tiles look away from the light
+	CHECK(clusters.count(grid.getClusterIndex(0, 0, grid.getSlice(30.f))) == 0);
+	CHECK(clusters.count(grid.getClusterIndex(TILES_X - 1, TILES_Y - 1, grid.getSlice(30.f))) == 0);
+}
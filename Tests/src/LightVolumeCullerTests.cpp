@@ -0,0 +1,90 @@
+#include "Test.h"
+#include "Sail/graphics/light/LightVolumeCuller.h"
+#include "Sail/graphics/camera/PerspectiveCamera.h"
+
+namespace {
+	const float NEAR_Z = 0.1f;
+	const float FAR_Z = 100.f;
+
+	// Attenuation giving a radius just below ten units
+	PointLight MakeLight(const glm::vec3& position) {
+		PointLight light;
+		light.setColor(glm::vec3(1.f, 0.5f, 0.25f));
+		light.setAttenuation(1.f, 0.f, 1.f);
+		light.setPosition(position);
+		return light;
+	}
+
+	bool Contains(const std::vector<LightVolumeCuller::LightVolume>& volumes, const glm::vec3& position) {
+		for (const LightVolumeCuller::LightVolume& volume : volumes) {
+			if (volume.position == position)
+				return true;
+		}
+		return false;
+	}
+}
+
+TEST(LightVolumeCullerSortsKnownLights) {
+	// At the origin looking down +z, the side planes are at x = +-16/9 z
+	PerspectiveCamera camera(90.f, 16.f / 9.f, NEAR_Z, FAR_Z);
+	camera.setPosition(glm::vec3(0.f));
+	camera.setDirection(glm::vec3(0.f, 0.f, 1.f));
+	float radius = MakeLight(glm::vec3(0.f)).getRadius();
+	CHECK(radius > 9.9f && radius < 10.f);
+
+	std::vector<PointLight> lights;
+	glm::vec3 inFront(0.f, 0.f, 20.f);
+	glm::vec3 behind(0.f, 0.f, -30.f);
+	glm::vec3 aroundCamera(0.f, 0.f, -radius * 0.5f);
+	// Sphere center outside of the side plane, 8.5 and 10.9 units away from it
+	glm::vec3 touchingSide(35.f, 0.f, 10.f);
+	glm::vec3 beyondSide(40.f, 0.f, 10.f);
+	// Sphere center past the far plane, 9 and 11 units away from it
+	glm::vec3 touchingFar(0.f, 0.f, FAR_Z + 9.f);
+	glm::vec3 beyondFar(0.f, 0.f, FAR_Z + 11.f);
+	for (const glm::vec3& position : { inFront, behind, aroundCamera, touchingSide, beyondSide, touchingFar, beyondFar })
+		lights.push_back(MakeLight(position));
+
+	LightVolumeCuller culler;
+	culler.cull(camera, lights);
+	const std::vector<LightVolumeCuller::LightVolume>& outside = culler.getOutsideVolumes();
+	const std::vector<LightVolumeCuller::LightVolume>& inside = culler.getInsideVolumes();
+	CHECK(culler.getNumCulled() == 3);
+	CHECK(outside.size() + inside.size() == 4);
+	CHECK(Contains(outside, inFront));
+	CHECK(Contains(outside, touchingSide));
+	CHECK(Contains(outside, touchingFar));
+	// Behind the camera, but the sphere reaches past the near plane
+	CHECK(Contains(inside, aroundCamera));
+	CHECK(!Contains(outside, behind) && !Contains(inside, behind));
+	CHECK(!Contains(outside, beyondSide) && !Contains(inside, beyondSide));
+	CHECK(!Contains(outside, beyondFar) && !Contains(inside, beyondFar));
+
+	// The instance data is copied from the light
+	const LightVolumeCuller::LightVolume& volume = outside.front();
+	CHECK(volume.position == inFront);
+	CHECK_NEAR(volume.radius, radius, 1e-5f);
+	CHECK(volume.color == glm::vec3(1.f, 0.5f, 0.25f));
+	CHECK(volume.attConstant == 1.f && volume.attLinear == 0.f && volume.attQuadratic == 1.f);
+	// A new cull starts over
+	culler.cull(camera, std::vector<PointLight>());
+	CHECK(culler.getNumCulled() == 0 && culler.getOutsideVolumes().empty() && culler.getInsideVolumes().empty());
+}
+
+TEST(LightVolumeCullerSplitsOnNearPlaneCorners) {
+	PerspectiveCamera camera(90.f, 16.f / 9.f, NEAR_Z, FAR_Z);
+	camera.setPosition(glm::vec3(0.f));
+	camera.setDirection(glm::vec3(0.f, 0.f, 1.f));
+	float radius = MakeLight(glm::vec3(0.f)).getRadius();
+	// The near plane corners are this far from the camera, any sphere closer than radius + that may clip the near plane
+	float nearCornerDist = NEAR_Z * std::sqrt(1.f + 1.f + (16.f / 9.f) * (16.f / 9.f));
+
+	std::vector<PointLight> lights;
+	lights.push_back(MakeLight(glm::vec3(0.f, 0.f, radius + nearCornerDist - 0.01f)));
+	lights.push_back(MakeLight(glm::vec3(0.f, 0.f, radius + nearCornerDist + 0.01f)));
+	LightVolumeCuller culler;
+	culler.cull(camera, lights);
+	CHECK(culler.getNumCulled() == 0);
+	CHECK(culler.getInsideVolumes().size() == 1 && culler.getInsideVolumes()[0].position == lights[0].getPosition());
+	CHECK(culler.getOutsideVolumes().size() == 1 && culler.getOutsideVolumes()[0].position == lights[1].getPosition());
+}
@@ -0,0 +1,36 @@
+#include "Test.h"
+#include <iostream>
+
+namespace {
+	unsigned int s_numFailures = 0;
+}
+
+std::vector<Test::Case>& Test::GetCases() {
+	static std::vector<Case> cases;
+	return cases;
+}
+
+void Test::Fail(const char* file, int line, const std::string& expression) {
+	std::cout << file << "(" << line << "): CHECK failed: " << expression << std::endl;
+	s_numFailures++;
+}
+
+// Runs every test, or only the ones whose name contains the first argument
+int main(int argc, char** argv) {
+	std::string filter = (argc > 1) ? argv[1] : "";
+	unsigned int numRun = 0;
+	unsigned int numFailed = 0;
+	for (const Test::Case& test : Test::GetCases()) {
+		if (std::string(test.name).find(filter) == std::string::npos)
+			continue;
+		unsigned int failuresBefore = s_numFailures;
+		test.function();
+		numRun++;
+		bool passed = s_numFailures == failuresBefore;
+		if (!passed)
+			numFailed++;
+		std::cout << ((passed) ? "[ OK ] " : "[FAIL] ") << test.name << std::endl;
+	}
+	std::cout << numRun - numFailed << "/" << numRun << " tests passed" << std::endl;
+	return (numFailed > 0) ? 1 : 0;
+}
\ No newline at end of file
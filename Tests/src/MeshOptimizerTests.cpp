@@ -0,0 +1,108 @@
+#include "Test.h"
+#include "Sail/resources/loaders/MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <random>
+
+namespace {
+	const unsigned int GRID_SIZE = 100;
+
+	// Triangle soup of a GRID_SIZE x GRID_SIZE grid of quads in shuffled order, like the FBX loader reads it
+	void CreateShuffledGrid(Mesh::Data& data) {
+		data.allocate(GRID_SIZE * GRID_SIZE * 6, 0, Mesh::Data::POSITIONS | Mesh::Data::TEXCOORDS);
+		std::vector<unsigned int> quads(GRID_SIZE * GRID_SIZE);
+		for (unsigned int i = 0; i < quads.size(); i++)
+			quads[i] = i;
+		std::shuffle(quads.begin(), quads.end(), std::mt19937(1));
+
+		unsigned int v = 0;
+		for (unsigned int quad : quads) {
+			float x = (float)(quad % GRID_SIZE);
+			float y = (float)(quad / GRID_SIZE);
+			float corners[6][2] = { { x, y }, { x, y + 1 }, { x + 1, y }, { x + 1, y }, { x, y + 1 }, { x + 1, y + 1 } };
+			for (auto& corner : corners) {
+				data.positions[v] = Mesh::vec3(corner[0], corner[1], 0.f);
+				data.texCoords[v] = Mesh::vec2(corner[0] * 0.1f, corner[1] * 0.1f);
+				v++;
+			}
+		}
+	}
+
+	// Corner positions of every triangle, sorted so meshes can be compared regardless of order
+	std::vector<std::array<float, 6>> GetTriangles(const Mesh::Data& data) {
+		std::vector<std::array<float, 6>> triangles;
+		unsigned int numCorners = (data.numIndices > 0) ? data.numIndices : data.numVertices;
+		for (unsigned int i = 0; i < numCorners; i += 3) {
+			std::array<float, 6> triangle;
+			for (unsigned int c = 0; c < 3; c++) {
+				unsigned int index = (data.numIndices > 0) ? (unsigned int)data.indices[i + c] : i + c;
+				triangle[c * 2] = data.positions[index].vec.x;
+				triangle[c * 2 + 1] = data.positions[index].vec.y;
+			}
+			triangles.push_back(triangle);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+}
+
+TEST(MeshOptimizerWeldsIdenticalVertices) {
+	Mesh::Data data;
+	CreateShuffledGrid(data);
+	auto triangles = GetTriangles(data);
+
+	MeshOptimizer::WeldVertices(data);
+	CHECK(data.numVertices == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+	CHECK(data.numIndices == GRID_SIZE * GRID_SIZE * 6);
+	CHECK(GetTriangles(data) == triangles);
+
+	// Meshes that already have indices are left alone
+	unsigned long* indices = data.indices;
+	MeshOptimizer::WeldVertices(data);
+	CHECK(data.indices == indices);
+	CHECK(data.numVertices == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+	data.freeArrays();
+}
+
+TEST(MeshOptimizerReducesACMR) {
+	Mesh::Data data;
+	CreateShuffledGrid(data);
+	auto triangles = GetTriangles(data);
+	CHECK_NEAR(MeshOptimizer::ComputeACMR(data), 3.f, 1e-6f);
+
+	MeshOptimizer::WeldVertices(data);
+	float weldedACMR = MeshOptimizer::ComputeACMR(data);
+	MeshOptimizer::OptimizeVertexCache(data);
+	float optimizedACMR = MeshOptimizer::ComputeACMR(data);
+	// The shuffled quads share few vertices within the cache, Forsyth's ordering gets close to the 0.5 of a perfect grid
+	CHECK(weldedACMR > 1.8f);
+	CHECK(optimizedACMR < 0.75f);
+	CHECK(GetTriangles(data) == triangles);
+	data.freeArrays();
+}
+
+TEST(MeshOptimizerOrdersVerticesByFirstUse) {
+	Mesh::Data data;
+	CreateShuffledGrid(data);
+	auto triangles = GetTriangles(data);
+	MeshOptimizer::Optimize(data);
+	float acmr = MeshOptimizer::ComputeACMR(data);
+
+	// Every index is either one already seen or the next new vertex
+	unsigned int numSeen = 0;
+	bool inOrder = true;
+	for (unsigned int i = 0; i < data.numIndices; i++) {
+		if (data.indices[i] == numSeen)
+			numSeen++;
+		else if (data.indices[i] > numSeen)
+			inOrder = false;
+	}
+	CHECK(inOrder);
+	CHECK(numSeen == data.numVertices);
+	CHECK(GetTriangles(data) == triangles);
+
+	// Renumbering the vertices does not change which ones the cache hits
+	MeshOptimizer::OptimizeVertexFetch(data);
+	CHECK_NEAR(MeshOptimizer::ComputeACMR(data), acmr, 1e-6f);
+	data.freeArrays();
+}
\ No newline at end of file
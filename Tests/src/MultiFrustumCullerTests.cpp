@@ -0,0 +1,130 @@
+#include "Test.h"
+#include "Sail/graphics/geometry/spatial/MultiFrustumCuller.h"
+#include "Sail/graphics/camera/Camera.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+namespace {
+	struct View {
+		Frustum frustum;
+		bool hasClippingPlane;
+		glm::vec4 clippingPlane;
+	};
+
+	View MakeView(const glm::vec3& position, const glm::vec3& target, float fovDegrees, float farZ) {
+		View view = {};
+		glm::mat4 viewMatrix = glm::lookAtLH(position, target, glm::vec3(0.f, 1.f, 0.f));
+		glm::mat4 proj = glm::perspectiveFovLH_ZO(glm::radians(fovDegrees), 1280.f, 720.f, 0.1f, farZ);
+		view.frustum.extractPlanes(proj * viewMatrix);
+		return view;
+	}
+
+	// Scalar reference, the box is culled if it is fully outside of any plane
+	bool IsVisible(const View& view, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+		if (!view.frustum.containsOrIntersects(AABB(boundsMin, boundsMax)))
+			return false;
+		if (view.hasClippingPlane) {
+			const glm::vec4& plane = view.clippingPlane;
+			glm::vec3 corner(
+				(plane.x > 0.f) ? boundsMax.x : boundsMin.x,
+				(plane.y > 0.f) ? boundsMax.y : boundsMin.y,
+				(plane.z > 0.f) ? boundsMax.z : boundsMin.z);
+			if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.f)
+				return false;
+		}
+		return true;
+	}
+
+	unsigned int ReferenceMask(const std::vector<View>& views, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+		unsigned int mask = 0;
+		for (unsigned int i = 0; i < views.size(); i++) {
+			if (IsVisible(views[i], boundsMin, boundsMax))
+				mask |= 1 << i;
+		}
+		return mask;
+	}
+
+	// Eight views, so both halves of the SSE rows are used, one with a clipping plane that keeps everything above y = 0
+	std::vector<View> MakeViews() {
+		std::vector<View> views;
+		views.push_back(MakeView(glm::vec3(0.f, 0.f, -10.f), glm::vec3(0.f), 70.f, 100.f));
+		views.push_back(MakeView(glm::vec3(0.f, 0.f, 10.f), glm::vec3(0.f), 70.f, 100.f));
+		views.push_back(MakeView(glm::vec3(20.f, 5.f, 0.f), glm::vec3(0.f), 40.f, 50.f));
+		views.push_back(MakeView(glm::vec3(0.f, 30.f, 0.1f), glm::vec3(0.f), 90.f, 60.f));
+		views.push_back(MakeView(glm::vec3(-15.f, 2.f, -15.f), glm::vec3(5.f, 0.f, 5.f), 60.f, 30.f));
+		views.push_back(MakeView(glm::vec3(0.f, 0.f, -10.f), glm::vec3(0.f, 0.f, -20.f), 70.f, 100.f));
+		views.push_back(MakeView(glm::vec3(50.f, 0.f, 50.f), glm::vec3(60.f, 0.f, 50.f), 20.f, 5.f));
+		View reflection = MakeView(glm::vec3(0.f, -5.f, -10.f), glm::vec3(0.f), 70.f, 100.f);
+		reflection.hasClippingPlane = true;
+		reflection.clippingPlane = glm::vec4(0.f, 1.f, 0.f, 0.f);
+		views.push_back(reflection);
+		return views;
+	}
+
+	void AddViews(MultiFrustumCuller& culler, const std::vector<View>& views) {
+		for (const View& view : views)
+			CHECK(culler.addView(view.frustum, (view.hasClippingPlane) ? &view.clippingPlane : nullptr) >= 0);
+	}
+}
+
+TEST(MultiFrustumCullerSortsKnownBoxes) {
+	std::vector<View> views = MakeViews();
+	MultiFrustumCuller culler;
+	AddViews(culler, views);
+	CHECK(culler.getNumViews() == 8);
+	CHECK(culler.getViewMask() == 0xFF);
+	CHECK(culler.addView(views[0].frustum) == -1);
+
+	// At the origin, seen by the views looking at it but not by the one looking away, and below the clipping plane
+	glm::vec3 origin(0.f, -0.5f, 0.f);
+	unsigned int mask = culler.getMask(origin - 0.4f, origin + 0.4f);
+	CHECK(mask == ReferenceMask(views, origin - 0.4f, origin + 0.4f));
+	CHECK((mask & 0x1F) == 0x1F);
+	CHECK((mask & (1 << 5)) == 0);
+	CHECK((mask & (1 << 7)) == 0);
+	// Straddling the clipping plane keeps it in the reflection
+	glm::vec3 straddle(0.f, 0.f, 0.f);
+	mask = culler.getMask(straddle - 0.5f, straddle + 0.5f);
+	CHECK(mask == ReferenceMask(views, straddle - 0.5f, straddle + 0.5f));
+	CHECK((mask & (1 << 7)) != 0);
+	// Straddling the far plane of view 6 keeps it, just beyond the plane culls it
+	glm::vec3 farPlane(55.f, 0.f, 50.f);
+	mask = culler.getMask(farPlane - 0.5f, farPlane + 0.5f);
+	CHECK(mask == ReferenceMask(views, farPlane - 0.5f, farPlane + 0.5f));
+	CHECK((mask & (1 << 6)) != 0);
+	glm::vec3 beyond(56.f, 0.f, 50.f);
+	mask = culler.getMask(beyond - 0.4f, beyond + 0.4f);
+	CHECK(mask == ReferenceMask(views, beyond - 0.4f, beyond + 0.4f));
+	CHECK((mask & (1 << 6)) == 0);
+	// Far away from everything
+	glm::vec3 outside(-500.f, 500.f, -500.f);
+	CHECK(culler.getMask(outside - 1.f, outside + 1.f) == 0);
+	// The parent mask limits the result
+	CHECK(culler.getMask(origin - 0.4f, origin + 0.4f, 0x3) == 0x3);
+}
+
+TEST(MultiFrustumCullerMatchesScalarReference) {
+	std::vector<View> views = MakeViews();
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> position(-70.f, 70.f);
+	std::uniform_real_distribution<float> size(0.01f, 10.f);
+
+	// Every number of views, so unused lanes never show up in the mask
+	for (unsigned int numViews = 1; numViews <= views.size(); numViews++) {
+		std::vector<View> used(views.begin(), views.begin() + numViews);
+		MultiFrustumCuller culler;
+		AddViews(culler, used);
+		unsigned int mismatches = 0;
+		unsigned int numVisible = 0;
+		for (unsigned int i = 0; i < 5000; i++) {
+			glm::vec3 center(position(random), position(random) * 0.5f, position(random));
+			glm::vec3 extents(size(random), size(random), size(random));
+			unsigned int mask = culler.getMask(center - extents, center + extents);
+			if (mask != ReferenceMask(used, center - extents, center + extents))
+				mismatches++;
+			numVisible += mask != 0;
+		}
+		CHECK(mismatches == 0);
+		CHECK(numVisible > 0);
+	}
+}
@@ -0,0 +1,41 @@
+#include "Test.h"
+#include "TestApplication.h"
+#include "API/NULL/NullAPI.h"
+#include "Sail/api/Renderer.h"
+#include "Sail/graphics/camera/PerspectiveCamera.h"
+#include "Sail/graphics/geometry/factory/CubeModel.h"
+#include "Sail/graphics/light/LightSetup.h"
+#include "Sail/graphics/shader/material/MaterialShader.h"
+
+TEST(NullBackendRecordsAFrame) {
+	TestApplication& app = TestApplication::Get();
+	NullAPI* api = app.getAPI<NullAPI>();
+	Shader* shader = &app.getResourceManager().getShaderSet<MaterialShader>();
+	std::unique_ptr<Model> cube = ModelFactory::CubeModel::Create(glm::vec3(0.5f), shader);
+	std::unique_ptr<Renderer> renderer(Renderer::Create(Renderer::FORWARD));
+	LightSetup lights;
+	renderer->setLightSetup(&lights);
+
+	PerspectiveCamera camera(90.f, 1280.f / 720.f, 0.1f, 100.f);
+	camera.setPosition(glm::vec3(0.f, 0.f, -5.f));
+	camera.setDirection(glm::vec3(0.f, 0.f, 1.f));
+
+	unsigned int framesBefore = api->getNumPresentedFrames();
+	renderer->begin(&camera);
+	for (float x : { -2.f, 0.f, 2.f })
+		renderer->submit(cube.get(), glm::translate(glm::mat4(1.f), glm::vec3(x, 0.f, 0.f)));
+	// Behind the camera, culled in end()
+	renderer->submit(cube.get(), glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, -20.f)));
+	renderer->end();
+	renderer->present();
+	api->present();
+
+	CHECK(api->getNumPresentedFrames() == framesBefore + 1);
+	const NullCommandStream::Counters& counters = api->getLastFrame().getCounters();
+	CHECK(counters.numDrawCalls() == 3);
+	CHECK(counters.indicesDrawn == 3 * cube->getMesh(0)->getNumIndices());
+	// Every cube uses the same pipeline, so the state cache only lets the first bind through
+	CHECK(counters.ops[NullCommandStream::BIND_PIPELINE] == 1);
+	CHECK(counters.ops[NullCommandStream::BIND_VERTEX_BUFFER] == 3);
+	CHECK(counters.cbufferBytesUploaded > 0);
+}
\ No newline at end of file
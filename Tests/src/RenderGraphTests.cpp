@@ -0,0 +1,245 @@
+#include "Test.h"
+#include "Sail/graphics/rendergraph/RenderGraph.h"
+
+namespace {
+	const RenderGraph::TextureDesc COLOR = { 1280, 720, RenderGraph::R8G8B8A8_UNORM, 0 };
+	const RenderGraph::TextureDesc DEPTH = { 1280, 720, RenderGraph::D32_FLOAT, 0 };
+
+	bool IsBarrier(const RenderGraph::Barrier& barrier, RenderGraph::ResourceHandle resource, RenderGraph::ResourceState before, RenderGraph::ResourceState after) {
+		return barrier.resource == resource && barrier.before == before && barrier.after == after;
+	}
+}
+
+TEST(RenderGraphCullsUnusedPasses) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle backBuffer = graph.importTexture("BackBuffer", COLOR, nullptr);
+	RenderGraph::ResourceHandle chain = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle scene = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle history = RenderGraph::INVALID_RESOURCE;
+
+	graph.addPass("Unused", [&](RenderGraph::PassBuilder& builder) { builder.create("Unused", COLOR); }, nullptr);
+	// Only read by a pass that is culled itself, so both go
+	graph.addPass("ChainStart", [&](RenderGraph::PassBuilder& builder) { chain = builder.create("Chain", COLOR); }, nullptr);
+	graph.addPass("ChainEnd", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(chain);
+		builder.create("ChainResult", COLOR);
+	}, nullptr);
+	graph.addPass("Scene", [&](RenderGraph::PassBuilder& builder) { scene = builder.create("Scene", COLOR); }, nullptr);
+	graph.addPass("Composite", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(scene);
+		builder.write(backBuffer);
+	}, nullptr);
+	graph.addPass("History", [&](RenderGraph::PassBuilder& builder) { history = builder.create("History", COLOR); }, nullptr);
+	graph.markOutput(history);
+	graph.addPass("Readback", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(scene);
+		builder.setSideEffect();
+	}, nullptr);
+	graph.addPass("Empty", nullptr, nullptr);
+
+	CHECK(graph.compile());
+	CHECK(graph.isPassCulled("Unused"));
+	CHECK(graph.isPassCulled("ChainStart"));
+	CHECK(graph.isPassCulled("ChainEnd"));
+	CHECK(!graph.isPassCulled("Scene"));
+	CHECK(!graph.isPassCulled("Composite"));
+	CHECK(!graph.isPassCulled("History"));
+	CHECK(!graph.isPassCulled("Readback"));
+	CHECK(graph.isPassCulled("Empty"));
+	CHECK(graph.getStats().numCulledPasses == 4);
+	CHECK(graph.getBarriers("Unused").empty());
+	CHECK(graph.getPhysicalIndex(chain) == RenderGraph::INVALID_RESOURCE);
+}
+
+TEST(RenderGraphDetectsCycles) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle shared = graph.importTexture("Shared", COLOR, nullptr);
+	RenderGraph::ResourceHandle x = RenderGraph::INVALID_RESOURCE;
+	// A reads what B writes later, so it runs after B, while B reads what A creates
+	graph.addPass("A", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(shared);
+		x = builder.create("X", COLOR);
+	}, nullptr);
+	graph.addPass("B", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(x);
+		builder.write(shared);
+	}, nullptr);
+	CHECK(!graph.compile());
+	CHECK(graph.getExecutionOrder().empty());
+
+	// Without the read of X, B simply runs first
+	graph.reset();
+	shared = graph.importTexture("Shared", COLOR, nullptr);
+	graph.addPass("A", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(shared);
+		x = builder.create("X", COLOR);
+	}, nullptr);
+	graph.markOutput(x);
+	graph.addPass("B", [&](RenderGraph::PassBuilder& builder) { builder.write(shared); }, nullptr);
+	CHECK(graph.compile());
+	const std::vector<unsigned int>& order = graph.getExecutionOrder();
+	CHECK(order.size() == 2 && order[0] == 1 && order[1] == 0);
+}
+
+TEST(RenderGraphRejectsStaleHandles) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle x = RenderGraph::INVALID_RESOURCE;
+	graph.addPass("Create", [&](RenderGraph::PassBuilder& builder) { x = builder.create("X", COLOR); }, nullptr);
+	graph.reset();
+	// The handle refers to a resource of the previous frame
+	graph.addPass("Read", [&](RenderGraph::PassBuilder& builder) { builder.read(x); }, nullptr);
+	CHECK(!graph.compile());
+}
+
+TEST(RenderGraphOrdersWriteAfterRead) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle backBuffer = graph.importTexture("BackBuffer", COLOR, nullptr);
+	RenderGraph::ResourceHandle shadow = graph.importTexture("Shadow", COLOR, nullptr);
+	RenderGraph::ResourceHandle x = RenderGraph::INVALID_RESOURCE;
+	graph.addPass("CreateX", [&](RenderGraph::PassBuilder& builder) { x = builder.create("X", COLOR); }, nullptr);
+	graph.addPass("ReadX", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(x);
+		builder.read(shadow);
+		builder.write(backBuffer);
+	}, nullptr);
+	graph.addPass("OverwriteX", [&](RenderGraph::PassBuilder& builder) { builder.write(x); }, nullptr);
+	graph.markOutput(x);
+	graph.addPass("WriteShadow", [&](RenderGraph::PassBuilder& builder) { builder.write(shadow); }, nullptr);
+
+	// ReadX waits for WriteShadow, and OverwriteX may not run before ReadX has seen the first contents of X
+	CHECK(graph.compile());
+	const std::vector<unsigned int>& order = graph.getExecutionOrder();
+	CHECK(order.size() == 4 && order[0] == 0 && order[1] == 3 && order[2] == 1 && order[3] == 2);
+}
+
+TEST(RenderGraphPlansBarriersInOrder) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle backBuffer = graph.importTexture("BackBuffer", COLOR, nullptr);
+	RenderGraph::ResourceHandle albedo = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle depth = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle lit = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle bloom = RenderGraph::INVALID_RESOURCE;
+	graph.addPass("GBuffer", [&](RenderGraph::PassBuilder& builder) {
+		albedo = builder.create("Albedo", COLOR);
+		depth = builder.create("Depth", DEPTH);
+	}, nullptr);
+	graph.addPass("Lighting", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(albedo);
+		builder.read(depth);
+		lit = builder.create("Lit", COLOR);
+	}, nullptr);
+	graph.addPass("Bloom", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(lit);
+		bloom = builder.create("Bloom", COLOR);
+	}, nullptr);
+	graph.addPass("Composite", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(bloom);
+		builder.write(backBuffer);
+	}, nullptr);
+	CHECK(graph.compile());
+
+	const std::vector<RenderGraph::Barrier>& gbuffer = graph.getBarriers("GBuffer");
+	CHECK(gbuffer.size() == 2);
+	CHECK(gbuffer.size() == 2 && IsBarrier(gbuffer[0], albedo, RenderGraph::UNDEFINED, RenderGraph::RENDER_TARGET));
+	CHECK(gbuffer.size() == 2 && IsBarrier(gbuffer[1], depth, RenderGraph::UNDEFINED, RenderGraph::DEPTH_WRITE));
+
+	const std::vector<RenderGraph::Barrier>& lighting = graph.getBarriers("Lighting");
+	CHECK(lighting.size() == 3);
+	CHECK(lighting.size() == 3 && IsBarrier(lighting[0], albedo, RenderGraph::RENDER_TARGET, RenderGraph::SHADER_READ));
+	CHECK(lighting.size() == 3 && IsBarrier(lighting[1], depth, RenderGraph::DEPTH_WRITE, RenderGraph::SHADER_READ));
+	CHECK(lighting.size() == 3 && IsBarrier(lighting[2], lit, RenderGraph::UNDEFINED, RenderGraph::RENDER_TARGET));
+
+	// Albedo is dead after lighting, so bloom takes over its target in the state albedo left it in
+	CHECK(graph.getPhysicalIndex(bloom) == graph.getPhysicalIndex(albedo));
+	CHECK(graph.getPhysicalIndex(lit) != graph.getPhysicalIndex(albedo));
+	CHECK(graph.getStats().numPhysicalResources == 3);
+	const std::vector<RenderGraph::Barrier>& bloomPass = graph.getBarriers("Bloom");
+	CHECK(bloomPass.size() == 2);
+	CHECK(bloomPass.size() == 2 && IsBarrier(bloomPass[0], lit, RenderGraph::RENDER_TARGET, RenderGraph::SHADER_READ));
+	CHECK(bloomPass.size() == 2 && IsBarrier(bloomPass[1], bloom, RenderGraph::SHADER_READ, RenderGraph::RENDER_TARGET));
+
+	const std::vector<RenderGraph::Barrier>& composite = graph.getBarriers("Composite");
+	CHECK(composite.size() == 2);
+	CHECK(composite.size() == 2 && IsBarrier(composite[0], bloom, RenderGraph::RENDER_TARGET, RenderGraph::SHADER_READ));
+	CHECK(composite.size() == 2 && IsBarrier(composite[1], backBuffer, RenderGraph::UNDEFINED, RenderGraph::RENDER_TARGET));
+}
+
+TEST(RenderGraphMergesReadAndWriteOfOnePass) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle backBuffer = graph.importTexture("BackBuffer", COLOR, nullptr);
+	RenderGraph::ResourceHandle depth = RenderGraph::INVALID_RESOURCE;
+	graph.addPass("Prepass", [&](RenderGraph::PassBuilder& builder) { depth = builder.create("Depth", DEPTH); }, nullptr);
+	// Depth testing against the prepass reads and writes the same target
+	graph.addPass("Forward", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(depth);
+		builder.write(depth);
+		builder.write(backBuffer);
+	}, nullptr);
+	CHECK(graph.compile());
+	const std::vector<RenderGraph::Barrier>& forward = graph.getBarriers("Forward");
+	CHECK(forward.size() == 1);
+	CHECK(forward.size() == 1 && IsBarrier(forward[0], backBuffer, RenderGraph::UNDEFINED, RenderGraph::RENDER_TARGET));
+}
+
+TEST(RenderGraphAliasesSequentialTargets) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle backBuffer = graph.importTexture("BackBuffer", COLOR, nullptr);
+	RenderGraph::ResourceHandle a = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle b = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle c = RenderGraph::INVALID_RESOURCE;
+	// A post process chain, each target is only alive while the pass after it reads it
+	graph.addPass("First", [&](RenderGraph::PassBuilder& builder) { a = builder.create("A", COLOR); }, nullptr);
+	graph.addPass("Second", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(a);
+		b = builder.create("B", COLOR);
+	}, nullptr);
+	graph.addPass("Third", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(b);
+		c = builder.create("C", COLOR);
+	}, nullptr);
+	graph.addPass("Composite", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(c);
+		builder.write(backBuffer);
+	}, nullptr);
+
+	CHECK(graph.compile());
+	const RenderGraph::Stats& stats = graph.getStats();
+	unsigned long long size = COLOR.getSizeInBytes();
+	CHECK(stats.numTransientResources == 3);
+	CHECK(stats.transientMemory == 3 * size);
+	CHECK(stats.peakLiveMemory == 2 * size);
+	CHECK(stats.aliasedMemory == 2 * size);
+	CHECK(stats.aliasedMemory < stats.transientMemory);
+	CHECK(stats.numPhysicalResources == 2);
+	CHECK(graph.getPhysicalIndex(c) == graph.getPhysicalIndex(a));
+	CHECK(graph.getPhysicalIndex(b) != graph.getPhysicalIndex(a));
+}
+
+TEST(RenderGraphDoesNotAliasOverlappingTargets) {
+	RenderGraph graph;
+	RenderGraph::ResourceHandle backBuffer = graph.importTexture("BackBuffer", COLOR, nullptr);
+	RenderGraph::ResourceHandle a = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle b = RenderGraph::INVALID_RESOURCE;
+	RenderGraph::ResourceHandle c = RenderGraph::INVALID_RESOURCE;
+	// All three are read by the last pass, so they are alive at the same time
+	graph.addPass("First", [&](RenderGraph::PassBuilder& builder) { a = builder.create("A", COLOR); }, nullptr);
+	graph.addPass("Second", [&](RenderGraph::PassBuilder& builder) { b = builder.create("B", COLOR); }, nullptr);
+	graph.addPass("Third", [&](RenderGraph::PassBuilder& builder) { c = builder.create("C", COLOR); }, nullptr);
+	graph.addPass("Composite", [&](RenderGraph::PassBuilder& builder) {
+		builder.read(a);
+		builder.read(b);
+		builder.read(c);
+		builder.write(backBuffer);
+	}, nullptr);
+
+	CHECK(graph.compile());
+	const RenderGraph::Stats& stats = graph.getStats();
+	unsigned long long size = COLOR.getSizeInBytes();
+	CHECK(stats.transientMemory == 3 * size);
+	CHECK(stats.peakLiveMemory == 3 * size);
+	CHECK(stats.aliasedMemory == stats.transientMemory);
+	CHECK(stats.numPhysicalResources == 3);
+	CHECK(graph.getPhysicalIndex(a) != graph.getPhysicalIndex(b));
+	CHECK(graph.getPhysicalIndex(b) != graph.getPhysicalIndex(c));
+	CHECK(graph.getPhysicalIndex(a) != graph.getPhysicalIndex(c));
+}
\ No newline at end of file
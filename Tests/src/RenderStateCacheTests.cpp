@@ -0,0 +1,40 @@
+#include "Test.h"
+#include "Sail/api/RenderStateCache.h"
+
+namespace {
+	const unsigned int PS = 2;
+	// Two views of the same resource, as a color and a depth stencil view would be
+	const uint64_t SRV_A = 0x100;
+	const uint64_t SRV_B = 0x200;
+	const uint64_t SRV_OTHER = 0x300;
+	const uint64_t RESOURCE = 0x1000;
+	const uint64_t OTHER_RESOURCE = 0x2000;
+}
+
+TEST(RenderStateCacheSkipsRedundantTextureBinds) {
+	RenderStateCache cache;
+	CHECK(cache.setTexture(0, PS, SRV_A, RESOURCE));
+	CHECK(!cache.setTexture(0, PS, SRV_A, RESOURCE));
+	CHECK(cache.setTexture(0, PS, SRV_OTHER, OTHER_RESOURCE));
+	CHECK(cache.getStats().textureBinds == 2);
+	CHECK(cache.getStats().textureSkips == 1);
+}
+
+TEST(RenderStateCacheForgetsTexturesOfOutputResource) {
+	RenderStateCache cache;
+	cache.setTexture(0, PS, SRV_A, RESOURCE);
+	cache.setTexture(1, PS, SRV_OTHER, OTHER_RESOURCE);
+	cache.setTexture(2, PS, SRV_B, RESOURCE);
+	// Binding the resource for output unbinds every view reading from it, but nothing else
+	cache.unbindResource(RESOURCE);
+	CHECK(cache.setTexture(0, PS, SRV_A, RESOURCE));
+	CHECK(!cache.setTexture(1, PS, SRV_OTHER, OTHER_RESOURCE));
+	CHECK(cache.setTexture(2, PS, SRV_B, RESOURCE));
+	// A slot rebound to another resource is not affected by the old one
+	cache.setTexture(0, PS, SRV_OTHER, OTHER_RESOURCE);
+	cache.unbindResource(RESOURCE);
+	CHECK(!cache.setTexture(0, PS, SRV_OTHER, OTHER_RESOURCE));
+	// Unknown resources never match
+	cache.unbindResource(0);
+	CHECK(!cache.setTexture(0, PS, SRV_OTHER, OTHER_RESOURCE));
+}
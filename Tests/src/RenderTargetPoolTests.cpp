@@ -0,0 +1,112 @@
+#include "Test.h"
+#include "Sail/graphics/rendergraph/RenderTargetPool.h"
+#include "Sail/api/RenderableTexture.h"
+
+namespace {
+	const RenderGraph::TextureDesc COLOR = { 1280, 720, RenderGraph::R8G8B8A8_UNORM, 0 };
+	const RenderGraph::TextureDesc HDR = { 1280, 720, RenderGraph::R16G16B16A16_FLOAT, 0 };
+
+	// Target without a graphics API behind it, only its identity matters
+	class FakeTarget : public RenderableTexture {
+	public:
+		virtual void begin() override {}
+		virtual void end() override {}
+		virtual void clear(const glm::vec4& color) override {}
+		virtual void resize(int width, int height) override {}
+	};
+
+	RenderableTexture* AllocateFake(const RenderTargetPool::Desc& desc) {
+		return new FakeTarget();
+	}
+}
+
+TEST(RenderTargetPoolReusesReleasedTargets) {
+	RenderTargetPool pool(AllocateFake);
+	RenderableTexture* first = pool.acquire(COLOR);
+	CHECK(first != nullptr);
+	// Released during the frame, a later user of the same frame gets it back
+	pool.release(first);
+	CHECK(pool.acquire(COLOR) == first);
+	// Returned by endFrame, the next frame gets it back
+	pool.endFrame();
+	CHECK(pool.acquire(COLOR) == first);
+	CHECK(pool.getStats().numAllocations == 1);
+	CHECK(pool.getStats().numReuses == 2);
+	CHECK(pool.getStats().memory == COLOR.getSizeInBytes());
+}
+
+TEST(RenderTargetPoolKeepsTargetsInUse) {
+	RenderTargetPool pool(AllocateFake);
+	RenderableTexture* first = pool.acquire(COLOR);
+	// Still in use, so the same description gets a new target
+	RenderableTexture* second = pool.acquire(COLOR);
+	CHECK(second != nullptr && second != first);
+	// Another format never gets a free target of the wrong format
+	pool.release(first);
+	RenderableTexture* hdr = pool.acquire(HDR);
+	CHECK(hdr != first && hdr != second);
+	CHECK(pool.getStats().numTargets == 3);
+	CHECK(pool.getStats().numInUse == 2);
+	CHECK(pool.acquire(COLOR) == first);
+	CHECK(pool.getStats().numInUse == 3);
+}
+
+TEST(RenderTargetPoolEvictsUnusedTargets) {
+	RenderTargetPool pool(AllocateFake, 2);
+	RenderableTexture* kept = pool.acquire(COLOR);
+	pool.acquire(HDR);
+	pool.endFrame();
+	// Only the color target is used in the following frames, the HDR one goes after two unused frames
+	for (unsigned int frame = 0; frame < 3; frame++) {
+		CHECK(pool.getStats().numTargets == 2);
+		CHECK(pool.acquire(COLOR) == kept);
+		pool.endFrame();
+	}
+	CHECK(pool.getStats().numTargets == 1);
+	CHECK(pool.getStats().numEvictions == 1);
+	CHECK(pool.getStats().memory == COLOR.getSizeInBytes());
+	CHECK(pool.acquire(COLOR) == kept);
+	// trim() only destroys targets that are not acquired
+	pool.trim();
+	CHECK(pool.getStats().numTargets == 1);
+	pool.endFrame();
+	pool.trim();
+	CHECK(pool.getStats().numTargets == 0);
+}
+
+TEST(RenderGraphTakesTargetsFromPool) {
+	RenderTargetPool pool(AllocateFake);
+	RenderableTexture* seenA = nullptr;
+	RenderableTexture* seenC = nullptr;
+	RenderableTexture* seenOther = nullptr;
+	for (unsigned int frame = 0; frame < 3; frame++) {
+		RenderGraph graph;
+		graph.setPool(&pool);
+		RenderGraph::ResourceHandle a = RenderGraph::INVALID_RESOURCE;
+		RenderGraph::ResourceHandle b = RenderGraph::INVALID_RESOURCE;
+		RenderGraph::ResourceHandle c = RenderGraph::INVALID_RESOURCE;
+		graph.addPass("A", [&](RenderGraph::PassBuilder& builder) { a = builder.create("A", COLOR); },
+			[&](const RenderGraph::PassResources& resources) { seenA = resources.getTexture(a); });
+		graph.addPass("B", [&](RenderGraph::PassBuilder& builder) {
+			builder.read(a);
+			b = builder.create("B", COLOR);
+		}, nullptr);
+		graph.addPass("C", [&](RenderGraph::PassBuilder& builder) {
+			builder.read(b);
+			c = builder.create("C", COLOR);
+		}, [&](const RenderGraph::PassResources& resources) { seenC = resources.getTexture(c); });
+		graph.markOutput(c);
+		CHECK(graph.compile());
+		graph.execute();
+
+		// A and C alias within the graph, so the chain needs two targets in total
+		CHECK(seenA != nullptr && seenA == seenC);
+		// The output is held until the end of the frame, while B was released after its last reader
+		seenOther = pool.acquire(COLOR);
+		CHECK(seenOther != nullptr && seenOther != seenC);
+		pool.endFrame();
+		// Every frame after the first reuses the targets of the one before
+		CHECK(pool.getStats().numAllocations == 2);
+	}
+	CHECK(pool.getStats().numTargets == 2);
+}
@@ -0,0 +1,70 @@
+#include "Test.h"
+#include "TestApplication.h"
+
+namespace {
+	// Every unreferenced resource is over a budget of zero, so the delay alone decides when it is evicted
+	struct ZeroBudget {
+		ZeroBudget(ResourceManager& manager) : manager(manager) { manager.setMemoryBudget(0, 0); }
+		~ZeroBudget() { manager.setMemoryBudget(SIZE_MAX, SIZE_MAX); }
+		ResourceManager& manager;
+	};
+
+	unsigned int EvictionDelay() {
+		return TestApplication::Get().getAPI()->getNumFramesInFlight() + 1;
+	}
+}
+
+TEST(ResourceManagerEvictsReleasedTextureAfterDelay) {
+	ResourceManager& manager = TestApplication::Get().getResourceManager();
+	ZeroBudget budget(manager);
+	ResourceID id("sponza/textures/chain_texture.tga");
+
+	TextureHandle handle = manager.loadTextureAsync(id);
+	manager.waitForPendingLoads();
+	CHECK(handle.isReady());
+	CHECK(manager.hasTexture(id));
+
+	// A copy keeps the texture loaded after the first handle is gone
+	TextureHandle copy = handle;
+	handle.reset();
+	for (unsigned int i = 0; i < EvictionDelay() * 2; i++)
+		manager.update();
+	CHECK(manager.hasTexture(id));
+
+	// After the last handle, the texture survives for the delay and is evicted by the update after it
+	unsigned int unreferencedBefore = manager.getMemoryUsage(ResourceManager::TEXTURE).numUnreferenced;
+	copy.reset();
+	CHECK(manager.getMemoryUsage(ResourceManager::TEXTURE).numUnreferenced == unreferencedBefore + 1);
+	for (unsigned int i = 1; i < EvictionDelay(); i++) {
+		manager.update();
+		CHECK(manager.hasTexture(id));
+	}
+	manager.update();
+	CHECK(!manager.hasTexture(id));
+}
+
+TEST(ResourceManagerNeverEvictsPinnedTexture) {
+	ResourceManager& manager = TestApplication::Get().getResourceManager();
+	ZeroBudget budget(manager);
+	ResourceID id("sponza/textures/chain_texture_mask.tga");
+
+	manager.loadTexture(id);
+	Texture* texture = &manager.getTexture(id);
+	// Handles coming and going do not unpin it
+	manager.loadTextureAsync(id).reset();
+	for (unsigned int i = 0; i < EvictionDelay() * 4; i++)
+		manager.update();
+	CHECK(manager.hasTexture(id));
+	CHECK(&manager.getTexture(id) == texture);
+	manager.evictUnreferenced();
+	CHECK(manager.hasTexture(id));
+
+	// Unpinning starts the same delay as releasing the last handle
+	manager.releaseTexture(id);
+	for (unsigned int i = 1; i < EvictionDelay(); i++) {
+		manager.update();
+		CHECK(manager.hasTexture(id));
+	}
+	manager.update();
+	CHECK(!manager.hasTexture(id));
+}
@@ -0,0 +1,122 @@
+#include "Test.h"
+#include "Sail/resources/ResourceTable.h"
+#include <random>
+#include <unordered_map>
+
+namespace {
+	// A new table has 16 slots, which holds up to 8 entries before it grows
+	const uint64_t NUM_SLOTS = 16;
+
+	// Ids of made up paths whose home slot in a new table is slot
+	std::vector<ResourceID> IdsWithHomeSlot(uint64_t slot, unsigned int count) {
+		std::vector<ResourceID> ids;
+		for (unsigned int i = 0; ids.size() < count; i++) {
+			std::string path = "tests/table/slot" + std::to_string(slot) + "_" + std::to_string(i);
+			if ((ResourceID::Hash(path.data(), path.size()) & (NUM_SLOTS - 1)) == slot)
+				ids.emplace_back(path);
+		}
+		return ids;
+	}
+}
+
+TEST(ResourceTableRejectsInvalidId) {
+	ResourceTable<int> table;
+	CHECK(table.insert(ResourceID(), 1) == nullptr);
+	CHECK(table.size() == 0);
+	CHECK(table.find(ResourceID()) == nullptr);
+	ResourceID id("tests/table/valid");
+	CHECK(table.insert(id, 2) != nullptr);
+	CHECK(table.insert(ResourceID(), 3) == nullptr);
+	CHECK(table.size() == 1);
+	CHECK(*table.find(id) == 2);
+	CHECK(!table.erase(ResourceID()));
+}
+
+TEST(ResourceTableProbesAroundTheEnd) {
+	// Three ids that all want the last slot wrap around to the first slots, and one that wants slot 0 lands after them
+	std::vector<ResourceID> last = IdsWithHomeSlot(NUM_SLOTS - 1, 3);
+	ResourceID first = IdsWithHomeSlot(0, 1)[0];
+	ResourceTable<int> table;
+	for (int i = 0; i < 3; i++)
+		table.insert(last[i], i);
+	table.insert(first, 3);
+	CHECK(table.size() == 4);
+	for (int i = 0; i < 3; i++)
+		CHECK(table.find(last[i]) && *table.find(last[i]) == i);
+	CHECK(table.find(first) && *table.find(first) == 3);
+	// Inserting an existing id keeps the first value
+	CHECK(*table.insert(last[1], 10) == 1);
+	CHECK(table.size() == 4);
+}
+
+TEST(ResourceTableEraseShiftsBackAcrossTheEnd) {
+	std::vector<ResourceID> last = IdsWithHomeSlot(NUM_SLOTS - 1, 3);
+	std::vector<ResourceID> first = IdsWithHomeSlot(0, 2);
+	ResourceTable<int> table;
+	for (int i = 0; i < 3; i++)
+		table.insert(last[i], i);
+	for (int i = 0; i < 2; i++)
+		table.insert(first[i], 3 + i);
+
+	// Removing the head of the chain shifts every later entry back one slot, over the end of the table
+	CHECK(table.erase(last[0]));
+	CHECK(table.find(last[0]) == nullptr);
+	CHECK(table.find(last[1]) && *table.find(last[1]) == 1);
+	CHECK(table.find(last[2]) && *table.find(last[2]) == 2);
+	CHECK(table.find(first[0]) && *table.find(first[0]) == 3);
+	CHECK(table.find(first[1]) && *table.find(first[1]) == 4);
+
+	// Removing from the middle has to move entries whose home slot is before the gap
+	CHECK(table.erase(last[2]));
+	CHECK(table.find(last[1]) && *table.find(last[1]) == 1);
+	CHECK(table.find(first[0]) && *table.find(first[0]) == 3);
+	CHECK(table.find(first[1]) && *table.find(first[1]) == 4);
+	CHECK(!table.erase(last[2]));
+	CHECK(table.size() == 3);
+
+	// The gap left at the end has to be usable again
+	CHECK(*table.insert(last[0], 5) == 5);
+	CHECK(table.find(last[0]) && *table.find(last[0]) == 5);
+	CHECK(table.size() == 4);
+}
+
+TEST(ResourceTableMatchesAReferenceMap) {
+	// Random inserts and erases over a small set of ids keep the probe chains long and crowded
+	std::vector<ResourceID> ids;
+	for (unsigned int i = 0; i < 64; i++)
+		ids.emplace_back("tests/table/random_" + std::to_string(i));
+	ResourceTable<unsigned int> table;
+	std::unordered_map<uint64_t, unsigned int> reference;
+	std::mt19937 random(7);
+	for (unsigned int step = 0; step < 20000; step++) {
+		const ResourceID& id = ids[random() % ids.size()];
+		if (random() % 2) {
+			table.insert(id, step);
+			reference.insert({ id.getHash(), step });
+		} else {
+			CHECK(table.erase(id) == (reference.erase(id.getHash()) == 1));
+		}
+	}
+	CHECK(table.size() == reference.size());
+	for (const ResourceID& id : ids) {
+		auto it = reference.find(id.getHash());
+		const unsigned int* value = table.find(id);
+		CHECK((value != nullptr) == (it != reference.end()));
+		if (value && it != reference.end())
+			CHECK(*value == it->second);
+	}
+}
+
+TEST(ResourceIdRejectsCollidingPaths) {
+	// Two different paths with the same 64 bit FNV-1a hash
+	const char* firstPath = "8yn0iYCKYHlIj4-BwPqk";
+	const char* secondPath = "GReLUrM4wMqfg9yzV3KQ";
+	CHECK(ResourceID::Hash(firstPath, 20) == ResourceID::Hash(secondPath, 20));
+	ResourceID first(firstPath);
+	ResourceID second(secondPath);
+	CHECK(first.isValid());
+	CHECK(!second.isValid());
+	CHECK(first.getPath() == firstPath);
+	// The first path keeps its id
+	CHECK(ResourceID(firstPath) == first);
+}
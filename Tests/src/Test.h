@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Minimal test registry for code that runs without a window or graphics device
+// TEST(Name) registers a function that main() runs, CHECK records a failure and lets the test continue
+namespace Test {
+
+	struct Case {
+		const char* name;
+		void (*function)();
+	};
+	std::vector<Case>& GetCases();
+	void Fail(const char* file, int line, const std::string& expression);
+
+	struct Registrar {
+		Registrar(const char* name, void (*function)()) {
+			GetCases().push_back({ name, function });
+		}
+	};
+
+}
+
+#define TEST(name) \
+	static void name(); \
+	static Test::Registrar name##Registrar(#name, &name); \
+	static void name()
+
+#define CHECK(expression) \
+	do { if (!(expression)) Test::Fail(__FILE__, __LINE__, #expression); } while (0)
+
+#define CHECK_NEAR(a, b, epsilon) \
+	do { if (!(std::abs((a) - (b)) <= (epsilon))) Test::Fail(__FILE__, __LINE__, #a " == " #b " within " #epsilon); } while (0)
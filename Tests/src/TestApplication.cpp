@@ -0,0 +1,39 @@
+#include "TestApplication.h"
+
+TestApplication& TestApplication::Get() {
+	static TestApplication app;
+	return app;
+}
+
+TestApplication::TestApplication()
+	: Application(1280, 720, "Sail tests", nullptr)
+	, m_frame(0)
+	, m_numFrames(0)
+{
+}
+
+int TestApplication::runFrames(unsigned int numFrames, FrameFunction onFrame) {
+	m_frame = 0;
+	m_numFrames = numFrames;
+	m_onFrame = onFrame;
+	int exitCode = startGameLoop();
+	m_onFrame = nullptr;
+	return exitCode;
+}
+
+int TestApplication::run() {
+	return startGameLoop();
+}
+
+void TestApplication::processInput(float dt) {
+	if (m_onFrame)
+		m_onFrame(m_frame, dt);
+}
+
+void TestApplication::update(float dt) {
+}
+
+void TestApplication::render(float dt) {
+	if (++m_frame >= m_numFrames)
+		getWindow()->requestClose(0);
+}
\ No newline at end of file
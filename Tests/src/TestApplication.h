@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+#include "Sail/Platform.h"
+#include "Sail/Application.h"
+
+// Application for tests that need the engine, such as the resource manager, a renderer or the game loop
+// Tests run on the Null platform, so it has no window or graphics device
+// Only one application can exist, every test shares the one from Get()
+class TestApplication : public Application {
+public:
+	// Called with the index of the frame, from processInput()
+	typedef std::function<void(unsigned int frame, float dt)> FrameFunction;
+
+public:
+	static TestApplication& Get();
+	TestApplication();
+
+	// Runs the game loop for a number of frames and returns its exit code
+	int runFrames(unsigned int numFrames, FrameFunction onFrame = nullptr);
+
+	virtual int run() override;
+	virtual void processInput(float dt) override;
+	virtual void update(float dt) override;
+	virtual void render(float dt) override;
+
+private:
+	unsigned int m_frame;
+	unsigned int m_numFrames;
+	FrameFunction m_onFrame;
+
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "Test.h"
+#include "Sail/utils/ThreadPool.h"
+#include <stdexcept>
+
+TEST(ThreadPoolParallelForRunsEveryIndexOnce) {
+	ThreadPool pool(3);
+	std::vector<std::atomic<unsigned int>> calls(1000);
+	for (auto& count : calls)
+		count = 0;
+	pool.parallelFor((unsigned int)calls.size(), [&](unsigned int i) {
+		calls[i]++;
+	});
+	bool once = true;
+	for (auto& count : calls)
+		once &= count == 1;
+	CHECK(once);
+}
+
+TEST(ThreadPoolParallelForRethrowsOnCaller) {
+	ThreadPool pool(2);
+	std::atomic<unsigned int> workerCalls(0);
+	std::atomic<unsigned int> numCalls(0);
+	bool caught = false;
+	try {
+		// The calling thread waits in its call until a worker has thrown, so the exception has to cross threads
+		pool.parallelFor(16, [&](unsigned int i) {
+			numCalls++;
+			if (ThreadPool::IsWorkerThread()) {
+				workerCalls++;
+				throw std::runtime_error("worker " + std::to_string(i));
+			}
+			while (workerCalls == 0)
+				std::this_thread::yield();
+		});
+	} catch (const std::runtime_error& error) {
+		caught = std::string(error.what()).find("worker") == 0;
+	}
+	CHECK(caught);
+	// The other calls still ran, and the pool keeps working afterwards
+	CHECK(numCalls == 16);
+	std::atomic<unsigned int> sum(0);
+	pool.parallelFor(100, [&](unsigned int i) { sum += i; });
+	CHECK(sum == 4950);
+}
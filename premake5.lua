@@ -2,7 +2,8 @@
 workspace "Sail"
 	configurations { "Debug", "Release" }
 	platforms { "DX11 x64", "DX11 x86",
-				"DX12 x64", "DX12 x86"
+				"DX12 x64", "DX12 x86",
+				"Null x64", "Null x86"
 				-- "Vulkan x64", "Vulkan x86",
 			  }
 
@@ -63,6 +64,20 @@ project "Demo"
 	filter "system:windows"
 		systemversion "latest"
 
+	-- Static libraries do not pass their dependencies on when linking with gcc, the fbx sdk for linux is linked statically
+	filter "system:linux"
+		links {
+			"ImGui",
+			"fbxsdk",
+			"xml2",
+			"z",
+			"pthread",
+			"dl"
+		}
+		libdirs {
+			"libraries/FBX_SDK/lib/gcc/x64/%{string.lower(cfg.buildcfg)}"
+		}
+
 	filter "configurations:Debug"
 		defines { "DEBUG" }
 		symbols "On"
@@ -82,6 +97,78 @@ project "Demo"
 		}
 
 
+-- Headless tests of engine code that does not need a window or graphics device
+-- Tests that need the engine run it on the Null platform, so the project is only built for that platform
+project "Tests"
+	location "Tests"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	removeplatforms { "DX11 x64", "DX11 x86", "DX12 x64", "DX12 x86" }
+
+	targetdir (binDir)
+	objdir (intermediatesDir)
+	-- Shaders and textures are loaded from the demo resources
+	debugdir "Demo"
+
+	files { 
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp"
+	}
+
+	includedirs {
+		"libraries",
+		"Sail/src",
+		"%{IncludeDir.FBX_SDK}",
+		"%{IncludeDir.ImGui}"
+	}
+
+	links {
+		"Sail"
+	}
+
+	-- Same clip space as the engine, which defines it in its pch
+	defines {
+		"GLM_FORCE_DEPTH_ZERO_TO_ONE"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	-- Static libraries do not pass their dependencies on when linking with gcc, the fbx sdk for linux is linked statically
+	filter "system:linux"
+		links {
+			"ImGui",
+			"fbxsdk",
+			"xml2",
+			"z",
+			"pthread",
+			"dl"
+		}
+		libdirs {
+			"libraries/FBX_SDK/lib/gcc/x64/%{string.lower(cfg.buildcfg)}"
+		}
+
+	filter "configurations:Debug"
+		defines { "DEBUG" }
+		symbols "On"
+
+	filter "configurations:Release"
+		defines { "NDEBUG" }
+		optimize "On"
+
+	filter { "action:vs2017 or vs2019", "platforms:*64" }
+		postbuildcommands {
+			"{COPY} \"../libraries/FBX_SDK/lib/vs2017/x64/%{cfg.buildcfg}/libfbxsdk.dll\" \"%{cfg.targetdir}\""
+		}
+	filter { "action:vs2017 or vs2019", "platforms:*86" }
+		postbuildcommands {
+			"{COPY} \"../libraries/FBX_SDK/lib/vs2017/x86/%{cfg.buildcfg}/libfbxsdk.dll\" \"%{cfg.targetdir}\""
+		}
+
+
 project "Sail"
 	location "Sail"
 	kind "StaticLib"
@@ -104,6 +191,8 @@ project "Sail"
 		"%{prj.name}/src/API/DX11/**",
 		"%{prj.name}/src/API/DX12/**",
 		"%{prj.name}/src/API/VULKAN/**",
+		"%{prj.name}/src/API/NULL/**",
+		"%{prj.name}/src/API/Windows/**",
 
 		"**/DXCubeMap.*",
 		"%{prj.name}/src/Sail/resources/audio/**",
@@ -130,7 +219,6 @@ project "Sail"
 	}
 
 	links {
-		"libfbxsdk",
 		"GLFW",
 		"ImGui"
 	}
@@ -155,6 +243,13 @@ project "Sail"
 			"%{prj.name}/src/API/DX12/**",
 			"%{prj.name}/src/API/Windows/**"
 		}
+	filter { "platforms:Null*" }
+		defines {
+			"_SAIL_NULL"
+		}
+		files {
+			"%{prj.name}/src/API/NULL/**"
+		}
 
 	filter { "action:vs2017 or vs2019", "platforms:*64" }
 		libdirs {
@@ -172,6 +267,9 @@ project "Sail"
 			"FBXSDK_SHARED",
 			"GLFW_INCLUDE_NONE"
 		}
+		links {
+			"libfbxsdk"
+		}
 
 	filter "configurations:Debug"
 		defines { "DEBUG" }